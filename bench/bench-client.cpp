@@ -0,0 +1,172 @@
+/*
+ * Lightweight GeoClue2 client process for the end-to-end benchmarks
+ *
+ * Connects to the system bus from DBUS_SYSTEM_BUS_ADDRESS, creates and
+ * starts one client and prints "ready". For every LocationUpdated it notes
+ * the receipt time and fetches the new Location with an async GetAll. The
+ * Altitude carries the stand-in's emit time (see geoclue1-standin.cpp).
+ *
+ * On SIGTERM it prints one "sample <emit_us> <received_us> <fetched_us>"
+ * line per fix, followed by "failed <n>" for fixes whose GetAll failed.
+ */
+
+#include <gio/gio.h>
+#include <glib-unix.h>
+#include <glib.h>
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "dbus_interfaces.h"
+#include "geoclue2_manager.h"
+
+namespace {
+
+struct Sample {
+    gint64 emit_us;
+    gint64 received_us;
+    gint64 fetched_us;
+};
+
+struct ClientState {
+    GDBusConnection *connection = nullptr;
+    GMainLoop *loop = nullptr;
+    std::vector<Sample> samples;
+    guint64 failed = 0;
+};
+
+struct FetchContext {
+    ClientState *state;
+    gint64 received_us;
+};
+
+GVariant *call(GDBusConnection *connection, const char *path, const char *interface,
+               const char *method, GVariant *parameters) {
+    GError *error = nullptr;
+    GVariant *result =
+        g_dbus_connection_call_sync(connection, "org.freedesktop.GeoClue2", path, interface,
+                                    method, parameters, nullptr, G_DBUS_CALL_FLAGS_NONE, -1,
+                                    nullptr, &error);
+    if (!result) {
+        g_printerr("%s.%s failed: %s\n", interface, method, error->message);
+        g_error_free(error);
+        exit(EXIT_FAILURE);
+    }
+    return result;
+}
+
+void on_location_fetched(GObject *source, GAsyncResult *res, gpointer user_data) {
+    gint64 fetched_us = g_get_monotonic_time();
+    auto *context = static_cast<FetchContext *>(user_data);
+
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, nullptr);
+    if (!result) {
+        ++context->state->failed;
+        delete context;
+        return;
+    }
+
+    GVariant *properties = g_variant_get_child_value(result, 0);
+    gdouble altitude = 0.0;
+    if (g_variant_lookup(properties, "Altitude", "d", &altitude)) {
+        context->state->samples.push_back({(gint64)altitude, context->received_us, fetched_us});
+    } else {
+        ++context->state->failed;
+    }
+
+    g_variant_unref(properties);
+    g_variant_unref(result);
+    delete context;
+}
+
+void on_location_updated(GDBusConnection *connection, const gchar * /*sender*/,
+                         const gchar * /*object_path*/, const gchar * /*interface_name*/,
+                         const gchar * /*signal_name*/, GVariant *parameters,
+                         gpointer user_data) {
+    gint64 received_us = g_get_monotonic_time();
+
+    const gchar *new_path = nullptr;
+    g_variant_get(parameters, "(&o&o)", nullptr, &new_path);
+
+    auto *context = new FetchContext{static_cast<ClientState *>(user_data), received_us};
+    g_dbus_connection_call(connection, "org.freedesktop.GeoClue2", new_path,
+                           "org.freedesktop.DBus.Properties", "GetAll",
+                           g_variant_new("(s)", GEOCLUE2_LOCATION_INTERFACE),
+                           G_VARIANT_TYPE("(a{sv})"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr,
+                           on_location_fetched, context);
+}
+
+gboolean on_terminate(gpointer user_data) {
+    auto *state = static_cast<ClientState *>(user_data);
+    g_main_loop_quit(state->loop);
+    return G_SOURCE_REMOVE;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char *desktop_id = argc > 1 ? argv[1] : "geoclue2to1-bench";
+
+    GError *error = nullptr;
+    ClientState state;
+    state.connection = g_bus_get_sync(G_BUS_TYPE_SYSTEM, nullptr, &error);
+    if (!state.connection) {
+        g_printerr("Cannot connect to the system bus: %s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+
+    GVariant *result = call(state.connection, GEOCLUE2_MANAGER_OBJECT_PATH,
+                            GEOCLUE2_MANAGER_INTERFACE, "CreateClient", nullptr);
+    const gchar *client_path_ref = nullptr;
+    g_variant_get(result, "(&o)", &client_path_ref);
+    std::string client_path = client_path_ref;
+    g_variant_unref(result);
+
+    g_variant_unref(call(state.connection, client_path.c_str(),
+                         "org.freedesktop.DBus.Properties", "Set",
+                         g_variant_new("(ssv)", GEOCLUE2_CLIENT_INTERFACE, "DesktopId",
+                                       g_variant_new_string(desktop_id))));
+
+    // Signals carry the bridge's unique name as sender
+    GVariant *owner = g_dbus_connection_call_sync(
+        state.connection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+        "GetNameOwner", g_variant_new("(s)", "org.freedesktop.GeoClue2"), G_VARIANT_TYPE("(s)"),
+        G_DBUS_CALL_FLAGS_NONE, -1, nullptr, nullptr);
+    if (!owner) {
+        g_printerr("org.freedesktop.GeoClue2 has no owner\n");
+        return EXIT_FAILURE;
+    }
+    const gchar *bridge_name = nullptr;
+    g_variant_get(owner, "(&s)", &bridge_name);
+
+    g_dbus_connection_signal_subscribe(state.connection, bridge_name,
+                                       GEOCLUE2_CLIENT_INTERFACE, "LocationUpdated",
+                                       client_path.c_str(), nullptr, G_DBUS_SIGNAL_FLAGS_NONE,
+                                       on_location_updated, &state, nullptr);
+    g_variant_unref(owner);
+
+    g_variant_unref(
+        call(state.connection, client_path.c_str(), GEOCLUE2_CLIENT_INTERFACE, "Start", nullptr));
+
+    printf("ready\n");
+    fflush(stdout);
+
+    state.loop = g_main_loop_new(nullptr, FALSE);
+    g_unix_signal_add(SIGTERM, on_terminate, &state);
+    g_main_loop_run(state.loop);
+    g_main_loop_unref(state.loop);
+
+    for (const Sample &sample : state.samples) {
+        printf("sample %" G_GINT64_FORMAT " %" G_GINT64_FORMAT " %" G_GINT64_FORMAT "\n",
+               sample.emit_us, sample.received_us, sample.fetched_us);
+    }
+    printf("failed %" G_GUINT64_FORMAT "\n", state.failed);
+    fflush(stdout);
+
+    g_object_unref(state.connection);
+    return EXIT_SUCCESS;
+}
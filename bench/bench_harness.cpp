@@ -0,0 +1,489 @@
+#include "bench_harness.h"
+#include "bridge_control.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * Implementation of the benchmark harness.
+ */
+
+// Permissive bus configuration for both private buses. The limits are high
+// enough for the scalability benchmark's thousands of clients.
+const char *BUS_CONFIG_TEMPLATE =
+    "<!DOCTYPE busconfig PUBLIC \"-//freedesktop//DTD D-Bus Bus Configuration 1.0//EN\"\n"
+    " \"http://www.freedesktop.org/standards/dbus/1.0/busconfig.dtd\">\n"
+    "<busconfig>\n"
+    "  <type>session</type>\n"
+    "  <listen>unix:tmpdir=%s</listen>\n"
+    "  <auth>EXTERNAL</auth>\n"
+    "  <limit name=\"max_completed_connections\">100000</limit>\n"
+    "  <limit name=\"max_connections_per_user\">100000</limit>\n"
+    "  <limit name=\"max_match_rules_per_connection\">100000</limit>\n"
+    "  <limit name=\"max_replies_per_connection\">100000</limit>\n"
+    "  <policy context=\"default\">\n"
+    "    <allow send_destination=\"*\" eavesdrop=\"true\"/>\n"
+    "    <allow eavesdrop=\"true\"/>\n"
+    "    <allow own=\"*\"/>\n"
+    "  </policy>\n"
+    "</busconfig>\n";
+
+const gint64 NAME_TIMEOUT_US = 10 * G_USEC_PER_SEC;
+
+// Accepted increase of a metric whose baseline names no tolerance
+const double DEFAULT_BASELINE_TOLERANCE = 0.2;
+
+namespace {
+
+bool wait_for_name(GDBusConnection *connection, const char *name, GError **error) {
+    gint64 deadline = g_get_monotonic_time() + NAME_TIMEOUT_US;
+    while (g_get_monotonic_time() < deadline) {
+        GVariant *result = g_dbus_connection_call_sync(
+            connection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+            "NameHasOwner", g_variant_new("(s)", name), G_VARIANT_TYPE("(b)"),
+            G_DBUS_CALL_FLAGS_NONE, -1, nullptr, error);
+        if (!result) {
+            return false;
+        }
+
+        gboolean has_owner = FALSE;
+        g_variant_get(result, "(b)", &has_owner);
+        g_variant_unref(result);
+        if (has_owner) {
+            return true;
+        }
+        g_usleep(20 * 1000);
+    }
+
+    g_set_error(error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT, "%s did not appear on the bus", name);
+    return false;
+}
+
+GDBusConnection *connect_address(const std::string &address, GError **error) {
+    return g_dbus_connection_new_for_address_sync(
+        address.c_str(),
+        static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT |
+                                          G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION),
+        nullptr, nullptr, error);
+}
+
+} // namespace
+
+bool bench_spawn(const std::vector<std::string> &argv, gchar **envp, bool pipe_stdout, bool quiet,
+                 BenchProcess *process, GError **error) {
+    std::vector<gchar *> args;
+    for (const auto &arg : argv) {
+        args.push_back(const_cast<gchar *>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+
+    int flags = G_SPAWN_DO_NOT_REAP_CHILD | G_SPAWN_SEARCH_PATH;
+    if (quiet) {
+        flags |= G_SPAWN_STDERR_TO_DEV_NULL;
+        if (!pipe_stdout) {
+            flags |= G_SPAWN_STDOUT_TO_DEV_NULL;
+        }
+    }
+
+    process->stdout_fd = -1;
+    return g_spawn_async_with_pipes(nullptr, args.data(), envp, static_cast<GSpawnFlags>(flags),
+                                    nullptr, nullptr, &process->pid, nullptr,
+                                    pipe_stdout ? &process->stdout_fd : nullptr, nullptr, error);
+}
+
+void bench_terminate(BenchProcess &process) {
+    if (process.pid > 0) {
+        kill(process.pid, SIGTERM);
+        waitpid(process.pid, nullptr, 0);
+        g_spawn_close_pid(process.pid);
+        process.pid = 0;
+    }
+    if (process.stdout_fd >= 0) {
+        close(process.stdout_fd);
+        process.stdout_fd = -1;
+    }
+}
+
+std::string bench_read_line(int fd) {
+    std::string line;
+    char c = 0;
+    while (true) {
+        ssize_t n = read(fd, &c, 1);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0 || c == '\n') {
+            break;
+        }
+        line += c;
+    }
+    return line;
+}
+
+std::string bench_read_all(int fd) {
+    std::string contents;
+    char buffer[4096];
+    while (true) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        contents.append(buffer, n);
+    }
+    return contents;
+}
+
+gint64 bench_process_cpu_us(GPid pid) {
+    gchar *path = g_strdup_printf("/proc/%d/stat", (int)pid);
+    gchar *contents = nullptr;
+    bool ok = g_file_get_contents(path, &contents, nullptr, nullptr);
+    g_free(path);
+    if (!ok) {
+        return -1;
+    }
+
+    // The command name may contain spaces; fields resume after its ')'.
+    // utime and stime are fields 14 and 15, i.e. the 12th and 13th after it.
+    gint64 cpu_us = -1;
+    const gchar *rest = strrchr(contents, ')');
+    if (rest) {
+        gchar **fields = g_strsplit(rest + 2, " ", 0);
+        if (g_strv_length(fields) > 12) {
+            gint64 ticks = g_ascii_strtoll(fields[11], nullptr, 10) +
+                           g_ascii_strtoll(fields[12], nullptr, 10);
+            cpu_us = ticks * G_USEC_PER_SEC / sysconf(_SC_CLK_TCK);
+        }
+        g_strfreev(fields);
+    }
+
+    g_free(contents);
+    return cpu_us;
+}
+
+gint64 bench_process_rss_bytes(GPid pid) {
+    gchar *path = g_strdup_printf("/proc/%d/status", (int)pid);
+    gchar *contents = nullptr;
+    bool ok = g_file_get_contents(path, &contents, nullptr, nullptr);
+    g_free(path);
+    if (!ok) {
+        return -1;
+    }
+
+    gint64 rss = -1;
+    const gchar *line = strstr(contents, "VmRSS:");
+    if (line) {
+        rss = g_ascii_strtoll(line + 6, nullptr, 10) * 1024;
+    }
+
+    g_free(contents);
+    return rss;
+}
+
+LatencySummary bench_summarize(std::vector<gint64> samples_us) {
+    LatencySummary summary;
+    summary.count = samples_us.size();
+    if (samples_us.empty()) {
+        return summary;
+    }
+
+    std::sort(samples_us.begin(), samples_us.end());
+    auto rank = [&samples_us](double p) {
+        gsize index = (gsize)std::ceil(p * samples_us.size());
+        return samples_us[std::max<gsize>(index, 1) - 1];
+    };
+
+    double total = 0.0;
+    for (gint64 sample : samples_us) {
+        total += sample;
+    }
+
+    summary.mean_us = total / samples_us.size();
+    summary.p50_us = rank(0.50);
+    summary.p95_us = rank(0.95);
+    summary.p99_us = rank(0.99);
+    summary.max_us = samples_us.back();
+    return summary;
+}
+
+void bench_json_summary(GString *json, const char *name, const LatencySummary &summary) {
+    g_string_append_printf(json,
+                           "\"%s\":{\"count\":%" G_GSIZE_FORMAT ",\"mean_us\":%.1f,"
+                           "\"p50_us\":%" G_GINT64_FORMAT ",\"p95_us\":%" G_GINT64_FORMAT
+                           ",\"p99_us\":%" G_GINT64_FORMAT ",\"max_us\":%" G_GINT64_FORMAT "}",
+                           name, summary.count, summary.mean_us, summary.p50_us, summary.p95_us,
+                           summary.p99_us, summary.max_us);
+}
+
+gint64 bench_stat_int(GVariant *stats, const char *key) {
+    GVariant *value = g_variant_lookup_value(stats, key, nullptr);
+    if (!value) {
+        return -1;
+    }
+
+    gint64 result = -1;
+    if (g_variant_is_of_type(value, G_VARIANT_TYPE_UINT64)) {
+        result = (gint64)g_variant_get_uint64(value);
+    } else if (g_variant_is_of_type(value, G_VARIANT_TYPE_INT64)) {
+        result = g_variant_get_int64(value);
+    } else if (g_variant_is_of_type(value, G_VARIANT_TYPE_UINT32)) {
+        result = g_variant_get_uint32(value);
+    } else if (g_variant_is_of_type(value, G_VARIANT_TYPE_INT32)) {
+        result = g_variant_get_int32(value);
+    }
+
+    g_variant_unref(value);
+    return result;
+}
+
+std::string bench_name_owner(GDBusConnection *bus, const char *name, GError **error) {
+    GVariant *result = g_dbus_connection_call_sync(
+        bus, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+        "GetNameOwner", g_variant_new("(s)", name), G_VARIANT_TYPE("(s)"),
+        G_DBUS_CALL_FLAGS_NONE, -1, nullptr, error);
+    if (!result) {
+        return "";
+    }
+
+    const gchar *owner = nullptr;
+    g_variant_get(result, "(&s)", &owner);
+    std::string unique_name = owner;
+    g_variant_unref(result);
+    return unique_name;
+}
+
+gint64 bench_bus_match_rules(GDBusConnection *bus, const char *name) {
+    GVariant *result = g_dbus_connection_call_sync(
+        bus, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus.Debug.Stats",
+        "GetConnectionStats", g_variant_new("(s)", name), G_VARIANT_TYPE("(a{sv})"),
+        G_DBUS_CALL_FLAGS_NONE, -1, nullptr, nullptr);
+    if (!result) {
+        return -1;
+    }
+
+    GVariant *stats = g_variant_get_child_value(result, 0);
+    guint32 rules = 0;
+    gint64 count = g_variant_lookup(stats, "MatchRules", "u", &rules) ? rules : -1;
+    g_variant_unref(stats);
+    g_variant_unref(result);
+    return count;
+}
+
+BenchStack::~BenchStack() {
+    bench_terminate(m_bridge);
+    bench_terminate(m_standin);
+
+    if (m_system) {
+        g_object_unref(m_system);
+    }
+    if (m_session) {
+        g_object_unref(m_session);
+    }
+
+    bench_terminate(m_system_bus);
+    bench_terminate(m_session_bus);
+    g_strfreev(m_envp);
+
+    if (!m_dir.empty()) {
+        // Only the buses' config and the bridge's caches live in there
+        gchar *rm_argv[] = {(gchar *)"rm", (gchar *)"-rf", (gchar *)m_dir.c_str(), nullptr};
+        g_spawn_sync(nullptr, rm_argv, nullptr, G_SPAWN_SEARCH_PATH, nullptr, nullptr, nullptr,
+                     nullptr, nullptr, nullptr);
+    }
+}
+
+bool BenchStack::start_bus(const char *name, BenchProcess *bus, std::string *address,
+                           GError **error) {
+    gchar *config_path = g_strdup_printf("%s/%s.conf", m_dir.c_str(), name);
+    gchar *config = g_strdup_printf(BUS_CONFIG_TEMPLATE, m_dir.c_str());
+    bool ok = g_file_set_contents(config_path, config, -1, error);
+    g_free(config);
+
+    if (ok) {
+        std::string config_arg = std::string("--config-file=") + config_path;
+        ok = bench_spawn({"dbus-daemon", config_arg, "--nofork", "--print-address=1"}, nullptr,
+                         true, false, bus, error);
+    }
+    g_free(config_path);
+
+    if (!ok) {
+        return false;
+    }
+
+    *address = bench_read_line(bus->stdout_fd);
+    if (address->empty()) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_FAILED, "%s dbus-daemon did not start", name);
+        return false;
+    }
+    return true;
+}
+
+bool BenchStack::start(const BenchStackOptions &options, GError **error) {
+    gchar *dir = g_dir_make_tmp("geoclue2to1-bench-XXXXXX", error);
+    if (!dir) {
+        return false;
+    }
+    m_dir = dir;
+    g_free(dir);
+
+    if (!start_bus("system", &m_system_bus, &m_system_address, error) ||
+        !start_bus("session", &m_session_bus, &m_session_address, error)) {
+        return false;
+    }
+
+    m_system = connect_address(m_system_address, error);
+    if (!m_system) {
+        return false;
+    }
+    m_session = connect_address(m_session_address, error);
+    if (!m_session) {
+        return false;
+    }
+
+    // The bridge keeps its caches and handoff socket in the temporary dir
+    std::string cache_dir = m_dir + "/cache";
+    m_envp = g_get_environ();
+    m_envp = g_environ_setenv(m_envp, "DBUS_SYSTEM_BUS_ADDRESS", m_system_address.c_str(), TRUE);
+    m_envp =
+        g_environ_setenv(m_envp, "DBUS_SESSION_BUS_ADDRESS", m_session_address.c_str(), TRUE);
+    m_envp = g_environ_setenv(m_envp, "XDG_CACHE_HOME", cache_dir.c_str(), TRUE);
+    m_envp = g_environ_setenv(m_envp, "XDG_STATE_HOME", cache_dir.c_str(), TRUE);
+    m_envp = g_environ_setenv(m_envp, "XDG_RUNTIME_DIR", m_dir.c_str(), TRUE);
+
+    std::vector<std::string> standin_argv = {options.standin_binary};
+    standin_argv.insert(standin_argv.end(), options.standin_args.begin(),
+                        options.standin_args.end());
+    if (!bench_spawn(standin_argv, m_envp, false, !options.verbose, &m_standin, error) ||
+        !wait_for_name(m_session, BENCH_STANDIN_BUS_NAME, error)) {
+        return false;
+    }
+
+    // A long grace period keeps GPS on between rounds of clients
+    std::vector<std::string> bridge_argv = {options.bridge_binary, "--grace-timeout", "600000",
+                                            "--profile-callbacks", "--stall-threshold", "0"};
+    bridge_argv.insert(bridge_argv.end(), options.bridge_args.begin(), options.bridge_args.end());
+    if (!bench_spawn(bridge_argv, m_envp, false, !options.verbose, &m_bridge, error) ||
+        !wait_for_name(m_system, "org.freedesktop.GeoClue2", error)) {
+        return false;
+    }
+
+    return true;
+}
+
+GDBusConnection *BenchStack::connect_system(GError **error) const {
+    return connect_address(m_system_address, error);
+}
+
+bool BenchStack::emit_fixes(double rate_hz, guint count, GError **error) {
+    struct EmitCall {
+        GVariant *result = nullptr;
+        GError *error = nullptr;
+        bool done = false;
+    } call;
+
+    // Asynchronous, so that the caller's connections keep being served
+    int timeout_ms = (int)(count / rate_hz * 1000.0) + 30000;
+    g_dbus_connection_call(
+        m_session, BENCH_STANDIN_BUS_NAME, BENCH_STANDIN_OBJECT_PATH, BENCH_STANDIN_INTERFACE,
+        "Emit", g_variant_new("(du)", rate_hz, count), nullptr, G_DBUS_CALL_FLAGS_NONE,
+        timeout_ms, nullptr,
+        [](GObject *source, GAsyncResult *res, gpointer user_data) {
+            auto *call = static_cast<EmitCall *>(user_data);
+            call->result =
+                g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &call->error);
+            call->done = true;
+        },
+        &call);
+
+    while (!call.done) {
+        g_main_context_iteration(nullptr, TRUE);
+    }
+
+    if (!call.result) {
+        g_propagate_error(error, call.error);
+        return false;
+    }
+
+    g_variant_unref(call.result);
+    return true;
+}
+
+GVariant *BenchStack::bridge_stats(GError **error) const {
+    GVariant *result = g_dbus_connection_call_sync(
+        m_system, "org.freedesktop.GeoClue2", BRIDGE_CONTROL_OBJECT_PATH,
+        BRIDGE_CONTROL_INTERFACE, "GetStats", nullptr, G_VARIANT_TYPE("(a{sv})"),
+        G_DBUS_CALL_FLAGS_NONE, -1, nullptr, error);
+    if (!result) {
+        return nullptr;
+    }
+
+    GVariant *stats = g_variant_get_child_value(result, 0);
+    g_variant_unref(result);
+    return stats;
+}
+
+BenchBaseline::BenchBaseline(const char *group) : m_group(group), m_key_file(g_key_file_new()) {}
+
+BenchBaseline::~BenchBaseline() { g_key_file_free(m_key_file); }
+
+bool BenchBaseline::load(const char *path, GError **error) {
+    return g_key_file_load_from_file(m_key_file, path, G_KEY_FILE_NONE, error);
+}
+
+double BenchBaseline::tolerance(const char *metric) const {
+    gchar *key = g_strdup_printf("%s.tolerance", metric);
+    double result = DEFAULT_BASELINE_TOLERANCE;
+    if (g_key_file_has_key(m_key_file, m_group.c_str(), key, nullptr)) {
+        result = g_key_file_get_double(m_key_file, m_group.c_str(), key, nullptr);
+    } else if (g_key_file_has_key(m_key_file, m_group.c_str(), "tolerance", nullptr)) {
+        result = g_key_file_get_double(m_key_file, m_group.c_str(), "tolerance", nullptr);
+    }
+    g_free(key);
+    return result;
+}
+
+bool BenchBaseline::check(const char *metric, double value, const char *unit) {
+    if (value < 0.0) {
+        g_print("  %-32s %14s%s\n", metric, "unavailable", m_updating ? "" : "  MISSING");
+        m_missing += m_updating ? 0 : 1;
+        return m_updating;
+    }
+    m_values[metric] = value;
+
+    double expected = g_key_file_get_double(m_key_file, m_group.c_str(), metric, nullptr);
+    if (expected <= 0.0) {
+        g_print("  %-32s %14.3f %-6s   (no reference)%s\n", metric, value, unit,
+                m_updating ? "" : "  MISSING");
+        m_missing += m_updating ? 0 : 1;
+        return m_updating;
+    }
+
+    double change = value / expected - 1.0;
+    bool regressed = change > tolerance(metric);
+    g_print("  %-32s %14.3f %-6s %+7.1f%% of %.3f%s\n", metric, value, unit, change * 100.0,
+            expected, regressed ? "  REGRESSED" : "");
+    if (regressed) {
+        ++m_regressions;
+    }
+    return !regressed;
+}
+
+bool BenchBaseline::update(const char *path, GError **error) const {
+    GKeyFile *key_file = g_key_file_new();
+    g_key_file_load_from_file(key_file, path, G_KEY_FILE_KEEP_COMMENTS, nullptr);
+
+    for (const auto &pair : m_values) {
+        g_key_file_set_double(key_file, m_group.c_str(), pair.first.c_str(), pair.second);
+    }
+
+    bool ok = g_key_file_save_to_file(key_file, path, error);
+    g_key_file_free(key_file);
+    return ok;
+}
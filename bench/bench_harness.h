@@ -0,0 +1,185 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Shared pieces of the end-to-end benchmarks.
+ *
+ * BenchStack runs everything the bridge talks to on private buses inside a
+ * temporary directory: a "system" and a "session" dbus-daemon, the scripted
+ * GeoClue1 stand-in (geoclue1-standin) on the session bus and the bridge
+ * itself. Benchmarks connect their clients to the private system bus and
+ * make the stand-in emit fixes through its Bench control interface.
+ *
+ * The stand-in stamps every fix with its emit time (CLOCK_MONOTONIC, in
+ * microseconds) in the Altitude field, so any process on the machine can
+ * compute the latency of a Location it received.
+ */
+
+// Stand-in control interface on the session bus
+inline constexpr const char *BENCH_STANDIN_BUS_NAME = "org.freedesktop.Geoclue.Master";
+inline constexpr const char *BENCH_STANDIN_OBJECT_PATH = "/io/github/rinigus/GeoClue2to1/Bench";
+inline constexpr const char *BENCH_STANDIN_INTERFACE = "io.github.rinigus.GeoClue2to1.Bench";
+
+struct BenchProcess {
+    GPid pid = 0;
+    int stdout_fd = -1; // -1 unless spawned with pipe_stdout
+};
+
+// Spawn `argv` with `envp` (nullptr = ours). With `quiet` the child's
+// stdout and stderr go to /dev/null.
+bool bench_spawn(const std::vector<std::string> &argv, gchar **envp, bool pipe_stdout, bool quiet,
+                 BenchProcess *process, GError **error);
+
+// SIGTERM, reap and close the pipe
+void bench_terminate(BenchProcess &process);
+
+// Blocking reads from a child's stdout: one line without the newline ("" at
+// EOF), or everything up to EOF
+std::string bench_read_line(int fd);
+std::string bench_read_all(int fd);
+
+// CPU time (user + system) of a process in microseconds, -1 if unknown
+gint64 bench_process_cpu_us(GPid pid);
+
+// Resident set size of a process in bytes, -1 if unknown
+gint64 bench_process_rss_bytes(GPid pid);
+
+struct LatencySummary {
+    gsize count = 0;
+    double mean_us = 0.0;
+    gint64 p50_us = 0;
+    gint64 p95_us = 0;
+    gint64 p99_us = 0;
+    gint64 max_us = 0;
+};
+
+// Nearest-rank percentiles
+LatencySummary bench_summarize(std::vector<gint64> samples_us);
+
+// Append `"name":{"count":..,"mean_us":..,"p50_us":..,...}` to a JSON object
+void bench_json_summary(GString *json, const char *name, const LatencySummary &summary);
+
+struct BenchStackOptions {
+    std::string bridge_binary;
+    std::string standin_binary;
+    std::vector<std::string> bridge_args;
+    std::vector<std::string> standin_args;
+    bool verbose = false; // keep the bridge's log on stderr
+};
+
+class BenchStack {
+  public:
+    BenchStack() = default;
+    ~BenchStack();
+
+    // Non-copyable
+    BenchStack(const BenchStack &) = delete;
+    BenchStack &operator=(const BenchStack &) = delete;
+
+    // Start both buses, the stand-in and the bridge; waits until the bridge
+    // owns org.freedesktop.GeoClue2
+    bool start(const BenchStackOptions &options, GError **error);
+
+    const std::string &dir() const { return m_dir; }
+    const std::string &system_address() const { return m_system_address; }
+
+    GPid bridge_pid() const { return m_bridge.pid; }
+    GPid system_bus_pid() const { return m_system_bus.pid; }
+    GPid session_bus_pid() const { return m_session_bus.pid; }
+
+    // Our own connection to the private system bus
+    GDBusConnection *system() const { return m_system; }
+
+    // A new connection to the private system bus, i.e. a new peer
+    GDBusConnection *connect_system(GError **error) const;
+
+    // Environment for client processes, pointing at the private buses
+    gchar **environment() const { return m_envp; }
+
+    // Make the stand-in emit `count` fixes at `rate_hz`; iterates the
+    // default main context until all were sent
+    bool emit_fixes(double rate_hz, guint count, GError **error);
+
+    // The bridge's GetStats a{sv}, nullptr on error
+    GVariant *bridge_stats(GError **error) const;
+
+  private:
+    std::string m_dir;
+    std::string m_system_address;
+    std::string m_session_address;
+    gchar **m_envp = nullptr;
+
+    BenchProcess m_system_bus;
+    BenchProcess m_session_bus;
+    BenchProcess m_standin;
+    BenchProcess m_bridge;
+
+    GDBusConnection *m_system = nullptr;
+    GDBusConnection *m_session = nullptr;
+
+    bool start_bus(const char *name, BenchProcess *bus, std::string *address, GError **error);
+};
+
+// Look up an integer stat (any integer type) in a GetStats a{sv}; -1 if absent
+gint64 bench_stat_int(GVariant *stats, const char *key);
+
+// Unique name owning `name` on `bus`, "" on error. Signals carry it as sender.
+std::string bench_name_owner(GDBusConnection *bus, const char *name, GError **error);
+
+// Match rules the bus daemon holds for connection `name`, from its
+// org.freedesktop.DBus.Debug.Stats interface; -1 if the daemon was built
+// without it
+gint64 bench_bus_match_rules(GDBusConnection *bus, const char *name);
+
+/**
+ * Stored reference values of a benchmark's metrics, for the perf tests.
+ *
+ * A GKeyFile with one group per benchmark. Each key is a metric's
+ * reference value, lower is better; "<metric>.tolerance" or the group's
+ * "tolerance" is the accepted increase as a fraction of it. The gated
+ * metrics are ratios the benchmark normalizes itself (one cost against
+ * another measured in the same run), so a reference holds across machines.
+ * A metric without a reference, or one the run could not measure, fails
+ * unless the run is storing new references with update().
+ */
+class BenchBaseline {
+  public:
+    explicit BenchBaseline(const char *group);
+    ~BenchBaseline();
+
+    // Non-copyable
+    BenchBaseline(const BenchBaseline &) = delete;
+    BenchBaseline &operator=(const BenchBaseline &) = delete;
+
+    bool load(const char *path, GError **error);
+
+    // The run stores its values with update(): missing references pass
+    void set_updating(bool updating) { m_updating = updating; }
+
+    // Record `value` and compare it with the reference; prints one line.
+    // A negative value is a metric this run could not measure.
+    bool check(const char *metric, double value, const char *unit);
+
+    // Metrics past their tolerance, without a reference or unmeasured so far
+    guint failures() const { return m_regressions + m_missing; }
+
+    // Store the values recorded by check() as the new references, keeping
+    // the file's comments and tolerances
+    bool update(const char *path, GError **error) const;
+
+  private:
+    std::string m_group;
+    GKeyFile *m_key_file = nullptr;
+    std::map<std::string, double> m_values;
+    guint m_regressions = 0;
+    guint m_missing = 0;
+    bool m_updating = false;
+
+    double tolerance(const char *metric) const;
+};
@@ -0,0 +1,274 @@
+/*
+ * Microbenchmarks of the fix path
+ *
+ * Isolated kernels of what the bridge does between a GeoClue1
+ * PositionChanged and the LocationUpdated signals, so that each
+ * optimization can be measured on its own:
+ *
+ * - decode_position: the "(iiddd(idd))" body, as on_position_changed() gets
+ *   it from the wire
+ * - velocity_merge: a VelocityChanged sample merged into the next positions
+ * - set_from_position_*: GeoClue2Location::set_from_geoclue1_position() with
+ *   a numeric timestamp (std::stoll), none, and one std::stoll rejects
+ * - path_format: Client and Location object paths
+ * - fanout/N: the handle_position_update() loop over N mock clients
+ * - location_export_unexport, client_register_unregister: object export
+ *
+ * Signals and exports go to one end of a private socketpair connection whose
+ * other end drops everything, so no bus daemon is involved. See
+ * micro_harness.h for the options; bench/baselines/micro.ini holds the
+ * reference ratios between them.
+ */
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <memory>
+#include <string>
+#include <sys/socket.h>
+#include <unordered_map>
+
+#include "dbus_interfaces.h"
+#include "geoclue1_backend.h"
+#include "geoclue2_location.h"
+#include "geoclue2_manager.h"
+#include "location_fanout.h"
+#include "micro_harness.h"
+
+namespace {
+
+// Both ends of a peer-to-peer connection; the bridge side sends, the far
+// side drops whatever arrives
+struct PeerPair {
+    GDBusConnection *bridge = nullptr;
+    GDBusConnection *far = nullptr;
+};
+
+GDBusMessage *drop_all(GDBusConnection * /*connection*/, GDBusMessage *message,
+                       gboolean incoming, gpointer /*user_data*/) {
+    if (incoming) {
+        g_object_unref(message);
+        return nullptr;
+    }
+    return message;
+}
+
+struct FarEnd {
+    GSocket *socket;
+    const gchar *guid;
+};
+
+gpointer open_far_end(gpointer data) {
+    auto *far_end = static_cast<FarEnd *>(data);
+    GSocketConnection *stream = g_socket_connection_factory_create_connection(far_end->socket);
+    GDBusConnection *connection = g_dbus_connection_new_sync(
+        G_IO_STREAM(stream), far_end->guid,
+        static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_SERVER |
+                                          G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_ALLOW_ANONYMOUS),
+        nullptr, nullptr, nullptr);
+    g_object_unref(stream);
+    return connection;
+}
+
+// Created once; benchmarks run many times during calibration
+const PeerPair &peer_pair() {
+    static PeerPair pair;
+    if (pair.bridge) {
+        return pair;
+    }
+
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) != 0) {
+        g_error("socketpair failed");
+    }
+
+    GSocket *bridge_socket = g_socket_new_from_fd(fds[0], nullptr);
+    GSocket *far_socket = g_socket_new_from_fd(fds[1], nullptr);
+    gchar *guid = g_dbus_generate_guid();
+
+    // The server handshake runs in a thread of its own while we do the client's
+    FarEnd far_end{far_socket, guid};
+    GThread *far_thread = g_thread_new("micro-far-end", open_far_end, &far_end);
+
+    GSocketConnection *stream = g_socket_connection_factory_create_connection(bridge_socket);
+    GError *error = nullptr;
+    pair.bridge = g_dbus_connection_new_sync(G_IO_STREAM(stream), nullptr,
+                                             G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT,
+                                             nullptr, nullptr, &error);
+    g_object_unref(stream);
+    if (!pair.bridge) {
+        g_error("Cannot open the benchmark connection: %s", error->message);
+    }
+
+    pair.far = static_cast<GDBusConnection *>(g_thread_join(far_thread));
+    if (!pair.far) {
+        g_error("Cannot open the far end of the benchmark connection");
+    }
+    g_dbus_connection_add_filter(pair.far, drop_all, nullptr, nullptr);
+
+    g_object_unref(bridge_socket);
+    g_object_unref(far_socket);
+    g_free(guid);
+    return pair;
+}
+
+GeoClue1Position sample_position() {
+    GeoClue1Position pos;
+    pos.latitude = 60.1699;
+    pos.longitude = 24.9384;
+    pos.altitude = 17.0;
+    pos.accuracy = 4.5;
+    pos.speed = 1.4;
+    pos.heading = 270.0;
+    pos.timestamp_iso8601 = "1760000000";
+    return pos;
+}
+
+void decode_position(MicroState &state) {
+    // Serialized like a message body off the wire, not a GVariant tree
+    GVariant *built = g_variant_ref_sink(g_variant_new("(iiddd(idd))", 7, 1760000000, 60.1699,
+                                                       24.9384, 17.0, 5, 4.5, 8.0));
+    GBytes *bytes = g_variant_get_data_as_bytes(built);
+    GVariant *parameters = g_variant_ref_sink(
+        g_variant_new_from_bytes(G_VARIANT_TYPE("(iiddd(idd))"), bytes, TRUE));
+
+    GeoClue1Position pos;
+    gint timestamp = 0;
+    while (state.keep_running()) {
+        micro_do_not_optimize(geoclue1_decode_position(parameters, &pos, &timestamp));
+        micro_do_not_optimize(pos);
+    }
+
+    g_variant_unref(parameters);
+    g_bytes_unref(bytes);
+    g_variant_unref(built);
+}
+MICRO_BENCHMARK(decode_position);
+
+// One VelocityChanged, then positions until it went stale
+void velocity_merge(MicroState &state) {
+    GeoClue1VelocityMerge merge;
+    GeoClue1Position pos;
+    while (state.keep_running()) {
+        merge.update(1.4, 270.0, 0.1, 2);
+        for (int i = 0; i < 3; ++i) {
+            merge.merge_into(pos);
+            micro_do_not_optimize(pos);
+        }
+    }
+}
+MICRO_BENCHMARK(velocity_merge);
+
+// The first call exports the Location; the timed ones only set properties
+void set_from_position(MicroState &state, const char *timestamp) {
+    GeoClue2Location location(peer_pair().bridge, GeoClue2Manager::location_object_path(1),
+                              nullptr);
+    GeoClue1Position pos = sample_position();
+    pos.timestamp_iso8601 = timestamp;
+    location.set_from_geoclue1_position(pos);
+
+    while (state.keep_running()) {
+        location.set_from_geoclue1_position(pos);
+        micro_clobber_memory();
+    }
+}
+
+void set_from_position_numeric(MicroState &state) { set_from_position(state, "1760000000"); }
+MICRO_BENCHMARK(set_from_position_numeric);
+
+void set_from_position_no_timestamp(MicroState &state) { set_from_position(state, ""); }
+MICRO_BENCHMARK(set_from_position_no_timestamp);
+
+// std::stoll throws, and the clock is read instead
+void set_from_position_invalid_timestamp(MicroState &state) {
+    set_from_position(state, "unknown");
+}
+MICRO_BENCHMARK(set_from_position_invalid_timestamp);
+
+void path_format(MicroState &state) {
+    guint id = 1000000;
+    while (state.keep_running()) {
+        micro_do_not_optimize(GeoClue2Manager::location_object_path(++id));
+        micro_do_not_optimize(GeoClue2Manager::client_object_path(id));
+    }
+}
+MICRO_BENCHMARK(path_format);
+
+// What handle_position_update() touches per client
+struct MockClient {
+    std::string path;
+    std::string peer;
+    std::string location_path;
+    bool active = true;
+};
+
+// The fan-out loop of handle_position_update() over arg() mock clients:
+// one template pair per fix, a stamped copy per client
+void fanout(MicroState &state) {
+    std::unordered_map<std::string, std::shared_ptr<MockClient>> clients;
+    for (gint64 i = 1; i <= state.arg(); ++i) {
+        auto client = std::make_shared<MockClient>();
+        client->path = GeoClue2Manager::client_object_path((guint)i);
+        client->peer = ":1." + std::to_string(100 + i % 50);
+        clients[client->path] = client;
+    }
+
+    GDBusConnection *connection = peer_pair().bridge;
+    guint location_id = 0;
+    while (state.keep_running()) {
+        std::string location_path = GeoClue2Manager::location_object_path(++location_id);
+        LocationSignalFanout fanout(connection, location_path);
+        for (auto &pair : clients) {
+            auto &client = pair.second;
+            if (client && client->active) {
+                fanout.send(client->path, client->peer, client->location_path);
+                client->location_path = location_path;
+            }
+        }
+        micro_do_not_optimize(fanout.sent());
+
+        // Let the worker thread drain the socket now and then
+        if (location_id % 64 == 0) {
+            state.pause_timing();
+            g_dbus_connection_flush_sync(connection, nullptr, nullptr);
+            state.resume_timing();
+        }
+    }
+
+    state.set_items_processed((gint64)state.iterations() * state.arg());
+    g_dbus_connection_flush_sync(connection, nullptr, nullptr);
+}
+MICRO_BENCHMARK(fanout)->arg(1)->arg(10)->arg(100)->arg(1000);
+
+// A Location as the manager makes one per fix: set, export, and unexport
+// once it leaves the retention window
+void location_export_unexport(MicroState &state) {
+    GDBusConnection *connection = peer_pair().bridge;
+    GeoClue1Position pos = sample_position();
+    guint location_id = 0;
+    while (state.keep_running()) {
+        GeoClue2Location location(connection,
+                                  GeoClue2Manager::location_object_path(++location_id), nullptr);
+        location.set_from_geoclue1_position(pos);
+    }
+}
+MICRO_BENCHMARK(location_export_unexport);
+
+// The bare GDBus cost of exporting a Client object
+void client_register_unregister(MicroState &state) {
+    static const GDBusInterfaceVTable vtable = {nullptr, nullptr, nullptr, {}};
+    GDBusConnection *connection = peer_pair().bridge;
+    GDBusInterfaceInfo *info = geoclue2_client_interface_info();
+    guint client_id = 0;
+    while (state.keep_running()) {
+        std::string path = GeoClue2Manager::client_object_path(++client_id);
+        guint registration = g_dbus_connection_register_object(connection, path.c_str(), info,
+                                                               &vtable, nullptr, nullptr, nullptr);
+        g_dbus_connection_unregister_object(connection, registration);
+    }
+}
+MICRO_BENCHMARK(client_register_unregister);
+
+} // namespace
+
+int main(int argc, char **argv) { return micro_main(argc, argv); }
@@ -0,0 +1,641 @@
+/*
+ * Client churn benchmark
+ *
+ * Starts the bridge on private buses (see bench_harness.h) and, for
+ * --rounds rounds, runs three phases:
+ *
+ * - cycles: --peers connections each loop --cycles times through
+ *   GetClient -> Set DesktopId -> Start -> Stop -> DeleteClient
+ * - storm: the same peers fire --storm CreateClient calls at once, then
+ *   delete all of those clients again
+ * - vanish: --vanish-peers new connections create --clients-per-peer
+ *   clients each, start half of them and disconnect together, so the bridge
+ *   drops them through on_peer_vanished() and remove_client()
+ *
+ * It reports per-method latency percentiles, the throughput of each phase
+ * and how long the bridge took to drop the vanished peers. Afterwards it
+ * checks that clients, peers, name watches, exported objects, cached
+ * credentials, the bridge's match rules on the bus and its memory are back
+ * at the baseline taken after a warm-up round, and fails if not. With
+ * --baseline it also fails when the Start latency, against its own median
+ * and against Stop's, regressed from a stored reference.
+ */
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+#include "dbus_interfaces.h"
+#include "geoclue2_manager.h"
+
+namespace {
+
+const int EXIT_SKIP = 77;
+
+const char *GEOCLUE2_BUS_NAME = "org.freedesktop.GeoClue2";
+
+// Longest wait for the bridge to drop the clients of vanished peers
+const gint64 VANISH_TIMEOUT_US = 30 * G_USEC_PER_SEC;
+const gulong VANISH_POLL_US = 5 * 1000;
+
+// Bridge stats that must return to their baseline after churn
+const char *const BASELINE_STATS[] = {"clients.total",         "clients.active",
+                                      "peers.total",           "peers.watches",
+                                      "memory.clients.live",   "memory.locations.live",
+                                      "credentials.cached",    "auth.agents"};
+
+// Asynchronous method calls with their round trip times, per method name
+class CallTracker {
+  public:
+    using Then = std::function<void(GVariant *)>;
+
+    void call(GDBusConnection *connection, const std::string &path, const char *interface,
+              const char *method, GVariant *parameters, const GVariantType *reply_type,
+              const std::string &label, Then then) {
+        ++m_pending;
+        g_dbus_connection_call(connection, GEOCLUE2_BUS_NAME, path.c_str(), interface, method,
+                               parameters, reply_type, G_DBUS_CALL_FLAGS_NONE, -1, nullptr,
+                               on_reply,
+                               new Pending{this, &m_latencies[label], g_get_monotonic_time(),
+                                           std::move(then)});
+    }
+
+    // Iterate the main context until no call is outstanding
+    void wait() {
+        while (m_pending > 0) {
+            g_main_context_iteration(nullptr, TRUE);
+        }
+    }
+
+    guint64 failures() const { return m_failures; }
+    const std::string &first_failure() const { return m_first_failure; }
+    std::map<std::string, std::vector<gint64>> &latencies() { return m_latencies; }
+
+  private:
+    struct Pending {
+        CallTracker *tracker;
+        std::vector<gint64> *latencies;
+        gint64 issued_us;
+        Then then;
+    };
+
+    std::map<std::string, std::vector<gint64>> m_latencies;
+    guint m_pending = 0;
+    guint64 m_failures = 0;
+    std::string m_first_failure;
+
+    /* static */
+    static void on_reply(GObject *source, GAsyncResult *res, gpointer user_data) {
+        std::unique_ptr<Pending> pending(static_cast<Pending *>(user_data));
+        CallTracker *tracker = pending->tracker;
+        pending->latencies->push_back(g_get_monotonic_time() - pending->issued_us);
+
+        GError *error = nullptr;
+        GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+        if (result) {
+            if (pending->then) {
+                pending->then(result);
+            }
+            g_variant_unref(result);
+        } else {
+            if (tracker->m_failures++ == 0) {
+                tracker->m_first_failure = error->message;
+            }
+            g_error_free(error);
+        }
+
+        // After `then`, which may have queued the next call of a chain
+        --tracker->m_pending;
+    }
+};
+
+struct PhaseResult {
+    std::string name;
+    guint64 operations = 0;
+    gint64 elapsed_us = 0;
+};
+
+struct ChurnOptions {
+    guint peers = 20;
+    guint cycles = 100;
+    guint storm = 2000;
+    guint vanish_peers = 100;
+    guint clients_per_peer = 10;
+};
+
+std::string client_path_of(GVariant *result) {
+    const gchar *path = nullptr;
+    g_variant_get(result, "(&o)", &path);
+    return path;
+}
+
+// One peer's GetClient -> Set DesktopId -> Start -> Stop -> DeleteClient
+// loops, each call issued from the previous one's reply
+struct Cycle {
+    CallTracker *tracker;
+    GDBusConnection *connection;
+    guint remaining;
+    std::string path;
+};
+
+void cycle_get_client(std::shared_ptr<Cycle> cycle);
+
+void cycle_delete(std::shared_ptr<Cycle> cycle) {
+    cycle->tracker->call(cycle->connection, GEOCLUE2_MANAGER_OBJECT_PATH,
+                         GEOCLUE2_MANAGER_INTERFACE, "DeleteClient",
+                         g_variant_new("(o)", cycle->path.c_str()), nullptr, "DeleteClient",
+                         [cycle](GVariant *) {
+                             --cycle->remaining;
+                             cycle_get_client(cycle);
+                         });
+}
+
+void cycle_stop(std::shared_ptr<Cycle> cycle) {
+    cycle->tracker->call(cycle->connection, cycle->path, GEOCLUE2_CLIENT_INTERFACE, "Stop",
+                         nullptr, nullptr, "Stop", [cycle](GVariant *) { cycle_delete(cycle); });
+}
+
+void cycle_start(std::shared_ptr<Cycle> cycle) {
+    cycle->tracker->call(cycle->connection, cycle->path, GEOCLUE2_CLIENT_INTERFACE, "Start",
+                         nullptr, nullptr, "Start", [cycle](GVariant *) { cycle_stop(cycle); });
+}
+
+void cycle_set_desktop_id(std::shared_ptr<Cycle> cycle) {
+    cycle->tracker->call(cycle->connection, cycle->path, "org.freedesktop.DBus.Properties", "Set",
+                         g_variant_new("(ssv)", GEOCLUE2_CLIENT_INTERFACE, "DesktopId",
+                                       g_variant_new_string("geoclue2to1-bench")),
+                         nullptr, "Set DesktopId", [cycle](GVariant *) { cycle_start(cycle); });
+}
+
+void cycle_get_client(std::shared_ptr<Cycle> cycle) {
+    if (cycle->remaining == 0) {
+        return;
+    }
+    cycle->tracker->call(cycle->connection, GEOCLUE2_MANAGER_OBJECT_PATH,
+                         GEOCLUE2_MANAGER_INTERFACE, "GetClient", nullptr, G_VARIANT_TYPE("(o)"),
+                         "GetClient", [cycle](GVariant *result) {
+                             cycle->path = client_path_of(result);
+                             cycle_set_desktop_id(cycle);
+                         });
+}
+
+PhaseResult phase_cycles(CallTracker &tracker, const std::vector<GDBusConnection *> &peers,
+                         guint cycles) {
+    PhaseResult phase{"cycles", (guint64)peers.size() * cycles, 0};
+    gint64 started_us = g_get_monotonic_time();
+    for (GDBusConnection *connection : peers) {
+        cycle_get_client(std::make_shared<Cycle>(Cycle{&tracker, connection, cycles, ""}));
+    }
+    tracker.wait();
+    phase.elapsed_us = g_get_monotonic_time() - started_us;
+    return phase;
+}
+
+// All CreateClient calls at once, spread over the peers, then all
+// DeleteClient calls at once
+PhaseResult phase_storm(CallTracker &tracker, const std::vector<GDBusConnection *> &peers,
+                        guint storm) {
+    PhaseResult phase{"storm", (guint64)storm * 2, 0};
+    std::vector<std::pair<GDBusConnection *, std::string>> created;
+
+    gint64 started_us = g_get_monotonic_time();
+    for (guint i = 0; i < storm; ++i) {
+        GDBusConnection *connection = peers[i % peers.size()];
+        tracker.call(connection, GEOCLUE2_MANAGER_OBJECT_PATH, GEOCLUE2_MANAGER_INTERFACE,
+                     "CreateClient", nullptr, G_VARIANT_TYPE("(o)"), "CreateClient (storm)",
+                     [&created, connection](GVariant *result) {
+                         created.emplace_back(connection, client_path_of(result));
+                     });
+    }
+    tracker.wait();
+
+    for (const auto &client : created) {
+        tracker.call(client.first, GEOCLUE2_MANAGER_OBJECT_PATH, GEOCLUE2_MANAGER_INTERFACE,
+                     "DeleteClient", g_variant_new("(o)", client.second.c_str()), nullptr,
+                     "DeleteClient (storm)", nullptr);
+    }
+    tracker.wait();
+
+    phase.elapsed_us = g_get_monotonic_time() - started_us;
+    return phase;
+}
+
+// Peers that create clients and then all disconnect; elapsed_us is the
+// time from the disconnects until the bridge has dropped every client
+bool phase_vanish(BenchStack &stack, CallTracker &tracker, const ChurnOptions &options,
+                  PhaseResult *phase, GError **error) {
+    phase->name = "vanish";
+    phase->operations = (guint64)options.vanish_peers * options.clients_per_peer;
+
+    GVariant *before = stack.bridge_stats(error);
+    if (!before) {
+        return false;
+    }
+    gint64 baseline_clients = bench_stat_int(before, "clients.total");
+    g_variant_unref(before);
+
+    std::vector<GDBusConnection *> peers;
+    auto close_peers = [&peers]() {
+        for (GDBusConnection *connection : peers) {
+            g_dbus_connection_close_sync(connection, nullptr, nullptr);
+            g_object_unref(connection);
+        }
+        peers.clear();
+    };
+
+    for (guint i = 0; i < options.vanish_peers; ++i) {
+        GDBusConnection *connection = stack.connect_system(error);
+        if (!connection) {
+            close_peers();
+            return false;
+        }
+        peers.push_back(connection);
+
+        for (guint j = 0; j < options.clients_per_peer; ++j) {
+            bool start = j % 2 == 0;
+            tracker.call(connection, GEOCLUE2_MANAGER_OBJECT_PATH, GEOCLUE2_MANAGER_INTERFACE,
+                         "CreateClient", nullptr, G_VARIANT_TYPE("(o)"), "CreateClient (vanish)",
+                         [&tracker, connection, start](GVariant *result) {
+                             if (start) {
+                                 tracker.call(connection, client_path_of(result),
+                                              GEOCLUE2_CLIENT_INTERFACE, "Start", nullptr,
+                                              nullptr, "Start (vanish)", nullptr);
+                             }
+                         });
+        }
+    }
+    tracker.wait();
+
+    gint64 started_us = g_get_monotonic_time();
+    close_peers();
+
+    gint64 clients = -1;
+    while (g_get_monotonic_time() - started_us < VANISH_TIMEOUT_US) {
+        GVariant *stats = stack.bridge_stats(error);
+        if (!stats) {
+            return false;
+        }
+        clients = bench_stat_int(stats, "clients.total");
+        g_variant_unref(stats);
+        if (clients <= baseline_clients) {
+            break;
+        }
+        g_usleep(VANISH_POLL_US);
+    }
+    phase->elapsed_us = g_get_monotonic_time() - started_us;
+
+    if (clients > baseline_clients) {
+        g_set_error(error, G_IO_ERROR, G_IO_ERROR_TIMED_OUT,
+                    "%" G_GINT64_FORMAT " clients of vanished peers still exist after %d s",
+                    clients - baseline_clients, (int)(VANISH_TIMEOUT_US / G_USEC_PER_SEC));
+        return false;
+    }
+    return true;
+}
+
+bool run_round(BenchStack &stack, CallTracker &tracker, const ChurnOptions &options,
+               std::vector<PhaseResult> *phases, GError **error) {
+    std::vector<GDBusConnection *> peers;
+    for (guint i = 0; i < options.peers; ++i) {
+        GDBusConnection *connection = stack.connect_system(error);
+        if (!connection) {
+            break;
+        }
+        peers.push_back(connection);
+    }
+
+    bool ok = peers.size() == options.peers;
+    if (ok) {
+        phases->push_back(phase_cycles(tracker, peers, options.cycles));
+        phases->push_back(phase_storm(tracker, peers, options.storm));
+    }
+
+    // These peers own no clients any more; closing them must not either
+    for (GDBusConnection *connection : peers) {
+        g_dbus_connection_close_sync(connection, nullptr, nullptr);
+        g_object_unref(connection);
+    }
+
+    PhaseResult vanish;
+    if (ok && phase_vanish(stack, tracker, options, &vanish, error)) {
+        phases->push_back(vanish);
+        return true;
+    }
+    return false;
+}
+
+struct Snapshot {
+    std::map<std::string, gint64> stats;
+    gint64 match_rules = -1;
+    gint64 rss_bytes = -1;
+    gint64 heap_live_bytes = -1;
+};
+
+bool take_snapshot(BenchStack &stack, const std::string &bridge_name, Snapshot *snapshot,
+                   GError **error) {
+    GVariant *stats = stack.bridge_stats(error);
+    if (!stats) {
+        return false;
+    }
+    for (const char *key : BASELINE_STATS) {
+        snapshot->stats[key] = bench_stat_int(stats, key);
+    }
+    snapshot->rss_bytes = bench_stat_int(stats, "memory.rss_bytes");
+    snapshot->heap_live_bytes = bench_stat_int(stats, "memory.heap.live_bytes");
+    g_variant_unref(stats);
+
+    snapshot->match_rules = bench_bus_match_rules(stack.system(), bridge_name.c_str());
+    return true;
+}
+
+// Compare against the baseline; counts must match exactly, memory within
+// `slack_bytes`
+bool check_baseline(const Snapshot &baseline, const Snapshot &after, gint64 slack_bytes,
+                    GString *json) {
+    bool ok = true;
+    g_print("\n%-24s %12s %12s\n", "resource", "baseline", "after");
+    g_string_append(json, ",\"baseline\":{");
+
+    auto report = [&](const char *name, gint64 before, gint64 now, bool leaked, bool first) {
+        g_print("%-24s %12" G_GINT64_FORMAT " %12" G_GINT64_FORMAT "%s\n", name, before, now,
+                leaked ? "  LEAK" : "");
+        g_string_append_printf(json,
+                               "%s\"%s\":{\"baseline\":%" G_GINT64_FORMAT
+                               ",\"after\":%" G_GINT64_FORMAT ",\"ok\":%s}",
+                               first ? "" : ",", name, before, now, leaked ? "false" : "true");
+        ok = ok && !leaked;
+    };
+
+    bool first = true;
+    for (const auto &pair : baseline.stats) {
+        gint64 now = after.stats.at(pair.first);
+        report(pair.first.c_str(), pair.second, now, now != pair.second, first);
+        first = false;
+    }
+    if (baseline.match_rules >= 0) {
+        report("bus.match_rules", baseline.match_rules, after.match_rules,
+               after.match_rules != baseline.match_rules, false);
+    }
+    if (baseline.rss_bytes >= 0) {
+        report("memory.rss_bytes", baseline.rss_bytes, after.rss_bytes,
+               after.rss_bytes - baseline.rss_bytes > slack_bytes, false);
+    }
+    if (baseline.heap_live_bytes >= 0) {
+        report("memory.heap.live_bytes", baseline.heap_live_bytes, after.heap_live_bytes,
+               after.heap_live_bytes - baseline.heap_live_bytes > slack_bytes, false);
+    }
+
+    g_string_append_printf(json, "},\"baseline_ok\":%s", ok ? "true" : "false");
+    return ok;
+}
+
+void print_results(const std::vector<PhaseResult> &phases, CallTracker &tracker) {
+    std::map<std::string, PhaseResult> totals;
+    for (const PhaseResult &phase : phases) {
+        PhaseResult &total = totals[phase.name];
+        total.name = phase.name;
+        total.operations += phase.operations;
+        total.elapsed_us += phase.elapsed_us;
+    }
+
+    g_print("%-24s %8s %9s %9s %9s %9s %9s\n", "method", "calls", "mean ms", "p50 ms", "p95 ms",
+            "p99 ms", "max ms");
+    for (auto &pair : tracker.latencies()) {
+        LatencySummary summary = bench_summarize(pair.second);
+        g_print("%-24s %8" G_GSIZE_FORMAT " %9.3f %9.3f %9.3f %9.3f %9.3f\n",
+                pair.first.c_str(), summary.count, summary.mean_us / 1000.0,
+                summary.p50_us / 1000.0, summary.p95_us / 1000.0, summary.p99_us / 1000.0,
+                summary.max_us / 1000.0);
+    }
+
+    g_print("\n");
+    for (const auto &pair : totals) {
+        const PhaseResult &total = pair.second;
+        double seconds = total.elapsed_us / (double)G_USEC_PER_SEC;
+        g_print("%-8s %8" G_GUINT64_FORMAT " ops in %8.3f s  %10.1f ops/s\n", total.name.c_str(),
+                total.operations, seconds, seconds > 0.0 ? total.operations / seconds : 0.0);
+    }
+}
+
+void append_results_json(GString *json, const std::vector<PhaseResult> &phases,
+                         CallTracker &tracker) {
+    g_string_append(json, ",\"methods\":{");
+    bool first = true;
+    for (auto &pair : tracker.latencies()) {
+        gchar *escaped = g_strescape(pair.first.c_str(), nullptr);
+        if (!first) {
+            g_string_append_c(json, ',');
+        }
+        bench_json_summary(json, escaped, bench_summarize(pair.second));
+        g_free(escaped);
+        first = false;
+    }
+
+    g_string_append(json, "},\"phases\":[");
+    for (size_t i = 0; i < phases.size(); ++i) {
+        const PhaseResult &phase = phases[i];
+        double seconds = phase.elapsed_us / (double)G_USEC_PER_SEC;
+        g_string_append_printf(json,
+                               "%s{\"phase\":\"%s\",\"operations\":%" G_GUINT64_FORMAT
+                               ",\"elapsed_us\":%" G_GINT64_FORMAT ",\"ops_per_s\":%.1f}",
+                               i ? "," : "", phase.name.c_str(), phase.operations,
+                               phase.elapsed_us,
+                               seconds > 0.0 ? phase.operations / seconds : 0.0);
+    }
+    g_string_append_c(json, ']');
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    gint peers = 20;
+    gint cycles = 100;
+    gint storm = 2000;
+    gint vanish_peers = 100;
+    gint clients_per_peer = 10;
+    gint rounds = 3;
+    gint slack_kib = 2048;
+    gchar *json_path = nullptr;
+    gchar *label = nullptr;
+    gchar *baseline_path = nullptr;
+    gchar *update_path = nullptr;
+    gboolean verbose = FALSE;
+
+    GOptionEntry entries[] = {
+        {"peers", 0, 0, G_OPTION_ARG_INT, &peers, "Connections cycling clients (default 20)",
+         "N"},
+        {"cycles", 0, 0, G_OPTION_ARG_INT, &cycles,
+         "GetClient..DeleteClient loops per peer and round (default 100)", "N"},
+        {"storm", 0, 0, G_OPTION_ARG_INT, &storm,
+         "CreateClient calls fired at once per round (default 2000)", "N"},
+        {"vanish-peers", 0, 0, G_OPTION_ARG_INT, &vanish_peers,
+         "Connections that disconnect together per round (default 100)", "N"},
+        {"clients-per-peer", 0, 0, G_OPTION_ARG_INT, &clients_per_peer,
+         "Clients of each vanishing peer (default 10)", "N"},
+        {"rounds", 0, 0, G_OPTION_ARG_INT, &rounds, "Rounds after the warm-up (default 3)", "N"},
+        {"memory-slack", 0, 0, G_OPTION_ARG_INT, &slack_kib,
+         "Memory growth over the baseline still accepted (default 2048)", "KIB"},
+        {"json", 0, 0, G_OPTION_ARG_FILENAME, &json_path, "Write results as JSON", "FILE"},
+        {"label", 0, 0, G_OPTION_ARG_STRING, &label, "Label stored in the JSON, e.g. a commit",
+         "TEXT"},
+        {"baseline", 0, 0, G_OPTION_ARG_FILENAME, &baseline_path,
+         "Fail if Start latency regressed against a baseline file", "FILE"},
+        {"update-baseline", 0, 0, G_OPTION_ARG_FILENAME, &update_path,
+         "Store this run's Start latency in a baseline file", "FILE"},
+        {"verbose", 0, 0, G_OPTION_ARG_NONE, &verbose, "Show the bridge's log", nullptr},
+        {nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr}};
+
+    GError *error = nullptr;
+    GOptionContext *context = g_option_context_new("- bridge client churn benchmark");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("Option parsing failed: %s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(context);
+        return EXIT_FAILURE;
+    }
+    g_option_context_free(context);
+
+    BenchBaseline perf_baseline("churn");
+    if (baseline_path && !perf_baseline.load(baseline_path, &error)) {
+        g_printerr("Cannot read baseline %s: %s\n", baseline_path, error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+    perf_baseline.set_updating(update_path != nullptr);
+
+    gchar *daemon = g_find_program_in_path("dbus-daemon");
+    if (!daemon) {
+        g_print("SKIP: dbus-daemon not found\n");
+        return EXIT_SKIP;
+    }
+    g_free(daemon);
+
+    ChurnOptions churn;
+    churn.peers = std::max(peers, 1);
+    churn.cycles = std::max(cycles, 0);
+    churn.storm = std::max(storm, 0);
+    churn.vanish_peers = std::max(vanish_peers, 0);
+    churn.clients_per_peer = std::max(clients_per_peer, 1);
+
+    // Lifted limits, so storms measure the registry rather than rejections
+    BenchStackOptions options;
+    options.bridge_binary = BENCH_BRIDGE_BINARY;
+    options.standin_binary = BENCH_STANDIN_BINARY;
+    options.bridge_args = {"--max-clients", "0", "--max-clients-per-peer", "0"};
+    options.verbose = verbose;
+
+    BenchStack stack;
+    if (!stack.start(options, &error)) {
+        g_printerr("Cannot start the benchmark stack: %s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+
+    std::string bridge_name = bench_name_owner(stack.system(), GEOCLUE2_BUS_NAME, &error);
+    if (bridge_name.empty()) {
+        g_printerr("Cannot find the bridge: %s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+
+    // A warm-up round first: one-time allocations (hash table growth, GDBus
+    // internals, the backend) are not leaks
+    std::vector<PhaseResult> phases;
+    Snapshot baseline;
+    CallTracker warmup;
+    if (!run_round(stack, warmup, churn, &phases, &error) ||
+        !take_snapshot(stack, bridge_name, &baseline, &error)) {
+        g_printerr("Warm-up failed: %s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+    phases.clear();
+
+    CallTracker tracker;
+    for (gint round = 0; round < std::max(rounds, 1); ++round) {
+        if (!run_round(stack, tracker, churn, &phases, &error)) {
+            g_printerr("Round %d failed: %s\n", round + 1, error->message);
+            g_error_free(error);
+            return EXIT_FAILURE;
+        }
+    }
+
+    Snapshot after;
+    if (!take_snapshot(stack, bridge_name, &after, &error)) {
+        g_printerr("Cannot read the bridge's stats: %s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+
+    print_results(phases, tracker);
+    if (tracker.failures() > 0) {
+        g_print("\n%" G_GUINT64_FORMAT " calls failed, first: %s\n", tracker.failures(),
+                tracker.first_failure().c_str());
+    }
+
+    gchar *escaped_label = g_strescape(label ? label : "", nullptr);
+    GString *json = g_string_new("{\"benchmark\":\"churn\"");
+    g_string_append_printf(json,
+                           ",\"label\":\"%s\",\"peers\":%u,\"cycles\":%u,\"storm\":%u,"
+                           "\"vanish_peers\":%u,\"clients_per_peer\":%u,\"rounds\":%d,"
+                           "\"failed_calls\":%" G_GUINT64_FORMAT,
+                           escaped_label, churn.peers, churn.cycles, churn.storm,
+                           churn.vanish_peers, churn.clients_per_peer, std::max(rounds, 1),
+                           tracker.failures());
+    g_free(escaped_label);
+    append_results_json(json, phases, tracker);
+    bool clean = check_baseline(baseline, after, (gint64)std::max(slack_kib, 0) * 1024, json);
+    g_string_append(json, "}\n");
+
+    if (json_path && !g_file_set_contents(json_path, json->str, json->len, &error)) {
+        g_printerr("Cannot write %s: %s\n", json_path, error->message);
+        g_error_free(error);
+    }
+    g_string_free(json, TRUE);
+
+    if (!clean) {
+        g_print("\nFAIL: resources did not return to the baseline\n");
+    }
+
+    // Start is the call a user waits on before the first fix. Its tail
+    // against its median, and its median against Stop's on the same bus
+    // under the same load, do not depend on the machine.
+    if (baseline_path || update_path) {
+        LatencySummary start = bench_summarize(tracker.latencies()["Start"]);
+        LatencySummary stop = bench_summarize(tracker.latencies()["Stop"]);
+        g_print("\nStored baseline:\n");
+        perf_baseline.check("start_p95_per_p50",
+                            start.count && start.p50_us > 0 ? (double)start.p95_us / start.p50_us
+                                                            : -1.0,
+                            "x");
+        perf_baseline.check("start_p50_per_stop_p50",
+                            start.count && stop.count && stop.p50_us > 0
+                                ? (double)start.p50_us / stop.p50_us
+                                : -1.0,
+                            "x");
+    }
+    if (update_path && !perf_baseline.update(update_path, &error)) {
+        g_printerr("Cannot write baseline %s: %s\n", update_path, error->message);
+        g_clear_error(&error);
+    }
+    if (perf_baseline.failures() > 0) {
+        g_print("\nFAIL: %u metrics regressed or have no reference\n", perf_baseline.failures());
+    }
+
+    g_free(json_path);
+    g_free(label);
+    g_free(baseline_path);
+    g_free(update_path);
+    return clean && tracker.failures() == 0 && perf_baseline.failures() == 0
+               ? EXIT_SUCCESS
+               : EXIT_FAILURE;
+}
@@ -0,0 +1,578 @@
+/*
+ * Client scalability benchmark
+ *
+ * Starts the bridge on private buses (see bench_harness.h) with the client
+ * limits lifted and grows the number of GeoClue2 clients step by step, up
+ * to 5,000 by default. The clients are spread over --peers connections to
+ * the private system bus, and --active-fraction of them are started. At
+ * every step the stand-in emits --fixes fixes and the benchmark records:
+ *
+ * - fan-out: time the bridge spent in its PositionChanged handler, i.e.
+ *   handle_position_update() and the LocationUpdated emission to every
+ *   active client, per fix
+ * - sends per fix, from delivery.sent_updates
+ * - CPU time of the bridge and the system bus daemon per fix
+ * - the bridge's RSS and the mean CreateClient round trip
+ *
+ * Each peer reads one Location per fix, like a real application would, so
+ * the bridge does not treat its clients as slow and coalesce them.
+ *
+ * The result is a scaling curve, printed as a table and written to --json,
+ * meant as the baseline for reworking the client registry and dispatcher.
+ * --baseline compares how the fan-out cost per client grows from the first
+ * to the last step, and the RSS per client, against stored references and
+ * fails the run on a regression.
+ */
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_harness.h"
+#include "dbus_interfaces.h"
+#include "geoclue2_manager.h"
+
+namespace {
+
+const int EXIT_SKIP = 77;
+
+const char *DEFAULT_STEPS = "1,10,100,500,1000,2000,5000";
+
+// Calls kept in flight, over all peers, while creating and starting clients
+const guint PIPELINE_DEPTH = 32;
+
+// Let the bridge settle after a step's clients were added, and peers
+// finish their reads after the last fix
+const gulong SETTLE_US = 1000 * 1000;
+
+// Width of the scaling curve bar
+const int CURVE_WIDTH = 40;
+
+const char *GEOCLUE2_BUS_NAME = "org.freedesktop.GeoClue2";
+
+struct Peer {
+    GDBusConnection *connection = nullptr;
+    guint subscription = 0;
+    std::vector<std::string> client_paths;
+    guint64 updates_received = 0;
+    guint64 reads = 0;
+    bool read_pending = false;
+    bool read_locations = true;
+};
+
+struct StepResult {
+    guint clients = 0;
+    guint active = 0;
+    guint fixes = 0;
+    double create_us_mean = 0.0;
+    double fanout_us_per_fix = 0.0;
+    gint64 fanout_us_max = 0;
+    double sends_per_fix = 0.0;
+    double received_per_fix = 0.0;
+    double bridge_cpu_us_per_fix = 0.0;
+    double system_bus_cpu_us_per_fix = 0.0;
+    gint64 bridge_rss_bytes = -1;
+};
+
+std::vector<guint> parse_steps(const char *steps) {
+    std::vector<guint> result;
+    gchar **parts = g_strsplit(steps, ",", 0);
+    for (gchar **part = parts; *part; ++part) {
+        guint64 count = g_ascii_strtoull(*part, nullptr, 10);
+        if (count > 0) {
+            result.push_back((guint)count);
+        }
+    }
+    g_strfreev(parts);
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+void on_location_read(GObject *source, GAsyncResult *res, gpointer user_data) {
+    auto *peer = static_cast<Peer *>(user_data);
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, nullptr);
+    if (result) {
+        g_variant_unref(result);
+    }
+    peer->read_pending = false;
+}
+
+// One LocationUpdated per active client and fix; one read per burst marks
+// all of the peer's clients as read
+void on_location_updated(GDBusConnection *connection, const gchar * /*sender*/,
+                         const gchar * /*object_path*/, const gchar * /*interface_name*/,
+                         const gchar * /*signal_name*/, GVariant *parameters,
+                         gpointer user_data) {
+    auto *peer = static_cast<Peer *>(user_data);
+    ++peer->updates_received;
+    if (!peer->read_locations || peer->read_pending) {
+        return;
+    }
+
+    const gchar *new_path = nullptr;
+    g_variant_get(parameters, "(&o&o)", nullptr, &new_path);
+
+    peer->read_pending = true;
+    ++peer->reads;
+    g_dbus_connection_call(connection, GEOCLUE2_BUS_NAME, new_path,
+                           "org.freedesktop.DBus.Properties", "Get",
+                           g_variant_new("(ss)", GEOCLUE2_LOCATION_INTERFACE, "Latitude"),
+                           G_VARIANT_TYPE("(v)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr,
+                           on_location_read, peer);
+}
+
+// Pipelined asynchronous calls on many peers: keep up to PIPELINE_DEPTH in
+// flight and iterate the main context until all replies are in
+class CallBatch {
+  public:
+    struct Call {
+        Peer *peer;
+        std::string path;
+        const char *interface;
+        const char *method;
+        GVariant *parameters; // floating, may be nullptr
+        const GVariantType *reply_type;
+        std::string *created_path; // receives the (o) reply, may be nullptr
+    };
+
+    void add(Call call) { m_calls.push_back(std::move(call)); }
+
+    bool run(GError **error) {
+        while (m_next < m_calls.size() && m_in_flight < PIPELINE_DEPTH) {
+            issue();
+        }
+        while (m_completed < m_calls.size()) {
+            g_main_context_iteration(nullptr, TRUE);
+            while (m_next < m_calls.size() && m_in_flight < PIPELINE_DEPTH) {
+                issue();
+            }
+        }
+
+        if (m_error) {
+            g_propagate_error(error, m_error);
+            m_error = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    // Mean round trip of one call, queueing in the pipeline excluded
+    double mean_us() const {
+        return m_calls.empty() ? 0.0 : (double)m_round_trip_us / m_calls.size();
+    }
+
+  private:
+    struct Pending {
+        CallBatch *batch;
+        Call *call;
+        gint64 issued_us;
+    };
+
+    std::vector<Call> m_calls;
+    size_t m_next = 0;
+    size_t m_completed = 0;
+    guint m_in_flight = 0;
+    gint64 m_round_trip_us = 0;
+    GError *m_error = nullptr;
+
+    void issue() {
+        Call &call = m_calls[m_next++];
+        ++m_in_flight;
+        g_dbus_connection_call(call.peer->connection, GEOCLUE2_BUS_NAME, call.path.c_str(),
+                               call.interface, call.method, call.parameters, call.reply_type,
+                               G_DBUS_CALL_FLAGS_NONE, -1, nullptr, on_reply,
+                               new Pending{this, &call, g_get_monotonic_time()});
+    }
+
+    /* static */
+    static void on_reply(GObject *source, GAsyncResult *res, gpointer user_data) {
+        std::unique_ptr<Pending> pending(static_cast<Pending *>(user_data));
+        CallBatch *batch = pending->batch;
+        --batch->m_in_flight;
+        ++batch->m_completed;
+        batch->m_round_trip_us += g_get_monotonic_time() - pending->issued_us;
+
+        GError *error = nullptr;
+        GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+        if (!result) {
+            if (!batch->m_error) {
+                batch->m_error = error;
+            } else {
+                g_error_free(error);
+            }
+            return;
+        }
+
+        if (pending->call->created_path) {
+            const gchar *path = nullptr;
+            g_variant_get(result, "(&o)", &path);
+            *pending->call->created_path = path;
+        }
+        g_variant_unref(result);
+    }
+};
+
+// Grow from `existing` to `existing + count` clients round-robin over the
+// peers and start the first `start` of the new ones
+bool add_clients(std::vector<Peer> &peers, guint existing, guint count, guint start,
+                 double *create_us_mean, GError **error) {
+    std::vector<std::pair<Peer *, std::string>> created(count);
+
+    CallBatch creates;
+    for (guint i = 0; i < count; ++i) {
+        Peer *peer = &peers[(existing + i) % peers.size()];
+        created[i].first = peer;
+        creates.add({peer, GEOCLUE2_MANAGER_OBJECT_PATH, GEOCLUE2_MANAGER_INTERFACE,
+                     "CreateClient", nullptr, G_VARIANT_TYPE("(o)"), &created[i].second});
+    }
+    if (!creates.run(error)) {
+        return false;
+    }
+    *create_us_mean = creates.mean_us();
+
+    CallBatch setup;
+    for (guint i = 0; i < count; ++i) {
+        Peer *peer = created[i].first;
+        const std::string &path = created[i].second;
+        peer->client_paths.push_back(path);
+        setup.add({peer, path, "org.freedesktop.DBus.Properties", "Set",
+                   g_variant_new("(ssv)", GEOCLUE2_CLIENT_INTERFACE, "DesktopId",
+                                 g_variant_new_string("geoclue2to1-bench")),
+                   nullptr, nullptr});
+        if (i < start) {
+            setup.add({peer, path, GEOCLUE2_CLIENT_INTERFACE, "Start", nullptr, nullptr,
+                       nullptr});
+        }
+    }
+    return setup.run(error);
+}
+
+bool open_peers(BenchStack &stack, guint count, bool read_locations, std::vector<Peer> *peers,
+                GError **error) {
+    std::string bridge_name = bench_name_owner(stack.system(), GEOCLUE2_BUS_NAME, error);
+    if (bridge_name.empty()) {
+        return false;
+    }
+
+    // Peers are referenced by pointer from here on
+    peers->resize(count);
+    for (Peer &peer : *peers) {
+        peer.connection = stack.connect_system(error);
+        if (!peer.connection) {
+            return false;
+        }
+        peer.read_locations = read_locations;
+        peer.subscription = g_dbus_connection_signal_subscribe(
+            peer.connection, bridge_name.c_str(), GEOCLUE2_CLIENT_INTERFACE, "LocationUpdated",
+            nullptr, nullptr, G_DBUS_SIGNAL_FLAGS_NONE, on_location_updated, &peer, nullptr);
+    }
+    return true;
+}
+
+void close_peers(std::vector<Peer> &peers) {
+    for (Peer &peer : peers) {
+        if (peer.connection) {
+            g_dbus_connection_signal_unsubscribe(peer.connection, peer.subscription);
+            g_dbus_connection_close_sync(peer.connection, nullptr, nullptr);
+            g_object_unref(peer.connection);
+        }
+    }
+    peers.clear();
+}
+
+// Iterate the main context for `us` microseconds, serving the peers
+void settle(gulong us) {
+    gint64 until = g_get_monotonic_time() + us;
+    while (g_get_monotonic_time() < until) {
+        while (g_main_context_iteration(nullptr, FALSE)) {
+        }
+        g_usleep(10 * 1000);
+    }
+}
+
+bool run_step(BenchStack &stack, std::vector<Peer> &peers, guint clients, guint active,
+              guint fixes, double rate_hz, StepResult *result, GError **error) {
+    result->clients = clients;
+    result->active = active;
+    result->fixes = fixes;
+    settle(SETTLE_US);
+
+    GVariant *before = stack.bridge_stats(error);
+    if (!before) {
+        return false;
+    }
+    guint64 received = 0;
+    for (const Peer &peer : peers) {
+        received += peer.updates_received;
+    }
+    gint64 bridge_cpu = bench_process_cpu_us(stack.bridge_pid());
+    gint64 system_cpu = bench_process_cpu_us(stack.system_bus_pid());
+
+    if (!stack.emit_fixes(rate_hz, fixes, error)) {
+        g_variant_unref(before);
+        return false;
+    }
+    settle(SETTLE_US);
+
+    result->bridge_cpu_us_per_fix =
+        (double)(bench_process_cpu_us(stack.bridge_pid()) - bridge_cpu) / fixes;
+    result->system_bus_cpu_us_per_fix =
+        (double)(bench_process_cpu_us(stack.system_bus_pid()) - system_cpu) / fixes;
+    result->bridge_rss_bytes = bench_process_rss_bytes(stack.bridge_pid());
+
+    GVariant *after = stack.bridge_stats(error);
+    if (!after) {
+        g_variant_unref(before);
+        return false;
+    }
+
+    // Fan-out is the whole PositionChanged callback; needs --profile-callbacks
+    const char *COUNT = "callbacks.Backend.PositionChanged.count";
+    const char *TOTAL = "callbacks.Backend.PositionChanged.total_us";
+    gint64 handled = bench_stat_int(after, COUNT) - bench_stat_int(before, COUNT);
+    gint64 spent = bench_stat_int(after, TOTAL) - bench_stat_int(before, TOTAL);
+    result->fanout_us_per_fix = handled > 0 ? (double)spent / handled : 0.0;
+    result->fanout_us_max = bench_stat_int(after, "callbacks.Backend.PositionChanged.max_us");
+    result->sends_per_fix = (double)(bench_stat_int(after, "delivery.sent_updates") -
+                                     bench_stat_int(before, "delivery.sent_updates")) /
+                            fixes;
+    g_variant_unref(before);
+    g_variant_unref(after);
+
+    guint64 received_after = 0;
+    for (const Peer &peer : peers) {
+        received_after += peer.updates_received;
+    }
+    result->received_per_fix = (double)(received_after - received) / fixes;
+    return true;
+}
+
+void print_header() {
+    g_print("%7s %7s  %10s %10s  %8s %8s  %10s %10s  %9s  %s\n", "clients", "active",
+            "create us", "fanout us", "sent/fix", "recv/fix", "bridge cpu", "bus cpu", "rss KiB",
+            "fan-out per fix");
+}
+
+void print_step(const StepResult &step, double max_fanout_us) {
+    int bar = max_fanout_us > 0.0
+                  ? (int)std::lround(step.fanout_us_per_fix / max_fanout_us * CURVE_WIDTH)
+                  : 0;
+    g_print("%7u %7u  %10.1f %10.1f  %8.1f %8.1f  %10.1f %10.1f  %9" G_GINT64_FORMAT "  %s\n",
+            step.clients, step.active, step.create_us_mean, step.fanout_us_per_fix,
+            step.sends_per_fix, step.received_per_fix, step.bridge_cpu_us_per_fix,
+            step.system_bus_cpu_us_per_fix,
+            step.bridge_rss_bytes >= 0 ? step.bridge_rss_bytes / 1024 : (gint64)-1,
+            std::string(std::max(bar, 0), '#').c_str());
+}
+
+gchar *results_json(const std::vector<StepResult> &steps, guint peers, double active_fraction,
+                    double rate_hz, const char *label) {
+    gchar *escaped_label = g_strescape(label ? label : "", nullptr);
+    GString *json = g_string_new("{\"benchmark\":\"client-scaling\"");
+    g_string_append_printf(json,
+                           ",\"label\":\"%s\",\"peers\":%u,\"active_fraction\":%.3f,"
+                           "\"rate_hz\":%.1f,\"steps\":[",
+                           escaped_label, peers, active_fraction, rate_hz);
+    g_free(escaped_label);
+
+    for (size_t i = 0; i < steps.size(); ++i) {
+        const StepResult &step = steps[i];
+        g_string_append_printf(
+            json,
+            "%s{\"clients\":%u,\"active\":%u,\"fixes\":%u,\"create_us_mean\":%.2f,"
+            "\"fanout_us_per_fix\":%.2f,\"fanout_us_max\":%" G_GINT64_FORMAT
+            ",\"sends_per_fix\":%.2f,\"received_per_fix\":%.2f,"
+            "\"bridge_cpu_us_per_fix\":%.2f,\"system_bus_cpu_us_per_fix\":%.2f,"
+            "\"bridge_rss_bytes\":%" G_GINT64_FORMAT "}",
+            i ? "," : "", step.clients, step.active, step.fixes, step.create_us_mean,
+            step.fanout_us_per_fix, step.fanout_us_max, step.sends_per_fix,
+            step.received_per_fix, step.bridge_cpu_us_per_fix, step.system_bus_cpu_us_per_fix,
+            step.bridge_rss_bytes);
+    }
+
+    g_string_append(json, "]}\n");
+    return g_string_free(json, FALSE);
+}
+
+// Fan-out cost per started client at the last step against the first, which
+// is 1 while the fan-out stays linear on any machine, and the RSS each client
+// added between those steps
+void check_baseline(const std::vector<StepResult> &results, BenchBaseline &baseline) {
+    g_print("\nStored baseline:\n");
+    const StepResult &first = results.front();
+    const StepResult &last = results.back();
+
+    double scaling = -1.0;
+    if (last.clients > first.clients && first.active && last.active &&
+        first.fanout_us_per_fix > 0.0) {
+        scaling = (last.fanout_us_per_fix / last.active) / (first.fanout_us_per_fix / first.active);
+    }
+    baseline.check("fanout_per_client_scaling", scaling, "x");
+
+    double rss_per_client = -1.0;
+    if (last.clients > first.clients && first.bridge_rss_bytes >= 0 &&
+        last.bridge_rss_bytes >= 0) {
+        rss_per_client = (double)(last.bridge_rss_bytes - first.bridge_rss_bytes) /
+                         (last.clients - first.clients);
+    }
+    baseline.check("rss_bytes_per_client", rss_per_client, "B");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    gchar *steps_option = nullptr;
+    gint peer_count = 50;
+    gdouble active_fraction = 1.0;
+    gint fixes = 50;
+    gdouble rate_hz = 10.0;
+    gboolean no_read = FALSE;
+    gchar *json_path = nullptr;
+    gchar *label = nullptr;
+    gchar *baseline_path = nullptr;
+    gchar *update_path = nullptr;
+    gboolean verbose = FALSE;
+
+    GOptionEntry entries[] = {
+        {"steps", 0, 0, G_OPTION_ARG_STRING, &steps_option,
+         "Client counts to measure at (default 1,10,100,500,1000,2000,5000)", "N,.."},
+        {"peers", 0, 0, G_OPTION_ARG_INT, &peer_count, "Bus connections to spread clients over "
+         "(default 50)", "N"},
+        {"active-fraction", 0, 0, G_OPTION_ARG_DOUBLE, &active_fraction,
+         "Fraction of clients that are started (default 1.0)", "F"},
+        {"fixes", 0, 0, G_OPTION_ARG_INT, &fixes, "Fixes per step (default 50)", "N"},
+        {"rate", 0, 0, G_OPTION_ARG_DOUBLE, &rate_hz, "Fix rate (default 10)", "HZ"},
+        {"no-read", 0, 0, G_OPTION_ARG_NONE, &no_read,
+         "Never read Locations, like signal-only listeners", nullptr},
+        {"json", 0, 0, G_OPTION_ARG_FILENAME, &json_path, "Write results as JSON", "FILE"},
+        {"label", 0, 0, G_OPTION_ARG_STRING, &label, "Label stored in the JSON, e.g. a commit",
+         "TEXT"},
+        {"baseline", 0, 0, G_OPTION_ARG_FILENAME, &baseline_path,
+         "Fail if per-client costs regressed against a baseline file", "FILE"},
+        {"update-baseline", 0, 0, G_OPTION_ARG_FILENAME, &update_path,
+         "Store this run's per-client costs in a baseline file", "FILE"},
+        {"verbose", 0, 0, G_OPTION_ARG_NONE, &verbose, "Show the bridge's log", nullptr},
+        {nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr}};
+
+    GError *error = nullptr;
+    GOptionContext *context = g_option_context_new("- bridge client scalability benchmark");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("Option parsing failed: %s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(context);
+        return EXIT_FAILURE;
+    }
+    g_option_context_free(context);
+
+    BenchBaseline perf_baseline("client-scaling");
+    if (baseline_path && !perf_baseline.load(baseline_path, &error)) {
+        g_printerr("Cannot read baseline %s: %s\n", baseline_path, error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+    perf_baseline.set_updating(update_path != nullptr);
+
+    gchar *daemon = g_find_program_in_path("dbus-daemon");
+    if (!daemon) {
+        g_print("SKIP: dbus-daemon not found\n");
+        return EXIT_SKIP;
+    }
+    g_free(daemon);
+
+    std::vector<guint> steps = parse_steps(steps_option ? steps_option : DEFAULT_STEPS);
+    active_fraction = std::clamp(active_fraction, 0.0, 1.0);
+    peer_count = std::max(peer_count, 1);
+    fixes = std::max(fixes, 1);
+    rate_hz = rate_hz > 0.0 ? rate_hz : 10.0;
+
+    BenchStackOptions options;
+    options.bridge_binary = BENCH_BRIDGE_BINARY;
+    options.standin_binary = BENCH_STANDIN_BINARY;
+    options.bridge_args = {"--max-clients", "0", "--max-clients-per-peer", "0"};
+    options.verbose = verbose;
+
+    BenchStack stack;
+    if (!stack.start(options, &error)) {
+        g_printerr("Cannot start the benchmark stack: %s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Peer> peers;
+    if (!open_peers(stack, (guint)peer_count, !no_read, &peers, &error)) {
+        g_printerr("Cannot connect peers: %s\n", error->message);
+        g_error_free(error);
+        close_peers(peers);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<StepResult> results;
+    guint clients = 0;
+    guint active = 0;
+    int status = EXIT_SUCCESS;
+    for (guint target : steps) {
+        // Keep the started share at active_fraction of all clients so far
+        guint target_active = (guint)std::lround(target * active_fraction);
+        StepResult step;
+        guint start = std::min(target - clients, target_active - std::min(target_active, active));
+        if (!add_clients(peers, clients, target - clients, start, &step.create_us_mean, &error) ||
+            !run_step(stack, peers, target, target_active, (guint)fixes, rate_hz, &step,
+                      &error)) {
+            g_printerr("Step at %u clients failed: %s\n", target, error->message);
+            g_error_free(error);
+            status = EXIT_FAILURE;
+            break;
+        }
+        clients = target;
+        active = target_active;
+        results.push_back(step);
+    }
+
+    double max_fanout_us = 0.0;
+    for (const StepResult &step : results) {
+        max_fanout_us = std::max(max_fanout_us, step.fanout_us_per_fix);
+    }
+    print_header();
+    for (const StepResult &step : results) {
+        print_step(step, max_fanout_us);
+    }
+
+    if (json_path && !results.empty()) {
+        gchar *json = results_json(results, (guint)peer_count, active_fraction, rate_hz, label);
+        if (!g_file_set_contents(json_path, json, -1, &error)) {
+            g_printerr("Cannot write %s: %s\n", json_path, error->message);
+            g_error_free(error);
+        }
+        g_free(json);
+    }
+
+    if ((baseline_path || update_path) && !results.empty()) {
+        check_baseline(results, perf_baseline);
+    }
+    if (update_path && !perf_baseline.update(update_path, &error)) {
+        g_printerr("Cannot write baseline %s: %s\n", update_path, error->message);
+        g_clear_error(&error);
+    }
+    if (perf_baseline.failures() > 0) {
+        g_print("\nFAIL: %u metrics regressed or have no reference\n", perf_baseline.failures());
+        status = EXIT_FAILURE;
+    }
+
+    close_peers(peers);
+    g_free(steps_option);
+    g_free(json_path);
+    g_free(label);
+    g_free(baseline_path);
+    g_free(update_path);
+    return status;
+}
@@ -0,0 +1,357 @@
+/*
+ * End-to-end latency benchmark
+ *
+ * Starts the bridge on private buses (see bench_harness.h) and, for each
+ * fix rate, N bench-client processes. The stand-in then emits fixes at
+ * that rate for --duration seconds. For every fix and client it measures:
+ *
+ * - signal: stand-in PositionChanged emit -> client LocationUpdated receipt
+ * - fetch:  stand-in PositionChanged emit -> client GetAll on the Location done
+ *
+ * It prints p50/p95/p99/max per rate, with the CPU time the bridge and both
+ * bus daemons spent per fix. Results also go to --json for comparing
+ * commits. --baseline fails the run when the bridge's CPU time per fix
+ * against the system bus daemon's, the p95 signal latency against the fix
+ * interval or, with --require-allocations, the bridge's allocations per
+ * fix and client regressed.
+ */
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "bench_harness.h"
+
+namespace {
+
+const int EXIT_SKIP = 77;
+
+// Fewest fixes per rate, so that 1 Hz runs still give percentiles
+const guint MIN_FIXES = 10;
+
+// Let the bridge subscribe to the provider before the first fix, and
+// clients finish their GetAll after the last one
+const gulong WARMUP_US = 500 * 1000;
+const gulong SETTLE_US = 1000 * 1000;
+
+struct RoundResult {
+    double rate_hz = 0.0;
+    guint fixes = 0;
+    guint64 failed = 0;
+    LatencySummary signal;
+    LatencySummary fetch;
+    double bridge_cpu_us_per_fix = 0.0;
+    double system_bus_cpu_us_per_fix = 0.0;
+    double session_bus_cpu_us_per_fix = 0.0;
+    gint64 bridge_rss_bytes = -1;
+};
+
+std::vector<double> parse_rates(const char *rates) {
+    std::vector<double> result;
+    gchar **parts = g_strsplit(rates, ",", 0);
+    for (gchar **part = parts; *part; ++part) {
+        double rate = g_ascii_strtod(*part, nullptr);
+        if (rate > 0.0) {
+            result.push_back(rate);
+        }
+    }
+    g_strfreev(parts);
+    return result;
+}
+
+// Collect "sample" and "failed" lines of one client
+void parse_client_output(const std::string &output, std::vector<gint64> *signal,
+                         std::vector<gint64> *fetch, guint64 *failed) {
+    gchar **lines = g_strsplit(output.c_str(), "\n", 0);
+    for (gchar **line = lines; *line; ++line) {
+        gint64 emit_us = 0, received_us = 0, fetched_us = 0;
+        guint64 count = 0;
+        if (sscanf(*line, "sample %" G_GINT64_FORMAT " %" G_GINT64_FORMAT " %" G_GINT64_FORMAT,
+                   &emit_us, &received_us, &fetched_us) == 3) {
+            signal->push_back(received_us - emit_us);
+            fetch->push_back(fetched_us - emit_us);
+        } else if (sscanf(*line, "failed %" G_GUINT64_FORMAT, &count) == 1) {
+            *failed += count;
+        }
+    }
+    g_strfreev(lines);
+}
+
+bool run_round(BenchStack &stack, const std::string &client_binary, guint clients,
+               double rate_hz, guint duration_s, RoundResult *result, GError **error) {
+    result->rate_hz = rate_hz;
+    result->fixes = std::max<guint>(MIN_FIXES, (guint)(rate_hz * duration_s));
+
+    std::vector<BenchProcess> processes(clients);
+    auto abort_round = [&processes]() {
+        for (auto &process : processes) {
+            bench_terminate(process);
+        }
+        return false;
+    };
+
+    for (guint i = 0; i < clients; ++i) {
+        if (!bench_spawn({client_binary}, stack.environment(), true, false, &processes[i],
+                         error)) {
+            return abort_round();
+        }
+    }
+    for (auto &process : processes) {
+        if (bench_read_line(process.stdout_fd) != "ready") {
+            g_set_error(error, G_IO_ERROR, G_IO_ERROR_FAILED, "bench-client failed to start");
+            return abort_round();
+        }
+    }
+    g_usleep(WARMUP_US);
+
+    gint64 bridge_cpu = bench_process_cpu_us(stack.bridge_pid());
+    gint64 system_cpu = bench_process_cpu_us(stack.system_bus_pid());
+    gint64 session_cpu = bench_process_cpu_us(stack.session_bus_pid());
+
+    if (!stack.emit_fixes(rate_hz, result->fixes, error)) {
+        return abort_round();
+    }
+    g_usleep(SETTLE_US);
+
+    result->bridge_cpu_us_per_fix =
+        (double)(bench_process_cpu_us(stack.bridge_pid()) - bridge_cpu) / result->fixes;
+    result->system_bus_cpu_us_per_fix =
+        (double)(bench_process_cpu_us(stack.system_bus_pid()) - system_cpu) / result->fixes;
+    result->session_bus_cpu_us_per_fix =
+        (double)(bench_process_cpu_us(stack.session_bus_pid()) - session_cpu) / result->fixes;
+    result->bridge_rss_bytes = bench_process_rss_bytes(stack.bridge_pid());
+
+    // Clients print their samples on SIGTERM
+    for (auto &process : processes) {
+        kill(process.pid, SIGTERM);
+    }
+
+    std::vector<gint64> signal;
+    std::vector<gint64> fetch;
+    for (auto &process : processes) {
+        parse_client_output(bench_read_all(process.stdout_fd), &signal, &fetch, &result->failed);
+        bench_terminate(process);
+    }
+
+    result->signal = bench_summarize(signal);
+    result->fetch = bench_summarize(fetch);
+    return true;
+}
+
+void print_round(const RoundResult &round, guint clients) {
+    guint64 expected = (guint64)round.fixes * clients;
+    g_print("%7.1f Hz  %5u fixes  %7" G_GSIZE_FORMAT "/%-7" G_GUINT64_FORMAT
+            "  signal p50 %6.2f p95 %6.2f p99 %6.2f max %7.2f ms"
+            "  fetch p50 %6.2f p99 %6.2f ms  cpu/fix bridge %6.1f bus %6.1f us\n",
+            round.rate_hz, round.fixes, round.signal.count, expected,
+            round.signal.p50_us / 1000.0, round.signal.p95_us / 1000.0,
+            round.signal.p99_us / 1000.0, round.signal.max_us / 1000.0,
+            round.fetch.p50_us / 1000.0, round.fetch.p99_us / 1000.0,
+            round.bridge_cpu_us_per_fix,
+            round.system_bus_cpu_us_per_fix + round.session_bus_cpu_us_per_fix);
+}
+
+gchar *results_json(const std::vector<RoundResult> &rounds, guint clients, guint duration_s,
+                    const char *label) {
+    gchar *escaped_label = g_strescape(label ? label : "", nullptr);
+    GString *json = g_string_new("{\"benchmark\":\"e2e-latency\"");
+    g_string_append_printf(json,
+                           ",\"label\":\"%s\",\"clients\":%u,\"duration_s\":%u,\"rounds\":[",
+                           escaped_label, clients, duration_s);
+    g_free(escaped_label);
+
+    for (size_t i = 0; i < rounds.size(); ++i) {
+        const RoundResult &round = rounds[i];
+        g_string_append_printf(json,
+                               "%s{\"rate_hz\":%.1f,\"fixes\":%u,\"expected\":%" G_GUINT64_FORMAT
+                               ",\"failed\":%" G_GUINT64_FORMAT ",",
+                               i ? "," : "", round.rate_hz, round.fixes,
+                               (guint64)round.fixes * clients, round.failed);
+        bench_json_summary(json, "signal", round.signal);
+        g_string_append_c(json, ',');
+        bench_json_summary(json, "fetch", round.fetch);
+        g_string_append_printf(json,
+                               ",\"bridge_cpu_us_per_fix\":%.2f,"
+                               "\"system_bus_cpu_us_per_fix\":%.2f,"
+                               "\"session_bus_cpu_us_per_fix\":%.2f,"
+                               "\"bridge_rss_bytes\":%" G_GINT64_FORMAT "}",
+                               round.bridge_cpu_us_per_fix, round.system_bus_cpu_us_per_fix,
+                               round.session_bus_cpu_us_per_fix, round.bridge_rss_bytes);
+    }
+
+    g_string_append(json, "]}\n");
+    return g_string_free(json, FALSE);
+}
+
+// Mean heap allocations per fix from the bridge's stats; -1 unless it
+// counts them
+double fix_allocations(const BenchStack &stack) {
+    GVariant *stats = stack.bridge_stats(nullptr);
+    if (!stats) {
+        return -1.0;
+    }
+
+    double result = -1.0;
+    GVariant *value = g_variant_lookup_value(stats, "memory.fix_allocations_mean",
+                                             G_VARIANT_TYPE_DOUBLE);
+    if (value) {
+        result = g_variant_get_double(value);
+        g_variant_unref(value);
+    }
+    g_variant_unref(stats);
+    return result;
+}
+
+// Ratios that hold across machines: the bridge's CPU time against the
+// system bus daemon's, which routes every message it sends and receives,
+// and the p95 signal latency as a fraction of the fix interval. Allocations
+// per fix and client only if `allocations_per_client` was asked for.
+void check_baseline(const std::vector<RoundResult> &rounds, bool with_allocations,
+                    double allocations_per_client, BenchBaseline &baseline) {
+    g_print("\nStored baseline:\n");
+    for (const RoundResult &round : rounds) {
+        gchar *cpu = g_strdup_printf("bridge_cpu_per_bus_cpu_%gHz", round.rate_hz);
+        gchar *latency = g_strdup_printf("signal_p95_per_interval_%gHz", round.rate_hz);
+        baseline.check(cpu,
+                       round.system_bus_cpu_us_per_fix > 0.0
+                           ? round.bridge_cpu_us_per_fix / round.system_bus_cpu_us_per_fix
+                           : -1.0,
+                       "x");
+        baseline.check(latency,
+                       round.signal.count ? round.signal.p95_us * round.rate_hz / G_USEC_PER_SEC
+                                          : -1.0,
+                       "x");
+        g_free(cpu);
+        g_free(latency);
+    }
+    if (with_allocations) {
+        baseline.check("fix_allocations_per_client", allocations_per_client, "allocs");
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    gint clients = 10;
+    gchar *rates = nullptr;
+    gint duration_s = 5;
+    gchar *json_path = nullptr;
+    gchar *label = nullptr;
+    gchar *replay_path = nullptr;
+    gchar *baseline_path = nullptr;
+    gchar *update_path = nullptr;
+    gboolean require_allocations = FALSE;
+    gboolean verbose = FALSE;
+
+    BenchStackOptions options;
+    options.bridge_binary = BENCH_BRIDGE_BINARY;
+    options.standin_binary = BENCH_STANDIN_BINARY;
+    std::string client_binary = BENCH_CLIENT_BINARY;
+
+    GOptionEntry entries[] = {
+        {"clients", 0, 0, G_OPTION_ARG_INT, &clients, "Client processes (default 10)", "N"},
+        {"rates", 0, 0, G_OPTION_ARG_STRING, &rates, "Fix rates (default 1,10,50,100)", "HZ,.."},
+        {"duration", 0, 0, G_OPTION_ARG_INT, &duration_s, "Seconds per rate (default 5)", "S"},
+        {"json", 0, 0, G_OPTION_ARG_FILENAME, &json_path, "Write results as JSON", "FILE"},
+        {"label", 0, 0, G_OPTION_ARG_STRING, &label, "Label stored in the JSON, e.g. a commit",
+         "TEXT"},
+        {"replay", 0, 0, G_OPTION_ARG_FILENAME, &replay_path,
+         "Replay fixes from FILE instead of the scripted walk", "FILE"},
+        {"baseline", 0, 0, G_OPTION_ARG_FILENAME, &baseline_path,
+         "Fail if per-fix costs regressed against a baseline file", "FILE"},
+        {"update-baseline", 0, 0, G_OPTION_ARG_FILENAME, &update_path,
+         "Store this run's per-fix costs in a baseline file", "FILE"},
+        {"require-allocations", 0, 0, G_OPTION_ARG_NONE, &require_allocations,
+         "Also gate allocations per fix (bridge built with ENABLE_ALLOC_COUNTING)", nullptr},
+        {"verbose", 0, 0, G_OPTION_ARG_NONE, &verbose, "Show the bridge's log", nullptr},
+        {nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr}};
+
+    GError *error = nullptr;
+    GOptionContext *context = g_option_context_new("- bridge end-to-end latency benchmark");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("Option parsing failed: %s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(context);
+        return EXIT_FAILURE;
+    }
+    g_option_context_free(context);
+
+    BenchBaseline perf_baseline("e2e-latency");
+    if (baseline_path && !perf_baseline.load(baseline_path, &error)) {
+        g_printerr("Cannot read baseline %s: %s\n", baseline_path, error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+    perf_baseline.set_updating(update_path != nullptr);
+
+    gchar *daemon = g_find_program_in_path("dbus-daemon");
+    if (!daemon) {
+        g_print("SKIP: dbus-daemon not found\n");
+        return EXIT_SKIP;
+    }
+    g_free(daemon);
+
+    std::vector<double> rate_list = parse_rates(rates ? rates : "1,10,50,100");
+    options.verbose = verbose;
+    if (replay_path) {
+        options.standin_args = {"--replay", replay_path};
+    }
+
+    BenchStack stack;
+    if (!stack.start(options, &error)) {
+        g_printerr("Cannot start the benchmark stack: %s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<RoundResult> rounds;
+    for (double rate : rate_list) {
+        RoundResult round;
+        if (!run_round(stack, client_binary, std::max(clients, 1), rate, std::max(duration_s, 1),
+                       &round, &error)) {
+            g_printerr("Round at %.1f Hz failed: %s\n", rate, error->message);
+            g_error_free(error);
+            return EXIT_FAILURE;
+        }
+        print_round(round, std::max(clients, 1));
+        rounds.push_back(round);
+    }
+
+    if (json_path) {
+        gchar *json = results_json(rounds, std::max(clients, 1), std::max(duration_s, 1), label);
+        if (!g_file_set_contents(json_path, json, -1, &error)) {
+            g_printerr("Cannot write %s: %s\n", json_path, error->message);
+            g_error_free(error);
+        }
+        g_free(json);
+    }
+
+    if (baseline_path || update_path) {
+        double allocations = fix_allocations(stack);
+        check_baseline(rounds, require_allocations,
+                       allocations >= 0.0 ? allocations / std::max(clients, 1) : -1.0,
+                       perf_baseline);
+    }
+    if (update_path && !perf_baseline.update(update_path, &error)) {
+        g_printerr("Cannot write baseline %s: %s\n", update_path, error->message);
+        g_clear_error(&error);
+    }
+    if (perf_baseline.failures() > 0) {
+        g_print("\nFAIL: %u metrics regressed or have no reference\n", perf_baseline.failures());
+    }
+
+    g_free(rates);
+    g_free(json_path);
+    g_free(label);
+    g_free(replay_path);
+    g_free(baseline_path);
+    g_free(update_path);
+    return perf_baseline.failures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,361 @@
+/*
+ * Scripted GeoClue1 stand-in for the benchmarks
+ *
+ * Owns org.freedesktop.Geoclue.Master on the session bus and implements
+ * just enough of geoclue-master for Geoclue1Backend: Master.Create(),
+ * MasterClient.SetRequirements()/PositionStart(), AddReference() and
+ * RemoveReference(), and PositionProviderChanged pointing at a provider
+ * object in this process.
+ *
+ * Fixes are only emitted on request, through
+ * io.github.rinigus.GeoClue2to1.Bench.Emit(rate_hz, count), which returns
+ * once all of them were sent. Each fix is a VelocityChanged followed by a
+ * PositionChanged. Positions walk a small circle, or are replayed from a
+ * file given with --replay ("lat lon alt accuracy [speed heading]" per
+ * line, repeated as needed). The Altitude field always carries the emit
+ * time (CLOCK_MONOTONIC, microseconds) for latency measurements.
+ */
+
+#include <gio/gio.h>
+#include <glib-unix.h>
+#include <glib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_harness.h"
+
+namespace {
+
+const char *MASTER_OBJECT_PATH = "/org/freedesktop/Geoclue/Master";
+const char *PROVIDER_OBJECT_PATH = "/org/freedesktop/Geoclue/Providers/Bench";
+
+// GeoClue1 position fields: latitude, longitude and altitude are valid
+const gint POSITION_FIELDS = 1 | 2 | 4;
+// GeoClue1 velocity fields: speed, direction and climb are valid
+const gint VELOCITY_FIELDS = 1 | 2 | 4;
+
+const char *STANDIN_XML =
+    "<node>"
+    "  <interface name='org.freedesktop.Geoclue.Master'>"
+    "    <method name='Create'>"
+    "      <arg name='path' type='o' direction='out'/>"
+    "    </method>"
+    "  </interface>"
+    "  <interface name='org.freedesktop.Geoclue.MasterClient'>"
+    "    <method name='SetRequirements'>"
+    "      <arg name='accuracy_level' type='i' direction='in'/>"
+    "      <arg name='time' type='i' direction='in'/>"
+    "      <arg name='require_updates' type='b' direction='in'/>"
+    "      <arg name='allowed_resources' type='i' direction='in'/>"
+    "    </method>"
+    "    <method name='PositionStart'/>"
+    "    <signal name='PositionProviderChanged'>"
+    "      <arg name='name' type='s'/>"
+    "      <arg name='description' type='s'/>"
+    "      <arg name='service' type='s'/>"
+    "      <arg name='path' type='s'/>"
+    "    </signal>"
+    "  </interface>"
+    "  <interface name='org.freedesktop.Geoclue'>"
+    "    <method name='AddReference'/>"
+    "    <method name='RemoveReference'/>"
+    "  </interface>"
+    "  <interface name='org.freedesktop.Geoclue.Position'>"
+    "    <signal name='PositionChanged'>"
+    "      <arg name='fields' type='i'/>"
+    "      <arg name='timestamp' type='i'/>"
+    "      <arg name='latitude' type='d'/>"
+    "      <arg name='longitude' type='d'/>"
+    "      <arg name='altitude' type='d'/>"
+    "      <arg name='accuracy' type='(idd)'/>"
+    "    </signal>"
+    "  </interface>"
+    "  <interface name='org.freedesktop.Geoclue.Velocity'>"
+    "    <signal name='VelocityChanged'>"
+    "      <arg name='fields' type='i'/>"
+    "      <arg name='timestamp' type='i'/>"
+    "      <arg name='speed' type='d'/>"
+    "      <arg name='direction' type='d'/>"
+    "      <arg name='climb' type='d'/>"
+    "    </signal>"
+    "  </interface>"
+    "  <interface name='io.github.rinigus.GeoClue2to1.Bench'>"
+    "    <method name='Emit'>"
+    "      <arg name='rate_hz' type='d' direction='in'/>"
+    "      <arg name='count' type='u' direction='in'/>"
+    "    </method>"
+    "  </interface>"
+    "</node>";
+
+struct ReplayFix {
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double accuracy = 0.0;
+    double speed = 0.0;
+    double heading = 0.0;
+};
+
+class GeoClue1StandIn {
+  public:
+    GeoClue1StandIn(GDBusConnection *connection, std::vector<ReplayFix> replay)
+        : m_connection(connection), m_replay(std::move(replay)) {
+        m_node = g_dbus_node_info_new_for_xml(STANDIN_XML, nullptr);
+        register_object(MASTER_OBJECT_PATH, "org.freedesktop.Geoclue.Master");
+        register_object(PROVIDER_OBJECT_PATH, "org.freedesktop.Geoclue");
+        register_object(PROVIDER_OBJECT_PATH, "org.freedesktop.Geoclue.Position");
+        register_object(PROVIDER_OBJECT_PATH, "org.freedesktop.Geoclue.Velocity");
+        register_object(BENCH_STANDIN_OBJECT_PATH, BENCH_STANDIN_INTERFACE);
+    }
+
+    ~GeoClue1StandIn() {
+        if (m_emit_id != 0) {
+            g_source_remove(m_emit_id);
+        }
+        for (guint id : m_registrations) {
+            g_dbus_connection_unregister_object(m_connection, id);
+        }
+        g_dbus_node_info_unref(m_node);
+    }
+
+    // Non-copyable
+    GeoClue1StandIn(const GeoClue1StandIn &) = delete;
+    GeoClue1StandIn &operator=(const GeoClue1StandIn &) = delete;
+
+  private:
+    GDBusConnection *m_connection;
+    GDBusNodeInfo *m_node = nullptr;
+    std::vector<guint> m_registrations;
+    guint m_next_client_id = 0;
+
+    std::vector<ReplayFix> m_replay;
+    guint64 m_fix_index = 0;
+
+    // Emit() in progress
+    GDBusMethodInvocation *m_emit_invocation = nullptr;
+    guint m_emit_id = 0;
+    guint m_emit_remaining = 0;
+    gint64 m_emit_period_us = 0;
+    gint64 m_next_emit_us = 0;
+
+    void register_object(const std::string &path, const char *interface_name) {
+        static const GDBusInterfaceVTable vtable = {&GeoClue1StandIn::on_method_call, nullptr,
+                                                    nullptr, {}};
+
+        GError *error = nullptr;
+        guint id = g_dbus_connection_register_object(
+            m_connection, path.c_str(), g_dbus_node_info_lookup_interface(m_node, interface_name),
+            &vtable, this, nullptr, &error);
+        if (id == 0) {
+            g_warning("Failed to export %s on %s: %s", interface_name, path.c_str(),
+                      error->message);
+            g_error_free(error);
+            return;
+        }
+        m_registrations.push_back(id);
+    }
+
+    void emit_fix() {
+        ReplayFix fix;
+        if (!m_replay.empty()) {
+            fix = m_replay[m_fix_index % m_replay.size()];
+        } else {
+            // A 100 m circle around Helsinki, one lap per 3600 fixes
+            double angle = m_fix_index * 2.0 * G_PI / 3600.0;
+            fix.latitude = 60.17 + 0.0009 * std::sin(angle);
+            fix.longitude = 24.94 + 0.0018 * std::cos(angle);
+            fix.accuracy = 5.0;
+            fix.speed = 1.5;
+            fix.heading = std::fmod(angle * 180.0 / G_PI + 90.0, 360.0);
+        }
+        ++m_fix_index;
+
+        gint timestamp = (gint)(g_get_real_time() / G_USEC_PER_SEC);
+        g_dbus_connection_emit_signal(
+            m_connection, nullptr, PROVIDER_OBJECT_PATH, "org.freedesktop.Geoclue.Velocity",
+            "VelocityChanged",
+            g_variant_new("(iiddd)", VELOCITY_FIELDS, timestamp, fix.speed, fix.heading, 0.0),
+            nullptr);
+
+        double emit_us = (double)g_get_monotonic_time();
+        g_dbus_connection_emit_signal(
+            m_connection, nullptr, PROVIDER_OBJECT_PATH, "org.freedesktop.Geoclue.Position",
+            "PositionChanged",
+            g_variant_new("(iiddd(idd))", POSITION_FIELDS, timestamp, fix.latitude,
+                          fix.longitude, emit_us, 5, fix.accuracy, fix.accuracy),
+            nullptr);
+    }
+
+    void schedule_emit() {
+        gint64 delay_us = std::max<gint64>(0, m_next_emit_us - g_get_monotonic_time());
+        m_emit_id = g_timeout_add(delay_us / 1000, &GeoClue1StandIn::on_emit_timeout, this);
+    }
+
+    void handle_emit(GVariant *parameters, GDBusMethodInvocation *invocation) {
+        gdouble rate_hz = 0.0;
+        guint32 count = 0;
+        g_variant_get(parameters, "(du)", &rate_hz, &count);
+
+        if (m_emit_invocation || rate_hz <= 0.0) {
+            g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR,
+                                                  G_DBUS_ERROR_INVALID_ARGS,
+                                                  "Emit already running or rate not positive");
+            return;
+        }
+        if (count == 0) {
+            g_dbus_method_invocation_return_value(invocation, nullptr);
+            return;
+        }
+
+        m_emit_invocation = invocation;
+        m_emit_remaining = count;
+        m_emit_period_us = (gint64)(G_USEC_PER_SEC / rate_hz);
+        m_next_emit_us = g_get_monotonic_time();
+        schedule_emit();
+    }
+
+    static gboolean on_emit_timeout(gpointer user_data) {
+        auto *self = static_cast<GeoClue1StandIn *>(user_data);
+        self->m_emit_id = 0;
+
+        self->emit_fix();
+        self->m_next_emit_us += self->m_emit_period_us;
+
+        if (--self->m_emit_remaining == 0) {
+            g_dbus_method_invocation_return_value(self->m_emit_invocation, nullptr);
+            self->m_emit_invocation = nullptr;
+        } else {
+            self->schedule_emit();
+        }
+        return G_SOURCE_REMOVE;
+    }
+
+    static void on_method_call(GDBusConnection *connection, const gchar * /*sender*/,
+                               const gchar *object_path, const gchar * /*interface_name*/,
+                               const gchar *method_name, GVariant *parameters,
+                               GDBusMethodInvocation *invocation, gpointer user_data) {
+        auto *self = static_cast<GeoClue1StandIn *>(user_data);
+
+        if (g_strcmp0(method_name, "Create") == 0) {
+            std::string path = std::string(MASTER_OBJECT_PATH) + "/client" +
+                               std::to_string(++self->m_next_client_id);
+            self->register_object(path, "org.freedesktop.Geoclue.MasterClient");
+            self->register_object(path, "org.freedesktop.Geoclue");
+            g_dbus_method_invocation_return_value(invocation,
+                                                  g_variant_new("(o)", path.c_str()));
+        } else if (g_strcmp0(method_name, "PositionStart") == 0) {
+            g_dbus_method_invocation_return_value(invocation, nullptr);
+            // The reply goes out first, so the backend has subscribed by now
+            g_dbus_connection_emit_signal(
+                connection, nullptr, object_path, "org.freedesktop.Geoclue.MasterClient",
+                "PositionProviderChanged",
+                g_variant_new("(ssss)", "Bench", "Benchmark stand-in",
+                              g_dbus_connection_get_unique_name(connection),
+                              PROVIDER_OBJECT_PATH),
+                nullptr);
+        } else if (g_strcmp0(method_name, "Emit") == 0) {
+            self->handle_emit(parameters, invocation);
+        } else {
+            // SetRequirements, AddReference, RemoveReference
+            g_dbus_method_invocation_return_value(invocation, nullptr);
+        }
+    }
+};
+
+std::vector<ReplayFix> load_replay(const char *path) {
+    std::vector<ReplayFix> fixes;
+
+    gchar *contents = nullptr;
+    GError *error = nullptr;
+    if (!g_file_get_contents(path, &contents, nullptr, &error)) {
+        g_printerr("Cannot read %s: %s\n", path, error->message);
+        g_error_free(error);
+        exit(EXIT_FAILURE);
+    }
+
+    gchar **lines = g_strsplit(contents, "\n", 0);
+    for (gchar **line = lines; *line; ++line) {
+        if ((*line)[0] == '#' || (*line)[0] == '\0') {
+            continue;
+        }
+
+        ReplayFix fix;
+        double altitude = 0.0;
+        int fields = sscanf(*line, "%lf %lf %lf %lf %lf %lf", &fix.latitude, &fix.longitude,
+                            &altitude, &fix.accuracy, &fix.speed, &fix.heading);
+        if (fields >= 4) {
+            fixes.push_back(fix);
+        }
+    }
+
+    g_strfreev(lines);
+    g_free(contents);
+    return fixes;
+}
+
+gboolean on_quit_signal(gpointer loop) {
+    g_main_loop_quit(static_cast<GMainLoop *>(loop));
+    return G_SOURCE_REMOVE;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    gchar *replay_path = nullptr;
+
+    GOptionEntry entries[] = {
+        {"replay", 0, 0, G_OPTION_ARG_FILENAME, &replay_path,
+         "Replay fixes from FILE (lat lon alt accuracy [speed heading])", "FILE"},
+        {nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr}};
+
+    GError *error = nullptr;
+    GOptionContext *context = g_option_context_new("- scripted GeoClue1 stand-in");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("Option parsing failed: %s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(context);
+        return EXIT_FAILURE;
+    }
+    g_option_context_free(context);
+
+    std::vector<ReplayFix> replay;
+    if (replay_path) {
+        replay = load_replay(replay_path);
+        g_free(replay_path);
+    }
+
+    GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
+    if (!connection) {
+        g_printerr("Cannot connect to the session bus: %s\n", error->message);
+        g_error_free(error);
+        return EXIT_FAILURE;
+    }
+
+    GMainLoop *loop = g_main_loop_new(nullptr, FALSE);
+    {
+        GeoClue1StandIn standin(connection, std::move(replay));
+
+        // Objects first, so the name never points at an empty process
+        guint owner_id =
+            g_bus_own_name_on_connection(connection, BENCH_STANDIN_BUS_NAME,
+                                         G_BUS_NAME_OWNER_FLAGS_NONE, nullptr, nullptr, nullptr,
+                                         nullptr);
+
+        g_unix_signal_add(SIGTERM, on_quit_signal, loop);
+        g_unix_signal_add(SIGINT, on_quit_signal, loop);
+        g_main_loop_run(loop);
+
+        g_bus_unown_name(owner_id);
+    }
+
+    g_main_loop_unref(loop);
+    g_object_unref(connection);
+    return EXIT_SUCCESS;
+}
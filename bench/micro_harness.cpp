@@ -0,0 +1,447 @@
+#include "micro_harness.h"
+
+#include <gio/gio.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * Implementation of the microbenchmark runner.
+ *
+ * Calibration follows Google Benchmark: start at one iteration and grow the
+ * count (at most tenfold per step) until a run takes the minimum time. That
+ * run is reported, and further repetitions reuse its iteration count.
+ */
+
+namespace {
+
+const double DEFAULT_MIN_TIME_S = 0.5;
+const guint64 MAX_ITERATIONS = 1000000000;
+
+// Tolerance when the baseline names none for a benchmark
+const double DEFAULT_TOLERANCE = 0.15;
+
+struct MicroResult {
+    std::string name;
+    guint64 iterations = 0;
+    double real_ns = 0.0; // per iteration
+    double cpu_ns = 0.0;  // per iteration
+    double items = 0.0;   // per iteration, 0 if the benchmark counts none
+    double items_per_second = 0.0;
+
+    // CPU time per item, or per iteration without items
+    double cpu_ns_per_item() const { return items > 0.0 ? cpu_ns / items : cpu_ns; }
+};
+
+// How a result fares against the baseline
+enum class Gate { None, Missing, Compared };
+
+struct Comparison {
+    Gate gate = Gate::None;
+    double ratio = -1.0;  // CPU time per item against the relative_to benchmark's
+    double change = 0.0;  // of the ratio against the stored one, as a fraction
+    double tolerance = 0.0;
+};
+
+std::vector<std::unique_ptr<MicroBenchmark>> &registry() {
+    static std::vector<std::unique_ptr<MicroBenchmark>> benchmarks;
+    return benchmarks;
+}
+
+gint64 clock_ns(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (gint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+bool run_once(const MicroBenchmark &benchmark, gint64 arg, guint64 iterations,
+              MicroResult *result) {
+    MicroState state(iterations, arg);
+    benchmark.function()(state);
+    if (!state.finished()) {
+        g_printerr("%s: the benchmark did not run its keep_running() loop\n",
+                   result->name.c_str());
+        return false;
+    }
+
+    result->iterations = iterations;
+    result->real_ns = (double)state.real_ns() / iterations;
+    result->cpu_ns = (double)state.cpu_ns() / iterations;
+    result->items = (double)state.items_processed() / iterations;
+    result->items_per_second =
+        state.items_processed() > 0 && state.real_ns() > 0
+            ? state.items_processed() * 1e9 / state.real_ns()
+            : 0.0;
+    return true;
+}
+
+bool run_benchmark(const MicroBenchmark &benchmark, gint64 arg, const std::string &name,
+                   double min_time_s, int repetitions, std::vector<MicroResult> *results) {
+    MicroResult result;
+    result.name = name;
+
+    guint64 iterations = 1;
+    gint64 min_time_ns = (gint64)(min_time_s * 1e9);
+    for (;;) {
+        if (!run_once(benchmark, arg, iterations, &result)) {
+            return false;
+        }
+
+        double elapsed_ns = result.real_ns * iterations;
+        if (elapsed_ns >= min_time_ns || iterations >= MAX_ITERATIONS) {
+            break;
+        }
+
+        // Aim 40% past the minimum so the next run is likely the last
+        double multiplier = elapsed_ns > 0.0 ? min_time_ns * 1.4 / elapsed_ns : 10.0;
+        multiplier = std::min(multiplier, 10.0);
+        iterations = std::max(iterations + 1, (guint64)(iterations * multiplier));
+        iterations = std::min(iterations, MAX_ITERATIONS);
+    }
+    results->push_back(result);
+
+    for (int i = 1; i < repetitions; ++i) {
+        if (!run_once(benchmark, arg, iterations, &result)) {
+            return false;
+        }
+        results->push_back(result);
+    }
+    return true;
+}
+
+// Median of the repetitions of each benchmark, in first-seen order
+std::vector<MicroResult> medians(const std::vector<MicroResult> &results) {
+    std::vector<MicroResult> medians;
+    for (size_t i = 0; i < results.size();) {
+        size_t end = i;
+        while (end < results.size() && results[end].name == results[i].name) {
+            ++end;
+        }
+
+        std::vector<MicroResult> runs(results.begin() + i, results.begin() + end);
+        std::sort(runs.begin(), runs.end(),
+                  [](const MicroResult &a, const MicroResult &b) { return a.cpu_ns < b.cpu_ns; });
+        medians.push_back(runs[runs.size() / 2]);
+        i = end;
+    }
+    return medians;
+}
+
+std::string format_time(double ns) {
+    gchar *text = ns >= 1e6   ? g_strdup_printf("%10.3f ms", ns / 1e6)
+                  : ns >= 1e4 ? g_strdup_printf("%10.2f us", ns / 1e3)
+                              : g_strdup_printf("%10.1f ns", ns);
+    std::string result = text;
+    g_free(text);
+    return result;
+}
+
+// CPU time per item of `result` against that of the benchmark its group
+// names as relative_to, from the same run; -1 if that one did not run
+double relative_cpu(const MicroResult &result, const std::vector<MicroResult> &results,
+                    GKeyFile *baseline) {
+    gchar *anchor = g_key_file_get_string(baseline, result.name.c_str(), "relative_to", nullptr);
+    double ratio = -1.0;
+    for (const MicroResult &other : results) {
+        if (anchor && other.name == anchor && other.cpu_ns_per_item() > 0.0) {
+            ratio = result.cpu_ns_per_item() / other.cpu_ns_per_item();
+        }
+    }
+    g_free(anchor);
+    return ratio;
+}
+
+// Only groups with relative_to are gated. Their stored "relative" ratio
+// holds across machines, unlike a CPU time.
+Comparison compare_baseline(const MicroResult &result, const std::vector<MicroResult> &results,
+                            GKeyFile *baseline) {
+    Comparison comparison;
+    const char *group = result.name.c_str();
+    if (!g_key_file_has_key(baseline, group, "relative_to", nullptr)) {
+        return comparison;
+    }
+
+    comparison.gate = Gate::Missing;
+    comparison.ratio = relative_cpu(result, results, baseline);
+    double expected = g_key_file_get_double(baseline, group, "relative", nullptr);
+    if (comparison.ratio < 0.0 || expected <= 0.0) {
+        return comparison;
+    }
+
+    comparison.gate = Gate::Compared;
+    comparison.tolerance = DEFAULT_TOLERANCE;
+    if (g_key_file_has_key(baseline, group, "tolerance", nullptr)) {
+        comparison.tolerance = g_key_file_get_double(baseline, group, "tolerance", nullptr);
+    } else if (g_key_file_has_key(baseline, "micro", "tolerance", nullptr)) {
+        comparison.tolerance = g_key_file_get_double(baseline, "micro", "tolerance", nullptr);
+    }
+    comparison.change = comparison.ratio / expected - 1.0;
+    return comparison;
+}
+
+// Gated results slower than the baseline allows, or without a reference
+guint count_failures(const std::vector<MicroResult> &results, GKeyFile *baseline) {
+    guint failures = 0;
+    for (const MicroResult &result : results) {
+        Comparison comparison = compare_baseline(result, results, baseline);
+        if (comparison.gate == Gate::Missing ||
+            (comparison.gate == Gate::Compared && comparison.change > comparison.tolerance)) {
+            ++failures;
+        }
+    }
+    return failures;
+}
+
+void print_table(const std::vector<MicroResult> &results, GKeyFile *baseline) {
+    size_t width = 24;
+    for (const MicroResult &result : results) {
+        width = std::max(width, result.name.size() + 2);
+    }
+
+    g_print("%-*s %13s %13s %12s%s\n", (int)width, "Benchmark", "Time", "CPU", "Iterations",
+            baseline ? "   vs baseline" : "");
+    g_print("%s\n", std::string(width + 41 + (baseline ? 15 : 0), '-').c_str());
+
+    for (const MicroResult &result : results) {
+        g_print("%-*s %s %s %12" G_GUINT64_FORMAT, (int)width, result.name.c_str(),
+                format_time(result.real_ns).c_str(), format_time(result.cpu_ns).c_str(),
+                result.iterations);
+
+        if (baseline) {
+            Comparison comparison = compare_baseline(result, results, baseline);
+            if (comparison.gate == Gate::Compared) {
+                g_print("   %+7.1f%%%s", comparison.change * 100.0,
+                        comparison.change > comparison.tolerance ? "  SLOWER" : "");
+            } else if (comparison.gate == Gate::Missing) {
+                g_print("   MISSING");
+            }
+        }
+        if (result.items_per_second > 0.0) {
+            g_print("   %.3g items/s", result.items_per_second);
+        }
+        g_print("\n");
+    }
+}
+
+gchar *results_json(const std::vector<MicroResult> &results, const char *executable) {
+    GDateTime *now = g_date_time_new_now_local();
+    gchar *date = g_date_time_format_iso8601(now);
+    g_date_time_unref(now);
+    gchar *escaped_executable = g_strescape(executable, nullptr);
+
+    GString *json = g_string_new("{\n  \"context\": {\n");
+    g_string_append_printf(json,
+                           "    \"date\": \"%s\",\n    \"executable\": \"%s\",\n"
+                           "    \"num_cpus\": %ld,\n    \"library\": \"geoclue2to1-micro\"\n"
+                           "  },\n  \"benchmarks\": [",
+                           date, escaped_executable, sysconf(_SC_NPROCESSORS_ONLN));
+    g_free(date);
+    g_free(escaped_executable);
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const MicroResult &result = results[i];
+        g_string_append_printf(json,
+                               "%s\n    {\"name\": \"%s\", \"run_name\": \"%s\", "
+                               "\"iterations\": %" G_GUINT64_FORMAT
+                               ", \"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\"",
+                               i ? "," : "", result.name.c_str(), result.name.c_str(),
+                               result.iterations, result.real_ns, result.cpu_ns);
+        if (result.items_per_second > 0.0) {
+            g_string_append_printf(json, ", \"items_per_second\": %.3f",
+                                   result.items_per_second);
+        }
+        g_string_append_c(json, '}');
+    }
+
+    g_string_append(json, "\n  ]\n}\n");
+    return g_string_free(json, FALSE);
+}
+
+// Keep the baseline's comments, tolerances and relative_to; replace only
+// the relative ratios
+bool update_baseline(const char *path, const std::vector<MicroResult> &results,
+                     GError **error) {
+    GKeyFile *key_file = g_key_file_new();
+    g_key_file_load_from_file(key_file, path, G_KEY_FILE_KEEP_COMMENTS, nullptr);
+
+    for (const MicroResult &result : results) {
+        double ratio = relative_cpu(result, results, key_file);
+        if (ratio > 0.0) {
+            g_key_file_set_double(key_file, result.name.c_str(), "relative", ratio);
+        }
+    }
+
+    bool ok = g_key_file_save_to_file(key_file, path, error);
+    g_key_file_free(key_file);
+    return ok;
+}
+
+} // namespace
+
+void MicroState::start() {
+    m_started = true;
+    m_real_started_ns = clock_ns(CLOCK_MONOTONIC);
+    m_cpu_started_ns = clock_ns(CLOCK_THREAD_CPUTIME_ID);
+}
+
+void MicroState::finish() {
+    if (!m_paused) {
+        pause_timing();
+    }
+    m_finished = true;
+}
+
+void MicroState::pause_timing() {
+    m_real_ns += clock_ns(CLOCK_MONOTONIC) - m_real_started_ns;
+    m_cpu_ns += clock_ns(CLOCK_THREAD_CPUTIME_ID) - m_cpu_started_ns;
+    m_paused = true;
+}
+
+void MicroState::resume_timing() {
+    m_paused = false;
+    m_real_started_ns = clock_ns(CLOCK_MONOTONIC);
+    m_cpu_started_ns = clock_ns(CLOCK_THREAD_CPUTIME_ID);
+}
+
+MicroBenchmark *micro_register(const char *name, MicroBenchmark::Function function) {
+    registry().push_back(std::make_unique<MicroBenchmark>(name, function));
+    return registry().back().get();
+}
+
+int micro_main(int argc, char **argv) {
+    gchar *filter = nullptr;
+    gdouble min_time_s = DEFAULT_MIN_TIME_S;
+    gint repetitions = 1;
+    gchar *format = nullptr;
+    gchar *out_path = nullptr;
+    gchar *baseline_path = nullptr;
+    gchar *update_path = nullptr;
+    gboolean list = FALSE;
+
+    GOptionEntry entries[] = {
+        {"benchmark_filter", 0, 0, G_OPTION_ARG_STRING, &filter,
+         "Run only benchmarks matching REGEX", "REGEX"},
+        {"benchmark_min_time", 0, 0, G_OPTION_ARG_DOUBLE, &min_time_s,
+         "Minimum time per benchmark (default 0.5)", "SECONDS"},
+        {"benchmark_repetitions", 0, 0, G_OPTION_ARG_INT, &repetitions,
+         "Runs per benchmark; the median is reported (default 1)", "N"},
+        {"benchmark_format", 0, 0, G_OPTION_ARG_STRING, &format,
+         "Output format on stdout: console or json", "FORMAT"},
+        {"benchmark_out", 0, 0, G_OPTION_ARG_FILENAME, &out_path, "Also write JSON to FILE",
+         "FILE"},
+        {"benchmark_list_tests", 0, 0, G_OPTION_ARG_NONE, &list, "List benchmarks and exit",
+         nullptr},
+        {"baseline", 0, 0, G_OPTION_ARG_FILENAME, &baseline_path,
+         "Compare relative CPU times against a baseline file", "FILE"},
+        {"update-baseline", 0, 0, G_OPTION_ARG_FILENAME, &update_path,
+         "Store this run's relative CPU times in a baseline file", "FILE"},
+        {nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr}};
+
+    GError *error = nullptr;
+    GOptionContext *context = g_option_context_new("- fix path microbenchmarks");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("Option parsing failed: %s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(context);
+        return EXIT_FAILURE;
+    }
+    g_option_context_free(context);
+
+    GRegex *regex = nullptr;
+    if (filter) {
+        regex = g_regex_new(filter, G_REGEX_OPTIMIZE, (GRegexMatchFlags)0, &error);
+        if (!regex) {
+            g_printerr("Invalid --benchmark_filter: %s\n", error->message);
+            g_error_free(error);
+            return EXIT_FAILURE;
+        }
+    }
+
+    GKeyFile *baseline = nullptr;
+    if (baseline_path) {
+        baseline = g_key_file_new();
+        if (!g_key_file_load_from_file(baseline, baseline_path, G_KEY_FILE_NONE, &error)) {
+            g_printerr("Cannot read baseline %s: %s\n", baseline_path, error->message);
+            g_error_free(error);
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<MicroResult> results;
+    int status = EXIT_SUCCESS;
+    for (const auto &benchmark : registry()) {
+        std::vector<std::pair<std::string, gint64>> runs;
+        if (benchmark->args().empty()) {
+            runs.emplace_back(benchmark->name(), 0);
+        }
+        for (gint64 arg : benchmark->args()) {
+            runs.emplace_back(benchmark->name() + "/" + std::to_string(arg), arg);
+        }
+
+        for (const auto &run : runs) {
+            if (regex && !g_regex_match(regex, run.first.c_str(), (GRegexMatchFlags)0, nullptr)) {
+                continue;
+            }
+            if (list) {
+                g_print("%s\n", run.first.c_str());
+                continue;
+            }
+            if (!run_benchmark(*benchmark, run.second, run.first, std::max(min_time_s, 0.0),
+                               std::max(repetitions, 1), &results)) {
+                status = EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (!list) {
+        std::vector<MicroResult> reported = medians(results);
+        gchar *json = results_json(reported, argv[0]);
+        if (format && g_str_equal(format, "json")) {
+            g_print("%s", json);
+        } else {
+            print_table(reported, baseline);
+        }
+
+        if (out_path && !g_file_set_contents(out_path, json, -1, &error)) {
+            g_printerr("Cannot write %s: %s\n", out_path, error->message);
+            g_clear_error(&error);
+            status = EXIT_FAILURE;
+        }
+        g_free(json);
+
+        if (update_path && !update_baseline(update_path, reported, &error)) {
+            g_printerr("Cannot write baseline %s: %s\n", update_path, error->message);
+            g_clear_error(&error);
+            status = EXIT_FAILURE;
+        }
+
+        // Slower than the baseline allows, or without a reference, fails the
+        // run, so that CTest catches it
+        guint failures = baseline ? count_failures(reported, baseline) : 0;
+        if (failures > 0) {
+            g_printerr("%u benchmarks slower than the baseline allows or without a reference\n",
+                       failures);
+            status = EXIT_FAILURE;
+        }
+    }
+
+    if (baseline) {
+        g_key_file_free(baseline);
+    }
+    if (regex) {
+        g_regex_unref(regex);
+    }
+    g_free(filter);
+    g_free(format);
+    g_free(out_path);
+    g_free(baseline_path);
+    g_free(update_path);
+    return status;
+}
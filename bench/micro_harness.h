@@ -0,0 +1,128 @@
+#pragma once
+
+#include <glib.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * Microbenchmark runner in the style of Google Benchmark.
+ *
+ * A benchmark is a function that does its setup, then runs the measured
+ * kernel once per iteration of `while (state.keep_running())`. The runner
+ * grows the iteration count until one run takes --benchmark_min_time and
+ * reports wall and CPU time per iteration:
+ *
+ *     static void path_format(MicroState &state) {
+ *         guint id = 0;
+ *         while (state.keep_running()) {
+ *             micro_do_not_optimize(GeoClue2Manager::location_object_path(++id));
+ *         }
+ *     }
+ *     MICRO_BENCHMARK(path_format);
+ *     MICRO_BENCHMARK(fanout)->arg(1)->arg(100); // runs as fanout/1, fanout/100
+ *
+ * Results print as a table or as Google Benchmark compatible JSON
+ * (--benchmark_format=json, --benchmark_out=FILE), so its compare tools
+ * work on them. A baseline (GKeyFile, one group per gated benchmark) names
+ * for each the benchmark of the same run it is measured against
+ * (relative_to) and their ratio of CPU time per item (relative), which does
+ * not depend on the machine. --baseline fails the run when a ratio grew
+ * past its tolerance or is missing; --update-baseline rewrites the ratios
+ * from the current run.
+ */
+
+class MicroState {
+  public:
+    MicroState(guint64 iterations, gint64 arg) : m_iterations(iterations), m_arg(arg) {}
+
+    // Non-copyable
+    MicroState(const MicroState &) = delete;
+    MicroState &operator=(const MicroState &) = delete;
+
+    // True once per iteration; timing covers the loop only
+    bool keep_running() {
+        if (G_UNLIKELY(!m_started)) {
+            start();
+        }
+        if (G_UNLIKELY(m_done == m_iterations)) {
+            finish();
+            return false;
+        }
+        ++m_done;
+        return true;
+    }
+
+    // Exclude per-iteration setup from the measurement
+    void pause_timing();
+    void resume_timing();
+
+    // The value given with ->arg(), 0 without
+    gint64 arg() const { return m_arg; }
+
+    guint64 iterations() const { return m_iterations; }
+
+    // Work items per run, reported as items_per_second
+    void set_items_processed(gint64 items) { m_items = items; }
+
+    bool finished() const { return m_finished; }
+    gint64 real_ns() const { return m_real_ns; }
+    gint64 cpu_ns() const { return m_cpu_ns; }
+    gint64 items_processed() const { return m_items; }
+
+  private:
+    guint64 m_iterations;
+    guint64 m_done = 0;
+    gint64 m_arg;
+    gint64 m_items = 0;
+
+    bool m_started = false;
+    bool m_paused = false;
+    bool m_finished = false;
+    gint64 m_real_started_ns = 0;
+    gint64 m_cpu_started_ns = 0;
+    gint64 m_real_ns = 0;
+    gint64 m_cpu_ns = 0;
+
+    void start();
+    void finish();
+};
+
+class MicroBenchmark {
+  public:
+    using Function = void (*)(MicroState &);
+
+    MicroBenchmark(const char *name, Function function) : m_name(name), m_function(function) {}
+
+    // Run once per argument, named "<name>/<value>"
+    MicroBenchmark *arg(gint64 value) {
+        m_args.push_back(value);
+        return this;
+    }
+
+    const std::string &name() const { return m_name; }
+    Function function() const { return m_function; }
+    const std::vector<gint64> &args() const { return m_args; }
+
+  private:
+    std::string m_name;
+    Function m_function;
+    std::vector<gint64> m_args;
+};
+
+// Register a benchmark; the runner owns it
+MicroBenchmark *micro_register(const char *name, MicroBenchmark::Function function);
+
+#define MICRO_BENCHMARK(function)                                                               \
+    static MicroBenchmark *micro_benchmark_##function G_GNUC_UNUSED =                          \
+        micro_register(#function, function)
+
+// Keep the compiler from optimizing away a value or the stores behind it
+template <typename T> inline void micro_do_not_optimize(const T &value) {
+    asm volatile("" : : "m"(value) : "memory");
+}
+
+inline void micro_clobber_memory() { asm volatile("" : : : "memory"); }
+
+// Parse the --benchmark_* options and run all registered benchmarks
+int micro_main(int argc, char **argv);
@@ -12,6 +12,7 @@ Source2:        geoclue2to1.conf
 BuildRequires:  cmake
 BuildRequires:  pkgconfig(dbus-glib-1)
 BuildRequires:  pkgconfig(glib-2.0)
+BuildRequires:  pkgconfig(libsystemd)
 BuildRequires:  systemd
 
 Requires(post):   systemd
@@ -58,14 +59,12 @@ fi
 
 %post
 systemctl-user daemon-reload || true
-systemctl-user start %{name} || true
-systemctl-user enable %{name} || true
-
-%pre
-# In case of update, stop first
-if [ "$1" = "2" ]; then
-  systemctl-user disable %{name} || true
-  systemctl-user stop %{name} || true
+if [ "$1" = "1" ]; then
+  systemctl-user start %{name} || true
+  systemctl-user enable %{name} || true
+else
+  # Update: the running instance hands its clients to the new binary
+  systemctl-user reload %{name} || true
 fi
 
 %files
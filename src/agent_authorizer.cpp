@@ -0,0 +1,447 @@
+#include "agent_authorizer.h"
+#include "bridge_config.h"
+#include "clock.h"
+
+#include <algorithm>
+#include <utility>
+
+// Lifetime of cached decisions. Denials expire sooner so that a user who
+// changes their mind in the agent UI is asked again reasonably soon.
+const gint64 AUTH_ALLOW_TTL_S = 24 * 60 * 60;
+const gint64 AUTH_DENY_TTL_S = 60 * 60;
+
+namespace {
+
+// Heap-allocated context for async D-Bus calls
+template <typename T> struct AsyncCall {
+    AgentAuthorizer *self;
+    T data;
+};
+
+gint64 wall_clock_s() { return Clock::get().real_us() / G_USEC_PER_SEC; }
+
+} // namespace
+
+AgentAuthorizer::AgentAuthorizer(GDBusConnection *connection, PeerCredentialCache &credentials)
+    : m_connection(connection), m_credentials(credentials), m_cancellable(g_cancellable_new()),
+      m_store_path(bridge_state_path("authorization.ini")) {
+    load_decisions();
+}
+
+AgentAuthorizer::~AgentAuthorizer() {
+    // Pending async calls see G_IO_ERROR_CANCELLED and do not touch us
+    g_cancellable_cancel(m_cancellable);
+    g_object_unref(m_cancellable);
+
+    for (auto &pair : m_agents) {
+        if (pair.second.watch_id != 0) {
+            g_bus_unwatch_name(pair.second.watch_id);
+        }
+    }
+}
+
+void AgentAuthorizer::add_agent(const std::string &peer, const std::string &agent_id,
+                                AddCallback done) {
+    m_credentials.lookup(peer, [this, peer, agent_id, done](bool ok,
+                                                            const PeerCredentials &credentials) {
+        if (!ok || !credentials.has_uid) {
+            g_warning("AgentAuthorizer: cannot resolve uid of agent %s, ignoring", peer.c_str());
+            done(false, "Cannot resolve the credentials of the agent");
+            return;
+        }
+
+        // The uid alone does not tell the user's agent from an app
+        const std::vector<std::string> &whitelist = BridgeConfig::current().agent_whitelist;
+        if (credentials.exe.empty() ||
+            std::find(whitelist.begin(), whitelist.end(), credentials.exe) == whitelist.end()) {
+            ++m_rejected_agents;
+            g_warning("AgentAuthorizer: refusing agent %s (%s): %s is not in the [agent] "
+                      "whitelist",
+                      agent_id.c_str(), peer.c_str(),
+                      credentials.exe.empty() ? "unknown executable" : credentials.exe.c_str());
+            done(false, "Executable not allowed to register an agent");
+            return;
+        }
+
+        guint uid = credentials.uid;
+        m_absent_agents.erase(uid);
+
+        auto it = m_agents.find(uid);
+        if (it != m_agents.end()) {
+            if (it->second.watch_id != 0) {
+                g_bus_unwatch_name(it->second.watch_id);
+            }
+            m_agents.erase(it);
+        }
+
+        // A different agent may answer differently: forget what the old one said
+        invalidate_uid_for_agent(uid, agent_id);
+
+        Agent agent;
+        agent.agent_id = agent_id;
+        agent.bus_name = peer;
+        agent.watch_id = g_bus_watch_name_on_connection(
+            m_connection, peer.c_str(), G_BUS_NAME_WATCHER_FLAGS_NONE, nullptr,
+            &AgentAuthorizer::on_agent_vanished, this, nullptr);
+        m_agents[uid] = agent;
+
+        g_message("AgentAuthorizer: agent %s (%s, %s) registered for uid %u", agent_id.c_str(),
+                  peer.c_str(), credentials.exe.c_str(), uid);
+        save_decisions();
+        done(true, "");
+    });
+}
+
+void AgentAuthorizer::authorize(const std::string &peer, const std::string &desktop_id,
+                                guint accuracy_level, Callback done) {
+    guint level = accuracy_level != 0 ? accuracy_level : DEFAULT_ACCURACY_LEVEL;
+
+    // No agents at all is the common case on Sailfish: skip the uid lookup
+    if (m_agents.empty() && m_absent_agents.empty()) {
+        ++m_no_agent;
+        done(true, level);
+        return;
+    }
+
+    m_credentials.lookup(peer, [this, desktop_id, accuracy_level,
+                                done](bool ok, const PeerCredentials &credentials) {
+        if (!ok || !credentials.has_uid) {
+            ++m_denied;
+            done(false, 0);
+            return;
+        }
+        authorize_peer(credentials, desktop_id, accuracy_level, done);
+    });
+}
+
+void AgentAuthorizer::authorize_peer(const PeerCredentials &credentials,
+                                     const std::string &desktop_id, guint accuracy_level,
+                                     Callback done) {
+    guint uid = credentials.uid;
+    guint level = accuracy_level != 0 ? accuracy_level : DEFAULT_ACCURACY_LEVEL;
+
+    // An agent that went away still decides through its cached answers
+    const std::string *agent_id = nullptr;
+    auto agent_it = m_agents.find(uid);
+    if (agent_it != m_agents.end()) {
+        agent_id = &agent_it->second.agent_id;
+    } else {
+        auto absent_it = m_absent_agents.find(uid);
+        if (absent_it == m_absent_agents.end() ||
+            BridgeConfig::current().agent_whitelist.empty()) {
+            ++m_no_agent;
+            done(true, level);
+            return;
+        }
+        agent_id = &absent_it->second;
+    }
+
+    // Decisions hold for the executable that asked; one of unknown
+    // executable is not cached (see query_agent())
+    DecisionKey key(uid, credentials.exe, desktop_id, level);
+
+    auto it = m_decisions.find(key);
+    if (it != m_decisions.end()) {
+        bool valid = it->second.agent_id == *agent_id && it->second.expires > wall_clock_s();
+        if (valid) {
+            ++m_cache_hits;
+            finish(key, it->second.authorized, it->second.allowed_accuracy_level, done);
+            return;
+        }
+        m_decisions.erase(it);
+    }
+
+    ++m_cache_misses;
+
+    // Fail closed while the agent is away
+    if (agent_it == m_agents.end()) {
+        ++m_agent_absent;
+        ++m_denied;
+        done(false, 0);
+        return;
+    }
+
+    // Only the first caller for a key talks to the agent
+    auto &waiters = m_pending[key];
+    waiters.push_back(std::move(done));
+    if (waiters.size() == 1) {
+        query_agent(agent_it->second, key);
+    }
+}
+
+void AgentAuthorizer::query_agent(const Agent &agent, const DecisionKey &key) {
+    struct QueryData {
+        DecisionKey key;
+        std::string agent_id;
+    };
+    auto *call = new AsyncCall<QueryData>{this, {key, agent.agent_id}};
+
+    g_dbus_connection_call(
+        m_connection, agent.bus_name.c_str(), "/org/freedesktop/GeoClue2/Agent",
+        "org.freedesktop.GeoClue2.Agent", "AuthorizeApp",
+        g_variant_new("(su)", std::get<2>(key).c_str(), std::get<3>(key)),
+        G_VARIANT_TYPE("(bu)"), G_DBUS_CALL_FLAGS_NONE, -1, m_cancellable,
+        [](GObject *source, GAsyncResult *res, gpointer user_data) {
+            auto *call = static_cast<AsyncCall<QueryData> *>(user_data);
+            GError *error = nullptr;
+            GVariant *result =
+                g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+
+            if (!result) {
+                if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+                    g_error_free(error);
+                    delete call;
+                    return;
+                }
+
+                // Not cached: a broken agent should not pin a denial
+                g_warning("AgentAuthorizer: AuthorizeApp(%s) failed: %s",
+                          std::get<2>(call->data.key).c_str(), error->message);
+                g_error_free(error);
+                ++call->self->m_agent_errors;
+                call->self->finish_pending(call->data.key, false, 0);
+                delete call;
+                return;
+            }
+
+            gboolean authorized = FALSE;
+            guint allowed_level = 0;
+            g_variant_get(result, "(bu)", &authorized, &allowed_level);
+            g_variant_unref(result);
+
+            // Without its executable a decision could be reused by another app
+            bool cacheable = !std::get<1>(call->data.key).empty();
+            if (cacheable) {
+                Decision decision;
+                decision.agent_id = call->data.agent_id;
+                decision.authorized = authorized;
+                decision.allowed_accuracy_level = allowed_level;
+                decision.expires =
+                    wall_clock_s() + (authorized ? AUTH_ALLOW_TTL_S : AUTH_DENY_TTL_S);
+                call->self->m_decisions[call->data.key] = decision;
+            }
+
+            call->self->finish_pending(call->data.key, authorized, allowed_level);
+            if (cacheable) {
+                call->self->save_decisions();
+            }
+            delete call;
+        },
+        call);
+}
+
+void AgentAuthorizer::finish_pending(const DecisionKey &key, bool authorized,
+                                     guint allowed_accuracy_level) {
+    auto it = m_pending.find(key);
+    if (it == m_pending.end()) {
+        return;
+    }
+
+    std::vector<Callback> waiters = std::move(it->second);
+    m_pending.erase(it);
+
+    for (auto &done : waiters) {
+        finish(key, authorized, allowed_accuracy_level, done);
+    }
+}
+
+void AgentAuthorizer::finish(const DecisionKey &key, bool authorized,
+                             guint allowed_accuracy_level, const Callback &done) {
+    // Allowed, but coarser than the client asked for
+    if (authorized && allowed_accuracy_level < std::get<3>(key)) {
+        authorized = false;
+    }
+
+    if (!authorized) {
+        ++m_denied;
+    }
+    done(authorized, allowed_accuracy_level);
+}
+
+void AgentAuthorizer::invalidate_uid_for_agent(guint uid, const std::string &agent_id) {
+    bool changed = false;
+    for (auto it = m_decisions.begin(); it != m_decisions.end();) {
+        if (std::get<0>(it->first) == uid && it->second.agent_id != agent_id) {
+            it = m_decisions.erase(it);
+            changed = true;
+        } else {
+            ++it;
+        }
+    }
+
+    if (changed) {
+        g_message("AgentAuthorizer: agent for uid %u changed, cached decisions dropped", uid);
+        save_decisions();
+    }
+}
+
+gsize AgentAuthorizer::trim_cache() {
+    gint64 now = wall_clock_s();
+    gsize dropped = 0;
+    // Only expired decisions: a uid whose agent is away still owns its
+    // unexpired answers, which the next save would otherwise lose for good
+    for (auto it = m_decisions.begin(); it != m_decisions.end();) {
+        if (it->second.expires <= now) {
+            it = m_decisions.erase(it);
+            ++dropped;
+        } else {
+            ++it;
+        }
+    }
+    return dropped;
+}
+
+void AgentAuthorizer::load_decisions() {
+    GKeyFile *store = g_key_file_new();
+    if (!g_key_file_load_from_file(store, m_store_path.c_str(), G_KEY_FILE_NONE, nullptr)) {
+        g_key_file_free(store);
+        return;
+    }
+
+    gint64 now = wall_clock_s();
+    gsize n_groups = 0;
+    gchar **groups = g_key_file_get_groups(store, &n_groups);
+
+    for (gsize i = 0; i < n_groups; ++i) {
+        const gchar *group = groups[i];
+
+        // Uids that had an agent: none is registered yet after a restart
+        if (g_str_has_prefix(group, "agent-")) {
+            gchar *agent_id = g_key_file_get_string(store, group, "agent", nullptr);
+            if (agent_id) {
+                guint uid = g_key_file_get_integer(store, group, "uid", nullptr);
+                m_absent_agents[uid] = agent_id;
+                g_free(agent_id);
+            }
+            continue;
+        }
+
+        Decision decision;
+        decision.expires = g_key_file_get_int64(store, group, "expires", nullptr);
+        if (decision.expires <= now) {
+            continue;
+        }
+
+        // Decisions stored before they were bound to an executable lack "exe"
+        // and are asked again
+        gchar *agent_id = g_key_file_get_string(store, group, "agent", nullptr);
+        gchar *exe = g_key_file_get_string(store, group, "exe", nullptr);
+        gchar *desktop_id = g_key_file_get_string(store, group, "desktop-id", nullptr);
+        if (!agent_id || !exe || !*exe || !desktop_id) {
+            g_free(agent_id);
+            g_free(exe);
+            g_free(desktop_id);
+            continue;
+        }
+
+        decision.agent_id = agent_id;
+        decision.authorized = g_key_file_get_boolean(store, group, "authorized", nullptr);
+        decision.allowed_accuracy_level =
+            g_key_file_get_integer(store, group, "allowed-accuracy", nullptr);
+
+        guint uid = g_key_file_get_integer(store, group, "uid", nullptr);
+        guint level = g_key_file_get_integer(store, group, "accuracy", nullptr);
+        m_decisions[DecisionKey(uid, exe, desktop_id, level)] = decision;
+
+        g_free(agent_id);
+        g_free(exe);
+        g_free(desktop_id);
+    }
+
+    g_strfreev(groups);
+    g_key_file_free(store);
+
+    g_message("AgentAuthorizer: loaded %zu cached decisions from %s", m_decisions.size(),
+              m_store_path.c_str());
+}
+
+void AgentAuthorizer::save_decisions() const {
+    GKeyFile *store = g_key_file_new();
+    gint64 now = wall_clock_s();
+    guint index = 0;
+
+    for (const auto &pair : m_decisions) {
+        if (pair.second.expires <= now) {
+            continue;
+        }
+
+        gchar *group = g_strdup_printf("decision-%u", index++);
+        g_key_file_set_integer(store, group, "uid", std::get<0>(pair.first));
+        g_key_file_set_string(store, group, "exe", std::get<1>(pair.first).c_str());
+        g_key_file_set_string(store, group, "desktop-id", std::get<2>(pair.first).c_str());
+        g_key_file_set_integer(store, group, "accuracy", std::get<3>(pair.first));
+        g_key_file_set_string(store, group, "agent", pair.second.agent_id.c_str());
+        g_key_file_set_boolean(store, group, "authorized", pair.second.authorized);
+        g_key_file_set_integer(store, group, "allowed-accuracy",
+                               pair.second.allowed_accuracy_level);
+        g_key_file_set_int64(store, group, "expires", pair.second.expires);
+        g_free(group);
+    }
+
+    auto save_agent = [store](guint uid, const std::string &agent_id) {
+        gchar *group = g_strdup_printf("agent-%u", uid);
+        g_key_file_set_integer(store, group, "uid", uid);
+        g_key_file_set_string(store, group, "agent", agent_id.c_str());
+        g_free(group);
+    };
+    for (const auto &pair : m_agents) {
+        save_agent(pair.first, pair.second.agent_id);
+    }
+    for (const auto &pair : m_absent_agents) {
+        save_agent(pair.first, pair.second);
+    }
+
+    gchar *dir = g_path_get_dirname(m_store_path.c_str());
+    g_mkdir_with_parents(dir, 0700);
+    g_free(dir);
+
+    GError *error = nullptr;
+    if (!g_key_file_save_to_file(store, m_store_path.c_str(), &error)) {
+        g_warning("AgentAuthorizer: failed to save %s: %s", m_store_path.c_str(), error->message);
+        g_error_free(error);
+    }
+
+    g_key_file_free(store);
+}
+
+void AgentAuthorizer::collect_stats(GVariantBuilder *stats) const {
+    guint64 lookups = m_cache_hits + m_cache_misses;
+
+    g_variant_builder_add(stats, "{sv}", "auth.agents", g_variant_new_uint32(m_agents.size()));
+    g_variant_builder_add(stats, "{sv}", "auth.cached_decisions",
+                          g_variant_new_uint32(m_decisions.size()));
+    g_variant_builder_add(stats, "{sv}", "auth.cache_hits", g_variant_new_uint64(m_cache_hits));
+    g_variant_builder_add(stats, "{sv}", "auth.cache_misses",
+                          g_variant_new_uint64(m_cache_misses));
+    g_variant_builder_add(stats, "{sv}", "auth.hit_rate",
+                          g_variant_new_double(lookups ? (double)m_cache_hits / lookups : 0.0));
+    g_variant_builder_add(stats, "{sv}", "auth.no_agent", g_variant_new_uint64(m_no_agent));
+    g_variant_builder_add(stats, "{sv}", "auth.denied", g_variant_new_uint64(m_denied));
+    g_variant_builder_add(stats, "{sv}", "auth.agent_errors",
+                          g_variant_new_uint64(m_agent_errors));
+    g_variant_builder_add(stats, "{sv}", "auth.rejected_agents",
+                          g_variant_new_uint64(m_rejected_agents));
+    g_variant_builder_add(stats, "{sv}", "auth.absent_agents",
+                          g_variant_new_uint32(m_absent_agents.size()));
+    g_variant_builder_add(stats, "{sv}", "auth.agent_absent",
+                          g_variant_new_uint64(m_agent_absent));
+}
+
+/* static */ void AgentAuthorizer::on_agent_vanished(GDBusConnection * /*connection*/,
+                                                     const gchar *name, gpointer user_data) {
+    auto *self = static_cast<AgentAuthorizer *>(user_data);
+
+    for (auto it = self->m_agents.begin(); it != self->m_agents.end(); ++it) {
+        if (it->second.bus_name == name) {
+            g_message("AgentAuthorizer: agent %s for uid %u vanished, only its cached "
+                      "decisions apply until an agent registers",
+                      name, it->first);
+            // Keep the cached decisions: the same agent re-registering after a
+            // restart should not cause a round of prompts
+            g_bus_unwatch_name(it->second.watch_id);
+            self->m_absent_agents[it->first] = it->second.agent_id;
+            self->m_agents.erase(it);
+            return;
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "peer_credentials.h"
+
+/**
+ * GeoClue2 agent authorization with a cached decision store.
+ *
+ * Agents register through Manager.AddAgent() and are kept per uid. Only
+ * executables in the [agent] whitelist of the configuration may register:
+ * on Sailfish every app runs as the same uid, so an app must not become the
+ * agent that approves its own Start(). When a client of that uid calls
+ * Start(), the agent's
+ * org.freedesktop.GeoClue2.Agent.AuthorizeApp(desktop_id, accuracy_level) is
+ * consulted once and the answer is cached per (uid, executable, DesktopId,
+ * accuracy level) with a TTL. The DesktopId is chosen by the client, so a
+ * decision only applies to the executable it was made for. Decisions are
+ * persisted across restarts and dropped when a different agent registers
+ * for the uid. A client is only authorized if the agent allows at least the
+ * accuracy level it requested: Locations are shared by all clients, so a
+ * fix cannot be coarsened for one of them.
+ *
+ * Without an agent for the uid every client is allowed, as before agent
+ * support existed. A uid whose agent went away (crashed or was killed) is
+ * not: until an agent registers again only its cached decisions apply, so
+ * killing the agent does not bypass it. The uids that had an agent are
+ * persisted with the decisions. With an empty [agent] whitelist no agent can
+ * register, and they are ignored.
+ */
+
+// Accuracy level a client that left RequestedAccuracyLevel at 0 asks for
+const guint DEFAULT_ACCURACY_LEVEL = 8; // EXACT
+
+class AgentAuthorizer {
+  public:
+    // allowed_accuracy_level is only meaningful when authorized is true, and
+    // then at least the requested level (DEFAULT_ACCURACY_LEVEL for 0)
+    using Callback = std::function<void(bool authorized, guint allowed_accuracy_level)>;
+
+    // Result of add_agent(); `error` says why a registration was refused
+    using AddCallback = std::function<void(bool registered, const std::string &error)>;
+
+    // Peer uids are looked up in `credentials`, which must outlive this object
+    AgentAuthorizer(GDBusConnection *connection, PeerCredentialCache &credentials);
+    ~AgentAuthorizer();
+
+    // Non-copyable
+    AgentAuthorizer(const AgentAuthorizer &) = delete;
+    AgentAuthorizer &operator=(const AgentAuthorizer &) = delete;
+
+    // Register the agent at unique name `peer` for the uid owning it; calls
+    // back once it is registered or refused
+    void add_agent(const std::string &peer, const std::string &agent_id, AddCallback done);
+
+    // Decide whether `peer` may start a client; calls back synchronously on
+    // cache hits and when no agent is registered for the uid
+    void authorize(const std::string &peer, const std::string &desktop_id,
+                   guint accuracy_level, Callback done);
+
+    // Memory pressure: forget expired decisions. Returns the number dropped.
+    gsize trim_cache();
+
+    // Add authorization counters to a stats a{sv}
+    void collect_stats(GVariantBuilder *stats) const;
+
+  private:
+    struct Agent {
+        std::string agent_id;
+        std::string bus_name;
+        guint watch_id = 0;
+    };
+
+    struct Decision {
+        std::string agent_id;
+        bool authorized = false;
+        guint allowed_accuracy_level = 0;
+        gint64 expires = 0; // wall clock, seconds
+    };
+
+    // (uid, executable, DesktopId, accuracy level)
+    using DecisionKey = std::tuple<guint, std::string, std::string, guint>;
+
+    GDBusConnection *m_connection;
+    PeerCredentialCache &m_credentials;
+    GCancellable *m_cancellable = nullptr;
+    std::string m_store_path;
+
+    std::unordered_map<guint, Agent> m_agents;
+    std::map<DecisionKey, Decision> m_decisions;
+
+    // Agent id of uids whose agent went away, until one registers again
+    std::unordered_map<guint, std::string> m_absent_agents;
+
+    // Callers waiting for an AuthorizeApp answer, coalesced per key
+    std::map<DecisionKey, std::vector<Callback>> m_pending;
+
+    guint64 m_cache_hits = 0;
+    guint64 m_cache_misses = 0;
+    guint64 m_no_agent = 0;
+    guint64 m_denied = 0;
+    guint64 m_agent_errors = 0;
+    guint64 m_rejected_agents = 0;
+    guint64 m_agent_absent = 0;
+
+    void authorize_peer(const PeerCredentials &credentials, const std::string &desktop_id,
+                        guint accuracy_level, Callback done);
+    void query_agent(const Agent &agent, const DecisionKey &key);
+    void finish_pending(const DecisionKey &key, bool authorized, guint allowed_accuracy_level);
+    void finish(const DecisionKey &key, bool authorized, guint allowed_accuracy_level,
+                const Callback &done);
+    void invalidate_uid_for_agent(guint uid, const std::string &agent_id);
+
+    // Persistence
+    void load_decisions();
+    void save_decisions() const;
+
+    static void on_agent_vanished(GDBusConnection *connection, const gchar *name,
+                                  gpointer user_data);
+};
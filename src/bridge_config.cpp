@@ -0,0 +1,454 @@
+#include "bridge_config.h"
+#include "clock.h"
+#include "loop_monitor.h"
+
+#include <glib/gstdio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+/**
+ * Implementation of the configuration file and its monitor.
+ */
+
+// Group prefix of per-DesktopId settings
+const char *const APPLICATION_GROUP_PREFIX = "application ";
+
+// Group prefix of per-QoS-class settings
+const char *const CLASS_GROUP_PREFIX = "class ";
+
+// Longest accepted batch-ms of a QoS class
+const guint MAX_BATCH_MS = 3600 * 1000;
+
+// Highest accepted max-rate, in fixes per second
+const double MAX_RATE_LIMIT_HZ = 1000.0;
+
+// Editors save in several steps (truncate, write, rename); read the files
+// once they settled
+const guint RELOAD_DELAY_MS = 200;
+
+namespace {
+
+struct UintKey {
+    const char *group;
+    const char *key;
+    guint BridgeConfig::*field;
+    guint min;
+    guint max;
+};
+
+const UintKey UINT_KEYS[] = {
+    {"retention", "depth", &BridgeConfig::retention_depth, 1, 10000},
+    {"retention", "pressure-depth", &BridgeConfig::pressure_retention_depth, 1, 10000},
+    {"fusion", "velocity-fresh-steps", &BridgeConfig::velocity_fresh_steps, 0, 100},
+    {"delivery", "slow-unread-limit", &BridgeConfig::slow_unread_limit, 1, 100000},
+    {"delivery", "slow-trickle-s", &BridgeConfig::slow_trickle_s, 1, 24 * 3600},
+    {"grace", "timeout-ms", &BridgeConfig::grace_timeout_ms, 0, 24 * 3600 * 1000},
+};
+
+std::shared_ptr<const BridgeConfig> &installed_config() {
+    static std::shared_ptr<const BridgeConfig> config;
+    return config;
+}
+
+bool read_uint(GKeyFile *file, const char *group, const char *key, guint min, guint max,
+               guint *result, GError **error) {
+    GError *parse_error = nullptr;
+    guint64 value = g_key_file_get_uint64(file, group, key, &parse_error);
+    if (parse_error || value < min || value > max) {
+        g_clear_error(&parse_error);
+        g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                    "[%s] %s must be a whole number from %u to %u", group, key, min, max);
+        return false;
+    }
+
+    *result = (guint)value;
+    return true;
+}
+
+bool read_bool(GKeyFile *file, const char *group, const char *key, bool *result,
+               GError **error) {
+    GError *parse_error = nullptr;
+    gboolean value = g_key_file_get_boolean(file, group, key, &parse_error);
+    if (parse_error) {
+        g_clear_error(&parse_error);
+        g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                    "[%s] %s must be true or false", group, key);
+        return false;
+    }
+
+    *result = value;
+    return true;
+}
+
+// QosClassId of the value of `key`, which names a class
+bool read_class(const BridgeConfig &config, GKeyFile *file, const char *group, const char *key,
+                guint *result, GError **error) {
+    gchar *name = g_key_file_get_string(file, group, key, nullptr);
+    for (guint id = 0; name && id < QOS_CLASS_COUNT; ++id) {
+        if (g_str_equal(config.qos_classes[id].name, name)) {
+            *result = id;
+            g_free(name);
+            return true;
+        }
+    }
+
+    g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                "[%s] %s must be realtime, interactive, background or batch", group, key);
+    g_free(name);
+    return false;
+}
+
+bool merge_rate(GKeyFile *file, const char *group, double *rate_hz, GError **error) {
+    GError *parse_error = nullptr;
+    double value = g_key_file_get_double(file, group, "max-rate", &parse_error);
+    if (parse_error || !(value >= 0.0 && value <= MAX_RATE_LIMIT_HZ)) {
+        g_clear_error(&parse_error);
+        g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                    "[%s] max-rate must be a number from 0 to %g", group, MAX_RATE_LIMIT_HZ);
+        return false;
+    }
+
+    *rate_hz = value;
+    return true;
+}
+
+bool read_whitelist(GKeyFile *file, const char *group, const char *key,
+                    std::vector<std::string> *result, GError **error) {
+    gchar **paths = g_key_file_get_string_list(file, group, key, nullptr, nullptr);
+    for (gchar **path = paths; path && *path; ++path) {
+        if (!g_path_is_absolute(*path)) {
+            g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                        "[%s] %s must list absolute paths of executables", group, key);
+            g_strfreev(paths);
+            return false;
+        }
+    }
+
+    result->clear();
+    for (gchar **path = paths; path && *path; ++path) {
+        result->push_back(*path);
+    }
+    g_strfreev(paths);
+    return true;
+}
+
+// A key of a [class <name>] group
+bool merge_class_key(BridgeConfig *config, GKeyFile *file, const char *path, const char *group,
+                     const char *key, GError **error) {
+    BridgeConfig::QosClass *qos = nullptr;
+    for (BridgeConfig::QosClass &candidate : config->qos_classes) {
+        if (g_str_equal(candidate.name, group + strlen(CLASS_GROUP_PREFIX))) {
+            qos = &candidate;
+        }
+    }
+
+    if (!qos) {
+        g_warning("%s: ignoring unknown class [%s]", path, group);
+    } else if (g_str_equal(key, "priority")) {
+        return read_uint(file, group, key, 0, 100, &qos->priority, error);
+    } else if (g_str_equal(key, "max-rate")) {
+        return merge_rate(file, group, &qos->max_rate_hz, error);
+    } else if (g_str_equal(key, "coalesce")) {
+        return read_bool(file, group, key, &qos->coalesce, error);
+    } else if (g_str_equal(key, "batch-ms")) {
+        return read_uint(file, group, key, 0, MAX_BATCH_MS, &qos->batch_ms, error);
+    } else if (g_str_equal(key, "deferred")) {
+        return read_bool(file, group, key, &qos->deferred, error);
+    } else {
+        g_warning("%s: ignoring unknown key [%s] %s", path, group, key);
+    }
+    return true;
+}
+
+bool merge_key(BridgeConfig *config, GKeyFile *file, const char *path, const char *group,
+               const char *key, GError **error) {
+    for (const UintKey &spec : UINT_KEYS) {
+        if (g_str_equal(spec.group, group) && g_str_equal(spec.key, key)) {
+            return read_uint(file, group, key, spec.min, spec.max, &(config->*spec.field),
+                             error);
+        }
+    }
+
+    if (g_str_has_prefix(group, CLASS_GROUP_PREFIX)) {
+        return merge_class_key(config, file, path, group, key, error);
+    }
+    if (g_str_equal(group, "agent") && g_str_equal(key, "whitelist")) {
+        return read_whitelist(file, group, key, &config->agent_whitelist, error);
+    }
+    if (g_str_equal(group, "qos") && g_str_equal(key, "default-class")) {
+        return read_class(*config, file, group, key, &config->default_qos_class, error);
+    }
+    if (g_str_has_prefix(group, APPLICATION_GROUP_PREFIX) && g_str_equal(key, "class")) {
+        const char *desktop_id = group + strlen(APPLICATION_GROUP_PREFIX);
+        guint qos_class = 0;
+        if (!read_class(*config, file, group, key, &qos_class, error)) {
+            return false;
+        }
+        config->applications[desktop_id].qos_class = (gint)qos_class;
+        return true;
+    }
+
+    if (g_str_equal(key, "max-rate")) {
+        if (g_str_equal(group, "delivery")) {
+            return merge_rate(file, group, &config->max_rate_hz, error);
+        }
+        if (g_str_has_prefix(group, APPLICATION_GROUP_PREFIX)) {
+            const char *desktop_id = group + strlen(APPLICATION_GROUP_PREFIX);
+            return merge_rate(file, group, &config->applications[desktop_id].max_rate_hz,
+                              error);
+        }
+    }
+
+    g_warning("%s: ignoring unknown key [%s] %s", path, group, key);
+    return true;
+}
+
+} // namespace
+
+guint BridgeConfig::qos_class_of(const std::string &desktop_id) const {
+    auto it = applications.find(desktop_id);
+    if (it != applications.end() && it->second.qos_class >= 0) {
+        return (guint)it->second.qos_class;
+    }
+    return default_qos_class;
+}
+
+gint64 BridgeConfig::min_delivery_interval_us(const std::string &desktop_id) const {
+    // The application's own cap, else its class's, else the [delivery] one
+    double rate_hz = qos_classes[qos_class_of(desktop_id)].max_rate_hz;
+    auto it = applications.find(desktop_id);
+    if (it != applications.end() && it->second.max_rate_hz >= 0.0) {
+        rate_hz = it->second.max_rate_hz;
+    }
+    if (rate_hz < 0.0) {
+        rate_hz = max_rate_hz;
+    }
+    return rate_hz > 0.0 ? (gint64)(G_USEC_PER_SEC / rate_hz) : 0;
+}
+
+bool BridgeConfig::merge_file(const char *path, GError **error) {
+    GKeyFile *file = g_key_file_new();
+    bool ok = g_key_file_load_from_file(file, path, G_KEY_FILE_NONE, error);
+
+    gchar **groups = ok ? g_key_file_get_groups(file, nullptr) : nullptr;
+    for (gchar **group = groups; ok && group && *group; ++group) {
+        gchar **keys = g_key_file_get_keys(file, *group, nullptr, nullptr);
+        for (gchar **key = keys; ok && keys && *key; ++key) {
+            ok = merge_key(this, file, path, *group, *key, error);
+        }
+        g_strfreev(keys);
+    }
+    g_strfreev(groups);
+    g_key_file_free(file);
+
+    if (!ok) {
+        g_prefix_error(error, "%s: ", path);
+    }
+    return ok;
+}
+
+bool BridgeConfig::validate(GError **error) const {
+    if (pressure_retention_depth > retention_depth) {
+        g_set_error(error, G_KEY_FILE_ERROR, G_KEY_FILE_ERROR_INVALID_VALUE,
+                    "[retention] pressure-depth %u exceeds depth %u", pressure_retention_depth,
+                    retention_depth);
+        return false;
+    }
+    return true;
+}
+
+/* static */ const BridgeConfig &BridgeConfig::current() {
+    static const BridgeConfig defaults;
+    const std::shared_ptr<const BridgeConfig> &config = installed_config();
+    return config ? *config : defaults;
+}
+
+/* static */ void BridgeConfig::install(std::shared_ptr<const BridgeConfig> config) {
+    installed_config() = std::move(config);
+}
+
+std::string bridge_state_path(const char *name) {
+#if GLIB_CHECK_VERSION(2, 72, 0)
+    const gchar *state_dir = g_get_user_state_dir();
+#else
+    const gchar *state_dir = g_getenv("XDG_STATE_HOME");
+    gchar *fallback = nullptr;
+    if (!state_dir || !g_path_is_absolute(state_dir)) {
+        fallback = g_build_filename(g_get_home_dir(), ".local", "state", nullptr);
+        state_dir = fallback;
+    }
+#endif
+    gchar *path = g_build_filename(state_dir, "geoclue2to1", name, nullptr);
+#if !GLIB_CHECK_VERSION(2, 72, 0)
+    g_free(fallback);
+#endif
+
+    // Versions before the state directory kept these files in the cache
+    if (!g_file_test(path, G_FILE_TEST_EXISTS)) {
+        gchar *legacy = g_build_filename(g_get_user_cache_dir(), "geoclue2to1", name, nullptr);
+        if (g_file_test(legacy, G_FILE_TEST_EXISTS)) {
+            gchar *dir = g_path_get_dirname(path);
+            g_mkdir_with_parents(dir, 0700);
+            g_free(dir);
+            if (g_rename(legacy, path) != 0) {
+                g_warning("Cannot move %s to %s: %s", legacy, path, g_strerror(errno));
+            }
+        }
+        g_free(legacy);
+    }
+
+    std::string result = path;
+    g_free(path);
+    return result;
+}
+
+ConfigMonitor::ConfigMonitor(const std::string &path, const BridgeConfig &defaults,
+                             Callback changed)
+    : m_path(path), m_drop_in_dir(path + ".d"), m_defaults(defaults),
+      m_changed(std::move(changed)) {
+    // Both may not exist yet; GLib watches for them to appear
+    m_file_monitor = watch(m_path, false);
+    m_dir_monitor = watch(m_drop_in_dir, true);
+
+    if (!reload()) {
+        // Unusable files still leave the command line's settings in effect
+        auto config = std::make_shared<BridgeConfig>(m_defaults);
+        config->generation = BridgeConfig::current().generation + 1;
+        BridgeConfig::install(config);
+    }
+}
+
+ConfigMonitor::~ConfigMonitor() {
+    if (m_reload_id != 0) {
+        Clock::get().remove(m_reload_id);
+    }
+
+    for (GFileMonitor *monitor : {m_file_monitor, m_dir_monitor}) {
+        if (monitor) {
+            g_signal_handlers_disconnect_by_data(monitor, this);
+            g_file_monitor_cancel(monitor);
+            g_object_unref(monitor);
+        }
+    }
+
+    BridgeConfig::install(nullptr);
+}
+
+GFileMonitor *ConfigMonitor::watch(const std::string &path, bool directory) {
+    GFile *file = g_file_new_for_path(path.c_str());
+    GError *error = nullptr;
+    GFileMonitor *monitor =
+        directory ? g_file_monitor_directory(file, G_FILE_MONITOR_NONE, nullptr, &error)
+                  : g_file_monitor_file(file, G_FILE_MONITOR_NONE, nullptr, &error);
+    g_object_unref(file);
+
+    if (!monitor) {
+        g_warning("ConfigMonitor: cannot watch %s, changes need SIGHUP: %s", path.c_str(),
+                  error->message);
+        g_error_free(error);
+        return nullptr;
+    }
+
+    g_signal_connect(monitor, "changed", G_CALLBACK(&ConfigMonitor::on_file_changed), this);
+    return monitor;
+}
+
+std::vector<std::string> ConfigMonitor::config_files() const {
+    std::vector<std::string> files;
+    if (g_file_test(m_path.c_str(), G_FILE_TEST_EXISTS)) {
+        files.push_back(m_path);
+    }
+
+    GDir *dir = g_dir_open(m_drop_in_dir.c_str(), 0, nullptr);
+    if (!dir) {
+        return files;
+    }
+
+    // Editor backups and package manager leftovers do not end in .conf
+    std::vector<std::string> drop_ins;
+    while (const gchar *name = g_dir_read_name(dir)) {
+        if (g_str_has_suffix(name, ".conf") && name[0] != '.') {
+            drop_ins.push_back(name);
+        }
+    }
+    g_dir_close(dir);
+
+    std::sort(drop_ins.begin(), drop_ins.end());
+    for (const std::string &name : drop_ins) {
+        gchar *file = g_build_filename(m_drop_in_dir.c_str(), name.c_str(), nullptr);
+        files.push_back(file);
+        g_free(file);
+    }
+    return files;
+}
+
+bool ConfigMonitor::reload() {
+    std::vector<std::string> files = config_files();
+
+    auto config = std::make_shared<BridgeConfig>(m_defaults);
+    GError *error = nullptr;
+    bool ok = true;
+    for (const std::string &file : files) {
+        if (!(ok = config->merge_file(file.c_str(), &error))) {
+            break;
+        }
+    }
+    ok = ok && config->validate(&error);
+
+    if (!ok) {
+        ++m_reload_errors;
+        g_warning("ConfigMonitor: keeping the running configuration: %s", error->message);
+        g_error_free(error);
+        return false;
+    }
+
+    config->generation = BridgeConfig::current().generation + 1;
+    BridgeConfig::install(config);
+    m_files = files.size();
+    ++m_reloads;
+
+    g_message("ConfigMonitor: applied %u files (generation %" G_GUINT64_FORMAT
+              "): retention %u/%u, velocity steps %u, max rate %g Hz, grace %u ms, "
+              "%zu applications",
+              m_files, config->generation, config->retention_depth,
+              config->pressure_retention_depth, config->velocity_fresh_steps,
+              config->max_rate_hz, config->grace_timeout_ms, config->applications.size());
+
+    if (m_changed) {
+        m_changed(*config);
+    }
+    return true;
+}
+
+void ConfigMonitor::collect_stats(GVariantBuilder *stats) const {
+    g_variant_builder_add(stats, "{sv}", "config.generation",
+                          g_variant_new_uint64(BridgeConfig::current().generation));
+    g_variant_builder_add(stats, "{sv}", "config.files", g_variant_new_uint32(m_files));
+    g_variant_builder_add(stats, "{sv}", "config.reloads", g_variant_new_uint64(m_reloads));
+    g_variant_builder_add(stats, "{sv}", "config.reload_errors",
+                          g_variant_new_uint64(m_reload_errors));
+}
+
+/* static */ void ConfigMonitor::on_file_changed(GFileMonitor * /*monitor*/, GFile * /*file*/,
+                                                 GFile * /*other_file*/,
+                                                 GFileMonitorEvent /*event_type*/,
+                                                 gpointer user_data) {
+    auto *self = static_cast<ConfigMonitor *>(user_data);
+    if (self->m_reload_id != 0) {
+        Clock::get().remove(self->m_reload_id);
+    }
+    self->m_reload_id =
+        Clock::get().add_timeout(RELOAD_DELAY_MS, &ConfigMonitor::on_reload_timeout, self);
+}
+
+/* static */ gboolean ConfigMonitor::on_reload_timeout(gpointer user_data) {
+    LoopMonitor::Scope timing("Timeout", "ConfigReload");
+
+    auto *self = static_cast<ConfigMonitor *>(user_data);
+    self->m_reload_id = 0;
+    self->reload();
+    return G_SOURCE_REMOVE;
+}
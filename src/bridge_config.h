@@ -0,0 +1,175 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Run-time tuning of the fix pipeline and the GPS power policy.
+ *
+ * Read from /etc/geoclue2to1.conf, then from the *.conf files of
+ * /etc/geoclue2to1.conf.d/ in name order; a later file overrides single
+ * keys of an earlier one:
+ *
+ *     [retention]
+ *     depth=25                 # Locations kept for slow readers
+ *     pressure-depth=5         # the same under memory pressure
+ *
+ *     [fusion]
+ *     velocity-fresh-steps=2   # positions a VelocityChanged is merged into
+ *
+ *     [delivery]
+ *     max-rate=0               # fixes per second per client, 0 = all
+ *     slow-unread-limit=10     # unread updates before a client is slow
+ *     slow-trickle-s=30        # a slow client still gets a fix this often
+ *
+ *     [grace]
+ *     timeout-ms=15000         # GPS kept on after the last client stopped
+ *
+ *     [qos]
+ *     default-class=interactive
+ *
+ *     [class background]       # realtime, interactive, background, batch
+ *     priority=2               # lower is served first within a fix
+ *     max-rate=1               # overrides [delivery] max-rate
+ *     coalesce=true            # coalesce updates of slow readers
+ *     batch-ms=0               # hold fixes, send the latest at the end
+ *     deferred=true            # send after everything else is handled
+ *
+ *     [application org.gnome.Maps]
+ *     class=realtime           # QoS class of this DesktopId
+ *     max-rate=1               # overrides the class and [delivery]
+ *
+ *     [agent]
+ *     whitelist=/usr/bin/lipstick;  # executables that may call AddAgent
+ *
+ * ConfigMonitor watches the files and re-reads all of them after a change.
+ * The new configuration is built completely before it replaces the running
+ * one, so every fix is handled under one consistent set of values, and a
+ * file with an error leaves the running configuration as it was.
+ */
+
+// QoS classes, assigned per DesktopId
+enum QosClassId : guint {
+    QOS_REALTIME,
+    QOS_INTERACTIVE,
+    QOS_BACKGROUND,
+    QOS_BATCH,
+    QOS_CLASS_COUNT
+};
+
+struct BridgeConfig {
+    struct QosClass {
+        const char *name;
+        guint priority;
+        double max_rate_hz; // -1 = [delivery] max-rate
+        bool coalesce;
+        guint batch_ms;
+        bool deferred;
+    };
+
+    guint retention_depth = 25;
+    guint pressure_retention_depth = 5;
+    guint velocity_fresh_steps = 2;
+    double max_rate_hz = 0.0;
+    guint slow_unread_limit = 10;
+    guint slow_trickle_s = 30;
+    guint grace_timeout_ms = 15000;
+
+    // [class <name>] groups, indexed by QosClassId. Navigation gets every
+    // fix first; background apps get at most one a second, after everyone
+    // else; batch apps get the latest fix every 30 s.
+    std::array<QosClass, QOS_CLASS_COUNT> qos_classes = {{
+        {"realtime", 0, -1.0, false, 0, false},
+        {"interactive", 1, -1.0, true, 0, false},
+        {"background", 2, 1.0, true, 0, true},
+        {"batch", 3, -1.0, true, 30000, true},
+    }};
+    guint default_qos_class = QOS_INTERACTIVE;
+
+    // [application <DesktopId>] groups
+    struct Application {
+        double max_rate_hz = -1.0; // -1 = the class's max-rate
+        gint qos_class = -1;       // -1 = [qos] default-class
+    };
+    std::unordered_map<std::string, Application> applications;
+
+    // [agent] whitelist: executables allowed to register as the authorizing
+    // agent of their uid. Empty: no agents, every client is allowed.
+    std::vector<std::string> agent_whitelist;
+
+    // Bumped by every applied reload, so that users may cache lookups
+    guint64 generation = 0;
+
+    // QosClassId of a client of `desktop_id`
+    guint qos_class_of(const std::string &desktop_id) const;
+
+    // Shortest time between two fixes sent to a client of `desktop_id`,
+    // 0 without a rate cap
+    gint64 min_delivery_interval_us(const std::string &desktop_id) const;
+
+    // Apply the keys of one file over the current values. Unknown keys are
+    // logged and skipped; values of the wrong type or out of range fail.
+    bool merge_file(const char *path, GError **error);
+
+    // Checks across keys, once all files are merged
+    bool validate(GError **error) const;
+
+    // The configuration in effect: the one last installed, or the defaults
+    static const BridgeConfig &current();
+
+    // Replace the configuration in effect; nullptr goes back to the defaults
+    static void install(std::shared_ptr<const BridgeConfig> config);
+};
+
+// Path of `name` in the bridge's directory under $XDG_STATE_HOME, for data
+// that must survive cache cleaning. A file left in the cache directory by
+// an older version is moved there on first use.
+std::string bridge_state_path(const char *name);
+
+class ConfigMonitor {
+  public:
+    using Callback = std::function<void(const BridgeConfig &config)>;
+
+    // Watch `path` and the drop-ins in `path`.d/ and install what they hold
+    // over `defaults`; `changed` runs after each applied (re)load
+    ConfigMonitor(const std::string &path, const BridgeConfig &defaults, Callback changed);
+    ~ConfigMonitor();
+
+    // Non-copyable
+    ConfigMonitor(const ConfigMonitor &) = delete;
+    ConfigMonitor &operator=(const ConfigMonitor &) = delete;
+
+    // Read all files again now (SIGHUP); false keeps the running configuration
+    bool reload();
+
+    // Add config.* entries to a stats a{sv}
+    void collect_stats(GVariantBuilder *stats) const;
+
+  private:
+    std::string m_path;
+    std::string m_drop_in_dir;
+    BridgeConfig m_defaults;
+    Callback m_changed;
+
+    GFileMonitor *m_file_monitor = nullptr;
+    GFileMonitor *m_dir_monitor = nullptr;
+    guint m_reload_id = 0;
+
+    guint m_files = 0;
+    guint64 m_reloads = 0;
+    guint64 m_reload_errors = 0;
+
+    std::vector<std::string> config_files() const;
+    GFileMonitor *watch(const std::string &path, bool directory);
+
+    static void on_file_changed(GFileMonitor *monitor, GFile *file, GFile *other_file,
+                                GFileMonitorEvent event_type, gpointer user_data);
+    static gboolean on_reload_timeout(gpointer user_data);
+};
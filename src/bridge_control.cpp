@@ -0,0 +1,143 @@
+#include "bridge_control.h"
+#include "dbus_interfaces.h"
+#include "log.h"
+#include "loop_monitor.h"
+#include "trace_ring.h"
+
+#include <utility>
+
+/**
+ * Implementation of the bridge control object.
+ *
+ * Stats providers are plain callbacks; each subsystem owns its counters and
+ * only formats them when GetStats() is called, so nothing is paid on the
+ * fix path for exposing them.
+ */
+
+BridgeControl::BridgeControl(GDBusConnection *connection)
+    : m_connection(connection), m_credentials(std::make_unique<PeerCredentialCache>(connection)) {
+    g_return_if_fail(connection != nullptr);
+
+    static const GDBusInterfaceVTable vtable = {&BridgeControl::on_method_call, nullptr, nullptr,
+                                                {}};
+
+    GError *error = nullptr;
+    m_registration_id = g_dbus_connection_register_object(
+        m_connection, BRIDGE_CONTROL_OBJECT_PATH, bridge_control_interface_info(), &vtable, this,
+        nullptr, &error);
+
+    if (m_registration_id == 0) {
+        g_warning("Failed to export bridge control at %s: %s", BRIDGE_CONTROL_OBJECT_PATH,
+                  error ? error->message : "unknown error");
+        if (error) {
+            g_error_free(error);
+        }
+        return;
+    }
+
+    g_message("BridgeControl exported at %s", BRIDGE_CONTROL_OBJECT_PATH);
+}
+
+BridgeControl::~BridgeControl() {
+    if (m_registration_id != 0) {
+        g_dbus_connection_unregister_object(m_connection, m_registration_id);
+        m_registration_id = 0;
+    }
+}
+
+void BridgeControl::add_stats_provider(StatsProvider provider) {
+    m_stats_providers.push_back(std::move(provider));
+}
+
+GVariant *BridgeControl::collect_stats() const {
+    GVariantBuilder stats;
+    g_variant_builder_init(&stats, G_VARIANT_TYPE_VARDICT);
+
+    for (const auto &provider : m_stats_providers) {
+        provider(&stats);
+    }
+
+    return g_variant_builder_end(&stats);
+}
+
+/* static */ void BridgeControl::on_method_call(GDBusConnection * /*connection*/,
+                                                const gchar * /*sender*/,
+                                                const gchar * /*object_path*/,
+                                                const gchar * /*interface_name*/,
+                                                const gchar *method_name, GVariant *parameters,
+                                                GDBusMethodInvocation *invocation,
+                                                gpointer user_data) {
+    LoopMonitor::Scope timing("Control", method_name);
+
+    static const DBusMethodEntry<BridgeControl> methods[] = {
+        {"GetStats", &BridgeControl::handle_get_stats},
+        {"DumpTrace", &BridgeControl::handle_dump_trace},
+        {"SetLogLevel", &BridgeControl::handle_set_log_level},
+    };
+
+    auto *control = static_cast<BridgeControl *>(user_data);
+    dbus_dispatch_method_call(control, methods, method_name, parameters, invocation);
+}
+
+void BridgeControl::handle_get_stats(GVariant * /*parameters*/,
+                                     GDBusMethodInvocation *invocation) {
+    g_dbus_method_invocation_return_value(invocation, g_variant_new("(@a{sv})", collect_stats()));
+}
+
+void BridgeControl::handle_dump_trace(GVariant * /*parameters*/,
+                                      GDBusMethodInvocation *invocation) {
+    require_root(invocation, [invocation]() {
+        gchar *json = TraceRing::dump_json();
+        g_dbus_method_invocation_return_value(
+            invocation, g_variant_new("(@s)", g_variant_new_take_string(json)));
+    });
+}
+
+void BridgeControl::handle_set_log_level(GVariant * /*parameters*/,
+                                         GDBusMethodInvocation *invocation) {
+    require_root(invocation, [invocation]() {
+        // The invocation keeps its parameters alive until it is answered
+        const gchar *category = nullptr;
+        const gchar *level = nullptr;
+        g_variant_get(g_dbus_method_invocation_get_parameters(invocation), "(&s&s)", &category,
+                      &level);
+
+        if (!log_set_level(category, level)) {
+            g_dbus_method_invocation_return_error(
+                invocation, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS,
+                "Unknown log category '%s' or level '%s'", category, level);
+            return;
+        }
+
+        g_message("Log level of %s set to %s", category, level);
+        g_dbus_method_invocation_return_value(invocation, nullptr);
+    });
+}
+
+void BridgeControl::require_root(GDBusMethodInvocation *invocation, std::function<void()> then) {
+    const gchar *sender = g_dbus_method_invocation_get_sender(invocation);
+    if (!sender) {
+        g_dbus_method_invocation_return_error_literal(invocation, G_DBUS_ERROR,
+                                                      G_DBUS_ERROR_ACCESS_DENIED,
+                                                      "Caller credentials unknown");
+        return;
+    }
+
+    // Callers are not tracked: one GetConnectionCredentials call each
+    m_credentials->lookup(sender, [invocation, then](bool ok,
+                                                     const PeerCredentials &credentials) {
+        if (!ok || !credentials.has_uid || credentials.uid != 0) {
+            g_dbus_method_invocation_return_error_literal(
+                invocation, G_DBUS_ERROR, G_DBUS_ERROR_ACCESS_DENIED,
+                "Only root may call this method");
+            return;
+        }
+        then();
+    });
+}
+
+std::shared_ptr<BridgeControl> bridge_control_register(GDBusConnection *connection) {
+    g_return_val_if_fail(connection != nullptr, nullptr);
+
+    return std::make_shared<BridgeControl>(connection);
+}
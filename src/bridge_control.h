@@ -0,0 +1,74 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "peer_credentials.h"
+
+/**
+ * Bridge control interface.
+ *
+ * Exports io.github.rinigus.GeoClue2to1 on /io/github/rinigus/GeoClue2to1.
+ * This is a private interface for diagnostics: GetStats() returns an a{sv}
+ * snapshot assembled from the stats providers registered by the Manager,
+ * backend and other subsystems; DumpTrace() returns the event trace ring
+ * (see trace_ring.h) as Chrome trace JSON and SetLogLevel() changes the
+ * level of a log category (see log.h).
+ *
+ * The trace and fix-level debug logs carry positions, so DumpTrace() and
+ * SetLogLevel() are only served to uid 0; GetStats() is open to any peer.
+ */
+
+// Canonical D-Bus identifiers for the bridge control object
+inline constexpr const char *BRIDGE_CONTROL_OBJECT_PATH = "/io/github/rinigus/GeoClue2to1";
+inline constexpr const char *BRIDGE_CONTROL_INTERFACE = "io.github.rinigus.GeoClue2to1";
+
+class BridgeControl {
+  public:
+    // Adds "name" -> value entries to an a{sv} builder
+    using StatsProvider = std::function<void(GVariantBuilder *stats)>;
+
+    explicit BridgeControl(GDBusConnection *connection);
+    ~BridgeControl();
+
+    // Non-copyable
+    BridgeControl(const BridgeControl &) = delete;
+    BridgeControl &operator=(const BridgeControl &) = delete;
+
+    void add_stats_provider(StatsProvider provider);
+
+    // Assemble the a{sv} stats snapshot (floating reference)
+    GVariant *collect_stats() const;
+
+  private:
+    GDBusConnection *m_connection;
+    guint m_registration_id = 0;
+
+    std::vector<StatsProvider> m_stats_providers;
+
+    // Callers of the privileged methods, resolved per call
+    std::unique_ptr<PeerCredentialCache> m_credentials;
+
+    // Run `then` if the caller of `invocation` is root, else fail the call
+    void require_root(GDBusMethodInvocation *invocation, std::function<void()> then);
+
+    // D-Bus vtable entry point
+    static void on_method_call(GDBusConnection *connection, const gchar *sender,
+                               const gchar *object_path, const gchar *interface_name,
+                               const gchar *method_name, GVariant *parameters,
+                               GDBusMethodInvocation *invocation, gpointer user_data);
+
+    // D-Bus method handlers
+    void handle_get_stats(GVariant *parameters, GDBusMethodInvocation *invocation);
+    void handle_dump_trace(GVariant *parameters, GDBusMethodInvocation *invocation);
+    void handle_set_log_level(GVariant *parameters, GDBusMethodInvocation *invocation);
+};
+
+/**
+ * Helper to create and register the control object on D-Bus.
+ */
+std::shared_ptr<BridgeControl> bridge_control_register(GDBusConnection *connection);
@@ -0,0 +1,98 @@
+#include "clock.h"
+
+#include <utility>
+
+/**
+ * Implementation of the system and virtual clocks.
+ */
+
+Clock *Clock::s_installed = nullptr;
+
+/* static */ Clock &Clock::get() {
+    static SystemClock system_clock;
+    return s_installed ? *s_installed : system_clock;
+}
+
+/* static */ void Clock::install(Clock *clock) { s_installed = clock; }
+
+gint64 SystemClock::monotonic_us() const { return g_get_monotonic_time(); }
+
+gint64 SystemClock::real_us() const { return g_get_real_time(); }
+
+guint SystemClock::add_timeout(guint interval_ms, GSourceFunc function, gpointer data) {
+    return g_timeout_add(interval_ms, function, data);
+}
+
+guint SystemClock::add_timeout_seconds(guint interval_s, GSourceFunc function, gpointer data) {
+    return g_timeout_add_seconds(interval_s, function, data);
+}
+
+void SystemClock::remove(guint id) { g_source_remove(id); }
+
+VirtualClock::VirtualClock(gint64 real_start_us) : m_real_start_us(real_start_us) {}
+
+guint VirtualClock::add_timeout(guint interval_ms, GSourceFunc function, gpointer data) {
+    return schedule((gint64)interval_ms * 1000, function, data);
+}
+
+guint VirtualClock::add_timeout_seconds(guint interval_s, GSourceFunc function, gpointer data) {
+    return schedule((gint64)interval_s * G_USEC_PER_SEC, function, data);
+}
+
+guint VirtualClock::schedule(gint64 interval_us, GSourceFunc function, gpointer data) {
+    guint id = m_next_id++;
+    gint64 deadline = m_now_us + interval_us;
+    m_timers.emplace(std::make_pair(deadline, id), Timer{interval_us, function, data});
+    m_deadlines[id] = deadline;
+    return id;
+}
+
+void VirtualClock::remove(guint id) {
+    auto it = m_deadlines.find(id);
+    if (it == m_deadlines.end()) {
+        g_warning("VirtualClock::remove: no timer %u", id);
+        return;
+    }
+
+    m_timers.erase(std::make_pair(it->second, id));
+    m_deadlines.erase(it);
+}
+
+void VirtualClock::advance(gint64 us) {
+    gint64 target = m_now_us + us;
+
+    while (!m_timers.empty() && m_timers.begin()->first.first <= target) {
+        auto first = m_timers.begin();
+        gint64 deadline = first->first.first;
+        guint id = first->first.second;
+        Timer timer = first->second;
+
+        // Out of the queue while it runs, so that it may remove itself
+        m_timers.erase(first);
+        m_now_us = deadline;
+        ++m_fired;
+
+        gboolean keep = timer.function(timer.data);
+
+        auto it = m_deadlines.find(id);
+        if (it == m_deadlines.end() || it->second != deadline) {
+            continue; // removed from its own callback
+        }
+
+        if (keep == G_SOURCE_CONTINUE) {
+            // A zero interval would spin here forever; GLib would run it
+            // on every iteration instead
+            gint64 next = deadline + MAX(timer.interval_us, (gint64)1);
+            m_timers.emplace(std::make_pair(next, id), timer);
+            it->second = next;
+        } else {
+            m_deadlines.erase(it);
+        }
+    }
+
+    m_now_us = target;
+}
+
+gint64 VirtualClock::next_deadline_us() const {
+    return m_timers.empty() ? -1 : m_timers.begin()->first.first;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <glib.h>
+
+#include <map>
+#include <utility>
+
+/**
+ * Time source and timers for the Manager, Clients and power accounting.
+ *
+ * Code that times client behaviour (the grace period, idle client reaping,
+ * slow client trickle, exit on idle, GPS on-time) reads the time and adds
+ * its timeouts through Clock::get() instead of GLib directly. By default
+ * that is the system clock, a thin wrapper over g_get_monotonic_time(),
+ * g_get_real_time() and g_timeout_add().
+ *
+ * Tests install a VirtualClock instead and advance it by hand. Its timers
+ * fire in deadline order, from inside advance(), with now() set to each
+ * deadline, so a day of grace periods and reaper ticks runs in however
+ * long the work in between takes. Install the clock before creating the
+ * objects that use it: timer ids from one clock mean nothing to another.
+ */
+
+class Clock {
+  public:
+    Clock() = default;
+    virtual ~Clock() = default;
+
+    // Non-copyable
+    Clock(const Clock &) = delete;
+    Clock &operator=(const Clock &) = delete;
+
+    // The installed clock, or the system clock
+    static Clock &get();
+
+    // Replace the clock; nullptr goes back to the system clock
+    static void install(Clock *clock);
+
+    // As g_get_monotonic_time() and g_get_real_time()
+    virtual gint64 monotonic_us() const = 0;
+    virtual gint64 real_us() const = 0;
+
+    // As g_timeout_add(): `function` runs every `interval_ms` until it
+    // returns G_SOURCE_REMOVE. Returns a non-zero id for remove().
+    virtual guint add_timeout(guint interval_ms, GSourceFunc function, gpointer data) = 0;
+
+    // As g_timeout_add_seconds(), which may batch wakeups
+    virtual guint add_timeout_seconds(guint interval_s, GSourceFunc function, gpointer data) = 0;
+
+    // Cancel a timeout that has not removed itself
+    virtual void remove(guint id) = 0;
+
+  private:
+    static Clock *s_installed;
+};
+
+class SystemClock final : public Clock {
+  public:
+    gint64 monotonic_us() const override;
+    gint64 real_us() const override;
+    guint add_timeout(guint interval_ms, GSourceFunc function, gpointer data) override;
+    guint add_timeout_seconds(guint interval_s, GSourceFunc function, gpointer data) override;
+    void remove(guint id) override;
+};
+
+class VirtualClock final : public Clock {
+  public:
+    // Starts at monotonic time 0 and at `real_start_us` wall clock time
+    explicit VirtualClock(gint64 real_start_us);
+
+    gint64 monotonic_us() const override { return m_now_us; }
+    gint64 real_us() const override { return m_real_start_us + m_now_us; }
+    guint add_timeout(guint interval_ms, GSourceFunc function, gpointer data) override;
+    guint add_timeout_seconds(guint interval_s, GSourceFunc function, gpointer data) override;
+    void remove(guint id) override;
+
+    // Move time forward by `us`, firing every timer that falls due on the
+    // way at its exact deadline. Repeating timers are rearmed from their
+    // deadline, not from when they ran, so they never drift.
+    void advance(gint64 us);
+
+    // Deadline of the earliest pending timer, or -1 without any
+    gint64 next_deadline_us() const;
+
+    gsize pending() const { return m_timers.size(); }
+    guint64 fired() const { return m_fired; }
+
+  private:
+    struct Timer {
+        gint64 interval_us;
+        GSourceFunc function;
+        gpointer data;
+    };
+
+    gint64 m_real_start_us;
+    gint64 m_now_us = 0;
+    guint m_next_id = 1;
+    guint64 m_fired = 0;
+
+    // Pending timers by (deadline, id); ids break ties in creation order
+    std::map<std::pair<gint64, guint>, Timer> m_timers;
+    std::map<guint, gint64> m_deadlines;
+
+    guint schedule(gint64 interval_us, GSourceFunc function, gpointer data);
+};
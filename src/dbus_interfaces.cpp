@@ -0,0 +1,129 @@
+#include "dbus_interfaces.h"
+#include "bridge_control.h"
+#include "geoclue2_manager.h"
+
+/**
+ * Introspection data for the interfaces exported by the bridge.
+ *
+ * The GeoClue2 part mirrors org.freedesktop.GeoClue2.{Manager,Client,Location}.xml
+ * from upstream GeoClue2; io.github.rinigus.GeoClue2to1 is the bridge's own
+ * diagnostics interface. The XML is parsed once on first use.
+ */
+
+namespace {
+
+const char GEOCLUE2_INTROSPECTION_XML[] =
+    "<node>"
+    "  <interface name='org.freedesktop.GeoClue2.Manager'>"
+    "    <property name='InUse' type='b' access='read'/>"
+    "    <property name='AvailableAccuracyLevel' type='u' access='read'/>"
+    "    <method name='GetClient'>"
+    "      <arg name='client' type='o' direction='out'/>"
+    "    </method>"
+    "    <method name='CreateClient'>"
+    "      <arg name='client' type='o' direction='out'/>"
+    "    </method>"
+    "    <method name='DeleteClient'>"
+    "      <arg name='client' type='o' direction='in'/>"
+    "    </method>"
+    "    <method name='AddAgent'>"
+    "      <arg name='id' type='s' direction='in'/>"
+    "    </method>"
+    "  </interface>"
+    "  <interface name='org.freedesktop.GeoClue2.Client'>"
+    "    <property name='Location' type='o' access='read'/>"
+    "    <property name='DistanceThreshold' type='u' access='readwrite'/>"
+    "    <property name='TimeThreshold' type='u' access='readwrite'/>"
+    "    <property name='DesktopId' type='s' access='readwrite'/>"
+    "    <property name='RequestedAccuracyLevel' type='u' access='readwrite'/>"
+    "    <property name='Active' type='b' access='read'/>"
+    "    <method name='Start'/>"
+    "    <method name='Stop'/>"
+    "    <signal name='LocationUpdated'>"
+    "      <arg name='old' type='o'/>"
+    "      <arg name='new' type='o'/>"
+    "    </signal>"
+    "  </interface>"
+    "  <interface name='org.freedesktop.GeoClue2.Location'>"
+    "    <property name='Latitude' type='d' access='read'/>"
+    "    <property name='Longitude' type='d' access='read'/>"
+    "    <property name='Accuracy' type='d' access='read'/>"
+    "    <property name='Altitude' type='d' access='read'/>"
+    "    <property name='Speed' type='d' access='read'/>"
+    "    <property name='Heading' type='d' access='read'/>"
+    "    <property name='Description' type='s' access='read'/>"
+    "    <property name='Timestamp' type='(tt)' access='read'/>"
+    "  </interface>"
+    "  <interface name='io.github.rinigus.GeoClue2to1'>"
+    "    <method name='GetStats'>"
+    "      <arg name='stats' type='a{sv}' direction='out'/>"
+    "    </method>"
+    "    <method name='DumpTrace'>"
+    "      <arg name='trace' type='s' direction='out'/>"
+    "    </method>"
+    "    <method name='SetLogLevel'>"
+    "      <arg name='category' type='s' direction='in'/>"
+    "      <arg name='level' type='s' direction='in'/>"
+    "    </method>"
+    "  </interface>"
+    "</node>";
+
+GDBusInterfaceInfo *lookup_interface(const char *interface_name) {
+    static GDBusNodeInfo *node_info = nullptr;
+
+    if (!node_info) {
+        GError *error = nullptr;
+        node_info = g_dbus_node_info_new_for_xml(GEOCLUE2_INTROSPECTION_XML, &error);
+        if (!node_info) {
+            // The XML is a compile-time constant, so this is a programming error
+            g_error("Failed to parse GeoClue2 introspection data: %s", error->message);
+        }
+    }
+
+    GDBusInterfaceInfo *info = g_dbus_node_info_lookup_interface(node_info, interface_name);
+    g_assert(info != nullptr);
+    return info;
+}
+
+} // namespace
+
+GDBusInterfaceInfo *geoclue2_manager_interface_info() {
+    static GDBusInterfaceInfo *info = lookup_interface(GEOCLUE2_MANAGER_INTERFACE);
+    return info;
+}
+
+GDBusInterfaceInfo *geoclue2_client_interface_info() {
+    static GDBusInterfaceInfo *info = lookup_interface(GEOCLUE2_CLIENT_INTERFACE);
+    return info;
+}
+
+GDBusInterfaceInfo *geoclue2_location_interface_info() {
+    static GDBusInterfaceInfo *info = lookup_interface(GEOCLUE2_LOCATION_INTERFACE);
+    return info;
+}
+
+GDBusInterfaceInfo *bridge_control_interface_info() {
+    static GDBusInterfaceInfo *info = lookup_interface(BRIDGE_CONTROL_INTERFACE);
+    return info;
+}
+
+void DBusPropertyBatch::emit(GDBusConnection *connection, const char *object_path,
+                             const char *interface_name) {
+    if (m_count == 0 || !connection) {
+        return;
+    }
+
+    GVariant *changed = g_variant_builder_end(&m_builder);
+    g_variant_builder_init(&m_builder, G_VARIANT_TYPE_VARDICT);
+    m_count = 0;
+
+    GError *error = nullptr;
+    if (!g_dbus_connection_emit_signal(
+            connection, nullptr, object_path, "org.freedesktop.DBus.Properties",
+            "PropertiesChanged",
+            g_variant_new("(s@a{sv}@as)", interface_name, changed, g_variant_new_strv(nullptr, 0)),
+            &error)) {
+        g_warning("Failed to emit PropertiesChanged on %s: %s", object_path, error->message);
+        g_error_free(error);
+    }
+}
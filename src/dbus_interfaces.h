@@ -0,0 +1,131 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * Table-driven D-Bus object support.
+ *
+ * Interface descriptions are parsed once from the introspection XML in
+ * dbus_interfaces.cpp. Objects register themselves with
+ * g_dbus_connection_register_object() using a static vtable and dispatch
+ * method calls and property access through the small tables below. Property
+ * values live as plain fields in the owning object and changes are emitted
+ * explicitly via DBusPropertyBatch.
+ */
+
+// Canonical D-Bus interface names
+inline constexpr const char *GEOCLUE2_CLIENT_INTERFACE = "org.freedesktop.GeoClue2.Client";
+inline constexpr const char *GEOCLUE2_LOCATION_INTERFACE = "org.freedesktop.GeoClue2.Location";
+
+// Parsed interface descriptions (owned by a process-wide node info, never freed)
+GDBusInterfaceInfo *geoclue2_manager_interface_info();
+GDBusInterfaceInfo *geoclue2_client_interface_info();
+GDBusInterfaceInfo *geoclue2_location_interface_info();
+GDBusInterfaceInfo *bridge_control_interface_info();
+
+template <typename T> struct DBusMethodEntry {
+    const char *name;
+    void (T::*handler)(GVariant *parameters, GDBusMethodInvocation *invocation);
+};
+
+template <typename T> struct DBusPropertyEntry {
+    const char *name;
+    GVariant *(T::*getter)() const;
+    // nullptr for read-only properties (GDBus rejects writes to those already)
+    bool (T::*setter)(GVariant *value);
+};
+
+template <typename T, std::size_t N>
+void dbus_dispatch_method_call(T *self, const DBusMethodEntry<T> (&table)[N],
+                               const char *method_name, GVariant *parameters,
+                               GDBusMethodInvocation *invocation) {
+    for (const auto &entry : table) {
+        if (std::strcmp(entry.name, method_name) == 0) {
+            (self->*entry.handler)(parameters, invocation);
+            return;
+        }
+    }
+
+    g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD,
+                                          "Unknown method %s", method_name);
+}
+
+template <typename T, std::size_t N>
+GVariant *dbus_dispatch_get_property(const T *self, const DBusPropertyEntry<T> (&table)[N],
+                                     const char *property_name, GError **error) {
+    for (const auto &entry : table) {
+        if (std::strcmp(entry.name, property_name) == 0) {
+            return (self->*entry.getter)();
+        }
+    }
+
+    g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_PROPERTY, "Unknown property %s",
+                property_name);
+    return nullptr;
+}
+
+template <typename T, std::size_t N>
+bool dbus_dispatch_set_property(T *self, const DBusPropertyEntry<T> (&table)[N],
+                                const char *property_name, GVariant *value, GError **error) {
+    for (const auto &entry : table) {
+        if (std::strcmp(entry.name, property_name) == 0 && entry.setter) {
+            if ((self->*entry.setter)(value)) {
+                return true;
+            }
+            g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS,
+                        "Invalid value for property %s", property_name);
+            return false;
+        }
+    }
+
+    g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_PROPERTY_READ_ONLY,
+                "Property %s is not writable", property_name);
+    return false;
+}
+
+/**
+ * Collects changed properties and emits them as a single
+ * org.freedesktop.DBus.Properties.PropertiesChanged signal.
+ */
+class DBusPropertyBatch {
+  public:
+    DBusPropertyBatch() { g_variant_builder_init(&m_builder, G_VARIANT_TYPE_VARDICT); }
+    ~DBusPropertyBatch() { g_variant_builder_clear(&m_builder); }
+
+    // Non-copyable
+    DBusPropertyBatch(const DBusPropertyBatch &) = delete;
+    DBusPropertyBatch &operator=(const DBusPropertyBatch &) = delete;
+
+    // Floating values are consumed, others are referenced
+    void add(const char *name, GVariant *value) {
+        g_variant_builder_add(&m_builder, "{sv}", name, value);
+        ++m_count;
+    }
+
+    // Add `value` unless it equals `old_value`; both are handled like add()
+    // handles its value. Returns whether the property was added.
+    bool add_if_changed(const char *name, GVariant *old_value, GVariant *value) {
+        g_variant_ref_sink(old_value);
+        bool changed = !g_variant_equal(old_value, value);
+        g_variant_unref(old_value);
+        if (!changed) {
+            g_variant_unref(g_variant_ref_sink(value));
+            return false;
+        }
+        add(name, value);
+        return true;
+    }
+
+    bool empty() const { return m_count == 0; }
+
+    // Emit accumulated changes (no-op when empty); the batch is reset afterwards
+    void emit(GDBusConnection *connection, const char *object_path, const char *interface_name);
+
+  private:
+    GVariantBuilder m_builder;
+    guint m_count = 0;
+};
@@ -1,1958 +0,0 @@
-/*
- * This file is generated by gdbus-codegen, do not modify it.
- *
- * The license of this code is the same as for the D-Bus interface description
- * it was derived from. Note that it links to GLib, so must comply with the
- * LGPL linking clauses.
- */
-
-#ifdef HAVE_CONFIG_H
-#include "config.h"
-#endif
-
-#include "geoclue2-client.h"
-
-#include <string.h>
-#ifdef G_OS_UNIX
-#include <gio/gunixfdlist.h>
-#endif
-
-#ifdef G_ENABLE_DEBUG
-#define g_marshal_value_peek_boolean(v) g_value_get_boolean(v)
-#define g_marshal_value_peek_char(v) g_value_get_schar(v)
-#define g_marshal_value_peek_uchar(v) g_value_get_uchar(v)
-#define g_marshal_value_peek_int(v) g_value_get_int(v)
-#define g_marshal_value_peek_uint(v) g_value_get_uint(v)
-#define g_marshal_value_peek_long(v) g_value_get_long(v)
-#define g_marshal_value_peek_ulong(v) g_value_get_ulong(v)
-#define g_marshal_value_peek_int64(v) g_value_get_int64(v)
-#define g_marshal_value_peek_uint64(v) g_value_get_uint64(v)
-#define g_marshal_value_peek_enum(v) g_value_get_enum(v)
-#define g_marshal_value_peek_flags(v) g_value_get_flags(v)
-#define g_marshal_value_peek_float(v) g_value_get_float(v)
-#define g_marshal_value_peek_double(v) g_value_get_double(v)
-#define g_marshal_value_peek_string(v) (char *)g_value_get_string(v)
-#define g_marshal_value_peek_param(v) g_value_get_param(v)
-#define g_marshal_value_peek_boxed(v) g_value_get_boxed(v)
-#define g_marshal_value_peek_pointer(v) g_value_get_pointer(v)
-#define g_marshal_value_peek_object(v) g_value_get_object(v)
-#define g_marshal_value_peek_variant(v) g_value_get_variant(v)
-#else /* !G_ENABLE_DEBUG */
-/* WARNING: This code accesses GValues directly, which is UNSUPPORTED API.
- *          Do not access GValues directly in your code. Instead, use the
- *          g_value_get_*() functions
- */
-#define g_marshal_value_peek_boolean(v) (v)->data[0].v_int
-#define g_marshal_value_peek_char(v) (v)->data[0].v_int
-#define g_marshal_value_peek_uchar(v) (v)->data[0].v_uint
-#define g_marshal_value_peek_int(v) (v)->data[0].v_int
-#define g_marshal_value_peek_uint(v) (v)->data[0].v_uint
-#define g_marshal_value_peek_long(v) (v)->data[0].v_long
-#define g_marshal_value_peek_ulong(v) (v)->data[0].v_ulong
-#define g_marshal_value_peek_int64(v) (v)->data[0].v_int64
-#define g_marshal_value_peek_uint64(v) (v)->data[0].v_uint64
-#define g_marshal_value_peek_enum(v) (v)->data[0].v_long
-#define g_marshal_value_peek_flags(v) (v)->data[0].v_ulong
-#define g_marshal_value_peek_float(v) (v)->data[0].v_float
-#define g_marshal_value_peek_double(v) (v)->data[0].v_double
-#define g_marshal_value_peek_string(v) (v)->data[0].v_pointer
-#define g_marshal_value_peek_param(v) (v)->data[0].v_pointer
-#define g_marshal_value_peek_boxed(v) (v)->data[0].v_pointer
-#define g_marshal_value_peek_pointer(v) (v)->data[0].v_pointer
-#define g_marshal_value_peek_object(v) (v)->data[0].v_pointer
-#define g_marshal_value_peek_variant(v) (v)->data[0].v_pointer
-#endif /* !G_ENABLE_DEBUG */
-
-typedef struct {
-    GDBusArgInfo parent_struct;
-    gboolean use_gvariant;
-} _ExtendedGDBusArgInfo;
-
-typedef struct {
-    GDBusMethodInfo parent_struct;
-    const gchar *signal_name;
-    gboolean pass_fdlist;
-} _ExtendedGDBusMethodInfo;
-
-typedef struct {
-    GDBusSignalInfo parent_struct;
-    const gchar *signal_name;
-} _ExtendedGDBusSignalInfo;
-
-typedef struct {
-    GDBusPropertyInfo parent_struct;
-    const gchar *hyphen_name;
-    guint use_gvariant : 1;
-    guint emits_changed_signal : 1;
-} _ExtendedGDBusPropertyInfo;
-
-typedef struct {
-    GDBusInterfaceInfo parent_struct;
-    const gchar *hyphen_name;
-} _ExtendedGDBusInterfaceInfo;
-
-typedef struct {
-    const _ExtendedGDBusPropertyInfo *info;
-    guint prop_id;
-    GValue orig_value; /* the value before the change */
-} ChangedProperty;
-
-static void _changed_property_free(ChangedProperty *data) {
-    g_value_unset(&data->orig_value);
-    g_free(data);
-}
-
-static gboolean _g_strv_equal0(gchar **a, gchar **b) {
-    gboolean ret = FALSE;
-    guint n;
-    if (a == NULL && b == NULL) {
-        ret = TRUE;
-        goto out;
-    }
-    if (a == NULL || b == NULL)
-        goto out;
-    if (g_strv_length(a) != g_strv_length(b))
-        goto out;
-    for (n = 0; a[n] != NULL; n++)
-        if (g_strcmp0(a[n], b[n]) != 0)
-            goto out;
-    ret = TRUE;
-out:
-    return ret;
-}
-
-static gboolean _g_variant_equal0(GVariant *a, GVariant *b) {
-    gboolean ret = FALSE;
-    if (a == NULL && b == NULL) {
-        ret = TRUE;
-        goto out;
-    }
-    if (a == NULL || b == NULL)
-        goto out;
-    ret = g_variant_equal(a, b);
-out:
-    return ret;
-}
-
-G_GNUC_UNUSED static gboolean _g_value_equal(const GValue *a, const GValue *b) {
-    gboolean ret = FALSE;
-    g_assert(G_VALUE_TYPE(a) == G_VALUE_TYPE(b));
-    switch (G_VALUE_TYPE(a)) {
-    case G_TYPE_BOOLEAN:
-        ret = (g_value_get_boolean(a) == g_value_get_boolean(b));
-        break;
-    case G_TYPE_UCHAR:
-        ret = (g_value_get_uchar(a) == g_value_get_uchar(b));
-        break;
-    case G_TYPE_INT:
-        ret = (g_value_get_int(a) == g_value_get_int(b));
-        break;
-    case G_TYPE_UINT:
-        ret = (g_value_get_uint(a) == g_value_get_uint(b));
-        break;
-    case G_TYPE_INT64:
-        ret = (g_value_get_int64(a) == g_value_get_int64(b));
-        break;
-    case G_TYPE_UINT64:
-        ret = (g_value_get_uint64(a) == g_value_get_uint64(b));
-        break;
-    case G_TYPE_DOUBLE: {
-        /* Avoid -Wfloat-equal warnings by doing a direct bit compare */
-        gdouble da = g_value_get_double(a);
-        gdouble db = g_value_get_double(b);
-        ret = memcmp(&da, &db, sizeof(gdouble)) == 0;
-    } break;
-    case G_TYPE_STRING:
-        ret = (g_strcmp0(g_value_get_string(a), g_value_get_string(b)) == 0);
-        break;
-    case G_TYPE_VARIANT:
-        ret = _g_variant_equal0(g_value_get_variant(a), g_value_get_variant(b));
-        break;
-    default:
-        if (G_VALUE_TYPE(a) == G_TYPE_STRV)
-            ret = _g_strv_equal0(g_value_get_boxed(a), g_value_get_boxed(b));
-        else
-            g_critical("_g_value_equal() does not handle type %s", g_type_name(G_VALUE_TYPE(a)));
-        break;
-    }
-    return ret;
-}
-
-static void _g_dbus_codegen_marshal_VOID__STRING_STRING(
-    GClosure *closure, GValue *return_value G_GNUC_UNUSED, unsigned int n_param_values,
-    const GValue *param_values, void *invocation_hint G_GNUC_UNUSED, void *marshal_data) {
-    typedef void (*_GDbusCodegenMarshalVoid_StringStringFunc)(void *data1, const gchar *arg_old,
-                                                              const gchar *arg_new, void *data2);
-    _GDbusCodegenMarshalVoid_StringStringFunc callback;
-    GCClosure *cc = (GCClosure *)closure;
-    void *data1, *data2;
-
-    g_return_if_fail(n_param_values == 3);
-
-    if (G_CCLOSURE_SWAP_DATA(closure)) {
-        data1 = closure->data;
-        data2 = g_value_peek_pointer(param_values + 0);
-    } else {
-        data1 = g_value_peek_pointer(param_values + 0);
-        data2 = closure->data;
-    }
-
-    callback =
-        (_GDbusCodegenMarshalVoid_StringStringFunc)(marshal_data ? marshal_data : cc->callback);
-
-    callback(data1, g_marshal_value_peek_string(param_values + 1),
-             g_marshal_value_peek_string(param_values + 2), data2);
-}
-
-static void _g_dbus_codegen_marshal_BOOLEAN__OBJECT(GClosure *closure, GValue *return_value,
-                                                    unsigned int n_param_values,
-                                                    const GValue *param_values,
-                                                    void *invocation_hint G_GNUC_UNUSED,
-                                                    void *marshal_data) {
-    typedef gboolean (*_GDbusCodegenMarshalBoolean_ObjectFunc)(
-        void *data1, GDBusMethodInvocation *arg_method_invocation, void *data2);
-    _GDbusCodegenMarshalBoolean_ObjectFunc callback;
-    GCClosure *cc = (GCClosure *)closure;
-    void *data1, *data2;
-    gboolean v_return;
-
-    g_return_if_fail(return_value != NULL);
-    g_return_if_fail(n_param_values == 2);
-
-    if (G_CCLOSURE_SWAP_DATA(closure)) {
-        data1 = closure->data;
-        data2 = g_value_peek_pointer(param_values + 0);
-    } else {
-        data1 = g_value_peek_pointer(param_values + 0);
-        data2 = closure->data;
-    }
-
-    callback = (_GDbusCodegenMarshalBoolean_ObjectFunc)(marshal_data ? marshal_data : cc->callback);
-
-    v_return = callback(data1, g_marshal_value_peek_object(param_values + 1), data2);
-
-    g_value_set_boolean(return_value, v_return);
-}
-
-/* ------------------------------------------------------------------------
- * Code for interface org.freedesktop.GeoClue2.Client
- * ------------------------------------------------------------------------
- */
-
-/**
- * SECTION:GClueClient
- * @title: GClueClient
- * @short_description: Generated C code for the org.freedesktop.GeoClue2.Client D-Bus interface
- *
- * This section contains code for working with the <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Client.top_of_page">org.freedesktop.GeoClue2.Client</link>
- * D-Bus interface in C.
- */
-
-enum {
-    GCLUE__CLIENT_LOCATION_UPDATED,
-};
-
-static unsigned GCLUE__CLIENT_SIGNALS[1] = {0};
-
-/* ---- Introspection data for org.freedesktop.GeoClue2.Client ---- */
-
-static const _ExtendedGDBusMethodInfo _gclue_client_method_info_start = {
-    {-1, (gchar *)"Start", NULL, NULL, NULL}, "handle-start", FALSE};
-
-static const _ExtendedGDBusMethodInfo _gclue_client_method_info_stop = {
-    {-1, (gchar *)"Stop", NULL, NULL, NULL}, "handle-stop", FALSE};
-
-static const GDBusMethodInfo *const _gclue_client_method_info_pointers[] = {
-    &_gclue_client_method_info_start.parent_struct, &_gclue_client_method_info_stop.parent_struct,
-    NULL};
-
-static const _ExtendedGDBusArgInfo _gclue_client_signal_info_location_updated_ARG_old = {
-    {-1, (gchar *)"old", (gchar *)"o", NULL}, FALSE};
-
-static const _ExtendedGDBusArgInfo _gclue_client_signal_info_location_updated_ARG_new = {
-    {-1, (gchar *)"new", (gchar *)"o", NULL}, FALSE};
-
-static const GDBusArgInfo *const _gclue_client_signal_info_location_updated_ARG_pointers[] = {
-    &_gclue_client_signal_info_location_updated_ARG_old.parent_struct,
-    &_gclue_client_signal_info_location_updated_ARG_new.parent_struct, NULL};
-
-static const _ExtendedGDBusSignalInfo _gclue_client_signal_info_location_updated = {
-    {-1, (gchar *)"LocationUpdated",
-     (GDBusArgInfo **)&_gclue_client_signal_info_location_updated_ARG_pointers, NULL},
-    "location-updated"};
-
-static const GDBusSignalInfo *const _gclue_client_signal_info_pointers[] = {
-    &_gclue_client_signal_info_location_updated.parent_struct, NULL};
-
-static const _ExtendedGDBusPropertyInfo _gclue_client_property_info_location = {
-    {-1, (gchar *)"Location", (gchar *)"o", G_DBUS_PROPERTY_INFO_FLAGS_READABLE, NULL},
-    "location",
-    FALSE,
-    TRUE};
-
-static const GDBusAnnotationInfo _gclue_client_property_distance_threshold_annotation_info_0 = {
-    -1, (gchar *)"org.freedesktop.Accounts.DefaultValue", (gchar *)"0", NULL};
-
-static const GDBusAnnotationInfo
-    *const _gclue_client_property_distance_threshold_annotation_info_pointers[] = {
-        &_gclue_client_property_distance_threshold_annotation_info_0, NULL};
-
-static const _ExtendedGDBusPropertyInfo _gclue_client_property_info_distance_threshold = {
-    {-1, (gchar *)"DistanceThreshold", (gchar *)"u",
-     G_DBUS_PROPERTY_INFO_FLAGS_READABLE | G_DBUS_PROPERTY_INFO_FLAGS_WRITABLE,
-     (GDBusAnnotationInfo **)&_gclue_client_property_distance_threshold_annotation_info_pointers},
-    "distance-threshold",
-    FALSE,
-    TRUE};
-
-static const GDBusAnnotationInfo _gclue_client_property_time_threshold_annotation_info_0 = {
-    -1, (gchar *)"org.freedesktop.Accounts.DefaultValue", (gchar *)"0", NULL};
-
-static const GDBusAnnotationInfo
-    *const _gclue_client_property_time_threshold_annotation_info_pointers[] = {
-        &_gclue_client_property_time_threshold_annotation_info_0, NULL};
-
-static const _ExtendedGDBusPropertyInfo _gclue_client_property_info_time_threshold = {
-    {-1, (gchar *)"TimeThreshold", (gchar *)"u",
-     G_DBUS_PROPERTY_INFO_FLAGS_READABLE | G_DBUS_PROPERTY_INFO_FLAGS_WRITABLE,
-     (GDBusAnnotationInfo **)&_gclue_client_property_time_threshold_annotation_info_pointers},
-    "time-threshold",
-    FALSE,
-    TRUE};
-
-static const _ExtendedGDBusPropertyInfo _gclue_client_property_info_desktop_id = {
-    {-1, (gchar *)"DesktopId", (gchar *)"s",
-     G_DBUS_PROPERTY_INFO_FLAGS_READABLE | G_DBUS_PROPERTY_INFO_FLAGS_WRITABLE, NULL},
-    "desktop-id",
-    FALSE,
-    TRUE};
-
-static const _ExtendedGDBusPropertyInfo _gclue_client_property_info_requested_accuracy_level = {
-    {-1, (gchar *)"RequestedAccuracyLevel", (gchar *)"u",
-     G_DBUS_PROPERTY_INFO_FLAGS_READABLE | G_DBUS_PROPERTY_INFO_FLAGS_WRITABLE, NULL},
-    "requested-accuracy-level",
-    FALSE,
-    TRUE};
-
-static const _ExtendedGDBusPropertyInfo _gclue_client_property_info_active = {
-    {-1, (gchar *)"Active", (gchar *)"b", G_DBUS_PROPERTY_INFO_FLAGS_READABLE, NULL},
-    "active",
-    FALSE,
-    TRUE};
-
-static const GDBusPropertyInfo *const _gclue_client_property_info_pointers[] = {
-    &_gclue_client_property_info_location.parent_struct,
-    &_gclue_client_property_info_distance_threshold.parent_struct,
-    &_gclue_client_property_info_time_threshold.parent_struct,
-    &_gclue_client_property_info_desktop_id.parent_struct,
-    &_gclue_client_property_info_requested_accuracy_level.parent_struct,
-    &_gclue_client_property_info_active.parent_struct,
-    NULL};
-
-static const _ExtendedGDBusInterfaceInfo _gclue_client_interface_info = {
-    {-1, (gchar *)"org.freedesktop.GeoClue2.Client",
-     (GDBusMethodInfo **)&_gclue_client_method_info_pointers,
-     (GDBusSignalInfo **)&_gclue_client_signal_info_pointers,
-     (GDBusPropertyInfo **)&_gclue_client_property_info_pointers, NULL},
-    "client",
-};
-
-/**
- * gclue_client_interface_info:
- *
- * Gets a machine-readable description of the <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Client.top_of_page">org.freedesktop.GeoClue2.Client</link>
- * D-Bus interface.
- *
- * Returns: (transfer none): A #GDBusInterfaceInfo. Do not free.
- */
-GDBusInterfaceInfo *gclue_client_interface_info(void) {
-    return (GDBusInterfaceInfo *)&_gclue_client_interface_info.parent_struct;
-}
-
-/**
- * gclue_client_override_properties:
- * @klass: The class structure for a #GObject derived class.
- * @property_id_begin: The property id to assign to the first overridden property.
- *
- * Overrides all #GObject properties in the #GClueClient interface for a concrete class.
- * The properties are overridden in the order they are defined.
- *
- * Returns: The last property id.
- */
-guint gclue_client_override_properties(GObjectClass *klass, guint property_id_begin) {
-    g_object_class_override_property(klass, property_id_begin++, "location");
-    g_object_class_override_property(klass, property_id_begin++, "distance-threshold");
-    g_object_class_override_property(klass, property_id_begin++, "time-threshold");
-    g_object_class_override_property(klass, property_id_begin++, "desktop-id");
-    g_object_class_override_property(klass, property_id_begin++, "requested-accuracy-level");
-    g_object_class_override_property(klass, property_id_begin++, "active");
-    return property_id_begin - 1;
-}
-
-inline static void gclue_client_signal_marshal_location_updated(
-    GClosure *closure, GValue *return_value, unsigned int n_param_values,
-    const GValue *param_values, void *invocation_hint, void *marshal_data) {
-    _g_dbus_codegen_marshal_VOID__STRING_STRING(closure, return_value, n_param_values, param_values,
-                                                invocation_hint, marshal_data);
-}
-
-inline static void gclue_client_method_marshal_start(GClosure *closure, GValue *return_value,
-                                                     unsigned int n_param_values,
-                                                     const GValue *param_values,
-                                                     void *invocation_hint, void *marshal_data) {
-    _g_dbus_codegen_marshal_BOOLEAN__OBJECT(closure, return_value, n_param_values, param_values,
-                                            invocation_hint, marshal_data);
-}
-
-inline static void gclue_client_method_marshal_stop(GClosure *closure, GValue *return_value,
-                                                    unsigned int n_param_values,
-                                                    const GValue *param_values,
-                                                    void *invocation_hint, void *marshal_data) {
-    _g_dbus_codegen_marshal_BOOLEAN__OBJECT(closure, return_value, n_param_values, param_values,
-                                            invocation_hint, marshal_data);
-}
-
-/**
- * GClueClient:
- *
- * Abstract interface type for the D-Bus interface <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Client.top_of_page">org.freedesktop.GeoClue2.Client</link>.
- */
-
-/**
- * GClueClientIface:
- * @parent_iface: The parent interface.
- * @handle_start: Handler for the #GClueClient::handle-start signal.
- * @handle_stop: Handler for the #GClueClient::handle-stop signal.
- * @get_active: Getter for the #GClueClient:active property.
- * @get_desktop_id: Getter for the #GClueClient:desktop-id property.
- * @get_distance_threshold: Getter for the #GClueClient:distance-threshold property.
- * @get_location: Getter for the #GClueClient:location property.
- * @get_requested_accuracy_level: Getter for the #GClueClient:requested-accuracy-level property.
- * @get_time_threshold: Getter for the #GClueClient:time-threshold property.
- * @location_updated: Handler for the #GClueClient::location-updated signal.
- *
- * Virtual table for the D-Bus interface <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Client.top_of_page">org.freedesktop.GeoClue2.Client</link>.
- */
-
-typedef GClueClientIface GClueClientInterface;
-G_DEFINE_INTERFACE(GClueClient, gclue_client, G_TYPE_OBJECT)
-
-static void gclue_client_default_init(GClueClientIface *iface) {
-    /* GObject signals for incoming D-Bus method calls: */
-    /**
-     * GClueClient::handle-start:
-     * @object: A #GClueClient.
-     * @invocation: A #GDBusMethodInvocation.
-     *
-     * Signal emitted when a remote caller is invoking the <link
-     * linkend="gdbus-method-org-freedesktop-GeoClue2-Client.Start">Start()</link> D-Bus method.
-     *
-     * If a signal handler returns %TRUE, it means the signal handler will handle the invocation
-     * (e.g. take a reference to @invocation and eventually call gclue_client_complete_start() or
-     * e.g. g_dbus_method_invocation_return_error() on it) and no other signal handlers will run. If
-     * no signal handler handles the invocation, the %G_DBUS_ERROR_UNKNOWN_METHOD error is returned.
-     *
-     * Returns: %G_DBUS_METHOD_INVOCATION_HANDLED or %TRUE if the invocation was handled,
-     * %G_DBUS_METHOD_INVOCATION_UNHANDLED or %FALSE to let other signal handlers run.
-     */
-    g_signal_new("handle-start", G_TYPE_FROM_INTERFACE(iface), G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(GClueClientIface, handle_start), g_signal_accumulator_true_handled,
-                 NULL, gclue_client_method_marshal_start, G_TYPE_BOOLEAN, 1,
-                 G_TYPE_DBUS_METHOD_INVOCATION);
-
-    /**
-     * GClueClient::handle-stop:
-     * @object: A #GClueClient.
-     * @invocation: A #GDBusMethodInvocation.
-     *
-     * Signal emitted when a remote caller is invoking the <link
-     * linkend="gdbus-method-org-freedesktop-GeoClue2-Client.Stop">Stop()</link> D-Bus method.
-     *
-     * If a signal handler returns %TRUE, it means the signal handler will handle the invocation
-     * (e.g. take a reference to @invocation and eventually call gclue_client_complete_stop() or
-     * e.g. g_dbus_method_invocation_return_error() on it) and no other signal handlers will run. If
-     * no signal handler handles the invocation, the %G_DBUS_ERROR_UNKNOWN_METHOD error is returned.
-     *
-     * Returns: %G_DBUS_METHOD_INVOCATION_HANDLED or %TRUE if the invocation was handled,
-     * %G_DBUS_METHOD_INVOCATION_UNHANDLED or %FALSE to let other signal handlers run.
-     */
-    g_signal_new("handle-stop", G_TYPE_FROM_INTERFACE(iface), G_SIGNAL_RUN_LAST,
-                 G_STRUCT_OFFSET(GClueClientIface, handle_stop), g_signal_accumulator_true_handled,
-                 NULL, gclue_client_method_marshal_stop, G_TYPE_BOOLEAN, 1,
-                 G_TYPE_DBUS_METHOD_INVOCATION);
-
-    /* GObject signals for received D-Bus signals: */
-    /**
-     * GClueClient::location-updated:
-     * @object: A #GClueClient.
-     * @arg_old: Argument.
-     * @arg_new: Argument.
-     *
-     * On the client-side, this signal is emitted whenever the D-Bus signal <link
-     * linkend="gdbus-signal-org-freedesktop-GeoClue2-Client.LocationUpdated">"LocationUpdated"</link>
-     * is received.
-     *
-     * On the service-side, this signal can be used with e.g. g_signal_emit_by_name() to make the
-     * object emit the D-Bus signal.
-     */
-    GCLUE__CLIENT_SIGNALS[GCLUE__CLIENT_LOCATION_UPDATED] = g_signal_new(
-        "location-updated", G_TYPE_FROM_INTERFACE(iface), G_SIGNAL_RUN_LAST,
-        G_STRUCT_OFFSET(GClueClientIface, location_updated), NULL, NULL,
-        gclue_client_signal_marshal_location_updated, G_TYPE_NONE, 2, G_TYPE_STRING, G_TYPE_STRING);
-
-    /* GObject properties for D-Bus properties: */
-    /**
-     * GClueClient:location:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.Location">"Location"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is readable but not writable, it is
-     * meaningful to read from it on both the client- and service-side. It is only meaningful,
-     * however, to write to it on the service-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_string("location", "Location", "Location", NULL,
-                                   G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueClient:distance-threshold:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.DistanceThreshold">"DistanceThreshold"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is both readable and writable, it is
-     * meaningful to both read from it and write to it on both the service- and client-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_uint("distance-threshold", "DistanceThreshold", "DistanceThreshold", 0,
-                                 G_MAXUINT32, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueClient:time-threshold:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.TimeThreshold">"TimeThreshold"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is both readable and writable, it is
-     * meaningful to both read from it and write to it on both the service- and client-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_uint("time-threshold", "TimeThreshold", "TimeThreshold", 0, G_MAXUINT32,
-                                 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueClient:desktop-id:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.DesktopId">"DesktopId"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is both readable and writable, it is
-     * meaningful to both read from it and write to it on both the service- and client-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_string("desktop-id", "DesktopId", "DesktopId", NULL,
-                                   G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueClient:requested-accuracy-level:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.RequestedAccuracyLevel">"RequestedAccuracyLevel"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is both readable and writable, it is
-     * meaningful to both read from it and write to it on both the service- and client-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_uint("requested-accuracy-level", "RequestedAccuracyLevel",
-                                 "RequestedAccuracyLevel", 0, G_MAXUINT32, 0,
-                                 G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueClient:active:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.Active">"Active"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is readable but not writable, it is
-     * meaningful to read from it on both the client- and service-side. It is only meaningful,
-     * however, to write to it on the service-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_boolean("active", "Active", "Active", FALSE,
-                                    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-}
-
-/**
- * gclue_client_get_location: (skip)
- * @object: A #GClueClient.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.Location">"Location"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * The returned value is only valid until the property changes so on the client-side it is only safe
- * to use this function on the thread where @object was constructed. Use gclue_client_dup_location()
- * if on another thread.
- *
- * Returns: (transfer none) (nullable): The property value or %NULL if the property is not set. Do
- * not free the returned value, it belongs to @object.
- */
-const gchar *gclue_client_get_location(GClueClient *object) {
-    g_return_val_if_fail(GCLUE_IS_CLIENT(object), NULL);
-
-    return GCLUE_CLIENT_GET_IFACE(object)->get_location(object);
-}
-
-/**
- * gclue_client_dup_location: (skip)
- * @object: A #GClueClient.
- *
- * Gets a copy of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.Location">"Location"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * Returns: (transfer full) (nullable): The property value or %NULL if the property is not set. The
- * returned value should be freed with g_free().
- */
-gchar *gclue_client_dup_location(GClueClient *object) {
-    gchar *value;
-    g_object_get(G_OBJECT(object), "location", &value, NULL);
-    return value;
-}
-
-/**
- * gclue_client_set_location: (skip)
- * @object: A #GClueClient.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.Location">"Location"</link> D-Bus
- * property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the
- * service-side.
- */
-void gclue_client_set_location(GClueClient *object, const gchar *value) {
-    g_object_set(G_OBJECT(object), "location", value, NULL);
-}
-
-/**
- * gclue_client_get_distance_threshold: (skip)
- * @object: A #GClueClient.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.DistanceThreshold">"DistanceThreshold"</link>
- * D-Bus property.
- *
- * Since this D-Bus property is both readable and writable, it is meaningful to use this function on
- * both the client- and service-side.
- *
- * Returns: The property value.
- */
-guint gclue_client_get_distance_threshold(GClueClient *object) {
-    g_return_val_if_fail(GCLUE_IS_CLIENT(object), 0);
-
-    return GCLUE_CLIENT_GET_IFACE(object)->get_distance_threshold(object);
-}
-
-/**
- * gclue_client_set_distance_threshold: (skip)
- * @object: A #GClueClient.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.DistanceThreshold">"DistanceThreshold"</link>
- * D-Bus property to @value.
- *
- * Since this D-Bus property is both readable and writable, it is meaningful to use this function on
- * both the client- and service-side.
- */
-void gclue_client_set_distance_threshold(GClueClient *object, guint value) {
-    g_object_set(G_OBJECT(object), "distance-threshold", value, NULL);
-}
-
-/**
- * gclue_client_get_time_threshold: (skip)
- * @object: A #GClueClient.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.TimeThreshold">"TimeThreshold"</link>
- * D-Bus property.
- *
- * Since this D-Bus property is both readable and writable, it is meaningful to use this function on
- * both the client- and service-side.
- *
- * Returns: The property value.
- */
-guint gclue_client_get_time_threshold(GClueClient *object) {
-    g_return_val_if_fail(GCLUE_IS_CLIENT(object), 0);
-
-    return GCLUE_CLIENT_GET_IFACE(object)->get_time_threshold(object);
-}
-
-/**
- * gclue_client_set_time_threshold: (skip)
- * @object: A #GClueClient.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.TimeThreshold">"TimeThreshold"</link>
- * D-Bus property to @value.
- *
- * Since this D-Bus property is both readable and writable, it is meaningful to use this function on
- * both the client- and service-side.
- */
-void gclue_client_set_time_threshold(GClueClient *object, guint value) {
-    g_object_set(G_OBJECT(object), "time-threshold", value, NULL);
-}
-
-/**
- * gclue_client_get_desktop_id: (skip)
- * @object: A #GClueClient.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.DesktopId">"DesktopId"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is both readable and writable, it is meaningful to use this function on
- * both the client- and service-side.
- *
- * The returned value is only valid until the property changes so on the client-side it is only safe
- * to use this function on the thread where @object was constructed. Use
- * gclue_client_dup_desktop_id() if on another thread.
- *
- * Returns: (transfer none) (nullable): The property value or %NULL if the property is not set. Do
- * not free the returned value, it belongs to @object.
- */
-const gchar *gclue_client_get_desktop_id(GClueClient *object) {
-    g_return_val_if_fail(GCLUE_IS_CLIENT(object), NULL);
-
-    return GCLUE_CLIENT_GET_IFACE(object)->get_desktop_id(object);
-}
-
-/**
- * gclue_client_dup_desktop_id: (skip)
- * @object: A #GClueClient.
- *
- * Gets a copy of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.DesktopId">"DesktopId"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is both readable and writable, it is meaningful to use this function on
- * both the client- and service-side.
- *
- * Returns: (transfer full) (nullable): The property value or %NULL if the property is not set. The
- * returned value should be freed with g_free().
- */
-gchar *gclue_client_dup_desktop_id(GClueClient *object) {
-    gchar *value;
-    g_object_get(G_OBJECT(object), "desktop-id", &value, NULL);
-    return value;
-}
-
-/**
- * gclue_client_set_desktop_id: (skip)
- * @object: A #GClueClient.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.DesktopId">"DesktopId"</link> D-Bus
- * property to @value.
- *
- * Since this D-Bus property is both readable and writable, it is meaningful to use this function on
- * both the client- and service-side.
- */
-void gclue_client_set_desktop_id(GClueClient *object, const gchar *value) {
-    g_object_set(G_OBJECT(object), "desktop-id", value, NULL);
-}
-
-/**
- * gclue_client_get_requested_accuracy_level: (skip)
- * @object: A #GClueClient.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.RequestedAccuracyLevel">"RequestedAccuracyLevel"</link>
- * D-Bus property.
- *
- * Since this D-Bus property is both readable and writable, it is meaningful to use this function on
- * both the client- and service-side.
- *
- * Returns: The property value.
- */
-guint gclue_client_get_requested_accuracy_level(GClueClient *object) {
-    g_return_val_if_fail(GCLUE_IS_CLIENT(object), 0);
-
-    return GCLUE_CLIENT_GET_IFACE(object)->get_requested_accuracy_level(object);
-}
-
-/**
- * gclue_client_set_requested_accuracy_level: (skip)
- * @object: A #GClueClient.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.RequestedAccuracyLevel">"RequestedAccuracyLevel"</link>
- * D-Bus property to @value.
- *
- * Since this D-Bus property is both readable and writable, it is meaningful to use this function on
- * both the client- and service-side.
- */
-void gclue_client_set_requested_accuracy_level(GClueClient *object, guint value) {
-    g_object_set(G_OBJECT(object), "requested-accuracy-level", value, NULL);
-}
-
-/**
- * gclue_client_get_active: (skip)
- * @object: A #GClueClient.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Client.Active">"Active"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * Returns: The property value.
- */
-gboolean gclue_client_get_active(GClueClient *object) {
-    g_return_val_if_fail(GCLUE_IS_CLIENT(object), FALSE);
-
-    return GCLUE_CLIENT_GET_IFACE(object)->get_active(object);
-}
-
-/**
- * gclue_client_set_active: (skip)
- * @object: A #GClueClient.
- * @value: The value to set.
- *
- * Sets the <link linkend="gdbus-property-org-freedesktop-GeoClue2-Client.Active">"Active"</link>
- * D-Bus property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the
- * service-side.
- */
-void gclue_client_set_active(GClueClient *object, gboolean value) {
-    g_object_set(G_OBJECT(object), "active", value, NULL);
-}
-
-/**
- * gclue_client_emit_location_updated:
- * @object: A #GClueClient.
- * @arg_old: Argument to pass with the signal.
- * @arg_new: Argument to pass with the signal.
- *
- * Emits the <link
- * linkend="gdbus-signal-org-freedesktop-GeoClue2-Client.LocationUpdated">"LocationUpdated"</link>
- * D-Bus signal.
- */
-void gclue_client_emit_location_updated(GClueClient *object, const gchar *arg_old,
-                                        const gchar *arg_new) {
-    g_signal_emit(object, GCLUE__CLIENT_SIGNALS[GCLUE__CLIENT_LOCATION_UPDATED], 0, arg_old,
-                  arg_new);
-}
-
-/**
- * gclue_client_call_start:
- * @proxy: A #GClueClientProxy.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
- * @user_data: User data to pass to @callback.
- *
- * Asynchronously invokes the <link
- * linkend="gdbus-method-org-freedesktop-GeoClue2-Client.Start">Start()</link> D-Bus method on
- * @proxy. When the operation is finished, @callback will be invoked in the thread-default main loop
- * of the thread you are calling this method from (see g_main_context_push_thread_default()). You
- * can then call gclue_client_call_start_finish() to get the result of the operation.
- *
- * See gclue_client_call_start_sync() for the synchronous, blocking version of this method.
- */
-void gclue_client_call_start(GClueClient *proxy, GCancellable *cancellable,
-                             GAsyncReadyCallback callback, gpointer user_data) {
-    g_dbus_proxy_call(G_DBUS_PROXY(proxy), "Start", g_variant_new("()"), G_DBUS_CALL_FLAGS_NONE, -1,
-                      cancellable, callback, user_data);
-}
-
-/**
- * gclue_client_call_start_finish:
- * @proxy: A #GClueClientProxy.
- * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
- * gclue_client_call_start().
- * @error: Return location for error or %NULL.
- *
- * Finishes an operation started with gclue_client_call_start().
- *
- * Returns: (skip): %TRUE if the call succeeded, %FALSE if @error is set.
- */
-gboolean gclue_client_call_start_finish(GClueClient *proxy, GAsyncResult *res, GError **error) {
-    GVariant *_ret;
-    _ret = g_dbus_proxy_call_finish(G_DBUS_PROXY(proxy), res, error);
-    if (_ret == NULL)
-        goto _out;
-    g_variant_get(_ret, "()");
-    g_variant_unref(_ret);
-_out:
-    return _ret != NULL;
-}
-
-/**
- * gclue_client_call_start_sync:
- * @proxy: A #GClueClientProxy.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @error: Return location for error or %NULL.
- *
- * Synchronously invokes the <link
- * linkend="gdbus-method-org-freedesktop-GeoClue2-Client.Start">Start()</link> D-Bus method on
- * @proxy. The calling thread is blocked until a reply is received.
- *
- * See gclue_client_call_start() for the asynchronous version of this method.
- *
- * Returns: (skip): %TRUE if the call succeeded, %FALSE if @error is set.
- */
-gboolean gclue_client_call_start_sync(GClueClient *proxy, GCancellable *cancellable,
-                                      GError **error) {
-    GVariant *_ret;
-    _ret = g_dbus_proxy_call_sync(G_DBUS_PROXY(proxy), "Start", g_variant_new("()"),
-                                  G_DBUS_CALL_FLAGS_NONE, -1, cancellable, error);
-    if (_ret == NULL)
-        goto _out;
-    g_variant_get(_ret, "()");
-    g_variant_unref(_ret);
-_out:
-    return _ret != NULL;
-}
-
-/**
- * gclue_client_call_stop:
- * @proxy: A #GClueClientProxy.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @callback: A #GAsyncReadyCallback to call when the request is satisfied or %NULL.
- * @user_data: User data to pass to @callback.
- *
- * Asynchronously invokes the <link
- * linkend="gdbus-method-org-freedesktop-GeoClue2-Client.Stop">Stop()</link> D-Bus method on @proxy.
- * When the operation is finished, @callback will be invoked in the thread-default main loop of the
- * thread you are calling this method from (see g_main_context_push_thread_default()). You can then
- * call gclue_client_call_stop_finish() to get the result of the operation.
- *
- * See gclue_client_call_stop_sync() for the synchronous, blocking version of this method.
- */
-void gclue_client_call_stop(GClueClient *proxy, GCancellable *cancellable,
-                            GAsyncReadyCallback callback, gpointer user_data) {
-    g_dbus_proxy_call(G_DBUS_PROXY(proxy), "Stop", g_variant_new("()"), G_DBUS_CALL_FLAGS_NONE, -1,
-                      cancellable, callback, user_data);
-}
-
-/**
- * gclue_client_call_stop_finish:
- * @proxy: A #GClueClientProxy.
- * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
- * gclue_client_call_stop().
- * @error: Return location for error or %NULL.
- *
- * Finishes an operation started with gclue_client_call_stop().
- *
- * Returns: (skip): %TRUE if the call succeeded, %FALSE if @error is set.
- */
-gboolean gclue_client_call_stop_finish(GClueClient *proxy, GAsyncResult *res, GError **error) {
-    GVariant *_ret;
-    _ret = g_dbus_proxy_call_finish(G_DBUS_PROXY(proxy), res, error);
-    if (_ret == NULL)
-        goto _out;
-    g_variant_get(_ret, "()");
-    g_variant_unref(_ret);
-_out:
-    return _ret != NULL;
-}
-
-/**
- * gclue_client_call_stop_sync:
- * @proxy: A #GClueClientProxy.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @error: Return location for error or %NULL.
- *
- * Synchronously invokes the <link
- * linkend="gdbus-method-org-freedesktop-GeoClue2-Client.Stop">Stop()</link> D-Bus method on @proxy.
- * The calling thread is blocked until a reply is received.
- *
- * See gclue_client_call_stop() for the asynchronous version of this method.
- *
- * Returns: (skip): %TRUE if the call succeeded, %FALSE if @error is set.
- */
-gboolean gclue_client_call_stop_sync(GClueClient *proxy, GCancellable *cancellable,
-                                     GError **error) {
-    GVariant *_ret;
-    _ret = g_dbus_proxy_call_sync(G_DBUS_PROXY(proxy), "Stop", g_variant_new("()"),
-                                  G_DBUS_CALL_FLAGS_NONE, -1, cancellable, error);
-    if (_ret == NULL)
-        goto _out;
-    g_variant_get(_ret, "()");
-    g_variant_unref(_ret);
-_out:
-    return _ret != NULL;
-}
-
-/**
- * gclue_client_complete_start:
- * @object: A #GClueClient.
- * @invocation: (transfer full): A #GDBusMethodInvocation.
- *
- * Helper function used in service implementations to finish handling invocations of the <link
- * linkend="gdbus-method-org-freedesktop-GeoClue2-Client.Start">Start()</link> D-Bus method. If you
- * instead want to finish handling an invocation by returning an error, use
- * g_dbus_method_invocation_return_error() or similar.
- *
- * This method will free @invocation, you cannot use it afterwards.
- */
-void gclue_client_complete_start(GClueClient *object G_GNUC_UNUSED,
-                                 GDBusMethodInvocation *invocation) {
-    g_dbus_method_invocation_return_value(invocation, g_variant_new("()"));
-}
-
-/**
- * gclue_client_complete_stop:
- * @object: A #GClueClient.
- * @invocation: (transfer full): A #GDBusMethodInvocation.
- *
- * Helper function used in service implementations to finish handling invocations of the <link
- * linkend="gdbus-method-org-freedesktop-GeoClue2-Client.Stop">Stop()</link> D-Bus method. If you
- * instead want to finish handling an invocation by returning an error, use
- * g_dbus_method_invocation_return_error() or similar.
- *
- * This method will free @invocation, you cannot use it afterwards.
- */
-void gclue_client_complete_stop(GClueClient *object G_GNUC_UNUSED,
-                                GDBusMethodInvocation *invocation) {
-    g_dbus_method_invocation_return_value(invocation, g_variant_new("()"));
-}
-
-/* ------------------------------------------------------------------------ */
-
-/**
- * GClueClientProxy:
- *
- * The #GClueClientProxy structure contains only private data and should only be accessed using the
- * provided API.
- */
-
-/**
- * GClueClientProxyClass:
- * @parent_class: The parent class.
- *
- * Class structure for #GClueClientProxy.
- */
-
-struct _GClueClientProxyPrivate {
-    GData *qdata;
-};
-
-static void gclue_client_proxy_iface_init(GClueClientIface *iface);
-
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-G_DEFINE_TYPE_WITH_CODE(GClueClientProxy, gclue_client_proxy, G_TYPE_DBUS_PROXY,
-                        G_ADD_PRIVATE(GClueClientProxy)
-                            G_IMPLEMENT_INTERFACE(GCLUE_TYPE_CLIENT, gclue_client_proxy_iface_init))
-
-#else
-G_DEFINE_TYPE_WITH_CODE(GClueClientProxy, gclue_client_proxy, G_TYPE_DBUS_PROXY,
-                        G_IMPLEMENT_INTERFACE(GCLUE_TYPE_CLIENT, gclue_client_proxy_iface_init))
-
-#endif
-static void gclue_client_proxy_finalize(GObject *object) {
-    GClueClientProxy *proxy = GCLUE_CLIENT_PROXY(object);
-    g_datalist_clear(&proxy->priv->qdata);
-    G_OBJECT_CLASS(gclue_client_proxy_parent_class)->finalize(object);
-}
-
-static void gclue_client_proxy_get_property(GObject *object, guint prop_id, GValue *value,
-                                            GParamSpec *pspec G_GNUC_UNUSED) {
-    const _ExtendedGDBusPropertyInfo *info;
-    GVariant *variant;
-    g_assert(prop_id != 0 && prop_id - 1 < 6);
-    info = (const _ExtendedGDBusPropertyInfo *)_gclue_client_property_info_pointers[prop_id - 1];
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(object), info->parent_struct.name);
-    if (info->use_gvariant) {
-        g_value_set_variant(value, variant);
-    } else {
-        if (variant != NULL)
-            g_dbus_gvariant_to_gvalue(variant, value);
-    }
-    if (variant != NULL)
-        g_variant_unref(variant);
-}
-
-static void gclue_client_proxy_set_property_cb(GDBusProxy *proxy, GAsyncResult *res,
-                                               gpointer user_data) {
-    const _ExtendedGDBusPropertyInfo *info = user_data;
-    GError *error;
-    GVariant *_ret;
-    error = NULL;
-    _ret = g_dbus_proxy_call_finish(proxy, res, &error);
-    if (!_ret) {
-        g_warning(
-            "Error setting property '%s' on interface org.freedesktop.GeoClue2.Client: %s (%s, %d)",
-            info->parent_struct.name, error->message, g_quark_to_string(error->domain),
-            error->code);
-        g_error_free(error);
-    } else {
-        g_variant_unref(_ret);
-    }
-}
-
-static void gclue_client_proxy_set_property(GObject *object, guint prop_id, const GValue *value,
-                                            GParamSpec *pspec G_GNUC_UNUSED) {
-    const _ExtendedGDBusPropertyInfo *info;
-    GVariant *variant;
-    g_assert(prop_id != 0 && prop_id - 1 < 6);
-    info = (const _ExtendedGDBusPropertyInfo *)_gclue_client_property_info_pointers[prop_id - 1];
-    variant = g_dbus_gvalue_to_gvariant(value, G_VARIANT_TYPE(info->parent_struct.signature));
-    g_dbus_proxy_call(G_DBUS_PROXY(object), "org.freedesktop.DBus.Properties.Set",
-                      g_variant_new("(ssv)", "org.freedesktop.GeoClue2.Client",
-                                    info->parent_struct.name, variant),
-                      G_DBUS_CALL_FLAGS_NONE, -1, NULL,
-                      (GAsyncReadyCallback)gclue_client_proxy_set_property_cb,
-                      (GDBusPropertyInfo *)&info->parent_struct);
-    g_variant_unref(variant);
-}
-
-static void gclue_client_proxy_g_signal(GDBusProxy *proxy, const gchar *sender_name G_GNUC_UNUSED,
-                                        const gchar *signal_name, GVariant *parameters) {
-    _ExtendedGDBusSignalInfo *info;
-    GVariantIter iter;
-    GVariant *child;
-    GValue *paramv;
-    gsize num_params;
-    gsize n;
-    guint signal_id;
-    info = (_ExtendedGDBusSignalInfo *)g_dbus_interface_info_lookup_signal(
-        (GDBusInterfaceInfo *)&_gclue_client_interface_info.parent_struct, signal_name);
-    if (info == NULL)
-        return;
-    num_params = g_variant_n_children(parameters);
-    paramv = g_new0(GValue, num_params + 1);
-    g_value_init(&paramv[0], GCLUE_TYPE_CLIENT);
-    g_value_set_object(&paramv[0], proxy);
-    g_variant_iter_init(&iter, parameters);
-    n = 1;
-    while ((child = g_variant_iter_next_value(&iter)) != NULL) {
-        _ExtendedGDBusArgInfo *arg_info = (_ExtendedGDBusArgInfo *)info->parent_struct.args[n - 1];
-        if (arg_info->use_gvariant) {
-            g_value_init(&paramv[n], G_TYPE_VARIANT);
-            g_value_set_variant(&paramv[n], child);
-            n++;
-        } else
-            g_dbus_gvariant_to_gvalue(child, &paramv[n++]);
-        g_variant_unref(child);
-    }
-    signal_id = g_signal_lookup(info->signal_name, GCLUE_TYPE_CLIENT);
-    g_signal_emitv(paramv, signal_id, 0, NULL);
-    for (n = 0; n < num_params + 1; n++)
-        g_value_unset(&paramv[n]);
-    g_free(paramv);
-}
-
-static void gclue_client_proxy_g_properties_changed(GDBusProxy *_proxy,
-                                                    GVariant *changed_properties,
-                                                    const gchar *const *invalidated_properties) {
-    GClueClientProxy *proxy = GCLUE_CLIENT_PROXY(_proxy);
-    guint n;
-    const gchar *key;
-    GVariantIter *iter;
-    _ExtendedGDBusPropertyInfo *info;
-    g_variant_get(changed_properties, "a{sv}", &iter);
-    while (g_variant_iter_next(iter, "{&sv}", &key, NULL)) {
-        info = (_ExtendedGDBusPropertyInfo *)g_dbus_interface_info_lookup_property(
-            (GDBusInterfaceInfo *)&_gclue_client_interface_info.parent_struct, key);
-        g_datalist_remove_data(&proxy->priv->qdata, key);
-        if (info != NULL)
-            g_object_notify(G_OBJECT(proxy), info->hyphen_name);
-    }
-    g_variant_iter_free(iter);
-    for (n = 0; invalidated_properties[n] != NULL; n++) {
-        info = (_ExtendedGDBusPropertyInfo *)g_dbus_interface_info_lookup_property(
-            (GDBusInterfaceInfo *)&_gclue_client_interface_info.parent_struct,
-            invalidated_properties[n]);
-        g_datalist_remove_data(&proxy->priv->qdata, invalidated_properties[n]);
-        if (info != NULL)
-            g_object_notify(G_OBJECT(proxy), info->hyphen_name);
-    }
-}
-
-static const gchar *gclue_client_proxy_get_location(GClueClient *object) {
-    GClueClientProxy *proxy = GCLUE_CLIENT_PROXY(object);
-    GVariant *variant;
-    const gchar *value = NULL;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "Location");
-    if (variant != NULL) {
-        value = g_variant_get_string(variant, NULL);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static guint gclue_client_proxy_get_distance_threshold(GClueClient *object) {
-    GClueClientProxy *proxy = GCLUE_CLIENT_PROXY(object);
-    GVariant *variant;
-    guint value = 0;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "DistanceThreshold");
-    if (variant != NULL) {
-        value = g_variant_get_uint32(variant);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static guint gclue_client_proxy_get_time_threshold(GClueClient *object) {
-    GClueClientProxy *proxy = GCLUE_CLIENT_PROXY(object);
-    GVariant *variant;
-    guint value = 0;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "TimeThreshold");
-    if (variant != NULL) {
-        value = g_variant_get_uint32(variant);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static const gchar *gclue_client_proxy_get_desktop_id(GClueClient *object) {
-    GClueClientProxy *proxy = GCLUE_CLIENT_PROXY(object);
-    GVariant *variant;
-    const gchar *value = NULL;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "DesktopId");
-    if (variant != NULL) {
-        value = g_variant_get_string(variant, NULL);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static guint gclue_client_proxy_get_requested_accuracy_level(GClueClient *object) {
-    GClueClientProxy *proxy = GCLUE_CLIENT_PROXY(object);
-    GVariant *variant;
-    guint value = 0;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "RequestedAccuracyLevel");
-    if (variant != NULL) {
-        value = g_variant_get_uint32(variant);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static gboolean gclue_client_proxy_get_active(GClueClient *object) {
-    GClueClientProxy *proxy = GCLUE_CLIENT_PROXY(object);
-    GVariant *variant;
-    gboolean value = FALSE;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "Active");
-    if (variant != NULL) {
-        value = g_variant_get_boolean(variant);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static void gclue_client_proxy_init(GClueClientProxy *proxy) {
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-    proxy->priv = gclue_client_proxy_get_instance_private(proxy);
-#else
-    proxy->priv =
-        G_TYPE_INSTANCE_GET_PRIVATE(proxy, GCLUE_TYPE_CLIENT_PROXY, GClueClientProxyPrivate);
-#endif
-
-    g_dbus_proxy_set_interface_info(G_DBUS_PROXY(proxy), gclue_client_interface_info());
-}
-
-static void gclue_client_proxy_class_init(GClueClientProxyClass *klass) {
-    GObjectClass *gobject_class;
-    GDBusProxyClass *proxy_class;
-
-    gobject_class = G_OBJECT_CLASS(klass);
-    gobject_class->finalize = gclue_client_proxy_finalize;
-    gobject_class->get_property = gclue_client_proxy_get_property;
-    gobject_class->set_property = gclue_client_proxy_set_property;
-
-    proxy_class = G_DBUS_PROXY_CLASS(klass);
-    proxy_class->g_signal = gclue_client_proxy_g_signal;
-    proxy_class->g_properties_changed = gclue_client_proxy_g_properties_changed;
-
-    gclue_client_override_properties(gobject_class, 1);
-
-#if GLIB_VERSION_MAX_ALLOWED < GLIB_VERSION_2_38
-    g_type_class_add_private(klass, sizeof(GClueClientProxyPrivate));
-#endif
-}
-
-static void gclue_client_proxy_iface_init(GClueClientIface *iface) {
-    iface->get_location = gclue_client_proxy_get_location;
-    iface->get_distance_threshold = gclue_client_proxy_get_distance_threshold;
-    iface->get_time_threshold = gclue_client_proxy_get_time_threshold;
-    iface->get_desktop_id = gclue_client_proxy_get_desktop_id;
-    iface->get_requested_accuracy_level = gclue_client_proxy_get_requested_accuracy_level;
-    iface->get_active = gclue_client_proxy_get_active;
-}
-
-/**
- * gclue_client_proxy_new:
- * @connection: A #GDBusConnection.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: (nullable): A bus name (well-known or unique) or %NULL if @connection is not a message bus
- * connection.
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @callback: A #GAsyncReadyCallback to call when the request is satisfied.
- * @user_data: User data to pass to @callback.
- *
- * Asynchronously creates a proxy for the D-Bus interface <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Client.top_of_page">org.freedesktop.GeoClue2.Client</link>.
- * See g_dbus_proxy_new() for more details.
- *
- * When the operation is finished, @callback will be invoked in the thread-default main loop of the
- * thread you are calling this method from (see g_main_context_push_thread_default()). You can then
- * call gclue_client_proxy_new_finish() to get the result of the operation.
- *
- * See gclue_client_proxy_new_sync() for the synchronous, blocking version of this constructor.
- */
-void gclue_client_proxy_new(GDBusConnection *connection, GDBusProxyFlags flags, const gchar *name,
-                            const gchar *object_path, GCancellable *cancellable,
-                            GAsyncReadyCallback callback, gpointer user_data) {
-    g_async_initable_new_async(GCLUE_TYPE_CLIENT_PROXY, G_PRIORITY_DEFAULT, cancellable, callback,
-                               user_data, "g-flags", flags, "g-name", name, "g-connection",
-                               connection, "g-object-path", object_path, "g-interface-name",
-                               "org.freedesktop.GeoClue2.Client", NULL);
-}
-
-/**
- * gclue_client_proxy_new_finish:
- * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
- * gclue_client_proxy_new().
- * @error: Return location for error or %NULL
- *
- * Finishes an operation started with gclue_client_proxy_new().
- *
- * Returns: (transfer full) (type GClueClientProxy): The constructed proxy object or %NULL if @error
- * is set.
- */
-GClueClient *gclue_client_proxy_new_finish(GAsyncResult *res, GError **error) {
-    GObject *ret;
-    GObject *source_object;
-    source_object = g_async_result_get_source_object(res);
-    ret = g_async_initable_new_finish(G_ASYNC_INITABLE(source_object), res, error);
-    g_object_unref(source_object);
-    if (ret != NULL)
-        return GCLUE_CLIENT(ret);
-    else
-        return NULL;
-}
-
-/**
- * gclue_client_proxy_new_sync:
- * @connection: A #GDBusConnection.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: (nullable): A bus name (well-known or unique) or %NULL if @connection is not a message bus
- * connection.
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @error: Return location for error or %NULL
- *
- * Synchronously creates a proxy for the D-Bus interface <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Client.top_of_page">org.freedesktop.GeoClue2.Client</link>.
- * See g_dbus_proxy_new_sync() for more details.
- *
- * The calling thread is blocked until a reply is received.
- *
- * See gclue_client_proxy_new() for the asynchronous version of this constructor.
- *
- * Returns: (transfer full) (type GClueClientProxy): The constructed proxy object or %NULL if @error
- * is set.
- */
-GClueClient *gclue_client_proxy_new_sync(GDBusConnection *connection, GDBusProxyFlags flags,
-                                         const gchar *name, const gchar *object_path,
-                                         GCancellable *cancellable, GError **error) {
-    GInitable *ret;
-    ret = g_initable_new(GCLUE_TYPE_CLIENT_PROXY, cancellable, error, "g-flags", flags, "g-name",
-                         name, "g-connection", connection, "g-object-path", object_path,
-                         "g-interface-name", "org.freedesktop.GeoClue2.Client", NULL);
-    if (ret != NULL)
-        return GCLUE_CLIENT(ret);
-    else
-        return NULL;
-}
-
-/**
- * gclue_client_proxy_new_for_bus:
- * @bus_type: A #GBusType.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: A bus name (well-known or unique).
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @callback: A #GAsyncReadyCallback to call when the request is satisfied.
- * @user_data: User data to pass to @callback.
- *
- * Like gclue_client_proxy_new() but takes a #GBusType instead of a #GDBusConnection.
- *
- * When the operation is finished, @callback will be invoked in the thread-default main loop of the
- * thread you are calling this method from (see g_main_context_push_thread_default()). You can then
- * call gclue_client_proxy_new_for_bus_finish() to get the result of the operation.
- *
- * See gclue_client_proxy_new_for_bus_sync() for the synchronous, blocking version of this
- * constructor.
- */
-void gclue_client_proxy_new_for_bus(GBusType bus_type, GDBusProxyFlags flags, const gchar *name,
-                                    const gchar *object_path, GCancellable *cancellable,
-                                    GAsyncReadyCallback callback, gpointer user_data) {
-    g_async_initable_new_async(GCLUE_TYPE_CLIENT_PROXY, G_PRIORITY_DEFAULT, cancellable, callback,
-                               user_data, "g-flags", flags, "g-name", name, "g-bus-type", bus_type,
-                               "g-object-path", object_path, "g-interface-name",
-                               "org.freedesktop.GeoClue2.Client", NULL);
-}
-
-/**
- * gclue_client_proxy_new_for_bus_finish:
- * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
- * gclue_client_proxy_new_for_bus().
- * @error: Return location for error or %NULL
- *
- * Finishes an operation started with gclue_client_proxy_new_for_bus().
- *
- * Returns: (transfer full) (type GClueClientProxy): The constructed proxy object or %NULL if @error
- * is set.
- */
-GClueClient *gclue_client_proxy_new_for_bus_finish(GAsyncResult *res, GError **error) {
-    GObject *ret;
-    GObject *source_object;
-    source_object = g_async_result_get_source_object(res);
-    ret = g_async_initable_new_finish(G_ASYNC_INITABLE(source_object), res, error);
-    g_object_unref(source_object);
-    if (ret != NULL)
-        return GCLUE_CLIENT(ret);
-    else
-        return NULL;
-}
-
-/**
- * gclue_client_proxy_new_for_bus_sync:
- * @bus_type: A #GBusType.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: A bus name (well-known or unique).
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @error: Return location for error or %NULL
- *
- * Like gclue_client_proxy_new_sync() but takes a #GBusType instead of a #GDBusConnection.
- *
- * The calling thread is blocked until a reply is received.
- *
- * See gclue_client_proxy_new_for_bus() for the asynchronous version of this constructor.
- *
- * Returns: (transfer full) (type GClueClientProxy): The constructed proxy object or %NULL if @error
- * is set.
- */
-GClueClient *gclue_client_proxy_new_for_bus_sync(GBusType bus_type, GDBusProxyFlags flags,
-                                                 const gchar *name, const gchar *object_path,
-                                                 GCancellable *cancellable, GError **error) {
-    GInitable *ret;
-    ret = g_initable_new(GCLUE_TYPE_CLIENT_PROXY, cancellable, error, "g-flags", flags, "g-name",
-                         name, "g-bus-type", bus_type, "g-object-path", object_path,
-                         "g-interface-name", "org.freedesktop.GeoClue2.Client", NULL);
-    if (ret != NULL)
-        return GCLUE_CLIENT(ret);
-    else
-        return NULL;
-}
-
-/* ------------------------------------------------------------------------ */
-
-/**
- * GClueClientSkeleton:
- *
- * The #GClueClientSkeleton structure contains only private data and should only be accessed using
- * the provided API.
- */
-
-/**
- * GClueClientSkeletonClass:
- * @parent_class: The parent class.
- *
- * Class structure for #GClueClientSkeleton.
- */
-
-struct _GClueClientSkeletonPrivate {
-    GValue *properties;
-    GList *changed_properties;
-    GSource *changed_properties_idle_source;
-    GMainContext *context;
-    GMutex lock;
-};
-
-static void _gclue_client_skeleton_handle_method_call(
-    GDBusConnection *connection G_GNUC_UNUSED, const gchar *sender G_GNUC_UNUSED,
-    const gchar *object_path G_GNUC_UNUSED, const gchar *interface_name, const gchar *method_name,
-    GVariant *parameters, GDBusMethodInvocation *invocation, gpointer user_data) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(user_data);
-    _ExtendedGDBusMethodInfo *info;
-    GVariantIter iter;
-    GVariant *child;
-    GValue *paramv;
-    gsize num_params;
-    guint num_extra;
-    gsize n;
-    guint signal_id;
-    GValue return_value = G_VALUE_INIT;
-    info = (_ExtendedGDBusMethodInfo *)g_dbus_method_invocation_get_method_info(invocation);
-    g_assert(info != NULL);
-    num_params = g_variant_n_children(parameters);
-    num_extra = info->pass_fdlist ? 3 : 2;
-    paramv = g_new0(GValue, num_params + num_extra);
-    n = 0;
-    g_value_init(&paramv[n], GCLUE_TYPE_CLIENT);
-    g_value_set_object(&paramv[n++], skeleton);
-    g_value_init(&paramv[n], G_TYPE_DBUS_METHOD_INVOCATION);
-    g_value_set_object(&paramv[n++], invocation);
-    if (info->pass_fdlist) {
-#ifdef G_OS_UNIX
-        g_value_init(&paramv[n], G_TYPE_UNIX_FD_LIST);
-        g_value_set_object(&paramv[n++], g_dbus_message_get_unix_fd_list(
-                                             g_dbus_method_invocation_get_message(invocation)));
-#else
-        g_assert_not_reached();
-#endif
-    }
-    g_variant_iter_init(&iter, parameters);
-    while ((child = g_variant_iter_next_value(&iter)) != NULL) {
-        _ExtendedGDBusArgInfo *arg_info =
-            (_ExtendedGDBusArgInfo *)info->parent_struct.in_args[n - num_extra];
-        if (arg_info->use_gvariant) {
-            g_value_init(&paramv[n], G_TYPE_VARIANT);
-            g_value_set_variant(&paramv[n], child);
-            n++;
-        } else
-            g_dbus_gvariant_to_gvalue(child, &paramv[n++]);
-        g_variant_unref(child);
-    }
-    signal_id = g_signal_lookup(info->signal_name, GCLUE_TYPE_CLIENT);
-    g_value_init(&return_value, G_TYPE_BOOLEAN);
-    g_signal_emitv(paramv, signal_id, 0, &return_value);
-    if (!g_value_get_boolean(&return_value))
-        g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD,
-                                              "Method %s is not implemented on interface %s",
-                                              method_name, interface_name);
-    g_value_unset(&return_value);
-    for (n = 0; n < num_params + num_extra; n++)
-        g_value_unset(&paramv[n]);
-    g_free(paramv);
-}
-
-static GVariant *_gclue_client_skeleton_handle_get_property(
-    GDBusConnection *connection G_GNUC_UNUSED, const gchar *sender G_GNUC_UNUSED,
-    const gchar *object_path G_GNUC_UNUSED, const gchar *interface_name G_GNUC_UNUSED,
-    const gchar *property_name, GError **error, gpointer user_data) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(user_data);
-    GValue value = G_VALUE_INIT;
-    GParamSpec *pspec;
-    _ExtendedGDBusPropertyInfo *info;
-    GVariant *ret;
-    ret = NULL;
-    info = (_ExtendedGDBusPropertyInfo *)g_dbus_interface_info_lookup_property(
-        (GDBusInterfaceInfo *)&_gclue_client_interface_info.parent_struct, property_name);
-    g_assert(info != NULL);
-    pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(skeleton), info->hyphen_name);
-    if (pspec == NULL) {
-        g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "No property with name %s",
-                    property_name);
-    } else {
-        g_value_init(&value, pspec->value_type);
-        g_object_get_property(G_OBJECT(skeleton), info->hyphen_name, &value);
-        ret = g_dbus_gvalue_to_gvariant(&value, G_VARIANT_TYPE(info->parent_struct.signature));
-        g_value_unset(&value);
-    }
-    return ret;
-}
-
-static gboolean _gclue_client_skeleton_handle_set_property(
-    GDBusConnection *connection G_GNUC_UNUSED, const gchar *sender G_GNUC_UNUSED,
-    const gchar *object_path G_GNUC_UNUSED, const gchar *interface_name G_GNUC_UNUSED,
-    const gchar *property_name, GVariant *variant, GError **error, gpointer user_data) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(user_data);
-    GValue value = G_VALUE_INIT;
-    GParamSpec *pspec;
-    _ExtendedGDBusPropertyInfo *info;
-    gboolean ret;
-    ret = FALSE;
-    info = (_ExtendedGDBusPropertyInfo *)g_dbus_interface_info_lookup_property(
-        (GDBusInterfaceInfo *)&_gclue_client_interface_info.parent_struct, property_name);
-    g_assert(info != NULL);
-    pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(skeleton), info->hyphen_name);
-    if (pspec == NULL) {
-        g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "No property with name %s",
-                    property_name);
-    } else {
-        if (info->use_gvariant)
-            g_value_set_variant(&value, variant);
-        else
-            g_dbus_gvariant_to_gvalue(variant, &value);
-        g_object_set_property(G_OBJECT(skeleton), info->hyphen_name, &value);
-        g_value_unset(&value);
-        ret = TRUE;
-    }
-    return ret;
-}
-
-static const GDBusInterfaceVTable _gclue_client_skeleton_vtable = {
-    _gclue_client_skeleton_handle_method_call,
-    _gclue_client_skeleton_handle_get_property,
-    _gclue_client_skeleton_handle_set_property,
-    {NULL}};
-
-static GDBusInterfaceInfo *
-gclue_client_skeleton_dbus_interface_get_info(GDBusInterfaceSkeleton *skeleton G_GNUC_UNUSED) {
-    return gclue_client_interface_info();
-}
-
-static GDBusInterfaceVTable *
-gclue_client_skeleton_dbus_interface_get_vtable(GDBusInterfaceSkeleton *skeleton G_GNUC_UNUSED) {
-    return (GDBusInterfaceVTable *)&_gclue_client_skeleton_vtable;
-}
-
-static GVariant *
-gclue_client_skeleton_dbus_interface_get_properties(GDBusInterfaceSkeleton *_skeleton) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(_skeleton);
-
-    GVariantBuilder builder;
-    guint n;
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_84
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
-#else
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
-#endif
-    if (_gclue_client_interface_info.parent_struct.properties == NULL)
-        goto out;
-    for (n = 0; _gclue_client_interface_info.parent_struct.properties[n] != NULL; n++) {
-        GDBusPropertyInfo *info = _gclue_client_interface_info.parent_struct.properties[n];
-        if (info->flags & G_DBUS_PROPERTY_INFO_FLAGS_READABLE) {
-            GVariant *value;
-            value = _gclue_client_skeleton_handle_get_property(
-                g_dbus_interface_skeleton_get_connection(G_DBUS_INTERFACE_SKELETON(skeleton)), NULL,
-                g_dbus_interface_skeleton_get_object_path(G_DBUS_INTERFACE_SKELETON(skeleton)),
-                "org.freedesktop.GeoClue2.Client", info->name, NULL, skeleton);
-            if (value != NULL) {
-                g_variant_take_ref(value);
-                g_variant_builder_add(&builder, "{sv}", info->name, value);
-                g_variant_unref(value);
-            }
-        }
-    }
-out:
-    return g_variant_builder_end(&builder);
-}
-
-static gboolean _gclue_client_emit_changed(gpointer user_data);
-
-static void gclue_client_skeleton_dbus_interface_flush(GDBusInterfaceSkeleton *_skeleton) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(_skeleton);
-    gboolean emit_changed = FALSE;
-
-    g_mutex_lock(&skeleton->priv->lock);
-    if (skeleton->priv->changed_properties_idle_source != NULL) {
-        g_source_destroy(skeleton->priv->changed_properties_idle_source);
-        skeleton->priv->changed_properties_idle_source = NULL;
-        emit_changed = TRUE;
-    }
-    g_mutex_unlock(&skeleton->priv->lock);
-
-    if (emit_changed)
-        _gclue_client_emit_changed(skeleton);
-}
-
-static void _gclue_client_on_signal_location_updated(GClueClient *object, const gchar *arg_old,
-                                                     const gchar *arg_new) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-
-    GList *connections, *l;
-    GVariant *signal_variant;
-    connections = g_dbus_interface_skeleton_get_connections(G_DBUS_INTERFACE_SKELETON(skeleton));
-
-    signal_variant = g_variant_ref_sink(g_variant_new("(oo)", arg_old, arg_new));
-    for (l = connections; l != NULL; l = l->next) {
-        GDBusConnection *connection = l->data;
-        g_dbus_connection_emit_signal(
-            connection, NULL,
-            g_dbus_interface_skeleton_get_object_path(G_DBUS_INTERFACE_SKELETON(skeleton)),
-            "org.freedesktop.GeoClue2.Client", "LocationUpdated", signal_variant, NULL);
-    }
-    g_variant_unref(signal_variant);
-    g_list_free_full(connections, g_object_unref);
-}
-
-static void gclue_client_skeleton_iface_init(GClueClientIface *iface);
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-G_DEFINE_TYPE_WITH_CODE(GClueClientSkeleton, gclue_client_skeleton, G_TYPE_DBUS_INTERFACE_SKELETON,
-                        G_ADD_PRIVATE(GClueClientSkeleton)
-                            G_IMPLEMENT_INTERFACE(GCLUE_TYPE_CLIENT,
-                                                  gclue_client_skeleton_iface_init))
-
-#else
-G_DEFINE_TYPE_WITH_CODE(GClueClientSkeleton, gclue_client_skeleton, G_TYPE_DBUS_INTERFACE_SKELETON,
-                        G_IMPLEMENT_INTERFACE(GCLUE_TYPE_CLIENT, gclue_client_skeleton_iface_init))
-
-#endif
-static void gclue_client_skeleton_finalize(GObject *object) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-    guint n;
-    for (n = 0; n < 6; n++)
-        g_value_unset(&skeleton->priv->properties[n]);
-    g_free(skeleton->priv->properties);
-    g_list_free_full(skeleton->priv->changed_properties, (GDestroyNotify)_changed_property_free);
-    if (skeleton->priv->changed_properties_idle_source != NULL)
-        g_source_destroy(skeleton->priv->changed_properties_idle_source);
-    g_main_context_unref(skeleton->priv->context);
-    g_mutex_clear(&skeleton->priv->lock);
-    G_OBJECT_CLASS(gclue_client_skeleton_parent_class)->finalize(object);
-}
-
-static void gclue_client_skeleton_get_property(GObject *object, guint prop_id, GValue *value,
-                                               GParamSpec *pspec G_GNUC_UNUSED) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-    g_assert(prop_id != 0 && prop_id - 1 < 6);
-    g_mutex_lock(&skeleton->priv->lock);
-    g_value_copy(&skeleton->priv->properties[prop_id - 1], value);
-    g_mutex_unlock(&skeleton->priv->lock);
-}
-
-static gboolean _gclue_client_emit_changed(gpointer user_data) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(user_data);
-    GList *l;
-    GVariantBuilder builder;
-    GVariantBuilder invalidated_builder;
-    guint num_changes;
-
-    g_mutex_lock(&skeleton->priv->lock);
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_84
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
-    g_variant_builder_init(&invalidated_builder, G_VARIANT_TYPE("as"));
-#else
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
-    g_variant_builder_init(&invalidated_builder, G_VARIANT_TYPE("as"));
-#endif
-    for (l = skeleton->priv->changed_properties, num_changes = 0; l != NULL; l = l->next) {
-        ChangedProperty *cp = l->data;
-        GVariant *variant;
-        const GValue *cur_value;
-
-        cur_value = &skeleton->priv->properties[cp->prop_id - 1];
-        if (!_g_value_equal(cur_value, &cp->orig_value)) {
-            variant = g_dbus_gvalue_to_gvariant(cur_value,
-                                                G_VARIANT_TYPE(cp->info->parent_struct.signature));
-            g_variant_builder_add(&builder, "{sv}", cp->info->parent_struct.name, variant);
-            g_variant_unref(variant);
-            num_changes++;
-        }
-    }
-    if (num_changes > 0) {
-        GList *connections, *ll;
-        GVariant *signal_variant;
-        signal_variant = g_variant_ref_sink(g_variant_new(
-            "(sa{sv}as)", "org.freedesktop.GeoClue2.Client", &builder, &invalidated_builder));
-        connections =
-            g_dbus_interface_skeleton_get_connections(G_DBUS_INTERFACE_SKELETON(skeleton));
-        for (ll = connections; ll != NULL; ll = ll->next) {
-            GDBusConnection *connection = ll->data;
-
-            g_dbus_connection_emit_signal(
-                connection, NULL,
-                g_dbus_interface_skeleton_get_object_path(G_DBUS_INTERFACE_SKELETON(skeleton)),
-                "org.freedesktop.DBus.Properties", "PropertiesChanged", signal_variant, NULL);
-        }
-        g_variant_unref(signal_variant);
-        g_list_free_full(connections, g_object_unref);
-    } else {
-        g_variant_builder_clear(&builder);
-        g_variant_builder_clear(&invalidated_builder);
-    }
-    g_list_free_full(skeleton->priv->changed_properties, (GDestroyNotify)_changed_property_free);
-    skeleton->priv->changed_properties = NULL;
-    skeleton->priv->changed_properties_idle_source = NULL;
-    g_mutex_unlock(&skeleton->priv->lock);
-    return FALSE;
-}
-
-static void _gclue_client_schedule_emit_changed(GClueClientSkeleton *skeleton,
-                                                const _ExtendedGDBusPropertyInfo *info,
-                                                guint prop_id, const GValue *orig_value) {
-    ChangedProperty *cp;
-    GList *l;
-    cp = NULL;
-    for (l = skeleton->priv->changed_properties; l != NULL; l = l->next) {
-        ChangedProperty *i_cp = l->data;
-        if (i_cp->info == info) {
-            cp = i_cp;
-            break;
-        }
-    }
-    if (cp == NULL) {
-        cp = g_new0(ChangedProperty, 1);
-        cp->prop_id = prop_id;
-        cp->info = info;
-        skeleton->priv->changed_properties = g_list_prepend(skeleton->priv->changed_properties, cp);
-        g_value_init(&cp->orig_value, G_VALUE_TYPE(orig_value));
-        g_value_copy(orig_value, &cp->orig_value);
-    }
-}
-
-static void gclue_client_skeleton_notify(GObject *object, GParamSpec *pspec G_GNUC_UNUSED) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-    g_mutex_lock(&skeleton->priv->lock);
-    if (skeleton->priv->changed_properties != NULL &&
-        skeleton->priv->changed_properties_idle_source == NULL) {
-        skeleton->priv->changed_properties_idle_source = g_idle_source_new();
-        g_source_set_priority(skeleton->priv->changed_properties_idle_source, G_PRIORITY_DEFAULT);
-        g_source_set_callback(skeleton->priv->changed_properties_idle_source,
-                              _gclue_client_emit_changed, g_object_ref(skeleton),
-                              (GDestroyNotify)g_object_unref);
-        g_source_set_name(skeleton->priv->changed_properties_idle_source,
-                          "[generated] _gclue_client_emit_changed");
-        g_source_attach(skeleton->priv->changed_properties_idle_source, skeleton->priv->context);
-        g_source_unref(skeleton->priv->changed_properties_idle_source);
-    }
-    g_mutex_unlock(&skeleton->priv->lock);
-}
-
-static void gclue_client_skeleton_set_property(GObject *object, guint prop_id, const GValue *value,
-                                               GParamSpec *pspec) {
-    const _ExtendedGDBusPropertyInfo *info;
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-    g_assert(prop_id != 0 && prop_id - 1 < 6);
-    info = (const _ExtendedGDBusPropertyInfo *)_gclue_client_property_info_pointers[prop_id - 1];
-    g_mutex_lock(&skeleton->priv->lock);
-    g_object_freeze_notify(object);
-    if (!_g_value_equal(value, &skeleton->priv->properties[prop_id - 1])) {
-        if (g_dbus_interface_skeleton_get_connection(G_DBUS_INTERFACE_SKELETON(skeleton)) != NULL &&
-            info->emits_changed_signal)
-            _gclue_client_schedule_emit_changed(skeleton, info, prop_id,
-                                                &skeleton->priv->properties[prop_id - 1]);
-        g_value_copy(value, &skeleton->priv->properties[prop_id - 1]);
-        g_object_notify_by_pspec(object, pspec);
-    }
-    g_mutex_unlock(&skeleton->priv->lock);
-    g_object_thaw_notify(object);
-}
-
-static void gclue_client_skeleton_init(GClueClientSkeleton *skeleton) {
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-    skeleton->priv = gclue_client_skeleton_get_instance_private(skeleton);
-#else
-    skeleton->priv = G_TYPE_INSTANCE_GET_PRIVATE(skeleton, GCLUE_TYPE_CLIENT_SKELETON,
-                                                 GClueClientSkeletonPrivate);
-#endif
-
-    g_mutex_init(&skeleton->priv->lock);
-    skeleton->priv->context = g_main_context_ref_thread_default();
-    skeleton->priv->properties = g_new0(GValue, 6);
-    g_value_init(&skeleton->priv->properties[0], G_TYPE_STRING);
-    g_value_init(&skeleton->priv->properties[1], G_TYPE_UINT);
-    g_value_init(&skeleton->priv->properties[2], G_TYPE_UINT);
-    g_value_init(&skeleton->priv->properties[3], G_TYPE_STRING);
-    g_value_init(&skeleton->priv->properties[4], G_TYPE_UINT);
-    g_value_init(&skeleton->priv->properties[5], G_TYPE_BOOLEAN);
-}
-
-static const gchar *gclue_client_skeleton_get_location(GClueClient *object) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-    const gchar *value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_string(&(skeleton->priv->properties[0]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static guint gclue_client_skeleton_get_distance_threshold(GClueClient *object) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-    guint value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_uint(&(skeleton->priv->properties[1]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static guint gclue_client_skeleton_get_time_threshold(GClueClient *object) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-    guint value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_uint(&(skeleton->priv->properties[2]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static const gchar *gclue_client_skeleton_get_desktop_id(GClueClient *object) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-    const gchar *value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_string(&(skeleton->priv->properties[3]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static guint gclue_client_skeleton_get_requested_accuracy_level(GClueClient *object) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-    guint value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_uint(&(skeleton->priv->properties[4]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static gboolean gclue_client_skeleton_get_active(GClueClient *object) {
-    GClueClientSkeleton *skeleton = GCLUE_CLIENT_SKELETON(object);
-    gboolean value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_boolean(&(skeleton->priv->properties[5]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static void gclue_client_skeleton_class_init(GClueClientSkeletonClass *klass) {
-    GObjectClass *gobject_class;
-    GDBusInterfaceSkeletonClass *skeleton_class;
-
-    gobject_class = G_OBJECT_CLASS(klass);
-    gobject_class->finalize = gclue_client_skeleton_finalize;
-    gobject_class->get_property = gclue_client_skeleton_get_property;
-    gobject_class->set_property = gclue_client_skeleton_set_property;
-    gobject_class->notify = gclue_client_skeleton_notify;
-
-    gclue_client_override_properties(gobject_class, 1);
-
-    skeleton_class = G_DBUS_INTERFACE_SKELETON_CLASS(klass);
-    skeleton_class->get_info = gclue_client_skeleton_dbus_interface_get_info;
-    skeleton_class->get_properties = gclue_client_skeleton_dbus_interface_get_properties;
-    skeleton_class->flush = gclue_client_skeleton_dbus_interface_flush;
-    skeleton_class->get_vtable = gclue_client_skeleton_dbus_interface_get_vtable;
-
-#if GLIB_VERSION_MAX_ALLOWED < GLIB_VERSION_2_38
-    g_type_class_add_private(klass, sizeof(GClueClientSkeletonPrivate));
-#endif
-}
-
-static void gclue_client_skeleton_iface_init(GClueClientIface *iface) {
-    iface->location_updated = _gclue_client_on_signal_location_updated;
-    iface->get_location = gclue_client_skeleton_get_location;
-    iface->get_distance_threshold = gclue_client_skeleton_get_distance_threshold;
-    iface->get_time_threshold = gclue_client_skeleton_get_time_threshold;
-    iface->get_desktop_id = gclue_client_skeleton_get_desktop_id;
-    iface->get_requested_accuracy_level = gclue_client_skeleton_get_requested_accuracy_level;
-    iface->get_active = gclue_client_skeleton_get_active;
-}
-
-/**
- * gclue_client_skeleton_new:
- *
- * Creates a skeleton object for the D-Bus interface <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Client.top_of_page">org.freedesktop.GeoClue2.Client</link>.
- *
- * Returns: (transfer full) (type GClueClientSkeleton): The skeleton object.
- */
-GClueClient *gclue_client_skeleton_new(void) {
-    return GCLUE_CLIENT(g_object_new(GCLUE_TYPE_CLIENT_SKELETON, NULL));
-}
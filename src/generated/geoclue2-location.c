@@ -1,1715 +0,0 @@
-/*
- * This file is generated by gdbus-codegen, do not modify it.
- *
- * The license of this code is the same as for the D-Bus interface description
- * it was derived from. Note that it links to GLib, so must comply with the
- * LGPL linking clauses.
- */
-
-#ifdef HAVE_CONFIG_H
-#include "config.h"
-#endif
-
-#include "geoclue2-location.h"
-
-#include <string.h>
-#ifdef G_OS_UNIX
-#include <gio/gunixfdlist.h>
-#endif
-
-#ifdef G_ENABLE_DEBUG
-#define g_marshal_value_peek_boolean(v) g_value_get_boolean(v)
-#define g_marshal_value_peek_char(v) g_value_get_schar(v)
-#define g_marshal_value_peek_uchar(v) g_value_get_uchar(v)
-#define g_marshal_value_peek_int(v) g_value_get_int(v)
-#define g_marshal_value_peek_uint(v) g_value_get_uint(v)
-#define g_marshal_value_peek_long(v) g_value_get_long(v)
-#define g_marshal_value_peek_ulong(v) g_value_get_ulong(v)
-#define g_marshal_value_peek_int64(v) g_value_get_int64(v)
-#define g_marshal_value_peek_uint64(v) g_value_get_uint64(v)
-#define g_marshal_value_peek_enum(v) g_value_get_enum(v)
-#define g_marshal_value_peek_flags(v) g_value_get_flags(v)
-#define g_marshal_value_peek_float(v) g_value_get_float(v)
-#define g_marshal_value_peek_double(v) g_value_get_double(v)
-#define g_marshal_value_peek_string(v) (char *)g_value_get_string(v)
-#define g_marshal_value_peek_param(v) g_value_get_param(v)
-#define g_marshal_value_peek_boxed(v) g_value_get_boxed(v)
-#define g_marshal_value_peek_pointer(v) g_value_get_pointer(v)
-#define g_marshal_value_peek_object(v) g_value_get_object(v)
-#define g_marshal_value_peek_variant(v) g_value_get_variant(v)
-#else /* !G_ENABLE_DEBUG */
-/* WARNING: This code accesses GValues directly, which is UNSUPPORTED API.
- *          Do not access GValues directly in your code. Instead, use the
- *          g_value_get_*() functions
- */
-#define g_marshal_value_peek_boolean(v) (v)->data[0].v_int
-#define g_marshal_value_peek_char(v) (v)->data[0].v_int
-#define g_marshal_value_peek_uchar(v) (v)->data[0].v_uint
-#define g_marshal_value_peek_int(v) (v)->data[0].v_int
-#define g_marshal_value_peek_uint(v) (v)->data[0].v_uint
-#define g_marshal_value_peek_long(v) (v)->data[0].v_long
-#define g_marshal_value_peek_ulong(v) (v)->data[0].v_ulong
-#define g_marshal_value_peek_int64(v) (v)->data[0].v_int64
-#define g_marshal_value_peek_uint64(v) (v)->data[0].v_uint64
-#define g_marshal_value_peek_enum(v) (v)->data[0].v_long
-#define g_marshal_value_peek_flags(v) (v)->data[0].v_ulong
-#define g_marshal_value_peek_float(v) (v)->data[0].v_float
-#define g_marshal_value_peek_double(v) (v)->data[0].v_double
-#define g_marshal_value_peek_string(v) (v)->data[0].v_pointer
-#define g_marshal_value_peek_param(v) (v)->data[0].v_pointer
-#define g_marshal_value_peek_boxed(v) (v)->data[0].v_pointer
-#define g_marshal_value_peek_pointer(v) (v)->data[0].v_pointer
-#define g_marshal_value_peek_object(v) (v)->data[0].v_pointer
-#define g_marshal_value_peek_variant(v) (v)->data[0].v_pointer
-#endif /* !G_ENABLE_DEBUG */
-
-typedef struct {
-    GDBusArgInfo parent_struct;
-    gboolean use_gvariant;
-} _ExtendedGDBusArgInfo;
-
-typedef struct {
-    GDBusMethodInfo parent_struct;
-    const gchar *signal_name;
-    gboolean pass_fdlist;
-} _ExtendedGDBusMethodInfo;
-
-typedef struct {
-    GDBusSignalInfo parent_struct;
-    const gchar *signal_name;
-} _ExtendedGDBusSignalInfo;
-
-typedef struct {
-    GDBusPropertyInfo parent_struct;
-    const gchar *hyphen_name;
-    guint use_gvariant : 1;
-    guint emits_changed_signal : 1;
-} _ExtendedGDBusPropertyInfo;
-
-typedef struct {
-    GDBusInterfaceInfo parent_struct;
-    const gchar *hyphen_name;
-} _ExtendedGDBusInterfaceInfo;
-
-typedef struct {
-    const _ExtendedGDBusPropertyInfo *info;
-    guint prop_id;
-    GValue orig_value; /* the value before the change */
-} ChangedProperty;
-
-static void _changed_property_free(ChangedProperty *data) {
-    g_value_unset(&data->orig_value);
-    g_free(data);
-}
-
-static gboolean _g_strv_equal0(gchar **a, gchar **b) {
-    gboolean ret = FALSE;
-    guint n;
-    if (a == NULL && b == NULL) {
-        ret = TRUE;
-        goto out;
-    }
-    if (a == NULL || b == NULL)
-        goto out;
-    if (g_strv_length(a) != g_strv_length(b))
-        goto out;
-    for (n = 0; a[n] != NULL; n++)
-        if (g_strcmp0(a[n], b[n]) != 0)
-            goto out;
-    ret = TRUE;
-out:
-    return ret;
-}
-
-static gboolean _g_variant_equal0(GVariant *a, GVariant *b) {
-    gboolean ret = FALSE;
-    if (a == NULL && b == NULL) {
-        ret = TRUE;
-        goto out;
-    }
-    if (a == NULL || b == NULL)
-        goto out;
-    ret = g_variant_equal(a, b);
-out:
-    return ret;
-}
-
-G_GNUC_UNUSED static gboolean _g_value_equal(const GValue *a, const GValue *b) {
-    gboolean ret = FALSE;
-    g_assert(G_VALUE_TYPE(a) == G_VALUE_TYPE(b));
-    switch (G_VALUE_TYPE(a)) {
-    case G_TYPE_BOOLEAN:
-        ret = (g_value_get_boolean(a) == g_value_get_boolean(b));
-        break;
-    case G_TYPE_UCHAR:
-        ret = (g_value_get_uchar(a) == g_value_get_uchar(b));
-        break;
-    case G_TYPE_INT:
-        ret = (g_value_get_int(a) == g_value_get_int(b));
-        break;
-    case G_TYPE_UINT:
-        ret = (g_value_get_uint(a) == g_value_get_uint(b));
-        break;
-    case G_TYPE_INT64:
-        ret = (g_value_get_int64(a) == g_value_get_int64(b));
-        break;
-    case G_TYPE_UINT64:
-        ret = (g_value_get_uint64(a) == g_value_get_uint64(b));
-        break;
-    case G_TYPE_DOUBLE: {
-        /* Avoid -Wfloat-equal warnings by doing a direct bit compare */
-        gdouble da = g_value_get_double(a);
-        gdouble db = g_value_get_double(b);
-        ret = memcmp(&da, &db, sizeof(gdouble)) == 0;
-    } break;
-    case G_TYPE_STRING:
-        ret = (g_strcmp0(g_value_get_string(a), g_value_get_string(b)) == 0);
-        break;
-    case G_TYPE_VARIANT:
-        ret = _g_variant_equal0(g_value_get_variant(a), g_value_get_variant(b));
-        break;
-    default:
-        if (G_VALUE_TYPE(a) == G_TYPE_STRV)
-            ret = _g_strv_equal0(g_value_get_boxed(a), g_value_get_boxed(b));
-        else
-            g_critical("_g_value_equal() does not handle type %s", g_type_name(G_VALUE_TYPE(a)));
-        break;
-    }
-    return ret;
-}
-
-/* ------------------------------------------------------------------------
- * Code for interface org.freedesktop.GeoClue2.Location
- * ------------------------------------------------------------------------
- */
-
-/**
- * SECTION:GClueLocation
- * @title: GClueLocation
- * @short_description: Generated C code for the org.freedesktop.GeoClue2.Location D-Bus interface
- *
- * This section contains code for working with the <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Location.top_of_page">org.freedesktop.GeoClue2.Location</link>
- * D-Bus interface in C.
- */
-
-/* ---- Introspection data for org.freedesktop.GeoClue2.Location ---- */
-
-static const _ExtendedGDBusPropertyInfo _gclue_location_property_info_latitude = {
-    {-1, (gchar *)"Latitude", (gchar *)"d", G_DBUS_PROPERTY_INFO_FLAGS_READABLE, NULL},
-    "latitude",
-    FALSE,
-    TRUE};
-
-static const _ExtendedGDBusPropertyInfo _gclue_location_property_info_longitude = {
-    {-1, (gchar *)"Longitude", (gchar *)"d", G_DBUS_PROPERTY_INFO_FLAGS_READABLE, NULL},
-    "longitude",
-    FALSE,
-    TRUE};
-
-static const _ExtendedGDBusPropertyInfo _gclue_location_property_info_accuracy = {
-    {-1, (gchar *)"Accuracy", (gchar *)"d", G_DBUS_PROPERTY_INFO_FLAGS_READABLE, NULL},
-    "accuracy",
-    FALSE,
-    TRUE};
-
-static const _ExtendedGDBusPropertyInfo _gclue_location_property_info_altitude = {
-    {-1, (gchar *)"Altitude", (gchar *)"d", G_DBUS_PROPERTY_INFO_FLAGS_READABLE, NULL},
-    "altitude",
-    FALSE,
-    TRUE};
-
-static const _ExtendedGDBusPropertyInfo _gclue_location_property_info_speed = {
-    {-1, (gchar *)"Speed", (gchar *)"d", G_DBUS_PROPERTY_INFO_FLAGS_READABLE, NULL},
-    "speed",
-    FALSE,
-    TRUE};
-
-static const _ExtendedGDBusPropertyInfo _gclue_location_property_info_heading = {
-    {-1, (gchar *)"Heading", (gchar *)"d", G_DBUS_PROPERTY_INFO_FLAGS_READABLE, NULL},
-    "heading",
-    FALSE,
-    TRUE};
-
-static const _ExtendedGDBusPropertyInfo _gclue_location_property_info_description = {
-    {-1, (gchar *)"Description", (gchar *)"s", G_DBUS_PROPERTY_INFO_FLAGS_READABLE, NULL},
-    "description",
-    FALSE,
-    TRUE};
-
-static const _ExtendedGDBusPropertyInfo _gclue_location_property_info_timestamp = {
-    {-1, (gchar *)"Timestamp", (gchar *)"(tt)", G_DBUS_PROPERTY_INFO_FLAGS_READABLE, NULL},
-    "timestamp",
-    FALSE,
-    TRUE};
-
-static const GDBusPropertyInfo *const _gclue_location_property_info_pointers[] = {
-    &_gclue_location_property_info_latitude.parent_struct,
-    &_gclue_location_property_info_longitude.parent_struct,
-    &_gclue_location_property_info_accuracy.parent_struct,
-    &_gclue_location_property_info_altitude.parent_struct,
-    &_gclue_location_property_info_speed.parent_struct,
-    &_gclue_location_property_info_heading.parent_struct,
-    &_gclue_location_property_info_description.parent_struct,
-    &_gclue_location_property_info_timestamp.parent_struct,
-    NULL};
-
-static const _ExtendedGDBusInterfaceInfo _gclue_location_interface_info = {
-    {-1, (gchar *)"org.freedesktop.GeoClue2.Location", NULL, NULL,
-     (GDBusPropertyInfo **)&_gclue_location_property_info_pointers, NULL},
-    "location",
-};
-
-/**
- * gclue_location_interface_info:
- *
- * Gets a machine-readable description of the <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Location.top_of_page">org.freedesktop.GeoClue2.Location</link>
- * D-Bus interface.
- *
- * Returns: (transfer none): A #GDBusInterfaceInfo. Do not free.
- */
-GDBusInterfaceInfo *gclue_location_interface_info(void) {
-    return (GDBusInterfaceInfo *)&_gclue_location_interface_info.parent_struct;
-}
-
-/**
- * gclue_location_override_properties:
- * @klass: The class structure for a #GObject derived class.
- * @property_id_begin: The property id to assign to the first overridden property.
- *
- * Overrides all #GObject properties in the #GClueLocation interface for a concrete class.
- * The properties are overridden in the order they are defined.
- *
- * Returns: The last property id.
- */
-guint gclue_location_override_properties(GObjectClass *klass, guint property_id_begin) {
-    g_object_class_override_property(klass, property_id_begin++, "latitude");
-    g_object_class_override_property(klass, property_id_begin++, "longitude");
-    g_object_class_override_property(klass, property_id_begin++, "accuracy");
-    g_object_class_override_property(klass, property_id_begin++, "altitude");
-    g_object_class_override_property(klass, property_id_begin++, "speed");
-    g_object_class_override_property(klass, property_id_begin++, "heading");
-    g_object_class_override_property(klass, property_id_begin++, "description");
-    g_object_class_override_property(klass, property_id_begin++, "timestamp");
-    return property_id_begin - 1;
-}
-
-/**
- * GClueLocation:
- *
- * Abstract interface type for the D-Bus interface <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Location.top_of_page">org.freedesktop.GeoClue2.Location</link>.
- */
-
-/**
- * GClueLocationIface:
- * @parent_iface: The parent interface.
- * @get_accuracy: Getter for the #GClueLocation:accuracy property.
- * @get_altitude: Getter for the #GClueLocation:altitude property.
- * @get_description: Getter for the #GClueLocation:description property.
- * @get_heading: Getter for the #GClueLocation:heading property.
- * @get_latitude: Getter for the #GClueLocation:latitude property.
- * @get_longitude: Getter for the #GClueLocation:longitude property.
- * @get_speed: Getter for the #GClueLocation:speed property.
- * @get_timestamp: Getter for the #GClueLocation:timestamp property.
- *
- * Virtual table for the D-Bus interface <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Location.top_of_page">org.freedesktop.GeoClue2.Location</link>.
- */
-
-typedef GClueLocationIface GClueLocationInterface;
-G_DEFINE_INTERFACE(GClueLocation, gclue_location, G_TYPE_OBJECT)
-
-static void gclue_location_default_init(GClueLocationIface *iface) {
-    /* GObject properties for D-Bus properties: */
-    /**
-     * GClueLocation:latitude:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Latitude">"Latitude"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is readable but not writable, it is
-     * meaningful to read from it on both the client- and service-side. It is only meaningful,
-     * however, to write to it on the service-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_double("latitude", "Latitude", "Latitude", -G_MAXDOUBLE, G_MAXDOUBLE,
-                                   0.0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueLocation:longitude:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Longitude">"Longitude"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is readable but not writable, it is
-     * meaningful to read from it on both the client- and service-side. It is only meaningful,
-     * however, to write to it on the service-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_double("longitude", "Longitude", "Longitude", -G_MAXDOUBLE, G_MAXDOUBLE,
-                                   0.0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueLocation:accuracy:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Accuracy">"Accuracy"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is readable but not writable, it is
-     * meaningful to read from it on both the client- and service-side. It is only meaningful,
-     * however, to write to it on the service-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_double("accuracy", "Accuracy", "Accuracy", -G_MAXDOUBLE, G_MAXDOUBLE,
-                                   0.0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueLocation:altitude:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Altitude">"Altitude"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is readable but not writable, it is
-     * meaningful to read from it on both the client- and service-side. It is only meaningful,
-     * however, to write to it on the service-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_double("altitude", "Altitude", "Altitude", -G_MAXDOUBLE, G_MAXDOUBLE,
-                                   0.0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueLocation:speed:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Speed">"Speed"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is readable but not writable, it is
-     * meaningful to read from it on both the client- and service-side. It is only meaningful,
-     * however, to write to it on the service-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_double("speed", "Speed", "Speed", -G_MAXDOUBLE, G_MAXDOUBLE, 0.0,
-                                   G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueLocation:heading:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Heading">"Heading"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is readable but not writable, it is
-     * meaningful to read from it on both the client- and service-side. It is only meaningful,
-     * however, to write to it on the service-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_double("heading", "Heading", "Heading", -G_MAXDOUBLE, G_MAXDOUBLE, 0.0,
-                                   G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueLocation:description:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Description">"Description"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is readable but not writable, it is
-     * meaningful to read from it on both the client- and service-side. It is only meaningful,
-     * however, to write to it on the service-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_string("description", "Description", "Description", NULL,
-                                   G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-    /**
-     * GClueLocation:timestamp:
-     *
-     * Represents the D-Bus property <link
-     * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Timestamp">"Timestamp"</link>.
-     *
-     * Since the D-Bus property for this #GObject property is readable but not writable, it is
-     * meaningful to read from it on both the client- and service-side. It is only meaningful,
-     * however, to write to it on the service-side.
-     */
-    g_object_interface_install_property(
-        iface, g_param_spec_variant("timestamp", "Timestamp", "Timestamp", G_VARIANT_TYPE("(tt)"),
-                                    NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
-}
-
-/**
- * gclue_location_get_latitude: (skip)
- * @object: A #GClueLocation.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Latitude">"Latitude"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * Returns: The property value.
- */
-gdouble gclue_location_get_latitude(GClueLocation *object) {
-    g_return_val_if_fail(GCLUE_IS_LOCATION(object), 0.0);
-
-    return GCLUE_LOCATION_GET_IFACE(object)->get_latitude(object);
-}
-
-/**
- * gclue_location_set_latitude: (skip)
- * @object: A #GClueLocation.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Latitude">"Latitude"</link> D-Bus
- * property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the
- * service-side.
- */
-void gclue_location_set_latitude(GClueLocation *object, gdouble value) {
-    g_object_set(G_OBJECT(object), "latitude", value, NULL);
-}
-
-/**
- * gclue_location_get_longitude: (skip)
- * @object: A #GClueLocation.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Longitude">"Longitude"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * Returns: The property value.
- */
-gdouble gclue_location_get_longitude(GClueLocation *object) {
-    g_return_val_if_fail(GCLUE_IS_LOCATION(object), 0.0);
-
-    return GCLUE_LOCATION_GET_IFACE(object)->get_longitude(object);
-}
-
-/**
- * gclue_location_set_longitude: (skip)
- * @object: A #GClueLocation.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Longitude">"Longitude"</link> D-Bus
- * property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the
- * service-side.
- */
-void gclue_location_set_longitude(GClueLocation *object, gdouble value) {
-    g_object_set(G_OBJECT(object), "longitude", value, NULL);
-}
-
-/**
- * gclue_location_get_accuracy: (skip)
- * @object: A #GClueLocation.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Accuracy">"Accuracy"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * Returns: The property value.
- */
-gdouble gclue_location_get_accuracy(GClueLocation *object) {
-    g_return_val_if_fail(GCLUE_IS_LOCATION(object), 0.0);
-
-    return GCLUE_LOCATION_GET_IFACE(object)->get_accuracy(object);
-}
-
-/**
- * gclue_location_set_accuracy: (skip)
- * @object: A #GClueLocation.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Accuracy">"Accuracy"</link> D-Bus
- * property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the
- * service-side.
- */
-void gclue_location_set_accuracy(GClueLocation *object, gdouble value) {
-    g_object_set(G_OBJECT(object), "accuracy", value, NULL);
-}
-
-/**
- * gclue_location_get_altitude: (skip)
- * @object: A #GClueLocation.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Altitude">"Altitude"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * Returns: The property value.
- */
-gdouble gclue_location_get_altitude(GClueLocation *object) {
-    g_return_val_if_fail(GCLUE_IS_LOCATION(object), 0.0);
-
-    return GCLUE_LOCATION_GET_IFACE(object)->get_altitude(object);
-}
-
-/**
- * gclue_location_set_altitude: (skip)
- * @object: A #GClueLocation.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Altitude">"Altitude"</link> D-Bus
- * property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the
- * service-side.
- */
-void gclue_location_set_altitude(GClueLocation *object, gdouble value) {
-    g_object_set(G_OBJECT(object), "altitude", value, NULL);
-}
-
-/**
- * gclue_location_get_speed: (skip)
- * @object: A #GClueLocation.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Speed">"Speed"</link> D-Bus property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * Returns: The property value.
- */
-gdouble gclue_location_get_speed(GClueLocation *object) {
-    g_return_val_if_fail(GCLUE_IS_LOCATION(object), 0.0);
-
-    return GCLUE_LOCATION_GET_IFACE(object)->get_speed(object);
-}
-
-/**
- * gclue_location_set_speed: (skip)
- * @object: A #GClueLocation.
- * @value: The value to set.
- *
- * Sets the <link linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Speed">"Speed"</link>
- * D-Bus property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the
- * service-side.
- */
-void gclue_location_set_speed(GClueLocation *object, gdouble value) {
-    g_object_set(G_OBJECT(object), "speed", value, NULL);
-}
-
-/**
- * gclue_location_get_heading: (skip)
- * @object: A #GClueLocation.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Heading">"Heading"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * Returns: The property value.
- */
-gdouble gclue_location_get_heading(GClueLocation *object) {
-    g_return_val_if_fail(GCLUE_IS_LOCATION(object), 0.0);
-
-    return GCLUE_LOCATION_GET_IFACE(object)->get_heading(object);
-}
-
-/**
- * gclue_location_set_heading: (skip)
- * @object: A #GClueLocation.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Heading">"Heading"</link> D-Bus
- * property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the
- * service-side.
- */
-void gclue_location_set_heading(GClueLocation *object, gdouble value) {
-    g_object_set(G_OBJECT(object), "heading", value, NULL);
-}
-
-/**
- * gclue_location_get_description: (skip)
- * @object: A #GClueLocation.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Description">"Description"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * The returned value is only valid until the property changes so on the client-side it is only safe
- * to use this function on the thread where @object was constructed. Use
- * gclue_location_dup_description() if on another thread.
- *
- * Returns: (transfer none) (nullable): The property value or %NULL if the property is not set. Do
- * not free the returned value, it belongs to @object.
- */
-const gchar *gclue_location_get_description(GClueLocation *object) {
-    g_return_val_if_fail(GCLUE_IS_LOCATION(object), NULL);
-
-    return GCLUE_LOCATION_GET_IFACE(object)->get_description(object);
-}
-
-/**
- * gclue_location_dup_description: (skip)
- * @object: A #GClueLocation.
- *
- * Gets a copy of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Description">"Description"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * Returns: (transfer full) (nullable): The property value or %NULL if the property is not set. The
- * returned value should be freed with g_free().
- */
-gchar *gclue_location_dup_description(GClueLocation *object) {
-    gchar *value;
-    g_object_get(G_OBJECT(object), "description", &value, NULL);
-    return value;
-}
-
-/**
- * gclue_location_set_description: (skip)
- * @object: A #GClueLocation.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Description">"Description"</link> D-Bus
- * property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the
- * service-side.
- */
-void gclue_location_set_description(GClueLocation *object, const gchar *value) {
-    g_object_set(G_OBJECT(object), "description", value, NULL);
-}
-
-/**
- * gclue_location_get_timestamp: (skip)
- * @object: A #GClueLocation.
- *
- * Gets the value of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Timestamp">"Timestamp"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * The returned value is only valid until the property changes so on the client-side it is only safe
- * to use this function on the thread where @object was constructed. Use
- * gclue_location_dup_timestamp() if on another thread.
- *
- * Returns: (transfer none) (nullable): The property value or %NULL if the property is not set. Do
- * not free the returned value, it belongs to @object.
- */
-GVariant *gclue_location_get_timestamp(GClueLocation *object) {
-    g_return_val_if_fail(GCLUE_IS_LOCATION(object), NULL);
-
-    return GCLUE_LOCATION_GET_IFACE(object)->get_timestamp(object);
-}
-
-/**
- * gclue_location_dup_timestamp: (skip)
- * @object: A #GClueLocation.
- *
- * Gets a copy of the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Timestamp">"Timestamp"</link> D-Bus
- * property.
- *
- * Since this D-Bus property is readable, it is meaningful to use this function on both the client-
- * and service-side.
- *
- * Returns: (transfer full) (nullable): The property value or %NULL if the property is not set. The
- * returned value should be freed with g_variant_unref().
- */
-GVariant *gclue_location_dup_timestamp(GClueLocation *object) {
-    GVariant *value;
-    g_object_get(G_OBJECT(object), "timestamp", &value, NULL);
-    return value;
-}
-
-/**
- * gclue_location_set_timestamp: (skip)
- * @object: A #GClueLocation.
- * @value: The value to set.
- *
- * Sets the <link
- * linkend="gdbus-property-org-freedesktop-GeoClue2-Location.Timestamp">"Timestamp"</link> D-Bus
- * property to @value.
- *
- * Since this D-Bus property is not writable, it is only meaningful to use this function on the
- * service-side.
- */
-void gclue_location_set_timestamp(GClueLocation *object, GVariant *value) {
-    g_object_set(G_OBJECT(object), "timestamp", value, NULL);
-}
-
-/* ------------------------------------------------------------------------ */
-
-/**
- * GClueLocationProxy:
- *
- * The #GClueLocationProxy structure contains only private data and should only be accessed using
- * the provided API.
- */
-
-/**
- * GClueLocationProxyClass:
- * @parent_class: The parent class.
- *
- * Class structure for #GClueLocationProxy.
- */
-
-struct _GClueLocationProxyPrivate {
-    GData *qdata;
-};
-
-static void gclue_location_proxy_iface_init(GClueLocationIface *iface);
-
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-G_DEFINE_TYPE_WITH_CODE(GClueLocationProxy, gclue_location_proxy, G_TYPE_DBUS_PROXY,
-                        G_ADD_PRIVATE(GClueLocationProxy)
-                            G_IMPLEMENT_INTERFACE(GCLUE_TYPE_LOCATION,
-                                                  gclue_location_proxy_iface_init))
-
-#else
-G_DEFINE_TYPE_WITH_CODE(GClueLocationProxy, gclue_location_proxy, G_TYPE_DBUS_PROXY,
-                        G_IMPLEMENT_INTERFACE(GCLUE_TYPE_LOCATION, gclue_location_proxy_iface_init))
-
-#endif
-static void gclue_location_proxy_finalize(GObject *object) {
-    GClueLocationProxy *proxy = GCLUE_LOCATION_PROXY(object);
-    g_datalist_clear(&proxy->priv->qdata);
-    G_OBJECT_CLASS(gclue_location_proxy_parent_class)->finalize(object);
-}
-
-static void gclue_location_proxy_get_property(GObject *object, guint prop_id, GValue *value,
-                                              GParamSpec *pspec G_GNUC_UNUSED) {
-    const _ExtendedGDBusPropertyInfo *info;
-    GVariant *variant;
-    g_assert(prop_id != 0 && prop_id - 1 < 8);
-    info = (const _ExtendedGDBusPropertyInfo *)_gclue_location_property_info_pointers[prop_id - 1];
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(object), info->parent_struct.name);
-    if (info->use_gvariant) {
-        g_value_set_variant(value, variant);
-    } else {
-        if (variant != NULL)
-            g_dbus_gvariant_to_gvalue(variant, value);
-    }
-    if (variant != NULL)
-        g_variant_unref(variant);
-}
-
-static void gclue_location_proxy_set_property_cb(GDBusProxy *proxy, GAsyncResult *res,
-                                                 gpointer user_data) {
-    const _ExtendedGDBusPropertyInfo *info = user_data;
-    GError *error;
-    GVariant *_ret;
-    error = NULL;
-    _ret = g_dbus_proxy_call_finish(proxy, res, &error);
-    if (!_ret) {
-        g_warning("Error setting property '%s' on interface org.freedesktop.GeoClue2.Location: %s "
-                  "(%s, %d)",
-                  info->parent_struct.name, error->message, g_quark_to_string(error->domain),
-                  error->code);
-        g_error_free(error);
-    } else {
-        g_variant_unref(_ret);
-    }
-}
-
-static void gclue_location_proxy_set_property(GObject *object, guint prop_id, const GValue *value,
-                                              GParamSpec *pspec G_GNUC_UNUSED) {
-    const _ExtendedGDBusPropertyInfo *info;
-    GVariant *variant;
-    g_assert(prop_id != 0 && prop_id - 1 < 8);
-    info = (const _ExtendedGDBusPropertyInfo *)_gclue_location_property_info_pointers[prop_id - 1];
-    variant = g_dbus_gvalue_to_gvariant(value, G_VARIANT_TYPE(info->parent_struct.signature));
-    g_dbus_proxy_call(G_DBUS_PROXY(object), "org.freedesktop.DBus.Properties.Set",
-                      g_variant_new("(ssv)", "org.freedesktop.GeoClue2.Location",
-                                    info->parent_struct.name, variant),
-                      G_DBUS_CALL_FLAGS_NONE, -1, NULL,
-                      (GAsyncReadyCallback)gclue_location_proxy_set_property_cb,
-                      (GDBusPropertyInfo *)&info->parent_struct);
-    g_variant_unref(variant);
-}
-
-static void gclue_location_proxy_g_signal(GDBusProxy *proxy, const gchar *sender_name G_GNUC_UNUSED,
-                                          const gchar *signal_name, GVariant *parameters) {
-    _ExtendedGDBusSignalInfo *info;
-    GVariantIter iter;
-    GVariant *child;
-    GValue *paramv;
-    gsize num_params;
-    gsize n;
-    guint signal_id;
-    info = (_ExtendedGDBusSignalInfo *)g_dbus_interface_info_lookup_signal(
-        (GDBusInterfaceInfo *)&_gclue_location_interface_info.parent_struct, signal_name);
-    if (info == NULL)
-        return;
-    num_params = g_variant_n_children(parameters);
-    paramv = g_new0(GValue, num_params + 1);
-    g_value_init(&paramv[0], GCLUE_TYPE_LOCATION);
-    g_value_set_object(&paramv[0], proxy);
-    g_variant_iter_init(&iter, parameters);
-    n = 1;
-    while ((child = g_variant_iter_next_value(&iter)) != NULL) {
-        _ExtendedGDBusArgInfo *arg_info = (_ExtendedGDBusArgInfo *)info->parent_struct.args[n - 1];
-        if (arg_info->use_gvariant) {
-            g_value_init(&paramv[n], G_TYPE_VARIANT);
-            g_value_set_variant(&paramv[n], child);
-            n++;
-        } else
-            g_dbus_gvariant_to_gvalue(child, &paramv[n++]);
-        g_variant_unref(child);
-    }
-    signal_id = g_signal_lookup(info->signal_name, GCLUE_TYPE_LOCATION);
-    g_signal_emitv(paramv, signal_id, 0, NULL);
-    for (n = 0; n < num_params + 1; n++)
-        g_value_unset(&paramv[n]);
-    g_free(paramv);
-}
-
-static void gclue_location_proxy_g_properties_changed(GDBusProxy *_proxy,
-                                                      GVariant *changed_properties,
-                                                      const gchar *const *invalidated_properties) {
-    GClueLocationProxy *proxy = GCLUE_LOCATION_PROXY(_proxy);
-    guint n;
-    const gchar *key;
-    GVariantIter *iter;
-    _ExtendedGDBusPropertyInfo *info;
-    g_variant_get(changed_properties, "a{sv}", &iter);
-    while (g_variant_iter_next(iter, "{&sv}", &key, NULL)) {
-        info = (_ExtendedGDBusPropertyInfo *)g_dbus_interface_info_lookup_property(
-            (GDBusInterfaceInfo *)&_gclue_location_interface_info.parent_struct, key);
-        g_datalist_remove_data(&proxy->priv->qdata, key);
-        if (info != NULL)
-            g_object_notify(G_OBJECT(proxy), info->hyphen_name);
-    }
-    g_variant_iter_free(iter);
-    for (n = 0; invalidated_properties[n] != NULL; n++) {
-        info = (_ExtendedGDBusPropertyInfo *)g_dbus_interface_info_lookup_property(
-            (GDBusInterfaceInfo *)&_gclue_location_interface_info.parent_struct,
-            invalidated_properties[n]);
-        g_datalist_remove_data(&proxy->priv->qdata, invalidated_properties[n]);
-        if (info != NULL)
-            g_object_notify(G_OBJECT(proxy), info->hyphen_name);
-    }
-}
-
-static gdouble gclue_location_proxy_get_latitude(GClueLocation *object) {
-    GClueLocationProxy *proxy = GCLUE_LOCATION_PROXY(object);
-    GVariant *variant;
-    gdouble value = 0.0;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "Latitude");
-    if (variant != NULL) {
-        value = g_variant_get_double(variant);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static gdouble gclue_location_proxy_get_longitude(GClueLocation *object) {
-    GClueLocationProxy *proxy = GCLUE_LOCATION_PROXY(object);
-    GVariant *variant;
-    gdouble value = 0.0;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "Longitude");
-    if (variant != NULL) {
-        value = g_variant_get_double(variant);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static gdouble gclue_location_proxy_get_accuracy(GClueLocation *object) {
-    GClueLocationProxy *proxy = GCLUE_LOCATION_PROXY(object);
-    GVariant *variant;
-    gdouble value = 0.0;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "Accuracy");
-    if (variant != NULL) {
-        value = g_variant_get_double(variant);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static gdouble gclue_location_proxy_get_altitude(GClueLocation *object) {
-    GClueLocationProxy *proxy = GCLUE_LOCATION_PROXY(object);
-    GVariant *variant;
-    gdouble value = 0.0;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "Altitude");
-    if (variant != NULL) {
-        value = g_variant_get_double(variant);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static gdouble gclue_location_proxy_get_speed(GClueLocation *object) {
-    GClueLocationProxy *proxy = GCLUE_LOCATION_PROXY(object);
-    GVariant *variant;
-    gdouble value = 0.0;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "Speed");
-    if (variant != NULL) {
-        value = g_variant_get_double(variant);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static gdouble gclue_location_proxy_get_heading(GClueLocation *object) {
-    GClueLocationProxy *proxy = GCLUE_LOCATION_PROXY(object);
-    GVariant *variant;
-    gdouble value = 0.0;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "Heading");
-    if (variant != NULL) {
-        value = g_variant_get_double(variant);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static const gchar *gclue_location_proxy_get_description(GClueLocation *object) {
-    GClueLocationProxy *proxy = GCLUE_LOCATION_PROXY(object);
-    GVariant *variant;
-    const gchar *value = NULL;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "Description");
-    if (variant != NULL) {
-        value = g_variant_get_string(variant, NULL);
-        g_variant_unref(variant);
-    }
-    return value;
-}
-
-static GVariant *gclue_location_proxy_get_timestamp(GClueLocation *object) {
-    GClueLocationProxy *proxy = GCLUE_LOCATION_PROXY(object);
-    GVariant *variant;
-    GVariant *value = NULL;
-    variant = g_dbus_proxy_get_cached_property(G_DBUS_PROXY(proxy), "Timestamp");
-    value = variant;
-    if (variant != NULL)
-        g_variant_unref(variant);
-    return value;
-}
-
-static void gclue_location_proxy_init(GClueLocationProxy *proxy) {
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-    proxy->priv = gclue_location_proxy_get_instance_private(proxy);
-#else
-    proxy->priv =
-        G_TYPE_INSTANCE_GET_PRIVATE(proxy, GCLUE_TYPE_LOCATION_PROXY, GClueLocationProxyPrivate);
-#endif
-
-    g_dbus_proxy_set_interface_info(G_DBUS_PROXY(proxy), gclue_location_interface_info());
-}
-
-static void gclue_location_proxy_class_init(GClueLocationProxyClass *klass) {
-    GObjectClass *gobject_class;
-    GDBusProxyClass *proxy_class;
-
-    gobject_class = G_OBJECT_CLASS(klass);
-    gobject_class->finalize = gclue_location_proxy_finalize;
-    gobject_class->get_property = gclue_location_proxy_get_property;
-    gobject_class->set_property = gclue_location_proxy_set_property;
-
-    proxy_class = G_DBUS_PROXY_CLASS(klass);
-    proxy_class->g_signal = gclue_location_proxy_g_signal;
-    proxy_class->g_properties_changed = gclue_location_proxy_g_properties_changed;
-
-    gclue_location_override_properties(gobject_class, 1);
-
-#if GLIB_VERSION_MAX_ALLOWED < GLIB_VERSION_2_38
-    g_type_class_add_private(klass, sizeof(GClueLocationProxyPrivate));
-#endif
-}
-
-static void gclue_location_proxy_iface_init(GClueLocationIface *iface) {
-    iface->get_latitude = gclue_location_proxy_get_latitude;
-    iface->get_longitude = gclue_location_proxy_get_longitude;
-    iface->get_accuracy = gclue_location_proxy_get_accuracy;
-    iface->get_altitude = gclue_location_proxy_get_altitude;
-    iface->get_speed = gclue_location_proxy_get_speed;
-    iface->get_heading = gclue_location_proxy_get_heading;
-    iface->get_description = gclue_location_proxy_get_description;
-    iface->get_timestamp = gclue_location_proxy_get_timestamp;
-}
-
-/**
- * gclue_location_proxy_new:
- * @connection: A #GDBusConnection.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: (nullable): A bus name (well-known or unique) or %NULL if @connection is not a message bus
- * connection.
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @callback: A #GAsyncReadyCallback to call when the request is satisfied.
- * @user_data: User data to pass to @callback.
- *
- * Asynchronously creates a proxy for the D-Bus interface <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Location.top_of_page">org.freedesktop.GeoClue2.Location</link>.
- * See g_dbus_proxy_new() for more details.
- *
- * When the operation is finished, @callback will be invoked in the thread-default main loop of the
- * thread you are calling this method from (see g_main_context_push_thread_default()). You can then
- * call gclue_location_proxy_new_finish() to get the result of the operation.
- *
- * See gclue_location_proxy_new_sync() for the synchronous, blocking version of this constructor.
- */
-void gclue_location_proxy_new(GDBusConnection *connection, GDBusProxyFlags flags, const gchar *name,
-                              const gchar *object_path, GCancellable *cancellable,
-                              GAsyncReadyCallback callback, gpointer user_data) {
-    g_async_initable_new_async(GCLUE_TYPE_LOCATION_PROXY, G_PRIORITY_DEFAULT, cancellable, callback,
-                               user_data, "g-flags", flags, "g-name", name, "g-connection",
-                               connection, "g-object-path", object_path, "g-interface-name",
-                               "org.freedesktop.GeoClue2.Location", NULL);
-}
-
-/**
- * gclue_location_proxy_new_finish:
- * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
- * gclue_location_proxy_new().
- * @error: Return location for error or %NULL
- *
- * Finishes an operation started with gclue_location_proxy_new().
- *
- * Returns: (transfer full) (type GClueLocationProxy): The constructed proxy object or %NULL if
- * @error is set.
- */
-GClueLocation *gclue_location_proxy_new_finish(GAsyncResult *res, GError **error) {
-    GObject *ret;
-    GObject *source_object;
-    source_object = g_async_result_get_source_object(res);
-    ret = g_async_initable_new_finish(G_ASYNC_INITABLE(source_object), res, error);
-    g_object_unref(source_object);
-    if (ret != NULL)
-        return GCLUE_LOCATION(ret);
-    else
-        return NULL;
-}
-
-/**
- * gclue_location_proxy_new_sync:
- * @connection: A #GDBusConnection.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: (nullable): A bus name (well-known or unique) or %NULL if @connection is not a message bus
- * connection.
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @error: Return location for error or %NULL
- *
- * Synchronously creates a proxy for the D-Bus interface <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Location.top_of_page">org.freedesktop.GeoClue2.Location</link>.
- * See g_dbus_proxy_new_sync() for more details.
- *
- * The calling thread is blocked until a reply is received.
- *
- * See gclue_location_proxy_new() for the asynchronous version of this constructor.
- *
- * Returns: (transfer full) (type GClueLocationProxy): The constructed proxy object or %NULL if
- * @error is set.
- */
-GClueLocation *gclue_location_proxy_new_sync(GDBusConnection *connection, GDBusProxyFlags flags,
-                                             const gchar *name, const gchar *object_path,
-                                             GCancellable *cancellable, GError **error) {
-    GInitable *ret;
-    ret = g_initable_new(GCLUE_TYPE_LOCATION_PROXY, cancellable, error, "g-flags", flags, "g-name",
-                         name, "g-connection", connection, "g-object-path", object_path,
-                         "g-interface-name", "org.freedesktop.GeoClue2.Location", NULL);
-    if (ret != NULL)
-        return GCLUE_LOCATION(ret);
-    else
-        return NULL;
-}
-
-/**
- * gclue_location_proxy_new_for_bus:
- * @bus_type: A #GBusType.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: A bus name (well-known or unique).
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @callback: A #GAsyncReadyCallback to call when the request is satisfied.
- * @user_data: User data to pass to @callback.
- *
- * Like gclue_location_proxy_new() but takes a #GBusType instead of a #GDBusConnection.
- *
- * When the operation is finished, @callback will be invoked in the thread-default main loop of the
- * thread you are calling this method from (see g_main_context_push_thread_default()). You can then
- * call gclue_location_proxy_new_for_bus_finish() to get the result of the operation.
- *
- * See gclue_location_proxy_new_for_bus_sync() for the synchronous, blocking version of this
- * constructor.
- */
-void gclue_location_proxy_new_for_bus(GBusType bus_type, GDBusProxyFlags flags, const gchar *name,
-                                      const gchar *object_path, GCancellable *cancellable,
-                                      GAsyncReadyCallback callback, gpointer user_data) {
-    g_async_initable_new_async(GCLUE_TYPE_LOCATION_PROXY, G_PRIORITY_DEFAULT, cancellable, callback,
-                               user_data, "g-flags", flags, "g-name", name, "g-bus-type", bus_type,
-                               "g-object-path", object_path, "g-interface-name",
-                               "org.freedesktop.GeoClue2.Location", NULL);
-}
-
-/**
- * gclue_location_proxy_new_for_bus_finish:
- * @res: The #GAsyncResult obtained from the #GAsyncReadyCallback passed to
- * gclue_location_proxy_new_for_bus().
- * @error: Return location for error or %NULL
- *
- * Finishes an operation started with gclue_location_proxy_new_for_bus().
- *
- * Returns: (transfer full) (type GClueLocationProxy): The constructed proxy object or %NULL if
- * @error is set.
- */
-GClueLocation *gclue_location_proxy_new_for_bus_finish(GAsyncResult *res, GError **error) {
-    GObject *ret;
-    GObject *source_object;
-    source_object = g_async_result_get_source_object(res);
-    ret = g_async_initable_new_finish(G_ASYNC_INITABLE(source_object), res, error);
-    g_object_unref(source_object);
-    if (ret != NULL)
-        return GCLUE_LOCATION(ret);
-    else
-        return NULL;
-}
-
-/**
- * gclue_location_proxy_new_for_bus_sync:
- * @bus_type: A #GBusType.
- * @flags: Flags from the #GDBusProxyFlags enumeration.
- * @name: A bus name (well-known or unique).
- * @object_path: An object path.
- * @cancellable: (nullable): A #GCancellable or %NULL.
- * @error: Return location for error or %NULL
- *
- * Like gclue_location_proxy_new_sync() but takes a #GBusType instead of a #GDBusConnection.
- *
- * The calling thread is blocked until a reply is received.
- *
- * See gclue_location_proxy_new_for_bus() for the asynchronous version of this constructor.
- *
- * Returns: (transfer full) (type GClueLocationProxy): The constructed proxy object or %NULL if
- * @error is set.
- */
-GClueLocation *gclue_location_proxy_new_for_bus_sync(GBusType bus_type, GDBusProxyFlags flags,
-                                                     const gchar *name, const gchar *object_path,
-                                                     GCancellable *cancellable, GError **error) {
-    GInitable *ret;
-    ret = g_initable_new(GCLUE_TYPE_LOCATION_PROXY, cancellable, error, "g-flags", flags, "g-name",
-                         name, "g-bus-type", bus_type, "g-object-path", object_path,
-                         "g-interface-name", "org.freedesktop.GeoClue2.Location", NULL);
-    if (ret != NULL)
-        return GCLUE_LOCATION(ret);
-    else
-        return NULL;
-}
-
-/* ------------------------------------------------------------------------ */
-
-/**
- * GClueLocationSkeleton:
- *
- * The #GClueLocationSkeleton structure contains only private data and should only be accessed using
- * the provided API.
- */
-
-/**
- * GClueLocationSkeletonClass:
- * @parent_class: The parent class.
- *
- * Class structure for #GClueLocationSkeleton.
- */
-
-struct _GClueLocationSkeletonPrivate {
-    GValue *properties;
-    GList *changed_properties;
-    GSource *changed_properties_idle_source;
-    GMainContext *context;
-    GMutex lock;
-};
-
-static void _gclue_location_skeleton_handle_method_call(
-    GDBusConnection *connection G_GNUC_UNUSED, const gchar *sender G_GNUC_UNUSED,
-    const gchar *object_path G_GNUC_UNUSED, const gchar *interface_name, const gchar *method_name,
-    GVariant *parameters, GDBusMethodInvocation *invocation, gpointer user_data) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(user_data);
-    _ExtendedGDBusMethodInfo *info;
-    GVariantIter iter;
-    GVariant *child;
-    GValue *paramv;
-    gsize num_params;
-    guint num_extra;
-    gsize n;
-    guint signal_id;
-    GValue return_value = G_VALUE_INIT;
-    info = (_ExtendedGDBusMethodInfo *)g_dbus_method_invocation_get_method_info(invocation);
-    g_assert(info != NULL);
-    num_params = g_variant_n_children(parameters);
-    num_extra = info->pass_fdlist ? 3 : 2;
-    paramv = g_new0(GValue, num_params + num_extra);
-    n = 0;
-    g_value_init(&paramv[n], GCLUE_TYPE_LOCATION);
-    g_value_set_object(&paramv[n++], skeleton);
-    g_value_init(&paramv[n], G_TYPE_DBUS_METHOD_INVOCATION);
-    g_value_set_object(&paramv[n++], invocation);
-    if (info->pass_fdlist) {
-#ifdef G_OS_UNIX
-        g_value_init(&paramv[n], G_TYPE_UNIX_FD_LIST);
-        g_value_set_object(&paramv[n++], g_dbus_message_get_unix_fd_list(
-                                             g_dbus_method_invocation_get_message(invocation)));
-#else
-        g_assert_not_reached();
-#endif
-    }
-    g_variant_iter_init(&iter, parameters);
-    while ((child = g_variant_iter_next_value(&iter)) != NULL) {
-        _ExtendedGDBusArgInfo *arg_info =
-            (_ExtendedGDBusArgInfo *)info->parent_struct.in_args[n - num_extra];
-        if (arg_info->use_gvariant) {
-            g_value_init(&paramv[n], G_TYPE_VARIANT);
-            g_value_set_variant(&paramv[n], child);
-            n++;
-        } else
-            g_dbus_gvariant_to_gvalue(child, &paramv[n++]);
-        g_variant_unref(child);
-    }
-    signal_id = g_signal_lookup(info->signal_name, GCLUE_TYPE_LOCATION);
-    g_value_init(&return_value, G_TYPE_BOOLEAN);
-    g_signal_emitv(paramv, signal_id, 0, &return_value);
-    if (!g_value_get_boolean(&return_value))
-        g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD,
-                                              "Method %s is not implemented on interface %s",
-                                              method_name, interface_name);
-    g_value_unset(&return_value);
-    for (n = 0; n < num_params + num_extra; n++)
-        g_value_unset(&paramv[n]);
-    g_free(paramv);
-}
-
-static GVariant *_gclue_location_skeleton_handle_get_property(
-    GDBusConnection *connection G_GNUC_UNUSED, const gchar *sender G_GNUC_UNUSED,
-    const gchar *object_path G_GNUC_UNUSED, const gchar *interface_name G_GNUC_UNUSED,
-    const gchar *property_name, GError **error, gpointer user_data) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(user_data);
-    GValue value = G_VALUE_INIT;
-    GParamSpec *pspec;
-    _ExtendedGDBusPropertyInfo *info;
-    GVariant *ret;
-    ret = NULL;
-    info = (_ExtendedGDBusPropertyInfo *)g_dbus_interface_info_lookup_property(
-        (GDBusInterfaceInfo *)&_gclue_location_interface_info.parent_struct, property_name);
-    g_assert(info != NULL);
-    pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(skeleton), info->hyphen_name);
-    if (pspec == NULL) {
-        g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "No property with name %s",
-                    property_name);
-    } else {
-        g_value_init(&value, pspec->value_type);
-        g_object_get_property(G_OBJECT(skeleton), info->hyphen_name, &value);
-        ret = g_dbus_gvalue_to_gvariant(&value, G_VARIANT_TYPE(info->parent_struct.signature));
-        g_value_unset(&value);
-    }
-    return ret;
-}
-
-static gboolean _gclue_location_skeleton_handle_set_property(
-    GDBusConnection *connection G_GNUC_UNUSED, const gchar *sender G_GNUC_UNUSED,
-    const gchar *object_path G_GNUC_UNUSED, const gchar *interface_name G_GNUC_UNUSED,
-    const gchar *property_name, GVariant *variant, GError **error, gpointer user_data) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(user_data);
-    GValue value = G_VALUE_INIT;
-    GParamSpec *pspec;
-    _ExtendedGDBusPropertyInfo *info;
-    gboolean ret;
-    ret = FALSE;
-    info = (_ExtendedGDBusPropertyInfo *)g_dbus_interface_info_lookup_property(
-        (GDBusInterfaceInfo *)&_gclue_location_interface_info.parent_struct, property_name);
-    g_assert(info != NULL);
-    pspec = g_object_class_find_property(G_OBJECT_GET_CLASS(skeleton), info->hyphen_name);
-    if (pspec == NULL) {
-        g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_INVALID_ARGS, "No property with name %s",
-                    property_name);
-    } else {
-        if (info->use_gvariant)
-            g_value_set_variant(&value, variant);
-        else
-            g_dbus_gvariant_to_gvalue(variant, &value);
-        g_object_set_property(G_OBJECT(skeleton), info->hyphen_name, &value);
-        g_value_unset(&value);
-        ret = TRUE;
-    }
-    return ret;
-}
-
-static const GDBusInterfaceVTable _gclue_location_skeleton_vtable = {
-    _gclue_location_skeleton_handle_method_call,
-    _gclue_location_skeleton_handle_get_property,
-    _gclue_location_skeleton_handle_set_property,
-    {NULL}};
-
-static GDBusInterfaceInfo *
-gclue_location_skeleton_dbus_interface_get_info(GDBusInterfaceSkeleton *skeleton G_GNUC_UNUSED) {
-    return gclue_location_interface_info();
-}
-
-static GDBusInterfaceVTable *
-gclue_location_skeleton_dbus_interface_get_vtable(GDBusInterfaceSkeleton *skeleton G_GNUC_UNUSED) {
-    return (GDBusInterfaceVTable *)&_gclue_location_skeleton_vtable;
-}
-
-static GVariant *
-gclue_location_skeleton_dbus_interface_get_properties(GDBusInterfaceSkeleton *_skeleton) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(_skeleton);
-
-    GVariantBuilder builder;
-    guint n;
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_84
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
-#else
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
-#endif
-    if (_gclue_location_interface_info.parent_struct.properties == NULL)
-        goto out;
-    for (n = 0; _gclue_location_interface_info.parent_struct.properties[n] != NULL; n++) {
-        GDBusPropertyInfo *info = _gclue_location_interface_info.parent_struct.properties[n];
-        if (info->flags & G_DBUS_PROPERTY_INFO_FLAGS_READABLE) {
-            GVariant *value;
-            value = _gclue_location_skeleton_handle_get_property(
-                g_dbus_interface_skeleton_get_connection(G_DBUS_INTERFACE_SKELETON(skeleton)), NULL,
-                g_dbus_interface_skeleton_get_object_path(G_DBUS_INTERFACE_SKELETON(skeleton)),
-                "org.freedesktop.GeoClue2.Location", info->name, NULL, skeleton);
-            if (value != NULL) {
-                g_variant_take_ref(value);
-                g_variant_builder_add(&builder, "{sv}", info->name, value);
-                g_variant_unref(value);
-            }
-        }
-    }
-out:
-    return g_variant_builder_end(&builder);
-}
-
-static gboolean _gclue_location_emit_changed(gpointer user_data);
-
-static void gclue_location_skeleton_dbus_interface_flush(GDBusInterfaceSkeleton *_skeleton) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(_skeleton);
-    gboolean emit_changed = FALSE;
-
-    g_mutex_lock(&skeleton->priv->lock);
-    if (skeleton->priv->changed_properties_idle_source != NULL) {
-        g_source_destroy(skeleton->priv->changed_properties_idle_source);
-        skeleton->priv->changed_properties_idle_source = NULL;
-        emit_changed = TRUE;
-    }
-    g_mutex_unlock(&skeleton->priv->lock);
-
-    if (emit_changed)
-        _gclue_location_emit_changed(skeleton);
-}
-
-static void gclue_location_skeleton_iface_init(GClueLocationIface *iface);
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-G_DEFINE_TYPE_WITH_CODE(GClueLocationSkeleton, gclue_location_skeleton,
-                        G_TYPE_DBUS_INTERFACE_SKELETON,
-                        G_ADD_PRIVATE(GClueLocationSkeleton)
-                            G_IMPLEMENT_INTERFACE(GCLUE_TYPE_LOCATION,
-                                                  gclue_location_skeleton_iface_init))
-
-#else
-G_DEFINE_TYPE_WITH_CODE(GClueLocationSkeleton, gclue_location_skeleton,
-                        G_TYPE_DBUS_INTERFACE_SKELETON,
-                        G_IMPLEMENT_INTERFACE(GCLUE_TYPE_LOCATION,
-                                              gclue_location_skeleton_iface_init))
-
-#endif
-static void gclue_location_skeleton_finalize(GObject *object) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    guint n;
-    for (n = 0; n < 8; n++)
-        g_value_unset(&skeleton->priv->properties[n]);
-    g_free(skeleton->priv->properties);
-    g_list_free_full(skeleton->priv->changed_properties, (GDestroyNotify)_changed_property_free);
-    if (skeleton->priv->changed_properties_idle_source != NULL)
-        g_source_destroy(skeleton->priv->changed_properties_idle_source);
-    g_main_context_unref(skeleton->priv->context);
-    g_mutex_clear(&skeleton->priv->lock);
-    G_OBJECT_CLASS(gclue_location_skeleton_parent_class)->finalize(object);
-}
-
-static void gclue_location_skeleton_get_property(GObject *object, guint prop_id, GValue *value,
-                                                 GParamSpec *pspec G_GNUC_UNUSED) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    g_assert(prop_id != 0 && prop_id - 1 < 8);
-    g_mutex_lock(&skeleton->priv->lock);
-    g_value_copy(&skeleton->priv->properties[prop_id - 1], value);
-    g_mutex_unlock(&skeleton->priv->lock);
-}
-
-static gboolean _gclue_location_emit_changed(gpointer user_data) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(user_data);
-    GList *l;
-    GVariantBuilder builder;
-    GVariantBuilder invalidated_builder;
-    guint num_changes;
-
-    g_mutex_lock(&skeleton->priv->lock);
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_84
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
-    g_variant_builder_init(&invalidated_builder, G_VARIANT_TYPE("as"));
-#else
-    g_variant_builder_init(&builder, G_VARIANT_TYPE("a{sv}"));
-    g_variant_builder_init(&invalidated_builder, G_VARIANT_TYPE("as"));
-#endif
-    for (l = skeleton->priv->changed_properties, num_changes = 0; l != NULL; l = l->next) {
-        ChangedProperty *cp = l->data;
-        GVariant *variant;
-        const GValue *cur_value;
-
-        cur_value = &skeleton->priv->properties[cp->prop_id - 1];
-        if (!_g_value_equal(cur_value, &cp->orig_value)) {
-            variant = g_dbus_gvalue_to_gvariant(cur_value,
-                                                G_VARIANT_TYPE(cp->info->parent_struct.signature));
-            g_variant_builder_add(&builder, "{sv}", cp->info->parent_struct.name, variant);
-            g_variant_unref(variant);
-            num_changes++;
-        }
-    }
-    if (num_changes > 0) {
-        GList *connections, *ll;
-        GVariant *signal_variant;
-        signal_variant = g_variant_ref_sink(g_variant_new(
-            "(sa{sv}as)", "org.freedesktop.GeoClue2.Location", &builder, &invalidated_builder));
-        connections =
-            g_dbus_interface_skeleton_get_connections(G_DBUS_INTERFACE_SKELETON(skeleton));
-        for (ll = connections; ll != NULL; ll = ll->next) {
-            GDBusConnection *connection = ll->data;
-
-            g_dbus_connection_emit_signal(
-                connection, NULL,
-                g_dbus_interface_skeleton_get_object_path(G_DBUS_INTERFACE_SKELETON(skeleton)),
-                "org.freedesktop.DBus.Properties", "PropertiesChanged", signal_variant, NULL);
-        }
-        g_variant_unref(signal_variant);
-        g_list_free_full(connections, g_object_unref);
-    } else {
-        g_variant_builder_clear(&builder);
-        g_variant_builder_clear(&invalidated_builder);
-    }
-    g_list_free_full(skeleton->priv->changed_properties, (GDestroyNotify)_changed_property_free);
-    skeleton->priv->changed_properties = NULL;
-    skeleton->priv->changed_properties_idle_source = NULL;
-    g_mutex_unlock(&skeleton->priv->lock);
-    return FALSE;
-}
-
-static void _gclue_location_schedule_emit_changed(GClueLocationSkeleton *skeleton,
-                                                  const _ExtendedGDBusPropertyInfo *info,
-                                                  guint prop_id, const GValue *orig_value) {
-    ChangedProperty *cp;
-    GList *l;
-    cp = NULL;
-    for (l = skeleton->priv->changed_properties; l != NULL; l = l->next) {
-        ChangedProperty *i_cp = l->data;
-        if (i_cp->info == info) {
-            cp = i_cp;
-            break;
-        }
-    }
-    if (cp == NULL) {
-        cp = g_new0(ChangedProperty, 1);
-        cp->prop_id = prop_id;
-        cp->info = info;
-        skeleton->priv->changed_properties = g_list_prepend(skeleton->priv->changed_properties, cp);
-        g_value_init(&cp->orig_value, G_VALUE_TYPE(orig_value));
-        g_value_copy(orig_value, &cp->orig_value);
-    }
-}
-
-static void gclue_location_skeleton_notify(GObject *object, GParamSpec *pspec G_GNUC_UNUSED) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    g_mutex_lock(&skeleton->priv->lock);
-    if (skeleton->priv->changed_properties != NULL &&
-        skeleton->priv->changed_properties_idle_source == NULL) {
-        skeleton->priv->changed_properties_idle_source = g_idle_source_new();
-        g_source_set_priority(skeleton->priv->changed_properties_idle_source, G_PRIORITY_DEFAULT);
-        g_source_set_callback(skeleton->priv->changed_properties_idle_source,
-                              _gclue_location_emit_changed, g_object_ref(skeleton),
-                              (GDestroyNotify)g_object_unref);
-        g_source_set_name(skeleton->priv->changed_properties_idle_source,
-                          "[generated] _gclue_location_emit_changed");
-        g_source_attach(skeleton->priv->changed_properties_idle_source, skeleton->priv->context);
-        g_source_unref(skeleton->priv->changed_properties_idle_source);
-    }
-    g_mutex_unlock(&skeleton->priv->lock);
-}
-
-static void gclue_location_skeleton_set_property(GObject *object, guint prop_id,
-                                                 const GValue *value, GParamSpec *pspec) {
-    const _ExtendedGDBusPropertyInfo *info;
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    g_assert(prop_id != 0 && prop_id - 1 < 8);
-    info = (const _ExtendedGDBusPropertyInfo *)_gclue_location_property_info_pointers[prop_id - 1];
-    g_mutex_lock(&skeleton->priv->lock);
-    g_object_freeze_notify(object);
-    if (!_g_value_equal(value, &skeleton->priv->properties[prop_id - 1])) {
-        if (g_dbus_interface_skeleton_get_connection(G_DBUS_INTERFACE_SKELETON(skeleton)) != NULL &&
-            info->emits_changed_signal)
-            _gclue_location_schedule_emit_changed(skeleton, info, prop_id,
-                                                  &skeleton->priv->properties[prop_id - 1]);
-        g_value_copy(value, &skeleton->priv->properties[prop_id - 1]);
-        g_object_notify_by_pspec(object, pspec);
-    }
-    g_mutex_unlock(&skeleton->priv->lock);
-    g_object_thaw_notify(object);
-}
-
-static void gclue_location_skeleton_init(GClueLocationSkeleton *skeleton) {
-#if GLIB_VERSION_MAX_ALLOWED >= GLIB_VERSION_2_38
-    skeleton->priv = gclue_location_skeleton_get_instance_private(skeleton);
-#else
-    skeleton->priv = G_TYPE_INSTANCE_GET_PRIVATE(skeleton, GCLUE_TYPE_LOCATION_SKELETON,
-                                                 GClueLocationSkeletonPrivate);
-#endif
-
-    g_mutex_init(&skeleton->priv->lock);
-    skeleton->priv->context = g_main_context_ref_thread_default();
-    skeleton->priv->properties = g_new0(GValue, 8);
-    g_value_init(&skeleton->priv->properties[0], G_TYPE_DOUBLE);
-    g_value_init(&skeleton->priv->properties[1], G_TYPE_DOUBLE);
-    g_value_init(&skeleton->priv->properties[2], G_TYPE_DOUBLE);
-    g_value_init(&skeleton->priv->properties[3], G_TYPE_DOUBLE);
-    g_value_init(&skeleton->priv->properties[4], G_TYPE_DOUBLE);
-    g_value_init(&skeleton->priv->properties[5], G_TYPE_DOUBLE);
-    g_value_init(&skeleton->priv->properties[6], G_TYPE_STRING);
-    g_value_init(&skeleton->priv->properties[7], G_TYPE_VARIANT);
-}
-
-static gdouble gclue_location_skeleton_get_latitude(GClueLocation *object) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    gdouble value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_double(&(skeleton->priv->properties[0]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static gdouble gclue_location_skeleton_get_longitude(GClueLocation *object) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    gdouble value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_double(&(skeleton->priv->properties[1]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static gdouble gclue_location_skeleton_get_accuracy(GClueLocation *object) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    gdouble value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_double(&(skeleton->priv->properties[2]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static gdouble gclue_location_skeleton_get_altitude(GClueLocation *object) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    gdouble value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_double(&(skeleton->priv->properties[3]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static gdouble gclue_location_skeleton_get_speed(GClueLocation *object) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    gdouble value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_double(&(skeleton->priv->properties[4]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static gdouble gclue_location_skeleton_get_heading(GClueLocation *object) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    gdouble value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_double(&(skeleton->priv->properties[5]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static const gchar *gclue_location_skeleton_get_description(GClueLocation *object) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    const gchar *value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_string(&(skeleton->priv->properties[6]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static GVariant *gclue_location_skeleton_get_timestamp(GClueLocation *object) {
-    GClueLocationSkeleton *skeleton = GCLUE_LOCATION_SKELETON(object);
-    GVariant *value;
-    g_mutex_lock(&skeleton->priv->lock);
-    value = g_marshal_value_peek_variant(&(skeleton->priv->properties[7]));
-    g_mutex_unlock(&skeleton->priv->lock);
-    return value;
-}
-
-static void gclue_location_skeleton_class_init(GClueLocationSkeletonClass *klass) {
-    GObjectClass *gobject_class;
-    GDBusInterfaceSkeletonClass *skeleton_class;
-
-    gobject_class = G_OBJECT_CLASS(klass);
-    gobject_class->finalize = gclue_location_skeleton_finalize;
-    gobject_class->get_property = gclue_location_skeleton_get_property;
-    gobject_class->set_property = gclue_location_skeleton_set_property;
-    gobject_class->notify = gclue_location_skeleton_notify;
-
-    gclue_location_override_properties(gobject_class, 1);
-
-    skeleton_class = G_DBUS_INTERFACE_SKELETON_CLASS(klass);
-    skeleton_class->get_info = gclue_location_skeleton_dbus_interface_get_info;
-    skeleton_class->get_properties = gclue_location_skeleton_dbus_interface_get_properties;
-    skeleton_class->flush = gclue_location_skeleton_dbus_interface_flush;
-    skeleton_class->get_vtable = gclue_location_skeleton_dbus_interface_get_vtable;
-
-#if GLIB_VERSION_MAX_ALLOWED < GLIB_VERSION_2_38
-    g_type_class_add_private(klass, sizeof(GClueLocationSkeletonPrivate));
-#endif
-}
-
-static void gclue_location_skeleton_iface_init(GClueLocationIface *iface) {
-    iface->get_latitude = gclue_location_skeleton_get_latitude;
-    iface->get_longitude = gclue_location_skeleton_get_longitude;
-    iface->get_accuracy = gclue_location_skeleton_get_accuracy;
-    iface->get_altitude = gclue_location_skeleton_get_altitude;
-    iface->get_speed = gclue_location_skeleton_get_speed;
-    iface->get_heading = gclue_location_skeleton_get_heading;
-    iface->get_description = gclue_location_skeleton_get_description;
-    iface->get_timestamp = gclue_location_skeleton_get_timestamp;
-}
-
-/**
- * gclue_location_skeleton_new:
- *
- * Creates a skeleton object for the D-Bus interface <link
- * linkend="gdbus-interface-org-freedesktop-GeoClue2-Location.top_of_page">org.freedesktop.GeoClue2.Location</link>.
- *
- * Returns: (transfer full) (type GClueLocationSkeleton): The skeleton object.
- */
-GClueLocation *gclue_location_skeleton_new(void) {
-    return GCLUE_LOCATION(g_object_new(GCLUE_TYPE_LOCATION_SKELETON, NULL));
-}
@@ -1,28 +1,77 @@
 #include "geoclue1_backend.h"
+#include "bridge_config.h"
+#include "loop_monitor.h"
+#include "probes.h"
+#include "trace_ring.h"
 
 #include <cmath>
 #include <utility>
 
-// Number of location updates while velocity is considered fresh
-const size_t VELOCITY_FRESH_STEPS = 2;
+// Synchronous call on a GeoClue1 proxy; `method` must be a string literal as
+// it names the span in the trace ring
+static GVariant *call_geoclue1(GDBusProxy *proxy, const char *method, GVariant *parameters,
+                               GError **error) {
+    TraceSpan span("geoclue1", method);
+    BRIDGE_PROBE1(geoclue1__call__start, method);
+    GVariant *result = g_dbus_proxy_call_sync(proxy, method, parameters, G_DBUS_CALL_FLAGS_NONE,
+                                              -1, nullptr, error);
+    BRIDGE_PROBE2(geoclue1__call__done, method, result != nullptr);
+    return result;
+}
 
-Geoclue1Backend::Geoclue1Backend(GDBusConnection * /*connection*/) {
-    // GeoClue1 runs on the *session* bus, not the system bus.
-    // We therefore connect to the session bus here, independently of
-    // the system-bus connection used for the GeoClue2 side.
-    GError *error = nullptr;
-    m_connection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
-    if (!m_connection) {
-        g_warning("Geoclue1Backend: failed to connect to session bus: %s",
-                  error ? error->message : "unknown error");
-        if (error) {
-            g_error_free(error);
-        }
+void GeoClue1VelocityMerge::update(double new_speed, double new_direction, double new_climb,
+                                   int fresh_steps) {
+    speed = std::isnan(new_speed) ? -1.0 : new_speed;
+    direction = std::isnan(new_direction) ? -1.0 : new_direction;
+    climb = std::isnan(new_climb) ? -1.0 : new_climb;
+    is_fresh = fresh_steps;
+}
+
+void GeoClue1VelocityMerge::merge_into(GeoClue1Position &pos) {
+    if (is_fresh > 0) {
+        pos.speed = speed;
+        pos.heading = direction;
+        pos.climb = climb;
+        is_fresh -= 1;
+    } else {
+        pos.speed = -1.0;   // Unknown
+        pos.heading = -1.0; // Unknown
+        pos.climb = -1.0;   // Unknown
+    }
+}
+
+gint geoclue1_decode_position(GVariant *parameters, GeoClue1Position *pos, gint *timestamp) {
+    gint fields = 0, timestamp_int = 0;
+    gdouble latitude = 0.0, longitude = 0.0, altitude = 0.0;
+    gint32 accuracy_level = 0;
+    gdouble accuracy_h = 0.0, accuracy_v = 0.0;
+
+    g_variant_get(parameters, "(iiddd(idd))", &fields, &timestamp_int, &latitude, &longitude,
+                  &altitude, &accuracy_level, &accuracy_h, &accuracy_v);
+
+    pos->latitude = latitude;
+    pos->longitude = longitude;
+    pos->altitude = altitude;
+    pos->accuracy = accuracy_h;
+    pos->timestamp_iso8601 = std::to_string(timestamp_int);
+
+    if (timestamp) {
+        *timestamp = timestamp_int;
+    }
+    return fields;
+}
+
+Geoclue1Backend::Geoclue1Backend(GDBusConnection *session_connection) {
+    // GeoClue1 runs on the *session* bus, not the system bus. The caller
+    // connects to it concurrently with the system bus at startup.
+    if (!session_connection) {
         // Leave m_connection == nullptr; ensure_master_client() will fail
         // gracefully and callers will see start_tracking() do nothing.
+        g_warning("Geoclue1Backend: no session bus connection");
         return;
     }
 
+    m_connection = G_DBUS_CONNECTION(g_object_ref(session_connection));
     g_message("Geoclue1Backend created (using session bus)");
 }
 
@@ -31,6 +80,11 @@ Geoclue1Backend::~Geoclue1Backend() {
     g_message("Geoclue1Backend::~Geoclue1Backend: destroying master client");
     destroy_master_client();
 
+    if (m_connection) {
+        g_object_unref(m_connection);
+        m_connection = nullptr;
+    }
+
     g_message("Geoclue1Backend destroyed");
 }
 
@@ -42,7 +96,30 @@ void Geoclue1Backend::set_velocity_callback(VelocityCallback cb) {
     m_velocity_callback = std::move(cb);
 }
 
+GVariant *Geoclue1Backend::save_state() const {
+    GVariantBuilder state;
+    g_variant_builder_init(&state, G_VARIANT_TYPE_VARDICT);
+    g_variant_builder_add(&state, "{sv}", "tracking", g_variant_new_boolean(m_tracking));
+    g_variant_builder_add(&state, "{sv}", "velocity-fresh",
+                          g_variant_new_int32(m_last_velocity.is_fresh));
+    g_variant_builder_add(&state, "{sv}", "speed", g_variant_new_double(m_last_velocity.speed));
+    g_variant_builder_add(&state, "{sv}", "direction",
+                          g_variant_new_double(m_last_velocity.direction));
+    g_variant_builder_add(&state, "{sv}", "climb", g_variant_new_double(m_last_velocity.climb));
+    return g_variant_builder_end(&state);
+}
+
+void Geoclue1Backend::restore_state(GVariant *state) {
+    g_variant_lookup(state, "velocity-fresh", "i", &m_last_velocity.is_fresh);
+    g_variant_lookup(state, "speed", "d", &m_last_velocity.speed);
+    g_variant_lookup(state, "direction", "d", &m_last_velocity.direction);
+    g_variant_lookup(state, "climb", "d", &m_last_velocity.climb);
+}
+
 void Geoclue1Backend::start_tracking() {
+    TraceSpan span("backend", "start_tracking");
+    BRIDGE_PROBE0(tracking__start);
+
     if (m_tracking) {
         g_message("Geoclue1Backend::start_tracking: already tracking");
         return;
@@ -61,6 +138,9 @@ void Geoclue1Backend::start_tracking() {
 }
 
 void Geoclue1Backend::stop_tracking() {
+    TraceSpan span("backend", "stop_tracking");
+    BRIDGE_PROBE0(tracking__stop);
+
     if (!m_tracking) {
         g_message("Geoclue1Backend::stop_tracking: not tracking");
         // Even if m_tracking is false, we may still have lingering proxies;
@@ -111,45 +191,22 @@ void Geoclue1Backend::on_position_changed(GDBusConnection * /*connection*/,
                                           const char * /*interface_name*/,
                                           const char * /*signal_name*/, GVariant *parameters,
                                           gpointer user_data) {
+    LoopMonitor::Scope timing("Backend", "PositionChanged");
+    TraceSpan span("geoclue1", "PositionChanged");
+
     auto *backend = static_cast<Geoclue1Backend *>(user_data);
     if (!backend) {
         return;
     }
 
-    gint fields = 0, timestamp_int = 0;
-    gdouble latitude = 0.0, longitude = 0.0, altitude = 0.0;
-    gint32 accuracy_level = 0;
-    gdouble accuracy_h = 0.0, accuracy_v = 0.0;
-
-    g_variant_get(parameters, "(iiddd(idd))", &fields, &timestamp_int, &latitude, &longitude,
-                  &altitude, &accuracy_level, &accuracy_h, &accuracy_v);
-
-    // g_debug("on_position_changed: fields=%d, ts=%d, lat=%f, lon=%f, alt=%f, "
-    //         "acc_level=%d, acc_h=%f, acc_v=%f",
-    //         fields, timestamp_int, latitude, longitude, altitude, accuracy_level, accuracy_h,
-    //         accuracy_v);
-
     GeoClue1Position pos;
-
-    pos.latitude = latitude;
-    pos.longitude = longitude;
-    pos.altitude = altitude;
-    pos.accuracy = accuracy_h;
-    pos.timestamp_iso8601 = std::to_string(timestamp_int);
+    gint timestamp_int = 0;
+    [[maybe_unused]] gint fields = geoclue1_decode_position(parameters, &pos, &timestamp_int);
+    BRIDGE_PROBE2(position__changed, fields, timestamp_int);
 
     // Merge velocity data if available and fresh
-    if (backend->m_last_velocity.is_fresh > 0) {
-        pos.speed = backend->m_last_velocity.speed;
-        pos.heading = backend->m_last_velocity.direction;
-        pos.climb = backend->m_last_velocity.climb;
-        backend->m_last_velocity.is_fresh -= 1;
-        // g_debug("on_position_changed: merged velocity: speed=%f, heading=%f, climb=%f",
-        // pos.speed, pos.heading, pos.climb);
-    } else {
-        pos.speed = -1.0;   // Unknown
-        pos.heading = -1.0; // Unknown
-        pos.climb = -1.0;   // Unknown
-    }
+    TraceRing::instant("backend", "fusion", backend->m_last_velocity.is_fresh > 0);
+    backend->m_last_velocity.merge_into(pos);
 
     if (backend->m_position_callback) {
         backend->m_position_callback(pos);
@@ -162,6 +219,9 @@ void Geoclue1Backend::on_velocity_changed(GDBusConnection * /*connection*/,
                                           const char * /*interface_name*/,
                                           const char * /*signal_name*/, GVariant *parameters,
                                           gpointer user_data) {
+    LoopMonitor::Scope timing("Backend", "VelocityChanged");
+    TraceRing::instant("geoclue1", "VelocityChanged");
+
     auto *backend = static_cast<Geoclue1Backend *>(user_data);
     if (!backend) {
         return;
@@ -171,15 +231,14 @@ void Geoclue1Backend::on_velocity_changed(GDBusConnection * /*connection*/,
     gdouble speed = 0.0, direction = 0.0, climb = 0.0;
 
     g_variant_get(parameters, "(iiddd)", &fields, &timestamp_int, &speed, &direction, &climb);
+    BRIDGE_PROBE2(velocity__changed, fields, timestamp_int);
     // g_debug("on_velocity_changed: fields=%d, ts=%d, speed=%f, direction=%f, climb=%f", fields,
     //         timestamp_int, speed, direction, climb);
 
-    // Store velocity data for merging with next position update
-    // Sanitize NaN values to -1.0 (GeoClue2 convention for "unknown")
-    backend->m_last_velocity.speed = std::isnan(speed) ? -1.0 : speed;
-    backend->m_last_velocity.direction = std::isnan(direction) ? -1.0 : direction;
-    backend->m_last_velocity.climb = std::isnan(climb) ? -1.0 : climb;
-    backend->m_last_velocity.is_fresh = VELOCITY_FRESH_STEPS;
+    // Store velocity data for merging with the next [fusion]
+    // velocity-fresh-steps position updates
+    backend->m_last_velocity.update(speed, direction, climb,
+                                    (int)BridgeConfig::current().velocity_fresh_steps);
 
     // Also call the velocity callback if set (for logging/debugging)
     if (backend->m_velocity_callback) {
@@ -219,8 +278,7 @@ bool Geoclue1Backend::ensure_master_client() {
     }
 
     // Call Master.Create() to get client object path.
-    GVariant *create_result = g_dbus_proxy_call_sync(m_master_proxy, "Create", g_variant_new("()"),
-                                                     G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+    GVariant *create_result = call_geoclue1(m_master_proxy, "Create", g_variant_new("()"), &error);
     if (!create_result) {
         g_warning("Geoclue1Backend::ensure_master_client: Master.Create failed: %s",
                   error ? error->message : "unknown error");
@@ -278,8 +336,7 @@ bool Geoclue1Backend::ensure_master_client() {
 
     if (client_geoclue_proxy) {
         GVariant *add_ref_result =
-            g_dbus_proxy_call_sync(client_geoclue_proxy, "AddReference", g_variant_new("()"),
-                                   G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+            call_geoclue1(client_geoclue_proxy, "AddReference", g_variant_new("()"), &error);
         if (!add_ref_result) {
             g_warning("Geoclue1Backend::ensure_master_client: AddReference on client "
                       "failed: %s",
@@ -306,10 +363,10 @@ bool Geoclue1Backend::ensure_master_client() {
     const gboolean require_updates = TRUE;
     const gint allowed_resources = (1 << 10) - 1;
 
-    GVariant *set_req_result = g_dbus_proxy_call_sync(
+    GVariant *set_req_result = call_geoclue1(
         m_client_proxy, "SetRequirements",
         g_variant_new("(iibi)", accuracy_level, time_limit, require_updates, allowed_resources),
-        G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+        &error);
     if (!set_req_result) {
         g_warning("Geoclue1Backend::ensure_master_client: SetRequirements failed: %s",
                   error ? error->message : "unknown");
@@ -321,8 +378,7 @@ bool Geoclue1Backend::ensure_master_client() {
 
     // Start positioning.
     GVariant *pos_start_result =
-        g_dbus_proxy_call_sync(m_client_proxy, "PositionStart", g_variant_new("()"),
-                               G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+        call_geoclue1(m_client_proxy, "PositionStart", g_variant_new("()"), &error);
     if (!pos_start_result) {
         g_warning("Geoclue1Backend::ensure_master_client: PositionStart failed: %s",
                   error ? error->message : "unknown");
@@ -353,8 +409,7 @@ void Geoclue1Backend::destroy_master_client() {
         g_message("Geoclue1Backend::destroy_master_client: calling RemoveReference "
                   "on provider");
         GVariant *rem_ref_result =
-            g_dbus_proxy_call_sync(m_provider_proxy, "RemoveReference", g_variant_new("()"),
-                                   G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+            call_geoclue1(m_provider_proxy, "RemoveReference", g_variant_new("()"), &error);
         if (!rem_ref_result) {
             g_warning("Geoclue1Backend::destroy_master_client: RemoveReference call "
                       "failed: %s",
@@ -389,8 +444,7 @@ void Geoclue1Backend::destroy_master_client() {
 
         if (client_geoclue_proxy) {
             GVariant *rem_ref_client_result =
-                g_dbus_proxy_call_sync(client_geoclue_proxy, "RemoveReference", g_variant_new("()"),
-                                       G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+                call_geoclue1(client_geoclue_proxy, "RemoveReference", g_variant_new("()"), &error);
             if (!rem_ref_client_result) {
                 g_warning("Geoclue1Backend::destroy_master_client: RemoveReference on "
                           "client failed: %s",
@@ -429,6 +483,8 @@ void Geoclue1Backend::on_position_provider_changed(GDBusConnection * /*connectio
                                                    const char * /*interface_name*/,
                                                    const char * /*signal_name*/,
                                                    GVariant *parameters, gpointer user_data) {
+    LoopMonitor::Scope timing("Backend", "PositionProviderChanged");
+
     GError *error = nullptr;
     auto *backend = static_cast<Geoclue1Backend *>(user_data);
     if (!backend) {
@@ -463,9 +519,8 @@ void Geoclue1Backend::on_position_provider_changed(GDBusConnection * /*connectio
         g_message("Geoclue1Backend::on_position_provider_changed: replacing "
                   "existing provider proxy");
         GError *error = nullptr;
-        GVariant *rem_ref_old_result = g_dbus_proxy_call_sync(
-            backend->m_provider_proxy, "RemoveReference", g_variant_new("()"),
-            G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+        GVariant *rem_ref_old_result = call_geoclue1(backend->m_provider_proxy, "RemoveReference",
+                                                     g_variant_new("()"), &error);
         if (!rem_ref_old_result) {
             g_warning("Geoclue1Backend::on_position_provider_changed: "
                       "RemoveReference (old) failed: %s",
@@ -494,8 +549,7 @@ void Geoclue1Backend::on_position_provider_changed(GDBusConnection * /*connectio
 
     // AddReference() so the provider stays alive.
     GVariant *add_ref_new_result =
-        g_dbus_proxy_call_sync(backend->m_provider_proxy, "AddReference", g_variant_new("()"),
-                               G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+        call_geoclue1(backend->m_provider_proxy, "AddReference", g_variant_new("()"), &error);
     if (!add_ref_new_result) {
         g_warning("Geoclue1Backend::on_position_provider_changed: AddReference "
                   "failed: %s",
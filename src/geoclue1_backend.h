@@ -31,12 +31,32 @@ struct GeoClue1Velocity {
     std::string timestamp_iso8601;
 };
 
+// Velocity of the last VelocityChanged, merged into the next few positions
+struct GeoClue1VelocityMerge {
+    int is_fresh = 0;        // positions the velocity is still merged into
+    double speed = -1.0;     // m/s
+    double direction = -1.0; // degrees from north
+    double climb = -1.0;     // m/s vertical speed
+
+    // Keep a VelocityChanged sample for the next `fresh_steps` positions.
+    // NaN becomes -1.0, the GeoClue2 convention for "unknown".
+    void update(double new_speed, double new_direction, double new_climb, int fresh_steps);
+
+    // Copy the velocity into `pos` while fresh, else mark it unknown
+    void merge_into(GeoClue1Position &pos);
+};
+
+// Decode a GeoClue1 PositionChanged body "(iiddd(idd))" into `pos`. Returns
+// the fields bitmask; `timestamp` receives the provider's Unix time.
+gint geoclue1_decode_position(GVariant *parameters, GeoClue1Position *pos, gint *timestamp);
+
 class Geoclue1Backend {
   public:
     using PositionCallback = std::function<void(const GeoClue1Position &)>;
     using VelocityCallback = std::function<void(const GeoClue1Velocity &)>;
 
-    explicit Geoclue1Backend(GDBusConnection *connection);
+    // session_connection may be nullptr if the session bus is unavailable
+    explicit Geoclue1Backend(GDBusConnection *session_connection);
     ~Geoclue1Backend();
 
     // Non-copyable
@@ -50,6 +70,12 @@ class Geoclue1Backend {
     // Control tracking based on active GeoClue2 clients
     void start_tracking();
     void stop_tracking();
+    bool is_tracking() const { return m_tracking; }
+
+    // Upgrade handoff: tracking flag and velocity merge state as an a{sv}.
+    // Restoring only seeds the velocity; tracking follows the clients.
+    GVariant *save_state() const;
+    void restore_state(GVariant *state);
 
   private:
     GDBusConnection *m_connection = nullptr;
@@ -58,12 +84,7 @@ class Geoclue1Backend {
     bool m_tracking = false;
 
     // Last velocity data for merging with position updates
-    struct {
-        int is_fresh = 0;
-        double speed = -1.0;     // m/s
-        double direction = -1.0; // degrees from north
-        double climb = -1.0;     // m/s vertical speed
-    } m_last_velocity;
+    GeoClue1VelocityMerge m_last_velocity;
 
     // Proxies for GeoClue1 objects:
     //
@@ -1,5 +1,14 @@
 #include "geoclue2_client.h"
+#include "agent_authorizer.h"
+#include "bridge_config.h"
+#include "clock.h"
+#include "dbus_interfaces.h"
 #include "geoclue2_manager.h"
+#include "location_fanout.h"
+#include "log.h"
+#include "loop_monitor.h"
+#include "probes.h"
+#include "trace_ring.h"
 
 /**
  * Implementation of the GeoClue2 Client object.
@@ -9,42 +18,36 @@
  */
 
 GeoClue2Client::GeoClue2Client(GDBusConnection *connection, const std::string &object_path,
-                               GeoClue2Manager *manager)
-    : m_connection(connection), m_object_path(object_path), m_manager(manager) {
+                               const std::string &peer, GeoClue2Manager *manager)
+    : m_connection(connection), m_object_path(object_path), m_peer(peer), m_manager(manager) {
     g_return_if_fail(connection != nullptr);
     g_return_if_fail(manager != nullptr);
 
-    // Create skeleton for org.freedesktop.GeoClue2.Client interface
-    GClueClient *client_iface = gclue_client_skeleton_new();
-    m_skeleton = GCLUE_CLIENT_SKELETON(client_iface);
+    m_idle_since_us = Clock::get().monotonic_us();
 
-    // Set initial property values
-    gclue_client_set_location(client_iface, m_location_path.c_str());
-    gclue_client_set_distance_threshold(client_iface, m_distance_threshold);
-    gclue_client_set_time_threshold(client_iface, m_time_threshold);
-    gclue_client_set_desktop_id(client_iface, m_desktop_id.c_str());
-    gclue_client_set_requested_accuracy_level(client_iface, m_requested_accuracy_level);
-    gclue_client_set_active(client_iface, m_active);
+    // Trailing client number of the path tags this client's trace events
+    m_trace_id = (guint32)g_ascii_strtoull(strrchr(m_object_path.c_str(), '/') + 1, nullptr, 10);
 
-    // Connect method handlers
-    g_signal_connect(m_skeleton, "handle-start", G_CALLBACK(on_handle_start), this);
-    g_signal_connect(m_skeleton, "handle-stop", G_CALLBACK(on_handle_stop), this);
+    static const GDBusInterfaceVTable vtable = {&GeoClue2Client::on_method_call,
+                                                &GeoClue2Client::on_get_property,
+                                                &GeoClue2Client::on_set_property, {}};
 
-    // Export the skeleton on D-Bus
+    // Export the object on D-Bus; property values are read from our fields
     GError *error = nullptr;
-    m_registration_id = g_dbus_interface_skeleton_export(
-        G_DBUS_INTERFACE_SKELETON(m_skeleton), m_connection, m_object_path.c_str(), &error);
-
-    if (error) {
-        g_warning("Failed to export Client at %s: %s", m_object_path.c_str(), error->message);
-        g_error_free(error);
-        g_object_unref(m_skeleton);
-        m_skeleton = nullptr;
-        m_registration_id = 0;
+    m_registration_id = g_dbus_connection_register_object(
+        m_connection, m_object_path.c_str(), geoclue2_client_interface_info(), &vtable, this,
+        nullptr, &error);
+
+    if (m_registration_id == 0) {
+        g_warning("Failed to export Client at %s: %s", m_object_path.c_str(),
+                  error ? error->message : "unknown error");
+        if (error) {
+            g_error_free(error);
+        }
         return;
     }
 
-    g_message("GeoClue2Client exported at %s", m_object_path.c_str());
+    BRIDGE_MESSAGE(LogCategory::Client, "GeoClue2Client exported at %s", m_object_path.c_str());
 }
 
 GeoClue2Client::~GeoClue2Client() {
@@ -53,17 +56,14 @@ GeoClue2Client::~GeoClue2Client() {
         set_active(false);
     }
 
+    cancel_rate_cap_send();
+
     if (m_registration_id != 0) {
-        g_dbus_interface_skeleton_unexport(G_DBUS_INTERFACE_SKELETON(m_skeleton));
+        g_dbus_connection_unregister_object(m_connection, m_registration_id);
         m_registration_id = 0;
     }
 
-    if (m_skeleton) {
-        g_object_unref(m_skeleton);
-        m_skeleton = nullptr;
-    }
-
-    g_message("GeoClue2Client destroyed at %s", m_object_path.c_str());
+    BRIDGE_MESSAGE(LogCategory::Client, "GeoClue2Client destroyed at %s", m_object_path.c_str());
 }
 
 void GeoClue2Client::set_active(bool active) {
@@ -71,89 +71,389 @@ void GeoClue2Client::set_active(bool active) {
         return;
     }
 
-    m_active = active;
+    TraceRing::instant("client", active ? "start" : "stop", m_trace_id);
 
-    if (m_skeleton) {
-        gclue_client_set_active(GCLUE_CLIENT(m_skeleton), m_active);
+    m_active = active;
+    m_idle_since_us = m_active ? -1 : Clock::get().monotonic_us();
+    if (!m_active) {
+        cancel_rate_cap_send();
     }
 
+    DBusPropertyBatch changes;
+    changes.add("Active", get_active());
+    changes.emit(m_connection, m_object_path.c_str(), GEOCLUE2_CLIENT_INTERFACE);
+
     // Notify manager of state change
     if (m_active_changed_callback) {
         m_active_changed_callback(m_active);
     }
 
-    g_message("Client %s is now %s", m_object_path.c_str(), m_active ? "active" : "inactive");
+    BRIDGE_MESSAGE_RATELIMITED(LogCategory::Client, "Client %s is now %s", m_object_path.c_str(),
+                               m_active ? "active" : "inactive");
 }
 
-void GeoClue2Client::notify_location_update(const std::string &new_location_path) {
-    if (!m_active || !m_skeleton) {
+gsize GeoClue2Client::estimated_memory() const {
+    return sizeof(*this) + m_object_path.capacity() + m_peer.capacity() + m_desktop_id.capacity() +
+           m_location_path.capacity() + m_pending_location_path.capacity();
+}
+
+void GeoClue2Client::notify_location_update(LocationSignalFanout &fanout) {
+    if (!m_active || m_registration_id == 0) {
         return; // Only send updates to active clients
     }
 
-    std::string old_location = m_location_path;
-    m_location_path = new_location_path;
+    BRIDGE_PROBE2(client__notify, m_trace_id, m_unread_updates);
+
+    gint64 now = Clock::get().monotonic_us();
+    ClientDeliveryStats &stats = m_manager->delivery_stats();
+    const BridgeConfig &config = BridgeConfig::current();
+
+    update_policy(config);
+    const BridgeConfig::QosClass &qos = config.qos_classes[m_qos_class];
+
+    // Updates sent without the peer reading any Location before it counts as
+    // slow; signal-only listeners and classes without coalescing keep
+    // getting every fix
+    if (qos.coalesce && !m_slow && m_read_locations &&
+        m_unread_updates >= config.slow_unread_limit) {
+        m_slow = true;
+        ++stats.slow_events;
+        g_message("Client %s: peer %s has %u unread updates (last read %" G_GINT64_FORMAT
+                  " ms ago), coalescing updates",
+                  m_object_path.c_str(), m_peer.c_str(), m_unread_updates,
+                  (now - m_last_read_us) / 1000);
+    }
 
-    // Update the Location property
-    gclue_client_set_location(GCLUE_CLIENT(m_skeleton), m_location_path.c_str());
+    // While slow, the latest fix is still delivered every slow-trickle-s so
+    // that a client which stopped reading Location objects is not starved
+    if (m_slow && now - m_last_delivery_us < (gint64)config.slow_trickle_s * G_USEC_PER_SEC) {
+        // Keep only the latest fix; it is sent once the peer catches up
+        m_pending_location_path = fanout.get_location_path();
+        ++stats.coalesced_updates;
+        TraceRing::instant("client", "coalesce", m_trace_id);
+        return;
+    }
 
-    // Emit LocationUpdated signal
-    gclue_client_emit_location_updated(GCLUE_CLIENT(m_skeleton), old_location.c_str(),
-                                       new_location_path.c_str());
+    // Batching window of the class: hold the latest fix, the Manager sends
+    // it to every client of the class when the window ends
+    if (qos.batch_ms > 0) {
+        m_pending_location_path = fanout.get_location_path();
+        ++stats.batched_updates;
+        m_manager->schedule_batch_flush(m_qos_class);
+        return;
+    }
 
-    g_debug("Client %s: LocationUpdated(%s -> %s)", m_object_path.c_str(), old_location.c_str(),
-            new_location_path.c_str());
+    // Rate cap of the client's application: hold the latest fix and send it
+    // once the interval since the last delivery has passed
+    if (rate_capped(now)) {
+        m_pending_location_path = fanout.get_location_path();
+        ++stats.rate_capped_updates;
+        schedule_rate_cap_send(now);
+        return;
+    }
+
+    deliver_location_update(fanout, now);
 }
 
-/* static */ gboolean GeoClue2Client::on_handle_start(GClueClient *object,
-                                                      GDBusMethodInvocation *invocation,
-                                                      gpointer user_data) {
-    auto *client = static_cast<GeoClue2Client *>(user_data);
-    if (!client) {
-        g_dbus_method_invocation_return_error_literal(invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
-                                                      "Internal error: client is null");
-        return TRUE;
+bool GeoClue2Client::flush_batched_update(LocationSignalFanout &fanout) {
+    // Slow clients get their fix once the peer catches up
+    if (!m_active || m_slow || m_pending_location_path != fanout.get_location_path()) {
+        return false;
     }
 
-    g_message("Client %s: Start() called", client->m_object_path.c_str());
+    gint64 now = Clock::get().monotonic_us();
+    if (rate_capped(now)) {
+        ++m_manager->delivery_stats().rate_capped_updates;
+        return true;
+    }
 
-    if (client->m_active) {
-        // Already started, just complete successfully
-        gclue_client_complete_start(object, invocation);
-        return TRUE;
+    deliver_location_update(fanout, now);
+    return false;
+}
+
+guint GeoClue2Client::qos_class() {
+    update_policy(BridgeConfig::current());
+    return m_qos_class;
+}
+
+void GeoClue2Client::update_policy(const BridgeConfig &config) {
+    if (m_policy_generation != config.generation) {
+        m_qos_class = config.qos_class_of(m_desktop_id);
+        m_min_interval_us = config.min_delivery_interval_us(m_desktop_id);
+        m_policy_generation = config.generation;
+    }
+}
+
+bool GeoClue2Client::rate_capped(gint64 now) const {
+    return m_min_interval_us > 0 && m_last_delivery_us >= 0 &&
+           now - m_last_delivery_us < m_min_interval_us;
+}
+
+void GeoClue2Client::schedule_rate_cap_send(gint64 now) {
+    if (m_rate_cap_timer_id != 0) {
+        return;
     }
 
-    // Activate this client
-    client->set_active(true);
+    // Rounded up, so that the cap has passed when the timer fires
+    gint64 wait_us = m_last_delivery_us + m_min_interval_us - now;
+    m_rate_cap_timer_id = Clock::get().add_timeout((guint)((wait_us + 999) / 1000),
+                                                   &GeoClue2Client::on_rate_cap_timeout, this);
+}
 
-    // Complete the method call
-    gclue_client_complete_start(object, invocation);
+void GeoClue2Client::cancel_rate_cap_send() {
+    if (m_rate_cap_timer_id != 0) {
+        Clock::get().remove(m_rate_cap_timer_id);
+        m_rate_cap_timer_id = 0;
+    }
+}
 
-    return TRUE;
+/* static */ gboolean GeoClue2Client::on_rate_cap_timeout(gpointer user_data) {
+    LoopMonitor::Scope timing("Timeout", "RateCap");
+
+    auto *self = static_cast<GeoClue2Client *>(user_data);
+    self->m_rate_cap_timer_id = 0;
+
+    // Slow clients get the held fix once the peer catches up
+    gint64 now = Clock::get().monotonic_us();
+    if (self->m_active && !self->m_slow && !self->m_pending_location_path.empty()) {
+        LocationSignalFanout fanout(self->m_connection, self->m_pending_location_path);
+        self->deliver_location_update(fanout, now);
+    }
+    return G_SOURCE_REMOVE;
+}
+
+void GeoClue2Client::deliver_location_update(LocationSignalFanout &fanout, gint64 now) {
+    m_pending_location_path.clear();
+    cancel_rate_cap_send();
+
+    TraceSpan span("client", "emit", m_trace_id);
+
+    // Location property change + LocationUpdated signal, stamped from the
+    // per-fix templates. The Location property only moves on once the peer
+    // was sent the new one.
+    if (!fanout.send(m_object_path, m_peer, m_location_path)) {
+        return;
+    }
+
+    BRIDGE_DEBUG_RATELIMITED(LogCategory::Fix, "Client %s: LocationUpdated(%s -> %s)",
+                             m_object_path.c_str(), m_location_path.c_str(),
+                             fanout.get_location_path().c_str());
+
+    m_location_path = fanout.get_location_path();
+    ++m_unread_updates;
+    m_last_delivery_us = now;
+    ++m_manager->delivery_stats().sent_updates;
+}
+
+void GeoClue2Client::mark_location_read() {
+    gint64 now = Clock::get().monotonic_us();
+    m_unread_updates = 0;
+    m_last_read_us = now;
+    m_read_locations = true;
+
+    if (!m_slow) {
+        return;
+    }
+
+    m_slow = false;
+    ++m_manager->delivery_stats().recovered_events;
+    g_message("Client %s: peer %s caught up, resuming updates", m_object_path.c_str(),
+              m_peer.c_str());
+
+    // Flush the coalesced fix right away
+    if (m_active && !m_pending_location_path.empty()) {
+        LocationSignalFanout fanout(m_connection, m_pending_location_path);
+        deliver_location_update(fanout, now);
+    }
 }
 
-/* static */ gboolean GeoClue2Client::on_handle_stop(GClueClient *object,
-                                                     GDBusMethodInvocation *invocation,
-                                                     gpointer user_data) {
+/* static */ void GeoClue2Client::on_method_call(GDBusConnection * /*connection*/,
+                                                 const gchar * /*sender*/,
+                                                 const gchar * /*object_path*/,
+                                                 const gchar * /*interface_name*/,
+                                                 const gchar *method_name, GVariant *parameters,
+                                                 GDBusMethodInvocation *invocation,
+                                                 gpointer user_data) {
+    LoopMonitor::Scope timing("Client", method_name);
+
+    static const DBusMethodEntry<GeoClue2Client> methods[] = {
+        {"Start", &GeoClue2Client::handle_start},
+        {"Stop", &GeoClue2Client::handle_stop},
+    };
+
     auto *client = static_cast<GeoClue2Client *>(user_data);
-    if (!client) {
-        g_dbus_method_invocation_return_error_literal(invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
-                                                      "Internal error: client is null");
-        return TRUE;
+    dbus_dispatch_method_call(client, methods, method_name, parameters, invocation);
+}
+
+// Accessor table shared by the get/set vtable entry points
+const DBusPropertyEntry<GeoClue2Client> GeoClue2Client::s_properties[] = {
+    {"Location", &GeoClue2Client::get_location, nullptr},
+    {"DistanceThreshold", &GeoClue2Client::get_distance_threshold,
+     &GeoClue2Client::set_distance_threshold},
+    {"TimeThreshold", &GeoClue2Client::get_time_threshold, &GeoClue2Client::set_time_threshold},
+    {"DesktopId", &GeoClue2Client::get_desktop_id_property, &GeoClue2Client::set_desktop_id},
+    {"RequestedAccuracyLevel", &GeoClue2Client::get_requested_accuracy_level_property,
+     &GeoClue2Client::set_requested_accuracy_level},
+    {"Active", &GeoClue2Client::get_active, nullptr},
+};
+
+GVariant *GeoClue2Client::save_state() const {
+    GVariantBuilder state;
+    g_variant_builder_init(&state, G_VARIANT_TYPE_VARDICT);
+    g_variant_builder_add(&state, "{sv}", "path", g_variant_new_string(m_object_path.c_str()));
+    g_variant_builder_add(&state, "{sv}", "peer", g_variant_new_string(m_peer.c_str()));
+    g_variant_builder_add(&state, "{sv}", "granted-accuracy-level",
+                          g_variant_new_uint32(m_granted_accuracy_level));
+    for (const auto &property : s_properties) {
+        g_variant_builder_add(&state, "{sv}", property.name, (this->*property.getter)());
+    }
+    return g_variant_builder_end(&state);
+}
+
+void GeoClue2Client::restore_state(GVariant *state) {
+    const gchar *desktop_id = nullptr;
+    if (g_variant_lookup(state, "DesktopId", "&s", &desktop_id)) {
+        m_desktop_id = desktop_id;
+        m_policy_generation = G_MAXUINT64;
+        m_manager->client_qos_changed();
     }
 
-    g_message("Client %s: Stop() called", client->m_object_path.c_str());
+    const gchar *location_path = nullptr;
+    if (g_variant_lookup(state, "Location", "&o", &location_path)) {
+        m_location_path = location_path;
+    }
 
-    if (!client->m_active) {
-        // Already stopped, just complete successfully
-        gclue_client_complete_stop(object, invocation);
-        return TRUE;
+    g_variant_lookup(state, "DistanceThreshold", "u", &m_distance_threshold);
+    g_variant_lookup(state, "TimeThreshold", "u", &m_time_threshold);
+    g_variant_lookup(state, "RequestedAccuracyLevel", "u", &m_requested_accuracy_level);
+    if (!g_variant_lookup(state, "granted-accuracy-level", "u", &m_granted_accuracy_level)) {
+        // From an instance that did not record it: what it started the client with
+        m_granted_accuracy_level = m_requested_accuracy_level != 0 ? m_requested_accuracy_level
+                                                                   : DEFAULT_ACCURACY_LEVEL;
     }
 
-    // Deactivate this client
-    client->set_active(false);
+    gboolean active = FALSE;
+    if (g_variant_lookup(state, "Active", "b", &active) && active && !m_active) {
+        m_active = true;
+        m_idle_since_us = -1;
+        if (m_active_changed_callback) {
+            m_active_changed_callback(true);
+        }
+    }
+}
 
-    // Complete the method call
-    gclue_client_complete_stop(object, invocation);
+/* static */ GVariant *GeoClue2Client::on_get_property(GDBusConnection * /*connection*/,
+                                                      const gchar * /*sender*/,
+                                                      const gchar * /*object_path*/,
+                                                      const gchar * /*interface_name*/,
+                                                      const gchar *property_name, GError **error,
+                                                      gpointer user_data) {
+    auto *client = static_cast<const GeoClue2Client *>(user_data);
+    return dbus_dispatch_get_property(client, s_properties, property_name, error);
+}
 
+/* static */ gboolean GeoClue2Client::on_set_property(GDBusConnection * /*connection*/,
+                                                     const gchar * /*sender*/,
+                                                     const gchar * /*object_path*/,
+                                                     const gchar * /*interface_name*/,
+                                                     const gchar *property_name, GVariant *value,
+                                                     GError **error, gpointer user_data) {
+    LoopMonitor::Scope timing("Client.Set", property_name);
+
+    auto *client = static_cast<GeoClue2Client *>(user_data);
+    GVariant *old_value = dbus_dispatch_get_property(client, s_properties, property_name, nullptr);
+    if (!dbus_dispatch_set_property(client, s_properties, property_name, value, error)) {
+        if (old_value) {
+            g_variant_unref(g_variant_ref_sink(old_value));
+        }
+        return FALSE;
+    }
+
+    // Writable properties are set by the client itself; echo a change so that
+    // other observers (and cached proxies) stay consistent. Writing the value
+    // a property already has is not a change.
+    DBusPropertyBatch changes;
+    if (old_value) {
+        changes.add_if_changed(property_name, old_value, value);
+    } else {
+        changes.add(property_name, value);
+    }
+    changes.emit(client->m_connection, client->m_object_path.c_str(), GEOCLUE2_CLIENT_INTERFACE);
     return TRUE;
 }
+
+GVariant *GeoClue2Client::get_location() const {
+    return g_variant_new_object_path(m_location_path.c_str());
+}
+
+GVariant *GeoClue2Client::get_distance_threshold() const {
+    return g_variant_new_uint32(m_distance_threshold);
+}
+
+GVariant *GeoClue2Client::get_time_threshold() const {
+    return g_variant_new_uint32(m_time_threshold);
+}
+
+GVariant *GeoClue2Client::get_desktop_id_property() const {
+    return g_variant_new_string(m_desktop_id.c_str());
+}
+
+GVariant *GeoClue2Client::get_requested_accuracy_level_property() const {
+    return g_variant_new_uint32(m_requested_accuracy_level);
+}
+
+GVariant *GeoClue2Client::get_active() const { return g_variant_new_boolean(m_active); }
+
+bool GeoClue2Client::set_distance_threshold(GVariant *value) {
+    m_distance_threshold = g_variant_get_uint32(value);
+    return true;
+}
+
+bool GeoClue2Client::set_time_threshold(GVariant *value) {
+    m_time_threshold = g_variant_get_uint32(value);
+    return true;
+}
+
+bool GeoClue2Client::set_desktop_id(GVariant *value) {
+    m_desktop_id = g_variant_get_string(value, nullptr);
+    m_policy_generation = G_MAXUINT64;
+    m_manager->client_qos_changed();
+    return true;
+}
+
+bool GeoClue2Client::set_requested_accuracy_level(GVariant *value) {
+    guint level = g_variant_get_uint32(value);
+
+    // More than the agent allowed needs a new Start()
+    if (m_active && (level != 0 ? level : DEFAULT_ACCURACY_LEVEL) > m_granted_accuracy_level) {
+        return false;
+    }
+
+    m_requested_accuracy_level = level;
+    return true;
+}
+
+void GeoClue2Client::handle_start(GVariant * /*parameters*/, GDBusMethodInvocation *invocation) {
+    BRIDGE_MESSAGE_RATELIMITED(LogCategory::Client, "Client %s: Start() called",
+                               m_object_path.c_str());
+
+    if (m_active) {
+        // Already started, just complete successfully
+        g_dbus_method_invocation_return_value(invocation, nullptr);
+        return;
+    }
+
+    // Authorization may involve the agent; the Manager completes the call
+    m_manager->request_client_start(m_object_path, invocation);
+}
+
+void GeoClue2Client::handle_stop(GVariant * /*parameters*/, GDBusMethodInvocation *invocation) {
+    BRIDGE_MESSAGE_RATELIMITED(LogCategory::Client, "Client %s: Stop() called",
+                               m_object_path.c_str());
+
+    // Deactivate this client (no-op when already stopped)
+    set_active(false);
+
+    // Complete the method call
+    g_dbus_method_invocation_return_value(invocation, nullptr);
+}
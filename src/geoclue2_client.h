@@ -7,11 +7,33 @@
 #include <memory>
 #include <string>
 
-#include "geoclue2-client.h"
+#include "dbus_interfaces.h"
+#include "memory_stats.h"
 
 // Forward declarations
+struct BridgeConfig;
 class GeoClue2Manager;
 class GeoClue2Location;
+class LocationSignalFanout;
+
+/**
+ * Delivery accounting shared by all clients of a Manager.
+ *
+ * A client is classified as slow when its peer read Location objects before
+ * but keeps receiving LocationUpdated without reading the new ones. While
+ * slow, updates are coalesced to the latest fix instead of queueing one
+ * message per fix in our outgoing buffers and in dbus-daemon. Peers that
+ * never read a Location live off the LocationUpdated signal itself and are
+ * never classified as slow.
+ */
+struct ClientDeliveryStats {
+    guint64 sent_updates = 0;
+    guint64 coalesced_updates = 0;
+    guint64 slow_events = 0;
+    guint64 recovered_events = 0;
+    guint64 rate_capped_updates = 0; // held back under a [delivery] max-rate
+    guint64 batched_updates = 0;     // held for the batching window of a QoS class
+};
 
 /**
  * GeoClue2 Client interface.
@@ -20,12 +42,12 @@ class GeoClue2Location;
  * Tracks per-client state and exposes Start/Stop and properties.
  */
 
-class GeoClue2Client {
+class GeoClue2Client : public LiveCounted<GeoClue2Client> {
   public:
     using ActiveChangedCallback = std::function<void(bool active)>;
 
     GeoClue2Client(GDBusConnection *connection, const std::string &object_path,
-                   GeoClue2Manager *manager);
+                   const std::string &peer, GeoClue2Manager *manager);
     ~GeoClue2Client();
 
     // Non-copyable
@@ -35,40 +57,147 @@ class GeoClue2Client {
     // Get the object path
     const std::string &get_path() const { return m_object_path; }
 
+    // Get the unique bus name of the peer that owns this client
+    const std::string &get_peer() const { return m_peer; }
+
     // Check if client is active (started)
     bool is_active() const { return m_active; }
 
-    // Update location and emit LocationUpdated signal
-    void notify_location_update(const std::string &new_location_path);
+    // Properties used for authorization
+    const std::string &get_desktop_id() const { return m_desktop_id; }
+    guint get_requested_accuracy_level() const { return m_requested_accuracy_level; }
+
+    // Accuracy level the agent allowed for the last Start(); while active,
+    // RequestedAccuracyLevel cannot be raised above it
+    void set_granted_accuracy_level(guint level) { m_granted_accuracy_level = level; }
+
+    // Set active state and notify manager (Start() goes through the Manager
+    // for authorization first)
+    void set_active(bool active);
+
+    // Monotonic time since when the client is unstarted (-1 while active)
+    gint64 get_idle_since_us() const { return m_idle_since_us; }
+
+    // Approximate heap footprint of this client, for quota accounting
+    gsize estimated_memory() const;
+
+    // Update location and queue LocationUpdated through the per-fix fan-out
+    void notify_location_update(LocationSignalFanout &fanout);
+
+    // Send the fix held for the batching window of the client's QoS class,
+    // unless the rate cap holds it for another window (returns true then)
+    bool flush_batched_update(LocationSignalFanout &fanout);
+
+    // Latest fix not yet sent (batched, coalesced or rate-capped), empty if none
+    const std::string &get_pending_location_path() const { return m_pending_location_path; }
+
+    // The fix was sent to the client or is held for it
+    bool was_offered(const std::string &location_path) const {
+        return m_location_path == location_path || m_pending_location_path == location_path;
+    }
+
+    // QosClassId of the client's DesktopId under the configuration in effect
+    guint qos_class();
+
+    // Record that the owning peer read a Location; recovers slow clients
+    void mark_location_read();
+
+    // Check if the client is currently classified as a slow consumer
+    bool is_slow() const { return m_slow; }
+
+    // Updates delivered since the peer last read a Location
+    guint get_unread_updates() const { return m_unread_updates; }
 
     // Set callback for when active state changes
     void set_active_changed_callback(ActiveChangedCallback cb) { m_active_changed_callback = cb; }
 
+    // Upgrade handoff: properties and active flag as an a{sv}, and the
+    // reverse. Restoring activates the client without signalling Active,
+    // since its value did not change for the peer.
+    GVariant *save_state() const;
+    void restore_state(GVariant *state);
+
   private:
     GDBusConnection *m_connection;
     std::string m_object_path;
+    std::string m_peer;
     GeoClue2Manager *m_manager;
-    GClueClientSkeleton *m_skeleton = nullptr;
     guint m_registration_id = 0;
+    guint32 m_trace_id = 0;
 
     // Client state
     bool m_active = false;
+    gint64 m_idle_since_us = -1;
     std::string m_desktop_id;
     guint m_requested_accuracy_level = 0;
+    guint m_granted_accuracy_level = 0;
     guint m_distance_threshold = 0;
     guint m_time_threshold = 0;
     std::string m_location_path = "/"; // "/" means no location yet
 
+    // Delivery accounting (see ClientDeliveryStats)
+    guint m_unread_updates = 0; // updates sent since the peer last read a Location
+    gint64 m_last_read_us = 0;
+    bool m_read_locations = false; // the peer reads Locations, not just the signal
+    gint64 m_last_delivery_us = -1; // -1 = nothing delivered yet
+    bool m_slow = false;
+    std::string m_pending_location_path; // latest fix held back while slow, batched or capped
+
+    // QoS class and rate cap of this DesktopId, cached per BridgeConfig generation
+    guint64 m_policy_generation = G_MAXUINT64;
+    guint m_qos_class = 0;
+    gint64 m_min_interval_us = 0;
+    guint m_rate_cap_timer_id = 0; // sends the fix held by the rate cap
+
     // Callback for active state changes
     ActiveChangedCallback m_active_changed_callback;
 
-    // D-Bus method handlers (static callbacks)
-    static gboolean on_handle_start(GClueClient *object, GDBusMethodInvocation *invocation,
-                                    gpointer user_data);
+    // Property accessor table (Location, thresholds, DesktopId, ...)
+    static const DBusPropertyEntry<GeoClue2Client> s_properties[];
 
-    static gboolean on_handle_stop(GClueClient *object, GDBusMethodInvocation *invocation,
-                                   gpointer user_data);
+    // D-Bus vtable entry points (dispatch through the tables in the .cpp)
+    static void on_method_call(GDBusConnection *connection, const gchar *sender,
+                               const gchar *object_path, const gchar *interface_name,
+                               const gchar *method_name, GVariant *parameters,
+                               GDBusMethodInvocation *invocation, gpointer user_data);
 
-    // Helper to set active state and notify manager
-    void set_active(bool active);
+    static GVariant *on_get_property(GDBusConnection *connection, const gchar *sender,
+                                     const gchar *object_path, const gchar *interface_name,
+                                     const gchar *property_name, GError **error,
+                                     gpointer user_data);
+
+    static gboolean on_set_property(GDBusConnection *connection, const gchar *sender,
+                                    const gchar *object_path, const gchar *interface_name,
+                                    const gchar *property_name, GVariant *value, GError **error,
+                                    gpointer user_data);
+
+    // D-Bus method handlers
+    void handle_start(GVariant *parameters, GDBusMethodInvocation *invocation);
+    void handle_stop(GVariant *parameters, GDBusMethodInvocation *invocation);
+
+    // D-Bus property accessors
+    GVariant *get_location() const;
+    GVariant *get_distance_threshold() const;
+    GVariant *get_time_threshold() const;
+    GVariant *get_desktop_id_property() const;
+    GVariant *get_requested_accuracy_level_property() const;
+    GVariant *get_active() const;
+    bool set_distance_threshold(GVariant *value);
+    bool set_time_threshold(GVariant *value);
+    bool set_desktop_id(GVariant *value);
+    bool set_requested_accuracy_level(GVariant *value);
+
+    // Look up the QoS policy again after a reload or a DesktopId change
+    void update_policy(const BridgeConfig &config);
+
+    // The rate cap of the client's application holds fixes back until then
+    bool rate_capped(gint64 now) const;
+
+    // One send of the held fix once the rate cap has passed
+    void schedule_rate_cap_send(gint64 now);
+    void cancel_rate_cap_send();
+    static gboolean on_rate_cap_timeout(gpointer user_data);
+
+    // Send the fix and update delivery accounting
+    void deliver_location_update(LocationSignalFanout &fanout, gint64 now);
 };
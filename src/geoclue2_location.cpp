@@ -1,22 +1,22 @@
 #include "geoclue2_location.h"
-
-#include <ctime>
+#include "clock.h"
+#include "geoclue2_manager.h"
+#include "log.h"
+#include "loop_monitor.h"
 
 /**
  * Implementation of the GeoClue2 Location object.
  *
- * Uses the generated GClueLocationSkeleton to expose location properties
- * on D-Bus. Location objects are read-only and immutable once created.
+ * Location properties are stored as plain fields and served through the
+ * table-driven dispatcher. Location objects are read-only and immutable once
+ * exported, so no PropertiesChanged signals are ever emitted for them.
  */
 
-GeoClue2Location::GeoClue2Location(GDBusConnection *connection, const std::string &object_path)
-    : m_connection(connection), m_object_path(object_path) {
+GeoClue2Location::GeoClue2Location(GDBusConnection *connection, const std::string &object_path,
+                                   GeoClue2Manager *manager)
+    : m_connection(connection), m_object_path(object_path), m_manager(manager) {
     g_return_if_fail(connection != nullptr);
 
-    // Create skeleton for org.freedesktop.GeoClue2.Location interface
-    GClueLocation *location_iface = gclue_location_skeleton_new();
-    m_skeleton = GCLUE_LOCATION_SKELETON(location_iface);
-
     // NOTE: Properties will be set via set_from_geoclue1_position()
     // BEFORE this object is exported to D-Bus. This ensures clients
     // immediately see valid data when the object appears.
@@ -25,39 +25,29 @@ GeoClue2Location::GeoClue2Location(GDBusConnection *connection, const std::strin
 
 GeoClue2Location::~GeoClue2Location() {
     if (m_registration_id != 0) {
-        g_dbus_interface_skeleton_unexport(G_DBUS_INTERFACE_SKELETON(m_skeleton));
+        g_dbus_connection_unregister_object(m_connection, m_registration_id);
         m_registration_id = 0;
     }
 
-    if (m_skeleton) {
-        g_object_unref(m_skeleton);
-        m_skeleton = nullptr;
-    }
-
-    g_debug("GeoClue2Location destroyed at %s", m_object_path.c_str());
+    BRIDGE_DEBUG(LogCategory::Fix, "GeoClue2Location destroyed at %s", m_object_path.c_str());
 }
 
 void GeoClue2Location::set_from_geoclue1_position(const GeoClue1Position &pos) {
-    if (!m_skeleton) {
+    if (!m_connection) {
         return;
     }
 
-    // Set basic position properties
-    gclue_location_set_latitude(GCLUE_LOCATION(m_skeleton), pos.latitude);
-    gclue_location_set_longitude(GCLUE_LOCATION(m_skeleton), pos.longitude);
-    gclue_location_set_accuracy(GCLUE_LOCATION(m_skeleton), pos.accuracy);
-
-    // Set altitude (real value from GeoClue1)
-    gclue_location_set_altitude(GCLUE_LOCATION(m_skeleton), pos.altitude);
-
-    // Set speed (-1.0 if unknown)
-    gclue_location_set_speed(GCLUE_LOCATION(m_skeleton), pos.speed);
-
-    // Set heading (-1.0 if unknown)
-    gclue_location_set_heading(GCLUE_LOCATION(m_skeleton), pos.heading);
+    // Basic position properties; altitude is the real value from GeoClue1,
+    // speed and heading are -1.0 if unknown
+    m_latitude = pos.latitude;
+    m_longitude = pos.longitude;
+    m_accuracy = pos.accuracy;
+    m_altitude = pos.altitude;
+    m_speed = pos.speed;
+    m_heading = pos.heading;
 
-    // Set description (empty for now)
-    gclue_location_set_description(GCLUE_LOCATION(m_skeleton), "");
+    // Description (empty for now)
+    m_description.clear();
 
     // Parse timestamp from ISO8601 string to (seconds, microseconds) tuple
     gint64 timestamp_sec = 0;
@@ -70,41 +60,158 @@ void GeoClue2Location::set_from_geoclue1_position(const GeoClue1Position &pos) {
             timestamp_usec = 0;
         } catch (...) {
             // Fall back to current time
-            struct timespec ts;
-            clock_gettime(CLOCK_REALTIME, &ts);
-            timestamp_sec = ts.tv_sec;
-            timestamp_usec = ts.tv_nsec / 1000;
+            gint64 now = Clock::get().real_us();
+            timestamp_sec = now / G_USEC_PER_SEC;
+            timestamp_usec = now % G_USEC_PER_SEC;
         }
     } else {
         // No timestamp provided, use current time
-        struct timespec ts;
-        clock_gettime(CLOCK_REALTIME, &ts);
-        timestamp_sec = ts.tv_sec;
-        timestamp_usec = ts.tv_nsec / 1000;
+        gint64 now = Clock::get().real_us();
+        timestamp_sec = now / G_USEC_PER_SEC;
+        timestamp_usec = now % G_USEC_PER_SEC;
     }
 
-    // Create GVariant tuple (tt) for timestamp
-    GVariant *timestamp = g_variant_new("(tt)", (guint64)timestamp_sec, (guint64)timestamp_usec);
-    gclue_location_set_timestamp(GCLUE_LOCATION(m_skeleton), timestamp);
+    m_timestamp_sec = (guint64)timestamp_sec;
+    m_timestamp_usec = (guint64)timestamp_usec;
 
     // NOW export to D-Bus after all properties are set
     // This ensures clients see valid data immediately
-    if (m_registration_id == 0) {
-        GError *error = nullptr;
-        m_registration_id = g_dbus_interface_skeleton_export(
-            G_DBUS_INTERFACE_SKELETON(m_skeleton), m_connection, m_object_path.c_str(), &error);
+    export_object();
+
+    BRIDGE_DEBUG_RATELIMITED(LogCategory::Fix,
+                             "Location updated at %s: lat=%.6f, lon=%.6f, alt=%.1f, "
+                             "acc=%.1f, speed=%.1f, heading=%.1f",
+                             m_object_path.c_str(), pos.latitude, pos.longitude, pos.altitude,
+                             pos.accuracy, pos.speed, pos.heading);
+}
 
+const DBusPropertyEntry<GeoClue2Location> GeoClue2Location::s_properties[] = {
+    {"Latitude", &GeoClue2Location::get_latitude, nullptr},
+    {"Longitude", &GeoClue2Location::get_longitude, nullptr},
+    {"Accuracy", &GeoClue2Location::get_accuracy, nullptr},
+    {"Altitude", &GeoClue2Location::get_altitude, nullptr},
+    {"Speed", &GeoClue2Location::get_speed, nullptr},
+    {"Heading", &GeoClue2Location::get_heading, nullptr},
+    {"Description", &GeoClue2Location::get_description, nullptr},
+    {"Timestamp", &GeoClue2Location::get_timestamp, nullptr},
+};
+
+void GeoClue2Location::export_object() {
+    if (m_registration_id != 0) {
+        return;
+    }
+
+    static const GDBusInterfaceVTable vtable = {&GeoClue2Location::on_method_call, nullptr,
+                                                nullptr, {}};
+
+    GError *error = nullptr;
+    m_registration_id = g_dbus_connection_register_object(
+        m_connection, m_object_path.c_str(), geoclue2_location_interface_info(), &vtable, this,
+        nullptr, &error);
+
+    if (m_registration_id == 0) {
+        g_warning("Failed to export Location at %s: %s", m_object_path.c_str(),
+                  error ? error->message : "unknown error");
         if (error) {
-            g_warning("Failed to export Location at %s: %s", m_object_path.c_str(), error->message);
             g_error_free(error);
-            return;
         }
+        return;
+    }
 
-        g_debug("GeoClue2Location exported at %s", m_object_path.c_str());
+    BRIDGE_DEBUG(LogCategory::Fix, "GeoClue2Location exported at %s", m_object_path.c_str());
+}
+
+GVariant *GeoClue2Location::save_state() const {
+    GVariantBuilder state;
+    g_variant_builder_init(&state, G_VARIANT_TYPE_VARDICT);
+    g_variant_builder_add(&state, "{sv}", "path", g_variant_new_string(m_object_path.c_str()));
+    for (const auto &property : s_properties) {
+        g_variant_builder_add(&state, "{sv}", property.name, (this->*property.getter)());
+    }
+    return g_variant_builder_end(&state);
+}
+
+void GeoClue2Location::restore_state(GVariant *state) {
+    g_variant_lookup(state, "Latitude", "d", &m_latitude);
+    g_variant_lookup(state, "Longitude", "d", &m_longitude);
+    g_variant_lookup(state, "Accuracy", "d", &m_accuracy);
+    g_variant_lookup(state, "Altitude", "d", &m_altitude);
+    g_variant_lookup(state, "Speed", "d", &m_speed);
+    g_variant_lookup(state, "Heading", "d", &m_heading);
+    g_variant_lookup(state, "Timestamp", "(tt)", &m_timestamp_sec, &m_timestamp_usec);
+
+    const gchar *description = nullptr;
+    if (g_variant_lookup(state, "Description", "&s", &description)) {
+        m_description = description;
     }
 
-    g_debug("Location updated at %s: lat=%.6f, lon=%.6f, alt=%.1f, "
-            "acc=%.1f, speed=%.1f, heading=%.1f",
-            m_object_path.c_str(), pos.latitude, pos.longitude, pos.altitude, pos.accuracy,
-            pos.speed, pos.heading);
+    export_object();
+}
+
+/* static */ void GeoClue2Location::on_method_call(GDBusConnection * /*connection*/,
+                                                   const gchar *sender,
+                                                   const gchar * /*object_path*/,
+                                                   const gchar * /*interface_name*/,
+                                                   const gchar *method_name, GVariant *parameters,
+                                                   GDBusMethodInvocation *invocation,
+                                                   gpointer user_data) {
+    LoopMonitor::Scope timing("Location", method_name);
+
+    auto *location = static_cast<const GeoClue2Location *>(user_data);
+
+    // Reading the Location shows the peer is consuming updates
+    if (location->m_manager) {
+        location->m_manager->location_read_by(sender);
+    }
+
+    if (g_str_equal(method_name, "GetAll")) {
+        GVariantBuilder properties;
+        g_variant_builder_init(&properties, G_VARIANT_TYPE_VARDICT);
+        for (const auto &property : s_properties) {
+            g_variant_builder_add(&properties, "{sv}", property.name,
+                                  (location->*property.getter)());
+        }
+        g_dbus_method_invocation_return_value(invocation,
+                                              g_variant_new("(a{sv})", &properties));
+        return;
+    }
+
+    if (g_str_equal(method_name, "Get")) {
+        const gchar *property_name = nullptr;
+        g_variant_get(parameters, "(&s&s)", nullptr, &property_name);
+
+        GError *error = nullptr;
+        GVariant *value =
+            dbus_dispatch_get_property(location, s_properties, property_name, &error);
+        if (!value) {
+            g_dbus_method_invocation_take_error(invocation, error);
+            return;
+        }
+        g_dbus_method_invocation_return_value(invocation, g_variant_new("(v)", value));
+        return;
+    }
+
+    // Location objects are read-only; GDBus rejects Set before it gets here
+    g_dbus_method_invocation_return_error(invocation, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD,
+                                          "Unknown method %s", method_name);
+}
+
+GVariant *GeoClue2Location::get_latitude() const { return g_variant_new_double(m_latitude); }
+
+GVariant *GeoClue2Location::get_longitude() const { return g_variant_new_double(m_longitude); }
+
+GVariant *GeoClue2Location::get_accuracy() const { return g_variant_new_double(m_accuracy); }
+
+GVariant *GeoClue2Location::get_altitude() const { return g_variant_new_double(m_altitude); }
+
+GVariant *GeoClue2Location::get_speed() const { return g_variant_new_double(m_speed); }
+
+GVariant *GeoClue2Location::get_heading() const { return g_variant_new_double(m_heading); }
+
+GVariant *GeoClue2Location::get_description() const {
+    return g_variant_new_string(m_description.c_str());
+}
+
+GVariant *GeoClue2Location::get_timestamp() const {
+    return g_variant_new("(tt)", m_timestamp_sec, m_timestamp_usec);
 }
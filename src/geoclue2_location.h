@@ -6,8 +6,11 @@
 #include <memory>
 #include <string>
 
+#include "dbus_interfaces.h"
 #include "geoclue1_backend.h"
-#include "geoclue2-location.h"
+#include "memory_stats.h"
+
+class GeoClue2Manager;
 
 /**
  * GeoClue2 Location interface.
@@ -16,9 +19,10 @@
  * Exposes read-only properties such as Latitude, Longitude, Accuracy, etc.
  */
 
-class GeoClue2Location {
+class GeoClue2Location : public LiveCounted<GeoClue2Location> {
   public:
-    GeoClue2Location(GDBusConnection *connection, const std::string &object_path);
+    GeoClue2Location(GDBusConnection *connection, const std::string &object_path,
+                     GeoClue2Manager *manager);
     ~GeoClue2Location();
 
     // Non-copyable
@@ -31,9 +35,52 @@ class GeoClue2Location {
     // Get the object path
     const std::string &get_path() const { return m_object_path; }
 
+    // Approximate heap footprint of this Location
+    gsize estimated_memory() const { return sizeof(*this) + m_object_path.capacity(); }
+
+    // Upgrade handoff: all properties as an a{sv}, and the reverse which
+    // also exports the object
+    GVariant *save_state() const;
+    void restore_state(GVariant *state);
+
   private:
     GDBusConnection *m_connection;
     std::string m_object_path;
-    GClueLocationSkeleton *m_skeleton = nullptr;
+    GeoClue2Manager *m_manager; // notified of reads for delivery accounting
     guint m_registration_id = 0;
+
+    // Exported properties
+    double m_latitude = 0.0;
+    double m_longitude = 0.0;
+    double m_accuracy = 0.0;
+    double m_altitude = 0.0;
+    double m_speed = -1.0;
+    double m_heading = -1.0;
+    std::string m_description;
+    guint64 m_timestamp_sec = 0;
+    guint64 m_timestamp_usec = 0;
+
+    // Register on D-Bus once the properties are set
+    void export_object();
+
+    // Property accessor table (all properties are read-only)
+    static const DBusPropertyEntry<GeoClue2Location> s_properties[];
+
+    // D-Bus vtable entry point. Without a get_property entry GDBus routes
+    // Properties.Get and GetAll here, so that a call counts as one read
+    // however many properties it returns.
+    static void on_method_call(GDBusConnection *connection, const gchar *sender,
+                               const gchar *object_path, const gchar *interface_name,
+                               const gchar *method_name, GVariant *parameters,
+                               GDBusMethodInvocation *invocation, gpointer user_data);
+
+    // D-Bus property getters
+    GVariant *get_latitude() const;
+    GVariant *get_longitude() const;
+    GVariant *get_accuracy() const;
+    GVariant *get_altitude() const;
+    GVariant *get_speed() const;
+    GVariant *get_heading() const;
+    GVariant *get_description() const;
+    GVariant *get_timestamp() const;
 };
@@ -1,12 +1,27 @@
 #include "geoclue2_manager.h"
+#include "agent_authorizer.h"
+#include "bridge_config.h"
+#include "clock.h"
 #include "geoclue1_backend.h"
+#include "peer_credentials.h"
+#include "power_accounting.h"
 #include "geoclue2_client.h"
 #include "geoclue2_location.h"
-
+#include "dbus_interfaces.h"
+#include "location_fanout.h"
+#include "log.h"
+#include "loop_monitor.h"
+#include "memory_stats.h"
+#include "probes.h"
+#include "trace_ring.h"
+
+#include <algorithm>
 #include <memory>
+#include <utility>
 
-// Maximum number of locations to keep in memory
-const size_t MAX_STORED_LOCATIONS = 25;
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
 
 /**
  * Implementation of the GeoClue2 Manager object.
@@ -16,39 +31,41 @@ const size_t MAX_STORED_LOCATIONS = 25;
  * - Handle GetClient/CreateClient/DeleteClient methods
  * - Manage client registry and lifecycles
  * - Control GeoClue1 backend based on active clients
- * - Broadcast position updates to all active clients
+ * - Broadcast position updates to all active clients, in QoS class order
  */
 
-GeoClue2Manager::GeoClue2Manager(GDBusConnection *connection) : m_connection(connection) {
-    g_return_if_fail(connection != nullptr);
+// Deferred QoS classes run below the default priority of D-Bus and timer
+// sources, so they never hold up a fix for the immediate classes
+const gint DEFERRED_FANOUT_PRIORITY = G_PRIORITY_LOW;
 
-    // Create skeleton for org.freedesktop.GeoClue2.Manager interface
-    GClueManager *manager_iface = gclue_manager_skeleton_new();
-    m_skeleton = GCLUE_MANAGER_SKELETON(manager_iface);
+// Deferred clients served per idle dispatch, so that a large deferred class
+// does not hold the loop in one callback
+const size_t DEFERRED_FANOUT_CHUNK = 64;
 
-    // Set initial property values
-    gclue_manager_set_in_use(manager_iface, FALSE);
-    gclue_manager_set_available_accuracy_level(manager_iface,
-                                               8); // EXACT level
+GeoClue2Manager::GeoClue2Manager(GDBusConnection *connection)
+    : m_connection(connection),
+      m_credentials(std::make_unique<PeerCredentialCache>(connection)),
+      m_authorizer(std::make_unique<AgentAuthorizer>(connection, *m_credentials)),
+      m_backend_cancellable(g_cancellable_new()) {
+    m_power = std::make_unique<PowerAccounting>(bridge_state_path("power.ini"));
 
-    // Connect method handlers
-    g_signal_connect(m_skeleton, "handle-get-client", G_CALLBACK(on_handle_get_client), this);
-    g_signal_connect(m_skeleton, "handle-create-client", G_CALLBACK(on_handle_create_client), this);
-    g_signal_connect(m_skeleton, "handle-delete-client", G_CALLBACK(on_handle_delete_client), this);
-    g_signal_connect(m_skeleton, "handle-add-agent", G_CALLBACK(on_handle_add_agent), this);
+    g_return_if_fail(connection != nullptr);
+
+    static const GDBusInterfaceVTable vtable = {&GeoClue2Manager::on_method_call,
+                                                &GeoClue2Manager::on_get_property, nullptr, {}};
 
     // Export the Manager on D-Bus
     GError *error = nullptr;
-    m_registration_id = g_dbus_interface_skeleton_export(
-        G_DBUS_INTERFACE_SKELETON(m_skeleton), m_connection, GEOCLUE2_MANAGER_OBJECT_PATH, &error);
+    m_registration_id = g_dbus_connection_register_object(
+        m_connection, GEOCLUE2_MANAGER_OBJECT_PATH, geoclue2_manager_interface_info(), &vtable,
+        this, nullptr, &error);
 
-    if (error) {
+    if (m_registration_id == 0) {
         g_warning("Failed to export Manager at %s: %s", GEOCLUE2_MANAGER_OBJECT_PATH,
-                  error->message);
-        g_error_free(error);
-        g_object_unref(m_skeleton);
-        m_skeleton = nullptr;
-        m_registration_id = 0;
+                  error ? error->message : "unknown error");
+        if (error) {
+            g_error_free(error);
+        }
         return;
     }
 
@@ -56,25 +73,60 @@ GeoClue2Manager::GeoClue2Manager(GDBusConnection *connection) : m_connection(con
 }
 
 GeoClue2Manager::~GeoClue2Manager() {
+    // A backend still being created is never handed to us
+    g_cancellable_cancel(m_backend_cancellable);
+    g_object_unref(m_backend_cancellable);
+    m_backend_waiters.clear();
+
     if (m_grace_timeout_id != 0) {
-        g_source_remove(m_grace_timeout_id);
+        Clock::get().remove(m_grace_timeout_id);
         m_grace_timeout_id = 0;
     }
 
+    if (m_reaper_id != 0) {
+        Clock::get().remove(m_reaper_id);
+        m_reaper_id = 0;
+    }
+
+    if (m_exit_idle_id != 0) {
+        Clock::get().remove(m_exit_idle_id);
+        m_exit_idle_id = 0;
+    }
+
+    if (m_deferred_idle_id != 0) {
+        g_source_remove(m_deferred_idle_id);
+        m_deferred_idle_id = 0;
+    }
+    m_deferred_fanout.reset();
+
+    for (BatchFlush &flush : m_batch_flushes) {
+        if (flush.timer_id != 0) {
+            Clock::get().remove(flush.timer_id);
+            flush.timer_id = 0;
+        }
+    }
+
+    // Clients stop as they are destroyed; detach them first, so that they do
+    // not call back into this half-destroyed Manager (and schedule a grace
+    // timeout on it)
+    for (auto &pair : m_clients_by_path) {
+        pair.second->set_active_changed_callback(nullptr);
+    }
+
     // Clean up all clients
+    for (auto &pair : m_clients_by_peer) {
+        if (pair.second.watch_id != 0) {
+            g_bus_unwatch_name(pair.second.watch_id);
+        }
+    }
     m_clients_by_peer.clear();
     m_clients_by_path.clear();
 
     if (m_registration_id != 0) {
-        g_dbus_interface_skeleton_unexport(G_DBUS_INTERFACE_SKELETON(m_skeleton));
+        g_dbus_connection_unregister_object(m_connection, m_registration_id);
         m_registration_id = 0;
     }
 
-    if (m_skeleton) {
-        g_object_unref(m_skeleton);
-        m_skeleton = nullptr;
-    }
-
     g_message("GeoClue2Manager destroyed");
 }
 
@@ -87,34 +139,111 @@ void GeoClue2Manager::set_backend(const std::shared_ptr<Geoclue1Backend> &backen
     }
 }
 
-void GeoClue2Manager::client_became_active() {
+void GeoClue2Manager::set_backend_factory(BackendFactory factory) {
+    m_backend_factory = std::move(factory);
+}
+
+void GeoClue2Manager::set_exit_on_idle(guint seconds, std::function<void()> on_idle) {
+    m_exit_idle_s = seconds;
+    m_on_idle = std::move(on_idle);
+
+    if (m_exit_idle_id != 0) {
+        Clock::get().remove(m_exit_idle_id);
+        m_exit_idle_id = 0;
+    }
+    update_exit_on_idle();
+}
+
+void GeoClue2Manager::set_client_limits(guint max_per_peer, guint max_total) {
+    m_max_clients_per_peer = max_per_peer;
+    m_max_clients = max_total;
+    g_message("GeoClue2Manager: client limits per peer=%u total=%u (0 = unlimited)", max_per_peer,
+              max_total);
+}
+
+void GeoClue2Manager::set_idle_client_timeout(guint seconds) {
+    m_idle_client_timeout_s = seconds;
+    if (m_idle_client_timeout_s == 0 && m_reaper_id != 0) {
+        Clock::get().remove(m_reaper_id);
+        m_reaper_id = 0;
+    }
+    schedule_reaper();
+}
+
+void GeoClue2Manager::client_became_active(const GeoClue2Client &client) {
     // Cancel any pending grace timeout
     if (m_grace_timeout_id != 0) {
-        g_source_remove(m_grace_timeout_id);
+        Clock::get().remove(m_grace_timeout_id);
         m_grace_timeout_id = 0;
     }
 
     ++m_active_clients;
-    g_message("GeoClue2Manager: client became active (count=%u)", m_active_clients);
+    m_fanout_dirty = true;
+    BRIDGE_MESSAGE_RATELIMITED(LogCategory::Manager,
+                               "GeoClue2Manager: client became active (count=%u)",
+                               m_active_clients);
 
     // Update InUse property
     update_in_use_property();
 
+    // Start() waits for the backend; a client restored by a handoff may
+    // become active while it is still being created
+    m_power->client_started(client.get_path(), power_app_id(client));
+    with_backend([this]() { start_backend_tracking(); });
+}
+
+void GeoClue2Manager::start_backend_tracking() {
     // If this is the first active client, start GeoClue1
-    if (m_active_clients == 1 && m_backend) {
+    if (m_active_clients > 0 && m_backend && !m_backend->is_tracking()) {
         g_message("GeoClue2Manager: starting GeoClue1 backend");
         m_backend->start_tracking();
     }
+
+    if (m_backend && m_backend->is_tracking()) {
+        m_power->gps_started();
+    }
 }
 
-void GeoClue2Manager::client_became_inactive() {
+void GeoClue2Manager::with_backend(std::function<void()> then) {
+    if (m_backend || !m_backend_factory) {
+        then();
+        return;
+    }
+
+    // First Start() since launch: connect to GeoClue1 only now
+    m_backend_waiters.push_back(std::move(then));
+    if (m_backend_waiters.size() > 1) {
+        return;
+    }
+
+    m_backend_factory(m_backend_cancellable, [this](std::shared_ptr<Geoclue1Backend> backend) {
+        m_backend = std::move(backend);
+        if (!m_backend) {
+            g_warning("GeoClue2Manager: GeoClue1 backend unavailable");
+        }
+
+        // Waiters run without a backend too, so that Start() still replies
+        std::vector<std::function<void()>> waiters;
+        waiters.swap(m_backend_waiters);
+        for (auto &waiter : waiters) {
+            waiter();
+        }
+    });
+}
+
+void GeoClue2Manager::client_became_inactive(const GeoClue2Client &client) {
     if (m_active_clients == 0) {
         g_warning("GeoClue2Manager::client_became_inactive called with count=0");
         return;
     }
 
+    m_power->client_stopped(client.get_path());
+
     --m_active_clients;
-    g_message("GeoClue2Manager: client became inactive (count=%u)", m_active_clients);
+    m_fanout_dirty = true;
+    BRIDGE_MESSAGE_RATELIMITED(LogCategory::Manager,
+                               "GeoClue2Manager: client became inactive (count=%u)",
+                               m_active_clients);
 
     // Update InUse property
     update_in_use_property();
@@ -122,90 +251,636 @@ void GeoClue2Manager::client_became_inactive() {
     if (m_active_clients == 0) {
         // No more active clients: schedule GPS shutdown with grace timeout
         if (m_grace_timeout_id != 0) {
-            g_source_remove(m_grace_timeout_id);
+            Clock::get().remove(m_grace_timeout_id);
             m_grace_timeout_id = 0;
         }
 
-        m_grace_timeout_id =
-            g_timeout_add(m_grace_timeout_ms, &GeoClue2Manager::on_grace_timeout, this);
+        guint grace_timeout_ms = BridgeConfig::current().grace_timeout_ms;
+        m_grace_timeout_id = Clock::get().add_timeout(grace_timeout_ms,
+                                                      &GeoClue2Manager::on_grace_timeout, this);
 
-        g_message("GeoClue2Manager: scheduled GeoClue1 stop in %u ms", m_grace_timeout_ms);
+        g_message("GeoClue2Manager: scheduled GeoClue1 stop in %u ms", grace_timeout_ms);
+    }
+}
+
+void GeoClue2Manager::request_client_start(const std::string &client_path,
+                                           GDBusMethodInvocation *invocation) {
+    auto it = m_clients_by_path.find(client_path);
+    if (it == m_clients_by_path.end()) {
+        g_dbus_method_invocation_return_error_literal(invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
+                                                      "Client no longer exists");
+        return;
     }
+
+    const auto &client = it->second;
+    m_authorizer->authorize(
+        client->get_peer(), client->get_desktop_id(), client->get_requested_accuracy_level(),
+        [this, client_path, invocation](bool authorized, guint allowed_accuracy_level) {
+            // The client may have been removed while the agent was asked
+            auto it = m_clients_by_path.find(client_path);
+            if (it == m_clients_by_path.end()) {
+                g_dbus_method_invocation_return_error_literal(
+                    invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED, "Client no longer exists");
+                return;
+            }
+
+            if (!authorized) {
+                g_message("GeoClue2Manager: agent denied %s", client_path.c_str());
+                g_dbus_method_invocation_return_error_literal(
+                    invocation, G_DBUS_ERROR, G_DBUS_ERROR_ACCESS_DENIED,
+                    "Location access denied by the agent");
+                return;
+            }
+            it->second->set_granted_accuracy_level(allowed_accuracy_level);
+
+            // Reply once GeoClue1 is connected, so that the client's first
+            // fix is not lost to a backend still being created
+            with_backend([this, client_path, invocation]() {
+                auto it = m_clients_by_path.find(client_path);
+                if (it == m_clients_by_path.end()) {
+                    g_dbus_method_invocation_return_error_literal(
+                        invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED, "Client no longer exists");
+                    return;
+                }
+
+                it->second->set_active(true);
+                g_dbus_method_invocation_return_value(invocation, nullptr);
+            });
+        });
+}
+
+void GeoClue2Manager::set_handing_off(bool handing_off) {
+    m_handing_off = handing_off;
+    m_power->set_saving(!handing_off);
 }
 
 void GeoClue2Manager::handle_position_update(const GeoClue1Position &pos) {
+    // The successor assigns the Location ids from here on
+    if (m_handing_off) {
+        return;
+    }
+
+    TraceSpan span("manager", "position_update", m_next_location_id + 1);
+    guint64 allocations_before = allocation_counters().thread_allocations;
+    BRIDGE_PROBE2(position__update__start, m_next_location_id + 1, m_clients_by_path.size());
+
     // Create a new Location object for this position
-    std::string location_path =
-        "/org/freedesktop/GeoClue2/Location/" + std::to_string(++m_next_location_id);
+    std::string location_path = location_object_path(++m_next_location_id);
 
-    auto location = std::make_shared<GeoClue2Location>(m_connection, location_path);
+    auto location = std::make_shared<GeoClue2Location>(m_connection, location_path, this);
 
     // Set properties BEFORE exporting to D-Bus
     // This ensures clients see valid data when object appears
-    location->set_from_geoclue1_position(pos);
+    {
+        TraceSpan export_span("manager", "location_export", m_next_location_id);
+        location->set_from_geoclue1_position(pos);
+    }
 
     // Store location to keep it alive while clients may reference it
     m_locations.push_back(location);
 
-    // Broadcast to all active clients
-    for (auto &pair : m_clients_by_path) {
-        auto &client = pair.second;
-        if (client && client->is_active()) {
-            client->notify_location_update(location_path);
+    // Broadcast to the active clients of the immediate QoS classes, highest
+    // priority first. Signal bodies are serialized once for this fix and
+    // stamped out per client.
+    update_fanout_order();
+    LocationSignalFanout fanout(m_connection, location_path);
+    for (size_t i = 0; i < m_deferred_begin; ++i) {
+        m_fanout_order[i]->notify_location_update(fanout);
+    }
+    TraceRing::instant("manager", "fanout_sent", fanout.sent());
+
+    // Deferred classes get the fix once the loop is idle; a newer fix that
+    // arrives first replaces it, also part way through the class
+    if (m_deferred_begin < m_fanout_order.size()) {
+        if (m_deferred_idle_id != 0) {
+            ++m_deferred_superseded;
+        } else {
+            m_deferred_idle_id = g_idle_add_full(DEFERRED_FANOUT_PRIORITY,
+                                                 &GeoClue2Manager::on_deferred_fanout, this,
+                                                 nullptr);
         }
+        m_deferred_fanout = std::make_unique<LocationSignalFanout>(m_connection, location_path);
+        m_deferred_next = m_deferred_begin;
     }
 
-    g_debug("GeoClue2Manager: broadcasted location %s to %u active clients", location_path.c_str(),
-            m_active_clients);
+    BRIDGE_DEBUG_RATELIMITED(LogCategory::Fix,
+                             "GeoClue2Manager: broadcasted location %s to %u active clients",
+                             location_path.c_str(), fanout.sent());
 
     // Clean up old locations to prevent memory growth
     // Following geoclue-2 pattern: keep some locations (clients may be slow)
-    // Only clean up locations > MAX_STORED_LOCATIONS updates old (enough buffer for any client)
-    while (m_locations.size() > MAX_STORED_LOCATIONS) {
+    // Only clean up locations > retention_depth() updates old (enough buffer for any client)
+    trim_locations();
+
+    m_last_fix_allocations = allocation_counters().thread_allocations - allocations_before;
+    m_fix_allocations += m_last_fix_allocations;
+    ++m_fixes;
+
+    BRIDGE_PROBE2(position__update__done, m_next_location_id, fanout.sent());
+}
+
+/* static */ std::string GeoClue2Manager::client_object_path(guint id) {
+    return "/org/freedesktop/GeoClue2/Client/" + std::to_string(id);
+}
+
+/* static */ std::string GeoClue2Manager::location_object_path(guint id) {
+    return "/org/freedesktop/GeoClue2/Location/" + std::to_string(id);
+}
+
+void GeoClue2Manager::update_fanout_order() {
+    const BridgeConfig &config = BridgeConfig::current();
+    if (!m_fanout_dirty && m_fanout_generation == config.generation) {
+        return;
+    }
+
+    // Sort key (deferred, priority) of each active client, looked up once
+    std::vector<std::pair<std::pair<bool, guint>, GeoClue2Client *>> order;
+    order.reserve(m_active_clients);
+    for (auto &pair : m_clients_by_path) {
+        GeoClue2Client *client = pair.second.get();
+        if (client->is_active()) {
+            const BridgeConfig::QosClass &qos = config.qos_classes[client->qos_class()];
+            order.push_back({{qos.deferred, qos.priority}, client});
+        }
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [](const auto &a, const auto &b) { return a.first < b.first; });
+
+    m_fanout_order.clear();
+    m_deferred_begin = order.size();
+    for (const auto &entry : order) {
+        if (entry.first.first && m_deferred_begin == order.size()) {
+            m_deferred_begin = m_fanout_order.size();
+        }
+        m_fanout_order.push_back(entry.second);
+    }
+
+    m_fanout_dirty = false;
+    m_fanout_generation = config.generation;
+    ++m_fanout_rebuilds;
+}
+
+bool GeoClue2Manager::send_deferred_fanout() {
+    // A client that started or stopped since the last chunk rebuilds the
+    // order; the pass then starts over, and clients that were already
+    // offered the fix are skipped
+    guint64 rebuilds = m_fanout_rebuilds;
+    update_fanout_order();
+    if (m_fanout_rebuilds != rebuilds) {
+        m_deferred_next = m_deferred_begin;
+    }
+
+    TraceSpan span("manager", "deferred_fanout", m_next_location_id);
+    const std::string &path = m_deferred_fanout->get_location_path();
+    size_t end = std::min(m_fanout_order.size(), m_deferred_next + DEFERRED_FANOUT_CHUNK);
+    for (; m_deferred_next < end; ++m_deferred_next) {
+        GeoClue2Client *client = m_fanout_order[m_deferred_next];
+        if (!client->was_offered(path)) {
+            client->notify_location_update(*m_deferred_fanout);
+        }
+    }
+
+    if (m_deferred_next < m_fanout_order.size()) {
+        return false;
+    }
+
+    m_deferred_fanout.reset();
+    ++m_deferred_fanouts;
+    return true;
+}
+
+void GeoClue2Manager::schedule_batch_flush(guint qos_class) {
+    BatchFlush &flush = m_batch_flushes[qos_class];
+    if (flush.timer_id != 0) {
+        return;
+    }
+
+    flush.manager = this;
+    flush.qos_class = qos_class;
+    flush.timer_id = Clock::get().add_timeout(
+        BridgeConfig::current().qos_classes[qos_class].batch_ms,
+        &GeoClue2Manager::on_batch_timeout, &flush);
+}
+
+void GeoClue2Manager::flush_batches(guint qos_class) {
+    update_fanout_order();
+
+    // Held fixes are the latest one each client was offered, so usually one
+    // fan-out serves the whole class
+    std::vector<std::unique_ptr<LocationSignalFanout>> fanouts;
+    bool held = false;
+    for (GeoClue2Client *client : m_fanout_order) {
+        const std::string &path = client->get_pending_location_path();
+        if (path.empty() || client->qos_class() != qos_class) {
+            continue;
+        }
+
+        auto it = std::find_if(fanouts.begin(), fanouts.end(),
+                               [&path](const auto &f) { return f->get_location_path() == path; });
+        if (it == fanouts.end()) {
+            fanouts.push_back(std::make_unique<LocationSignalFanout>(m_connection, path));
+            it = fanouts.end() - 1;
+        }
+        held |= client->flush_batched_update(**it);
+    }
+    ++m_batch_flush_count;
+
+    // Fixes held back by a rate cap go out with a later window
+    if (held && BridgeConfig::current().qos_classes[qos_class].batch_ms > 0) {
+        schedule_batch_flush(qos_class);
+    }
+}
+
+size_t GeoClue2Manager::retention_depth() const {
+    const BridgeConfig &config = BridgeConfig::current();
+    return m_memory_pressure ? config.pressure_retention_depth : config.retention_depth;
+}
+
+size_t GeoClue2Manager::trim_locations() {
+    size_t dropped = 0;
+    while (m_locations.size() > retention_depth()) {
         m_locations.pop_front();
+        ++dropped;
+    }
+    return dropped;
+}
+
+void GeoClue2Manager::apply_config() {
+    // QoS classes may have moved; the fan-out order follows with the next fix
+    m_fanout_dirty = true;
+
+    // A smaller depth takes effect now rather than with the next fix
+    size_t dropped = trim_locations();
+    if (dropped > 0) {
+        g_message("GeoClue2Manager: retention depth now %zu, dropped %zu locations",
+                  retention_depth(), dropped);
+    }
+}
+
+void GeoClue2Manager::set_memory_pressure(bool under_pressure) {
+    if (under_pressure == m_memory_pressure) {
+        return;
+    }
+
+    m_memory_pressure = under_pressure;
+    if (!under_pressure) {
+        g_message("GeoClue2Manager: memory pressure over, retaining %zu locations again",
+                  retention_depth());
+        return;
+    }
+
+    size_t dropped = trim_locations();
+    ++m_pressure_retention_shrinks;
+    m_pressure_locations_dropped += dropped;
+
+    gsize entries = m_authorizer->trim_cache();
+    ++m_pressure_cache_trims;
+    m_pressure_cache_entries_dropped += entries;
+
+    g_message("GeoClue2Manager: memory pressure, dropped %zu locations and %zu cached decisions",
+              dropped, entries);
+
+    // With GPS already off nothing will allocate soon; give the heap back now
+    if (!m_backend || !m_backend->is_tracking()) {
+        release_heap();
+    }
+}
+
+void GeoClue2Manager::release_heap() {
+#ifdef __GLIBC__
+    gint64 rss_before = process_memory().rss_bytes;
+    malloc_trim(0);
+    gint64 rss_after = process_memory().rss_bytes;
+
+    ++m_malloc_trims;
+    if (rss_before >= 0 && rss_after >= 0 && rss_after < rss_before) {
+        m_malloc_trim_released_bytes += rss_before - rss_after;
+    }
+    BRIDGE_MESSAGE(LogCategory::Manager,
+                   "GeoClue2Manager: malloc_trim released %" G_GINT64_FORMAT " bytes",
+                   std::max<gint64>(0, rss_before - rss_after));
+#endif
+}
+
+GVariant *GeoClue2Manager::save_state() const {
+    GVariantBuilder clients;
+    g_variant_builder_init(&clients, G_VARIANT_TYPE("aa{sv}"));
+    for (const auto &pair : m_clients_by_path) {
+        g_variant_builder_add_value(&clients, pair.second->save_state());
+    }
+
+    GVariantBuilder locations;
+    g_variant_builder_init(&locations, G_VARIANT_TYPE("aa{sv}"));
+    for (const auto &location : m_locations) {
+        g_variant_builder_add_value(&locations, location->save_state());
+    }
+
+    GVariantBuilder state;
+    g_variant_builder_init(&state, G_VARIANT_TYPE_VARDICT);
+    g_variant_builder_add(&state, "{sv}", "next-client-id", g_variant_new_uint32(m_next_client_id));
+    g_variant_builder_add(&state, "{sv}", "next-location-id",
+                          g_variant_new_uint32(m_next_location_id));
+    g_variant_builder_add(&state, "{sv}", "clients", g_variant_builder_end(&clients));
+    g_variant_builder_add(&state, "{sv}", "locations", g_variant_builder_end(&locations));
+    if (m_backend) {
+        g_variant_builder_add(&state, "{sv}", "backend", m_backend->save_state());
+    }
+    g_variant_builder_add(&state, "{sv}", "power", m_power->save_state());
+    return g_variant_builder_end(&state);
+}
+
+void GeoClue2Manager::restore_state(GVariant *state) {
+    guint next_id = 0;
+    if (g_variant_lookup(state, "next-client-id", "u", &next_id)) {
+        m_next_client_id = std::max(m_next_client_id, next_id);
+    }
+    if (g_variant_lookup(state, "next-location-id", "u", &next_id)) {
+        m_next_location_id = std::max(m_next_location_id, next_id);
+    }
+
+    // Power totals and active clients first, so that restored clients and
+    // tracking do not count as new sessions and GPS starts
+    GVariant *power_state = g_variant_lookup_value(state, "power", G_VARIANT_TYPE_VARDICT);
+    if (power_state) {
+        m_power->restore_state(power_state);
+        g_variant_unref(power_state);
+    }
+
+    // Fixes first, so that restored clients never point at a missing object
+    GVariantIter *iter = nullptr;
+    GVariant *entry = nullptr;
+    if (g_variant_lookup(state, "locations", "aa{sv}", &iter)) {
+        while ((entry = g_variant_iter_next_value(iter))) {
+            const gchar *path = nullptr;
+            if (g_variant_lookup(entry, "path", "&s", &path)) {
+                auto location = std::make_shared<GeoClue2Location>(m_connection, path, this);
+                location->restore_state(entry);
+                m_locations.push_back(location);
+            }
+            g_variant_unref(entry);
+        }
+        g_variant_iter_free(iter);
+    }
+
+    // A backend that was tracking is warmed up before clients activate it,
+    // so that GeoClue1 keeps the provider running across the handoff
+    GVariant *backend_state = g_variant_lookup_value(state, "backend", G_VARIANT_TYPE_VARDICT);
+    gboolean was_tracking = FALSE;
+    if (backend_state) {
+        g_variant_lookup(backend_state, "tracking", "b", &was_tracking);
+        std::shared_ptr<GVariant> saved(backend_state, g_variant_unref);
+        with_backend([this, saved]() {
+            if (m_backend) {
+                m_backend->restore_state(saved.get());
+            }
+        });
+    }
+
+    guint restored = 0;
+    if (g_variant_lookup(state, "clients", "aa{sv}", &iter)) {
+        while ((entry = g_variant_iter_next_value(iter))) {
+            const gchar *path = nullptr;
+            const gchar *peer = nullptr;
+            if (g_variant_lookup(entry, "path", "&s", &path) &&
+                g_variant_lookup(entry, "peer", "&s", &peer) && !m_clients_by_path.count(path)) {
+                add_client(path, peer)->restore_state(entry);
+                ++restored;
+            }
+            g_variant_unref(entry);
+        }
+        g_variant_iter_free(iter);
+    }
+
+    // Stopped during its grace period: keep GPS warm for the rest of it
+    if (was_tracking) {
+        with_backend([this]() {
+            if (m_active_clients == 0 && m_backend && m_grace_timeout_id == 0) {
+                m_backend->start_tracking();
+                m_power->gps_started();
+                m_grace_timeout_id =
+                    Clock::get().add_timeout(BridgeConfig::current().grace_timeout_ms,
+                                             &GeoClue2Manager::on_grace_timeout, this);
+            }
+        });
+    }
+
+    g_message("GeoClue2Manager: restored %u clients and %zu locations from handoff", restored,
+              m_locations.size());
+}
+
+void GeoClue2Manager::location_read_by(const char *peer) {
+    if (!peer) {
+        return;
+    }
+
+    auto it = m_clients_by_peer.find(peer);
+    if (it == m_clients_by_peer.end()) {
+        return;
+    }
+
+    for (auto &client : it->second.clients) {
+        client->mark_location_read();
+    }
+}
+
+void GeoClue2Manager::collect_stats(GVariantBuilder *stats) const {
+    guint slow_clients = 0;
+    guint max_unread = 0;
+    gsize client_memory = 0;
+    const BridgeConfig &config = BridgeConfig::current();
+    std::array<guint, QOS_CLASS_COUNT> class_active = {};
+    for (const auto &pair : m_clients_by_path) {
+        if (pair.second->is_slow()) {
+            ++slow_clients;
+        }
+        if (pair.second->is_active()) {
+            ++class_active[config.qos_class_of(pair.second->get_desktop_id())];
+        }
+        max_unread = std::max(max_unread, pair.second->get_unread_updates());
+        client_memory += pair.second->estimated_memory();
+    }
+
+    gsize location_memory = 0;
+    for (const auto &location : m_locations) {
+        location_memory += location->estimated_memory();
+    }
+
+    // Largest per-peer footprint, the one the per-peer quota bounds
+    gsize max_peer_clients = 0;
+    gsize max_peer_memory = 0;
+    guint peer_watches = 0;
+    for (const auto &pair : m_clients_by_peer) {
+        if (pair.second.watch_id != 0) {
+            ++peer_watches;
+        }
+        gsize peer_memory = pair.first.capacity();
+        for (const auto &client : pair.second.clients) {
+            peer_memory += client->estimated_memory();
+        }
+        max_peer_clients = std::max(max_peer_clients, pair.second.clients.size());
+        max_peer_memory = std::max(max_peer_memory, peer_memory);
+    }
+
+    g_variant_builder_add(stats, "{sv}", "clients.total",
+                          g_variant_new_uint32(m_clients_by_path.size()));
+    g_variant_builder_add(stats, "{sv}", "clients.active", g_variant_new_uint32(m_active_clients));
+    g_variant_builder_add(stats, "{sv}", "clients.slow", g_variant_new_uint32(slow_clients));
+    g_variant_builder_add(stats, "{sv}", "clients.memory_bytes",
+                          g_variant_new_uint64(client_memory));
+    g_variant_builder_add(stats, "{sv}", "memory.clients.live",
+                          g_variant_new_uint64(GeoClue2Client::live()));
+    g_variant_builder_add(stats, "{sv}", "memory.locations.live",
+                          g_variant_new_uint64(GeoClue2Location::live()));
+    g_variant_builder_add(stats, "{sv}", "memory.locations.retained",
+                          g_variant_new_uint64(m_locations.size()));
+    g_variant_builder_add(stats, "{sv}", "memory.locations.bytes",
+                          g_variant_new_uint64(location_memory));
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.retention_depth",
+                          g_variant_new_uint32(retention_depth()));
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.retention_shrinks",
+                          g_variant_new_uint64(m_pressure_retention_shrinks));
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.locations_dropped",
+                          g_variant_new_uint64(m_pressure_locations_dropped));
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.cache_trims",
+                          g_variant_new_uint64(m_pressure_cache_trims));
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.cache_entries_dropped",
+                          g_variant_new_uint64(m_pressure_cache_entries_dropped));
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.malloc_trims",
+                          g_variant_new_uint64(m_malloc_trims));
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.malloc_trim_released_bytes",
+                          g_variant_new_int64(m_malloc_trim_released_bytes));
+    if (allocation_counters().available && m_fixes > 0) {
+        g_variant_builder_add(stats, "{sv}", "memory.fix_allocations_last",
+                              g_variant_new_uint64(m_last_fix_allocations));
+        g_variant_builder_add(stats, "{sv}", "memory.fix_allocations_mean",
+                              g_variant_new_double((double)m_fix_allocations / m_fixes));
     }
+    g_variant_builder_add(stats, "{sv}", "clients.limit", g_variant_new_uint32(m_max_clients));
+    g_variant_builder_add(stats, "{sv}", "clients.rejected_total",
+                          g_variant_new_uint64(m_rejected_total));
+    g_variant_builder_add(stats, "{sv}", "clients.reaped", g_variant_new_uint64(m_reaped_clients));
+    g_variant_builder_add(stats, "{sv}", "peers.total",
+                          g_variant_new_uint32(m_clients_by_peer.size()));
+    g_variant_builder_add(stats, "{sv}", "peers.watches", g_variant_new_uint32(peer_watches));
+    g_variant_builder_add(stats, "{sv}", "peers.client_limit",
+                          g_variant_new_uint32(m_max_clients_per_peer));
+    g_variant_builder_add(stats, "{sv}", "peers.max_clients",
+                          g_variant_new_uint32(max_peer_clients));
+    g_variant_builder_add(stats, "{sv}", "peers.max_memory_bytes",
+                          g_variant_new_uint64(max_peer_memory));
+    g_variant_builder_add(stats, "{sv}", "peers.rejected",
+                          g_variant_new_uint64(m_rejected_per_peer));
+    g_variant_builder_add(stats, "{sv}", "locations.retained",
+                          g_variant_new_uint32(m_locations.size()));
+    g_variant_builder_add(stats, "{sv}", "locations.created",
+                          g_variant_new_uint32(m_next_location_id));
+    g_variant_builder_add(stats, "{sv}", "delivery.sent_updates",
+                          g_variant_new_uint64(m_delivery_stats.sent_updates));
+    g_variant_builder_add(stats, "{sv}", "delivery.coalesced_updates",
+                          g_variant_new_uint64(m_delivery_stats.coalesced_updates));
+    g_variant_builder_add(stats, "{sv}", "delivery.slow_events",
+                          g_variant_new_uint64(m_delivery_stats.slow_events));
+    g_variant_builder_add(stats, "{sv}", "delivery.recovered_events",
+                          g_variant_new_uint64(m_delivery_stats.recovered_events));
+    g_variant_builder_add(stats, "{sv}", "delivery.rate_capped_updates",
+                          g_variant_new_uint64(m_delivery_stats.rate_capped_updates));
+    g_variant_builder_add(stats, "{sv}", "delivery.batched_updates",
+                          g_variant_new_uint64(m_delivery_stats.batched_updates));
+    g_variant_builder_add(stats, "{sv}", "delivery.max_unread_updates",
+                          g_variant_new_uint32(max_unread));
+    g_variant_builder_add(stats, "{sv}", "qos.deferred_fanouts",
+                          g_variant_new_uint64(m_deferred_fanouts));
+    g_variant_builder_add(stats, "{sv}", "qos.deferred_superseded",
+                          g_variant_new_uint64(m_deferred_superseded));
+    g_variant_builder_add(stats, "{sv}", "qos.batch_flushes",
+                          g_variant_new_uint64(m_batch_flush_count));
+    for (guint id = 0; id < QOS_CLASS_COUNT; ++id) {
+        gchar *key = g_strdup_printf("qos.%s.active", config.qos_classes[id].name);
+        g_variant_builder_add(stats, "{sv}", key, g_variant_new_uint32(class_active[id]));
+        g_free(key);
+    }
+
+    m_credentials->collect_stats(stats);
+    m_authorizer->collect_stats(stats);
+    m_power->collect_stats(stats);
 }
 
 std::shared_ptr<GeoClue2Client> GeoClue2Manager::create_client_for_peer(const std::string &peer,
                                                                         bool reuse) {
+    auto peer_it = m_clients_by_peer.find(peer);
+
     // Check if we should reuse existing client
-    if (reuse) {
-        auto it = m_clients_by_peer.find(peer);
-        if (it != m_clients_by_peer.end()) {
-            g_message("GeoClue2Manager: reusing existing client for peer %s", peer.c_str());
-            return it->second;
-        }
+    if (reuse && peer_it != m_clients_by_peer.end() && !peer_it->second.clients.empty()) {
+        g_message("GeoClue2Manager: reusing existing client for peer %s", peer.c_str());
+        return peer_it->second.clients.front();
     }
 
     // Create new client
-    std::string client_path =
-        "/org/freedesktop/GeoClue2/Client/" + std::to_string(++m_next_client_id);
+    std::string client_path = client_object_path(++m_next_client_id);
 
-    auto client = std::make_shared<GeoClue2Client>(m_connection, client_path, this);
+    return add_client(client_path, peer);
+}
+
+std::shared_ptr<GeoClue2Client> GeoClue2Manager::add_client(const std::string &client_path,
+                                                            const std::string &peer) {
+    auto client = std::make_shared<GeoClue2Client>(m_connection, client_path, peer, this);
 
     // Set up active state callback to track GPS lifecycle
-    client->set_active_changed_callback([this](bool active) {
+    client->set_active_changed_callback([this, raw_client = client.get()](bool active) {
         if (active) {
-            this->client_became_active();
+            this->client_became_active(*raw_client);
         } else {
-            this->client_became_inactive();
+            this->client_became_inactive(*raw_client);
         }
     });
 
     // Register client
-    m_clients_by_peer[peer] = client;
+    PeerEntry &entry = m_clients_by_peer[peer];
+    entry.clients.push_back(client);
     m_clients_by_path[client_path] = client;
 
-    // Monitor peer for vanishing (disconnection/crash)
-    g_bus_watch_name_on_connection(m_connection, peer.c_str(), G_BUS_NAME_WATCHER_FLAGS_NONE,
-                                   nullptr, // name appeared (not needed, already appeared)
-                                   on_peer_vanished, this, nullptr);
+    // Monitor peer for vanishing (disconnection/crash), once per peer, and
+    // resolve its credentials ahead of the first Start()
+    if (entry.watch_id == 0) {
+        entry.watch_id = g_bus_watch_name_on_connection(
+            m_connection, peer.c_str(), G_BUS_NAME_WATCHER_FLAGS_NONE,
+            nullptr, // name appeared (not needed, already appeared)
+            on_peer_vanished, this, nullptr);
+        m_credentials->track(peer);
+    }
+
+    schedule_reaper();
+    update_exit_on_idle();
 
     g_message("GeoClue2Manager: created client %s for peer %s", client_path.c_str(), peer.c_str());
 
     return client;
 }
 
+bool GeoClue2Manager::check_client_limits(const std::string &peer, GError **error) {
+    if (m_max_clients != 0 && m_clients_by_path.size() >= m_max_clients) {
+        ++m_rejected_total;
+        g_warning("GeoClue2Manager: rejecting client for %s, %zu clients exist (limit %u)",
+                  peer.c_str(), m_clients_by_path.size(), m_max_clients);
+        g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_LIMITS_EXCEEDED,
+                    "Too many GeoClue2 clients (limit %u)", m_max_clients);
+        return false;
+    }
+
+    auto it = m_clients_by_peer.find(peer);
+    if (m_max_clients_per_peer != 0 && it != m_clients_by_peer.end() &&
+        it->second.clients.size() >= m_max_clients_per_peer) {
+        ++m_rejected_per_peer;
+        g_warning("GeoClue2Manager: rejecting client for %s, peer has %zu clients (limit %u)",
+                  peer.c_str(), it->second.clients.size(), m_max_clients_per_peer);
+        g_set_error(error, G_DBUS_ERROR, G_DBUS_ERROR_LIMITS_EXCEEDED,
+                    "Too many GeoClue2 clients for this peer (limit %u)", m_max_clients_per_peer);
+        return false;
+    }
+
+    return true;
+}
+
 void GeoClue2Manager::remove_client(const std::string &client_path) {
     auto it = m_clients_by_path.find(client_path);
     if (it == m_clients_by_path.end()) {
@@ -217,113 +892,219 @@ void GeoClue2Manager::remove_client(const std::string &client_path) {
 
     // Remove from both registries
     m_clients_by_path.erase(it);
-
-    // Find and remove from peer registry
-    for (auto it2 = m_clients_by_peer.begin(); it2 != m_clients_by_peer.end(); ++it2) {
-        if (it2->second == client) {
-            m_clients_by_peer.erase(it2);
-            break;
+    m_fanout_dirty = true;
+
+    auto peer_it = m_clients_by_peer.find(client->get_peer());
+    if (peer_it != m_clients_by_peer.end()) {
+        auto &clients = peer_it->second.clients;
+        clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+
+        // Last client of this peer: stop watching it
+        if (clients.empty()) {
+            if (peer_it->second.watch_id != 0) {
+                g_bus_unwatch_name(peer_it->second.watch_id);
+            }
+            m_credentials->forget(peer_it->first);
+            m_clients_by_peer.erase(peer_it);
         }
     }
 
     g_message("GeoClue2Manager: removed client %s", client_path.c_str());
     update_in_use_property();
+    update_exit_on_idle();
+}
+
+void GeoClue2Manager::schedule_reaper() {
+    if (m_reaper_id != 0 || m_idle_client_timeout_s == 0 || m_clients_by_path.empty()) {
+        return;
+    }
+
+    // Idle timeouts are in minutes, so a coarse scan is plenty
+    guint interval_s = std::min<guint>(60, m_idle_client_timeout_s);
+    m_reaper_id =
+        Clock::get().add_timeout_seconds(interval_s, &GeoClue2Manager::on_reaper_timeout, this);
+}
+
+void GeoClue2Manager::update_exit_on_idle() {
+    if (!m_clients_by_path.empty()) {
+        if (m_exit_idle_id != 0) {
+            Clock::get().remove(m_exit_idle_id);
+            m_exit_idle_id = 0;
+        }
+        return;
+    }
+
+    if (m_exit_idle_s == 0 || m_exit_idle_id != 0) {
+        return;
+    }
+
+    m_exit_idle_id = Clock::get().add_timeout_seconds(
+        m_exit_idle_s, &GeoClue2Manager::on_exit_idle_timeout, this);
+    BRIDGE_DEBUG(LogCategory::Manager,
+                 "GeoClue2Manager: no clients, exiting in %u s unless one appears", m_exit_idle_s);
+}
+
+std::string GeoClue2Manager::power_app_id(const GeoClue2Client &client) const {
+    if (!client.get_desktop_id().empty()) {
+        return client.get_desktop_id();
+    }
+
+    // No DesktopId: the peer's process name is stable across runs, unlike
+    // its unique bus name
+    const PeerCredentials *credentials = m_credentials->find(client.get_peer());
+    if (credentials && credentials->has_pid) {
+        gchar *comm_path = g_strdup_printf("/proc/%u/comm", credentials->pid);
+        gchar *comm = nullptr;
+        bool found = g_file_get_contents(comm_path, &comm, nullptr, nullptr);
+        g_free(comm_path);
+        if (found) {
+            std::string app_id = std::string("process:") + g_strstrip(comm);
+            g_free(comm);
+            return app_id;
+        }
+    }
+
+    return "unknown";
 }
 
 void GeoClue2Manager::update_in_use_property() {
-    gboolean in_use = (m_active_clients > 0);
-    if (m_skeleton) {
-        gclue_manager_set_in_use(GCLUE_MANAGER(m_skeleton), in_use);
+    bool in_use = (m_active_clients > 0);
+    if (in_use == m_in_use) {
+        return;
     }
+
+    m_in_use = in_use;
+
+    DBusPropertyBatch changes;
+    changes.add("InUse", get_in_use());
+    changes.emit(m_connection, GEOCLUE2_MANAGER_OBJECT_PATH, GEOCLUE2_MANAGER_INTERFACE);
 }
 
-/* static */ gboolean GeoClue2Manager::on_handle_get_client(GClueManager *object,
-                                                            GDBusMethodInvocation *invocation,
-                                                            gpointer user_data) {
+/* static */ void GeoClue2Manager::on_method_call(GDBusConnection * /*connection*/,
+                                                  const gchar * /*sender*/,
+                                                  const gchar * /*object_path*/,
+                                                  const gchar * /*interface_name*/,
+                                                  const gchar *method_name, GVariant *parameters,
+                                                  GDBusMethodInvocation *invocation,
+                                                  gpointer user_data) {
+    LoopMonitor::Scope timing("Manager", method_name);
+
+    static const DBusMethodEntry<GeoClue2Manager> methods[] = {
+        {"GetClient", &GeoClue2Manager::handle_get_client},
+        {"CreateClient", &GeoClue2Manager::handle_create_client},
+        {"DeleteClient", &GeoClue2Manager::handle_delete_client},
+        {"AddAgent", &GeoClue2Manager::handle_add_agent},
+    };
+
     auto *manager = static_cast<GeoClue2Manager *>(user_data);
-    if (!manager) {
-        g_dbus_method_invocation_return_error_literal(invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
-                                                      "Internal error: manager is null");
-        return TRUE;
-    }
+    dbus_dispatch_method_call(manager, methods, method_name, parameters, invocation);
+}
+
+/* static */ GVariant *GeoClue2Manager::on_get_property(GDBusConnection * /*connection*/,
+                                                       const gchar * /*sender*/,
+                                                       const gchar * /*object_path*/,
+                                                       const gchar * /*interface_name*/,
+                                                       const gchar *property_name, GError **error,
+                                                       gpointer user_data) {
+    static const DBusPropertyEntry<GeoClue2Manager> properties[] = {
+        {"InUse", &GeoClue2Manager::get_in_use, nullptr},
+        {"AvailableAccuracyLevel", &GeoClue2Manager::get_available_accuracy_level, nullptr},
+    };
+
+    auto *manager = static_cast<const GeoClue2Manager *>(user_data);
+    return dbus_dispatch_get_property(manager, properties, property_name, error);
+}
+
+GVariant *GeoClue2Manager::get_in_use() const { return g_variant_new_boolean(m_in_use); }
 
+GVariant *GeoClue2Manager::get_available_accuracy_level() const {
+    return g_variant_new_uint32(m_available_accuracy_level);
+}
+
+void GeoClue2Manager::handle_get_client(GVariant * /*parameters*/,
+                                        GDBusMethodInvocation *invocation) {
     const gchar *peer = g_dbus_method_invocation_get_sender(invocation);
     g_message("GeoClue2Manager: GetClient() called by %s", peer);
 
-    // Create or reuse client for this peer
-    auto client = manager->create_client_for_peer(peer, true);
+    // Create or reuse client for this peer; only a new client counts against quotas
+    auto it = m_clients_by_peer.find(peer);
+    bool reusable = it != m_clients_by_peer.end() && !it->second.clients.empty();
+
+    GError *error = nullptr;
+    if (!reusable && !check_client_limits(peer, &error)) {
+        g_dbus_method_invocation_take_error(invocation, error);
+        return;
+    }
+
+    auto client = create_client_for_peer(peer, true);
     if (!client) {
         g_dbus_method_invocation_return_error_literal(invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
                                                       "Failed to create client");
-        return TRUE;
+        return;
     }
 
     // Complete the method call with client path
-    gclue_manager_complete_get_client(object, invocation, client->get_path().c_str());
-
-    return TRUE;
+    g_dbus_method_invocation_return_value(invocation,
+                                          g_variant_new("(o)", client->get_path().c_str()));
 }
 
-/* static */ gboolean GeoClue2Manager::on_handle_create_client(GClueManager *object,
-                                                               GDBusMethodInvocation *invocation,
-                                                               gpointer user_data) {
-    auto *manager = static_cast<GeoClue2Manager *>(user_data);
-    if (!manager) {
-        g_dbus_method_invocation_return_error_literal(invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
-                                                      "Internal error: manager is null");
-        return TRUE;
-    }
-
+void GeoClue2Manager::handle_create_client(GVariant * /*parameters*/,
+                                           GDBusMethodInvocation *invocation) {
     const gchar *peer = g_dbus_method_invocation_get_sender(invocation);
     g_message("GeoClue2Manager: CreateClient() called by %s", peer);
 
+    GError *error = nullptr;
+    if (!check_client_limits(peer, &error)) {
+        g_dbus_method_invocation_take_error(invocation, error);
+        return;
+    }
+
     // Always create new client (never reuse)
-    auto client = manager->create_client_for_peer(peer, false);
+    auto client = create_client_for_peer(peer, false);
     if (!client) {
         g_dbus_method_invocation_return_error_literal(invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
                                                       "Failed to create client");
-        return TRUE;
+        return;
     }
 
     // Complete the method call with client path
-    gclue_manager_complete_create_client(object, invocation, client->get_path().c_str());
-
-    return TRUE;
+    g_dbus_method_invocation_return_value(invocation,
+                                          g_variant_new("(o)", client->get_path().c_str()));
 }
 
-/* static */ gboolean GeoClue2Manager::on_handle_delete_client(GClueManager *object,
-                                                               GDBusMethodInvocation *invocation,
-                                                               const gchar *client_path,
-                                                               gpointer user_data) {
-    auto *manager = static_cast<GeoClue2Manager *>(user_data);
-    if (!manager) {
-        g_dbus_method_invocation_return_error_literal(invocation, G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
-                                                      "Internal error: manager is null");
-        return TRUE;
-    }
+void GeoClue2Manager::handle_delete_client(GVariant *parameters,
+                                           GDBusMethodInvocation *invocation) {
+    const gchar *client_path = nullptr;
+    g_variant_get(parameters, "(&o)", &client_path);
 
     g_message("GeoClue2Manager: DeleteClient(%s) called", client_path);
 
     // Remove the client
-    manager->remove_client(client_path);
+    remove_client(client_path);
 
     // Complete the method call
-    gclue_manager_complete_delete_client(object, invocation);
-
-    return TRUE;
+    g_dbus_method_invocation_return_value(invocation, nullptr);
 }
 
-/* static */ gboolean GeoClue2Manager::on_handle_add_agent(GClueManager *object,
-                                                           GDBusMethodInvocation *invocation,
-                                                           const gchar *agent_id,
-                                                           gpointer user_data) {
-    // Agent API not implemented - we skip authorization
-    g_message("GeoClue2Manager: AddAgent(%s) called (not implemented)", agent_id);
-
-    // Just complete successfully
-    gclue_manager_complete_add_agent(object, invocation);
+void GeoClue2Manager::handle_add_agent(GVariant *parameters, GDBusMethodInvocation *invocation) {
+    const gchar *agent_id = nullptr;
+    g_variant_get(parameters, "(&s)", &agent_id);
 
-    return TRUE;
+    const gchar *peer = g_dbus_method_invocation_get_sender(invocation);
+    g_message("GeoClue2Manager: AddAgent(%s) called by %s", agent_id, peer);
+
+    // Reply once the agent is registered, so that a Start() right after
+    // AddAgent() already goes through it
+    m_authorizer->add_agent(peer, agent_id,
+                            [invocation](bool registered, const std::string &error) {
+                                if (registered) {
+                                    g_dbus_method_invocation_return_value(invocation, nullptr);
+                                } else {
+                                    g_dbus_method_invocation_return_error_literal(
+                                        invocation, G_DBUS_ERROR, G_DBUS_ERROR_ACCESS_DENIED,
+                                        error.c_str());
+                                }
+                            });
 }
 
 /* static */ void GeoClue2Manager::on_peer_vanished(GDBusConnection * /*connection*/,
@@ -336,20 +1117,80 @@ void GeoClue2Manager::update_in_use_property() {
     g_message("GeoClue2Manager: peer %s vanished", name);
 
     // Find all clients belonging to this peer and remove them
+    auto it = manager->m_clients_by_peer.find(name);
+    if (it == manager->m_clients_by_peer.end()) {
+        return;
+    }
+
     std::vector<std::string> paths_to_remove;
+    for (const auto &client : it->second.clients) {
+        paths_to_remove.push_back(client->get_path());
+    }
 
-    for (auto &pair : manager->m_clients_by_peer) {
-        if (pair.first == name) {
-            paths_to_remove.push_back(pair.second->get_path());
+    // Removing the last client also drops the peer entry and its watch
+    for (const auto &path : paths_to_remove) {
+        manager->remove_client(path);
+    }
+}
+
+/* static */ gboolean GeoClue2Manager::on_reaper_timeout(gpointer user_data) {
+    LoopMonitor::Scope timing("Timeout", "IdleClientReaper");
+
+    auto *self = static_cast<GeoClue2Manager *>(user_data);
+    if (!self) {
+        return G_SOURCE_REMOVE;
+    }
+
+    gint64 now = Clock::get().monotonic_us();
+    gint64 limit_us = (gint64)self->m_idle_client_timeout_s * G_USEC_PER_SEC;
+
+    std::vector<std::string> paths_to_remove;
+    for (const auto &pair : self->m_clients_by_path) {
+        gint64 idle_since = pair.second->get_idle_since_us();
+        if (idle_since >= 0 && now - idle_since >= limit_us) {
+            paths_to_remove.push_back(pair.first);
         }
     }
 
     for (const auto &path : paths_to_remove) {
-        manager->remove_client(path);
+        g_message("GeoClue2Manager: reclaiming client %s, unstarted for %u s", path.c_str(),
+                  self->m_idle_client_timeout_s);
+        self->remove_client(path);
+        ++self->m_reaped_clients;
+    }
+
+    if (self->m_clients_by_path.empty()) {
+        self->m_reaper_id = 0;
+        return G_SOURCE_REMOVE;
     }
+
+    return G_SOURCE_CONTINUE;
+}
+
+/* static */ gboolean GeoClue2Manager::on_deferred_fanout(gpointer user_data) {
+    LoopMonitor::Scope timing("Idle", "DeferredFanout");
+
+    auto *self = static_cast<GeoClue2Manager *>(user_data);
+    if (!self->send_deferred_fanout()) {
+        return G_SOURCE_CONTINUE;
+    }
+
+    self->m_deferred_idle_id = 0;
+    return G_SOURCE_REMOVE;
+}
+
+/* static */ gboolean GeoClue2Manager::on_batch_timeout(gpointer user_data) {
+    LoopMonitor::Scope timing("Timeout", "BatchFlush");
+
+    auto *flush = static_cast<BatchFlush *>(user_data);
+    flush->timer_id = 0;
+    flush->manager->flush_batches(flush->qos_class);
+    return G_SOURCE_REMOVE;
 }
 
 /* static */ gboolean GeoClue2Manager::on_grace_timeout(gpointer user_data) {
+    LoopMonitor::Scope timing("Timeout", "GraceStop");
+
     auto *self = static_cast<GeoClue2Manager *>(user_data);
     if (!self) {
         return G_SOURCE_REMOVE;
@@ -360,6 +1201,12 @@ void GeoClue2Manager::update_in_use_property() {
     if (self->m_active_clients == 0 && self->m_backend) {
         g_message("GeoClue2Manager: grace timeout expired, stopping GeoClue1 backend");
         self->m_backend->stop_tracking();
+        self->m_power->gps_stopped();
+
+        // The fix path's buffers are free now; return them while memory is short
+        if (self->m_memory_pressure) {
+            self->release_heap();
+        }
     } else {
         g_message("GeoClue2Manager: grace timeout expired, but clients=%u, "
                   "skipping stop",
@@ -369,6 +1216,24 @@ void GeoClue2Manager::update_in_use_property() {
     return G_SOURCE_REMOVE;
 }
 
+/* static */ gboolean GeoClue2Manager::on_exit_idle_timeout(gpointer user_data) {
+    LoopMonitor::Scope timing("Timeout", "ExitOnIdle");
+
+    auto *self = static_cast<GeoClue2Manager *>(user_data);
+    if (!self) {
+        return G_SOURCE_REMOVE;
+    }
+
+    self->m_exit_idle_id = 0;
+
+    if (self->m_clients_by_path.empty() && self->m_on_idle) {
+        g_message("GeoClue2Manager: no clients for %u s, exiting on idle", self->m_exit_idle_s);
+        self->m_on_idle();
+    }
+
+    return G_SOURCE_REMOVE;
+}
+
 std::shared_ptr<GeoClue2Manager> geoclue2_manager_register(GDBusConnection *connection) {
     g_return_val_if_fail(connection != nullptr, nullptr);
 
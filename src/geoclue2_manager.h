@@ -3,17 +3,23 @@
 #include <gio/gio.h>
 #include <glib.h>
 
+#include <array>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
-#include "geoclue2-manager.h"
+#include "bridge_config.h"
+#include "geoclue2_client.h"
 
 // Forward declarations
-class GeoClue2Client;
+class AgentAuthorizer;
 class GeoClue2Location;
+class LocationSignalFanout;
+class PeerCredentialCache;
+class PowerAccounting;
 class Geoclue1Backend;
 struct GeoClue1Position;
 
@@ -37,53 +43,205 @@ class GeoClue2Manager {
     GeoClue2Manager(const GeoClue2Manager &) = delete;
     GeoClue2Manager &operator=(const GeoClue2Manager &) = delete;
 
+    // The factory creates the backend asynchronously and hands it to `ready`
+    // (nullptr when it could not be created). `ready` must not be called once
+    // `cancellable` is cancelled.
+    using BackendReady = std::function<void(std::shared_ptr<Geoclue1Backend>)>;
+    using BackendFactory = std::function<void(GCancellable *cancellable, BackendReady ready)>;
+
     // Backend wiring - so Manager can control GeoClue1 lifecycle
     void set_backend(const std::shared_ptr<Geoclue1Backend> &backend);
 
+    // Create the backend on the first Start() instead of at startup
+    void set_backend_factory(BackendFactory factory);
+
+    // Call `on_idle` once there were no clients for `seconds` (0 = never)
+    void set_exit_on_idle(guint seconds, std::function<void()> on_idle);
+
+    // Client quotas (0 = unlimited); CreateClient/GetClient beyond them fail
+    // with org.freedesktop.DBus.Error.LimitsExceeded
+    void set_client_limits(guint max_per_peer, guint max_total);
+
+    // Unexport clients that stay unstarted this long (0 = never)
+    void set_idle_client_timeout(guint seconds);
+
     // Client lifecycle hooks (called from Client::set_active())
-    void client_became_active();
-    void client_became_inactive();
+    void client_became_active(const GeoClue2Client &client);
+    void client_became_inactive(const GeoClue2Client &client);
+
+    // A client's DesktopId, and with it its QoS class, changed
+    void client_qos_changed() { m_fanout_dirty = true; }
+
+    // Send the fixes held by the clients of a batching QoS class when its
+    // batching window ends (called from Client::notify_location_update())
+    void schedule_batch_flush(guint qos_class);
+
+    // Authorize and activate a client for Start(); completes the invocation
+    void request_client_start(const std::string &client_path, GDBusMethodInvocation *invocation);
 
     // Position update handler (called from backend callback)
     void handle_position_update(const GeoClue1Position &pos);
 
+    // Object paths of the n-th Client and Location
+    static std::string client_object_path(guint id);
+    static std::string location_object_path(guint id);
+
     // Get the D-Bus connection
     GDBusConnection *get_connection() const { return m_connection; }
 
+    // Delivery accounting shared by all clients
+    ClientDeliveryStats &delivery_stats() { return m_delivery_stats; }
+
+    // A peer read a Location property (delivery accounting hook)
+    void location_read_by(const char *peer);
+
+    // The configuration changed (see ConfigMonitor): drop Locations beyond a
+    // smaller retention depth. Everything else is read per use.
+    void apply_config();
+
+    // Memory pressure (see MemoryPressureMonitor): retain fewer Locations,
+    // drop optional caches and return freed heap to the kernel once GPS is off
+    void set_memory_pressure(bool under_pressure);
+
+    // Add manager counters to a stats a{sv} (see BridgeControl)
+    void collect_stats(GVariantBuilder *stats) const;
+
+    // Upgrade handoff (see handoff.h): clients, retained fixes, backend
+    // state and power totals as an a{sv}, and the reverse, which re-exports
+    // the same objects
+    GVariant *save_state() const;
+    void restore_state(GVariant *state);
+
+    // Ignore fixes from the backend while a successor takes over from the
+    // snapshot, so that no Location is created beyond it, and leave saving
+    // the power totals to the successor
+    void set_handing_off(bool handing_off);
+
   private:
     GDBusConnection *m_connection;
-    GClueManagerSkeleton *m_skeleton = nullptr;
     guint m_registration_id = 0;
 
-    // GeoClue1 backend for GPS tracking
+    // Exported properties
+    bool m_in_use = false;
+    guint m_available_accuracy_level = 8; // EXACT level
+
+    // Credentials of peers owning clients, resolved when the peer first
+    // appears so that policy checks are local lookups
+    std::unique_ptr<PeerCredentialCache> m_credentials;
+
+    // Agent authorization for Start()
+    std::unique_ptr<AgentAuthorizer> m_authorizer;
+
+    // GPS on-time attributed to the applications that kept it on
+    std::unique_ptr<PowerAccounting> m_power;
+
+    // GeoClue1 backend for GPS tracking, created on demand by the factory
     std::shared_ptr<Geoclue1Backend> m_backend;
+    BackendFactory m_backend_factory;
+    GCancellable *m_backend_cancellable = nullptr;
+
+    // Work waiting for the factory to finish (Start() replies, handoff)
+    std::vector<std::function<void()>> m_backend_waiters;
+
+    // Exit-on-idle for D-Bus activated instances
+    guint m_exit_idle_s = 0;
+    guint m_exit_idle_id = 0;
+    std::function<void()> m_on_idle;
+
+    // Clients owned by one peer, plus the watch for its disconnection
+    struct PeerEntry {
+        std::vector<std::shared_ptr<GeoClue2Client>> clients;
+        guint watch_id = 0;
+    };
 
     // Client registry
-    std::unordered_map<std::string, std::shared_ptr<GeoClue2Client>> m_clients_by_peer;
+    std::unordered_map<std::string, PeerEntry> m_clients_by_peer;
     std::unordered_map<std::string, std::shared_ptr<GeoClue2Client>> m_clients_by_path;
     guint m_next_client_id = 0;
 
+    // Client quotas and idle reclamation
+    guint m_max_clients_per_peer = 16;
+    guint m_max_clients = 256;
+    guint m_idle_client_timeout_s = 10 * 60;
+    guint m_reaper_id = 0;
+    guint64 m_rejected_per_peer = 0;
+    guint64 m_rejected_total = 0;
+    guint64 m_reaped_clients = 0;
+
     // Location management
     guint m_next_location_id = 0;
     std::deque<std::shared_ptr<GeoClue2Location>> m_locations;
 
+    // Fixes are dropped from the handoff snapshot on
+    bool m_handing_off = false;
+
+    // Memory pressure reactions
+    bool m_memory_pressure = false;
+    guint64 m_pressure_retention_shrinks = 0;
+    guint64 m_pressure_locations_dropped = 0;
+    guint64 m_pressure_cache_trims = 0;
+    guint64 m_pressure_cache_entries_dropped = 0;
+    guint64 m_malloc_trims = 0;
+    gint64 m_malloc_trim_released_bytes = 0;
+
+    // Per-client delivery accounting totals
+    ClientDeliveryStats m_delivery_stats;
+
+    // Heap allocations made while handling fixes (counting allocator only)
+    guint64 m_fixes = 0;
+    guint64 m_fix_allocations = 0;
+    guint64 m_last_fix_allocations = 0;
+
     // Active client tracking
     guint m_active_clients = 0;
-    guint m_grace_timeout_ms = 15000; // 15 seconds
     guint m_grace_timeout_id = 0;
 
-    // D-Bus method handlers
-    static gboolean on_handle_get_client(GClueManager *object, GDBusMethodInvocation *invocation,
-                                         gpointer user_data);
+    // Active clients in fan-out order: by QoS priority, with the deferred
+    // classes from m_deferred_begin on. Rebuilt when a client starts, stops
+    // or changes its DesktopId, and after a reload.
+    std::vector<GeoClue2Client *> m_fanout_order;
+    size_t m_deferred_begin = 0;
+    bool m_fanout_dirty = true;
+    guint64 m_fanout_generation = G_MAXUINT64;
+    guint64 m_fanout_rebuilds = 0;
+
+    // Deferred classes get the latest fix once nothing else is pending, a
+    // chunk of clients per idle dispatch from m_deferred_next on
+    guint m_deferred_idle_id = 0;
+    std::unique_ptr<LocationSignalFanout> m_deferred_fanout;
+    size_t m_deferred_next = 0;
+    guint64 m_deferred_fanouts = 0;
+    guint64 m_deferred_superseded = 0;
+
+    // Batching window timers, one per QoS class
+    struct BatchFlush {
+        GeoClue2Manager *manager = nullptr;
+        guint qos_class = 0;
+        guint timer_id = 0;
+    };
+    std::array<BatchFlush, QOS_CLASS_COUNT> m_batch_flushes;
+    guint64 m_batch_flush_count = 0;
 
-    static gboolean on_handle_create_client(GClueManager *object, GDBusMethodInvocation *invocation,
-                                            gpointer user_data);
+    // D-Bus vtable entry points (dispatch through the tables in the .cpp)
+    static void on_method_call(GDBusConnection *connection, const gchar *sender,
+                               const gchar *object_path, const gchar *interface_name,
+                               const gchar *method_name, GVariant *parameters,
+                               GDBusMethodInvocation *invocation, gpointer user_data);
 
-    static gboolean on_handle_delete_client(GClueManager *object, GDBusMethodInvocation *invocation,
-                                            const gchar *client_path, gpointer user_data);
+    static GVariant *on_get_property(GDBusConnection *connection, const gchar *sender,
+                                     const gchar *object_path, const gchar *interface_name,
+                                     const gchar *property_name, GError **error,
+                                     gpointer user_data);
+
+    // D-Bus method handlers
+    void handle_get_client(GVariant *parameters, GDBusMethodInvocation *invocation);
+    void handle_create_client(GVariant *parameters, GDBusMethodInvocation *invocation);
+    void handle_delete_client(GVariant *parameters, GDBusMethodInvocation *invocation);
+    void handle_add_agent(GVariant *parameters, GDBusMethodInvocation *invocation);
 
-    static gboolean on_handle_add_agent(GClueManager *object, GDBusMethodInvocation *invocation,
-                                        const gchar *agent_id, gpointer user_data);
+    // D-Bus property getters
+    GVariant *get_in_use() const;
+    GVariant *get_available_accuracy_level() const;
 
     // Peer monitoring
     static void on_peer_vanished(GDBusConnection *connection, const gchar *name,
@@ -91,11 +249,37 @@ class GeoClue2Manager {
 
     // Helper methods
     std::shared_ptr<GeoClue2Client> create_client_for_peer(const std::string &peer, bool reuse);
+    std::shared_ptr<GeoClue2Client> add_client(const std::string &client_path,
+                                               const std::string &peer);
+    bool check_client_limits(const std::string &peer, GError **error);
     void remove_client(const std::string &client_path);
     void update_in_use_property();
+    void schedule_reaper();
+    void update_exit_on_idle();
+    void with_backend(std::function<void()> then);
+    void start_backend_tracking();
+    std::string power_app_id(const GeoClue2Client &client) const;
+    void update_fanout_order();
+    bool send_deferred_fanout(); // true once every deferred client was served
+    void flush_batches(guint qos_class);
+    size_t retention_depth() const;
+    size_t trim_locations();
+    void release_heap();
+
+    // Idle client reaper callback
+    static gboolean on_reaper_timeout(gpointer user_data);
+
+    // No clients for the exit-on-idle period
+    static gboolean on_exit_idle_timeout(gpointer user_data);
 
     // Grace timeout callback
     static gboolean on_grace_timeout(gpointer user_data);
+
+    // Deferred QoS classes, served at idle priority until the fan-out is done
+    static gboolean on_deferred_fanout(gpointer user_data);
+
+    // End of a batching window
+    static gboolean on_batch_timeout(gpointer user_data);
 };
 
 /**
@@ -0,0 +1,358 @@
+#include "handoff.h"
+#include "clock.h"
+
+#include <gio/gunixsocketaddress.h>
+#include <glib/gstdio.h>
+
+#include <csignal>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * Implementation of the upgrade handoff socket.
+ */
+
+// Snapshots are a few KiB per client; anything beyond this is not ours
+const guint64 HANDOFF_MAX_SNAPSHOT_BYTES = 64 * 1024 * 1024;
+
+std::string handoff_socket_path() {
+    gchar *path = g_build_filename(g_get_user_runtime_dir(), "geoclue2to1-handoff", nullptr);
+    std::string result = path;
+    g_free(path);
+    return result;
+}
+
+namespace {
+
+enum class SocketState { Absent, Stale, InUse };
+
+// Probe `path` without asking for a snapshot: a socket nobody listens on any
+// more refuses the connection
+SocketState probe_socket(const std::string &path) {
+    GError *error = nullptr;
+    GSocket *socket =
+        g_socket_new(G_SOCKET_FAMILY_UNIX, G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_DEFAULT, &error);
+    if (!socket) {
+        g_warning("HandoffServer: cannot create socket: %s", error->message);
+        g_error_free(error);
+        return SocketState::Absent;
+    }
+
+    GSocketAddress *address = g_unix_socket_address_new(path.c_str());
+    SocketState state = SocketState::InUse;
+    if (!g_socket_connect(socket, address, nullptr, &error)) {
+        state = g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CONNECTION_REFUSED)
+                    ? SocketState::Stale
+                    : SocketState::Absent;
+        g_error_free(error);
+    }
+
+    g_object_unref(address);
+    g_socket_close(socket, nullptr);
+    g_object_unref(socket);
+    return state;
+}
+
+// One connection being served
+struct Transfer {
+    HandoffServer *server;
+    GSocketConnection *connection;
+    guint8 request = 0;
+    GBytes *data = nullptr;
+
+    ~Transfer() {
+        if (data) {
+            g_bytes_unref(data);
+        }
+        g_object_unref(connection);
+    }
+};
+
+} // namespace
+
+HandoffServer::HandoffServer(const std::string &socket_path, SnapshotProvider provider,
+                             SentCallback on_sent)
+    : m_socket_path(socket_path), m_provider(std::move(provider)), m_on_sent(std::move(on_sent)),
+      m_cancellable(g_cancellable_new()) {
+    switch (probe_socket(m_socket_path)) {
+    case SocketState::InUse:
+        // Another instance serves its own clients; its socket stays
+        g_warning("HandoffServer: %s is in use by another instance, not listening",
+                  m_socket_path.c_str());
+        return;
+    case SocketState::Stale:
+        // Left by a crashed instance
+        g_unlink(m_socket_path.c_str());
+        break;
+    case SocketState::Absent:
+        break;
+    }
+
+    if (listen()) {
+        g_message("HandoffServer: listening on %s", m_socket_path.c_str());
+    }
+}
+
+HandoffServer::~HandoffServer() {
+    // A transfer in flight sees G_IO_ERROR_CANCELLED and does not touch us
+    g_cancellable_cancel(m_cancellable);
+    g_object_unref(m_cancellable);
+
+    if (m_takeover_timer_id != 0) {
+        Clock::get().remove(m_takeover_timer_id);
+    }
+    if (m_successor_watch_id != 0) {
+        g_source_remove(m_successor_watch_id);
+        g_spawn_close_pid(m_successor_pid);
+    }
+
+    stop_listening();
+}
+
+void HandoffServer::expect_successor(GPid pid) {
+    m_successor_pid = pid;
+    m_successor_watch_id = g_child_watch_add(pid, &HandoffServer::on_successor_exited, this);
+}
+
+bool HandoffServer::listen() {
+    GSocketAddress *address = g_unix_socket_address_new(m_socket_path.c_str());
+    m_service = g_socket_service_new();
+
+    GError *error = nullptr;
+    if (!g_socket_listener_add_address(G_SOCKET_LISTENER(m_service), address, G_SOCKET_TYPE_STREAM,
+                                       G_SOCKET_PROTOCOL_DEFAULT, nullptr, nullptr, &error)) {
+        g_warning("HandoffServer: cannot listen on %s: %s", m_socket_path.c_str(), error->message);
+        g_error_free(error);
+        g_object_unref(address);
+        g_object_unref(m_service);
+        m_service = nullptr;
+        return false;
+    }
+    g_object_unref(address);
+
+    GStatBuf st;
+    if (g_stat(m_socket_path.c_str(), &st) == 0) {
+        m_socket_inode = st.st_ino;
+    }
+
+    g_chmod(m_socket_path.c_str(), 0600);
+    g_signal_connect(m_service, "incoming", G_CALLBACK(&HandoffServer::on_incoming), this);
+    g_socket_service_start(m_service);
+    return true;
+}
+
+void HandoffServer::stop_listening() {
+    if (!m_service) {
+        return;
+    }
+
+    g_socket_service_stop(m_service);
+    g_socket_listener_close(G_SOCKET_LISTENER(m_service));
+    g_object_unref(m_service);
+    m_service = nullptr;
+
+    // Leave the path alone if another instance has bound its own socket there
+    GStatBuf st;
+    if (g_stat(m_socket_path.c_str(), &st) == 0 && st.st_ino == m_socket_inode) {
+        g_unlink(m_socket_path.c_str());
+    }
+}
+
+/* static */ gboolean HandoffServer::on_incoming(GSocketService * /*service*/,
+                                                 GSocketConnection *connection,
+                                                 GObject * /*source_object*/, gpointer user_data) {
+    auto *self = static_cast<HandoffServer *>(user_data);
+
+    GError *error = nullptr;
+    GCredentials *credentials =
+        g_socket_get_credentials(g_socket_connection_get_socket(connection), &error);
+    if (!credentials) {
+        g_warning("HandoffServer: cannot get peer credentials: %s", error->message);
+        g_error_free(error);
+        return TRUE;
+    }
+
+    // Only the successor we started; liveness probes are refused the same way
+    pid_t pid = g_credentials_get_unix_pid(credentials, nullptr);
+    g_object_unref(credentials);
+    if (self->m_successor_pid == 0 || pid != self->m_successor_pid) {
+        g_message("HandoffServer: refusing handoff to pid %d, not a successor we started",
+                  (int)pid);
+        return TRUE;
+    }
+
+    // Wait for the request; a liveness probe closes without sending one
+    auto *transfer = new Transfer{self, G_SOCKET_CONNECTION(g_object_ref(connection))};
+    GInputStream *in = g_io_stream_get_input_stream(G_IO_STREAM(connection));
+    g_input_stream_read_async(in, &transfer->request, sizeof(transfer->request),
+                              G_PRIORITY_DEFAULT, self->m_cancellable,
+                              &HandoffServer::on_request_read, transfer);
+    return TRUE;
+}
+
+/* static */ void HandoffServer::on_request_read(GObject *source, GAsyncResult *res,
+                                                 gpointer user_data) {
+    auto *transfer = static_cast<Transfer *>(user_data);
+
+    GError *error = nullptr;
+    gssize got = g_input_stream_read_finish(G_INPUT_STREAM(source), res, &error);
+    if (got < 0) {
+        if (!g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+            g_warning("HandoffServer: reading the request failed: %s", error->message);
+        }
+        g_error_free(error);
+        delete transfer;
+        return;
+    }
+
+    // Probes, and requests that lost the race against another successor
+    if (got != sizeof(transfer->request) || transfer->request != HANDOFF_REQUEST ||
+        !transfer->server->m_service) {
+        delete transfer;
+        return;
+    }
+
+    // Sent from the main loop without blocking it
+    transfer->data = transfer->server->take_snapshot();
+    GOutputStream *out = g_io_stream_get_output_stream(G_IO_STREAM(transfer->connection));
+    g_output_stream_write_all_async(out, g_bytes_get_data(transfer->data, nullptr),
+                                    g_bytes_get_size(transfer->data), G_PRIORITY_DEFAULT,
+                                    transfer->server->m_cancellable,
+                                    &HandoffServer::on_snapshot_written, transfer);
+}
+
+/* static */ void HandoffServer::on_snapshot_written(GObject *source, GAsyncResult *res,
+                                                     gpointer user_data) {
+    auto *transfer = static_cast<Transfer *>(user_data);
+
+    GError *error = nullptr;
+    gsize written = 0;
+    bool ok = g_output_stream_write_all_finish(G_OUTPUT_STREAM(source), res, &written, &error) &&
+              g_io_stream_close(G_IO_STREAM(transfer->connection), nullptr, &error);
+    if (!ok && g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+        g_error_free(error);
+        delete transfer;
+        return;
+    }
+
+    HandoffServer *self = transfer->server;
+    delete transfer;
+
+    if (!ok) {
+        // The successor went away; serve the next one
+        g_warning("HandoffServer: sending snapshot failed: %s", error->message);
+        g_error_free(error);
+        self->listen();
+        if (self->m_on_sent) {
+            self->m_on_sent(false);
+        }
+        return;
+    }
+
+    self->m_handed_off = true;
+    self->m_takeover_timer_id = Clock::get().add_timeout_seconds(
+        HANDOFF_TAKEOVER_TIMEOUT_S, &HandoffServer::on_takeover_timeout, self);
+    g_message("HandoffServer: handed %zu bytes of state to a successor", written);
+    if (self->m_on_sent) {
+        self->m_on_sent(true);
+    }
+}
+
+void HandoffServer::abort_handoff(const char *reason) {
+    g_warning("HandoffServer: %s, resuming", reason);
+
+    if (m_takeover_timer_id != 0) {
+        Clock::get().remove(m_takeover_timer_id);
+        m_takeover_timer_id = 0;
+    }
+    m_handed_off = false;
+
+    listen();
+    if (m_on_sent) {
+        m_on_sent(false);
+    }
+}
+
+/* static */ void HandoffServer::on_successor_exited(GPid pid, gint /*status*/,
+                                                     gpointer user_data) {
+    auto *self = static_cast<HandoffServer *>(user_data);
+    self->m_successor_watch_id = 0;
+    self->m_successor_pid = 0;
+    g_spawn_close_pid(pid);
+
+    if (self->m_handed_off) {
+        self->abort_handoff("the successor exited before taking the bus name over");
+    }
+}
+
+/* static */ gboolean HandoffServer::on_takeover_timeout(gpointer user_data) {
+    auto *self = static_cast<HandoffServer *>(user_data);
+    self->m_takeover_timer_id = 0;
+
+    // It must not take the name over later with a stale snapshot; its exit
+    // is reaped by the child watch
+    if (self->m_successor_pid != 0) {
+        kill(self->m_successor_pid, SIGTERM);
+    }
+    self->abort_handoff("the successor did not take the bus name over in time");
+    return G_SOURCE_REMOVE;
+}
+
+GBytes *HandoffServer::take_snapshot() {
+    // One successor at a time; it binds the path once it has our state
+    stop_listening();
+
+    GVariant *snapshot = g_variant_ref_sink(m_provider());
+    gsize size = g_variant_get_size(snapshot);
+    guint64 header = GUINT64_TO_BE((guint64)size);
+
+    GByteArray *buffer = g_byte_array_sized_new(sizeof(header) + size);
+    g_byte_array_append(buffer, reinterpret_cast<const guint8 *>(&header), sizeof(header));
+    g_byte_array_append(buffer, static_cast<const guint8 *>(g_variant_get_data(snapshot)), size);
+    g_variant_unref(snapshot);
+    return g_byte_array_free_to_bytes(buffer);
+}
+
+GVariant *handoff_receive_snapshot(const std::string &socket_path, GError **error) {
+    GSocketClient *client = g_socket_client_new();
+    GSocketAddress *address = g_unix_socket_address_new(socket_path.c_str());
+
+    GSocketConnection *connection =
+        g_socket_client_connect(client, G_SOCKET_CONNECTABLE(address), nullptr, error);
+    g_object_unref(address);
+    g_object_unref(client);
+    if (!connection) {
+        return nullptr;
+    }
+
+    GOutputStream *out = g_io_stream_get_output_stream(G_IO_STREAM(connection));
+    GInputStream *in = g_io_stream_get_input_stream(G_IO_STREAM(connection));
+    guint64 header = 0;
+    gsize got = 0;
+    GVariant *snapshot = nullptr;
+
+    if (g_output_stream_write_all(out, &HANDOFF_REQUEST, sizeof(HANDOFF_REQUEST), nullptr, nullptr,
+                                  error) &&
+        g_input_stream_read_all(in, &header, sizeof(header), &got, nullptr, error)) {
+        guint64 size = GUINT64_FROM_BE(header);
+        if (got != sizeof(header) || size > HANDOFF_MAX_SNAPSHOT_BYTES) {
+            g_set_error(error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Invalid snapshot header");
+        } else {
+            gpointer data = g_malloc(size);
+            if (g_input_stream_read_all(in, data, size, &got, nullptr, error) && got == size) {
+                GVariant *untrusted = g_variant_ref_sink(g_variant_new_from_data(
+                    G_VARIANT_TYPE_VARDICT, data, size, FALSE, g_free, data));
+                snapshot = g_variant_get_normal_form(untrusted);
+                g_variant_unref(untrusted);
+            } else {
+                g_free(data);
+                if (error && !*error) {
+                    g_set_error(error, G_IO_ERROR, G_IO_ERROR_PARTIAL_INPUT, "Truncated snapshot");
+                }
+            }
+        }
+    }
+
+    g_object_unref(connection);
+    return snapshot;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <sys/types.h>
+
+#include <functional>
+#include <string>
+
+/**
+ * Live state handoff between an old and a new bridge process.
+ *
+ * A running bridge listens on a unix socket in $XDG_RUNTIME_DIR. A new
+ * process started with --takeover connects to it and receives a snapshot of
+ * the old process' state (an a{sv}, see GeoClue2Manager::save_state()), re-
+ * exports identical objects from it and then replaces the old process as
+ * owner of org.freedesktop.GeoClue2. The old process stops listening and
+ * handling fixes once it took the snapshot, and exits once it lost the name
+ * after having handed its state over. If the name is not taken over within
+ * HANDOFF_TAKEOVER_TIMEOUT_S, or the successor exits first, the old process
+ * resumes and listens again.
+ *
+ * Wire format: the successor sends HANDOFF_REQUEST; the reply is a 64-bit
+ * big-endian length followed by the serialized a{sv}. Connections that close
+ * without a request (see the liveness probe in HandoffServer) are ignored.
+ * Only the successor the old process started itself is served (see
+ * expect_successor()): every app may run under our uid, and the snapshot
+ * holds every client's fixes and stops delivery.
+ */
+
+// Default location of the handoff socket
+std::string handoff_socket_path();
+
+// The byte a successor sends to ask for the snapshot
+const guint8 HANDOFF_REQUEST = 'S';
+
+// How long a successor that has our snapshot may take to own the bus name
+const guint HANDOFF_TAKEOVER_TIMEOUT_S = 30;
+
+class HandoffServer {
+  public:
+    // Returns a new (possibly floating) a{sv} snapshot of the current state
+    using SnapshotProvider = std::function<GVariant *()>;
+
+    // Called once the snapshot was written (true), and with false if it
+    // could not be or the successor did not take over in time; the server
+    // then listens again
+    using SentCallback = std::function<void(bool sent)>;
+
+    // A socket at `socket_path` is only replaced if no instance answers on it
+    HandoffServer(const std::string &socket_path, SnapshotProvider provider,
+                  SentCallback on_sent);
+    ~HandoffServer();
+
+    // Non-copyable
+    HandoffServer(const HandoffServer &) = delete;
+    HandoffServer &operator=(const HandoffServer &) = delete;
+
+    // Serve the snapshot to process `pid` only: a successor spawned with
+    // G_SPAWN_DO_NOT_REAP_CHILD, which the server reaps. Exiting before it
+    // owns the bus name ends the handoff.
+    void expect_successor(GPid pid);
+
+    // A successor was started and has not exited yet
+    bool successor_pending() const { return m_successor_pid != 0; }
+
+    // A successor received our snapshot; losing the bus name is expected
+    bool handed_off() const { return m_handed_off; }
+
+  private:
+    std::string m_socket_path;
+    SnapshotProvider m_provider;
+    SentCallback m_on_sent;
+    GSocketService *m_service = nullptr;
+    GCancellable *m_cancellable = nullptr;
+    ino_t m_socket_inode = 0;
+    bool m_handed_off = false;
+    GPid m_successor_pid = 0;
+    guint m_successor_watch_id = 0;
+    guint m_takeover_timer_id = 0;
+
+    bool listen();
+    void stop_listening();
+    GBytes *take_snapshot();
+    void abort_handoff(const char *reason);
+
+    static void on_successor_exited(GPid pid, gint status, gpointer user_data);
+    static gboolean on_takeover_timeout(gpointer user_data);
+
+    static gboolean on_incoming(GSocketService *service, GSocketConnection *connection,
+                                GObject *source_object, gpointer user_data);
+    static void on_request_read(GObject *source, GAsyncResult *res, gpointer user_data);
+    static void on_snapshot_written(GObject *source, GAsyncResult *res, gpointer user_data);
+};
+
+// Fetch a snapshot from the instance listening at `socket_path`. Returns a
+// new a{sv} reference, or nullptr with `error` set.
+GVariant *handoff_receive_snapshot(const std::string &socket_path, GError **error);
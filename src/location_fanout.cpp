@@ -0,0 +1,110 @@
+#include "location_fanout.h"
+#include "dbus_interfaces.h"
+
+namespace {
+
+// Placeholder path for templates; replaced by the client path on every copy
+const char *TEMPLATE_OBJECT_PATH = "/";
+
+} // namespace
+
+LocationSignalFanout::LocationSignalFanout(GDBusConnection *connection,
+                                           const std::string &new_location_path)
+    : m_connection(connection), m_new_location_path(new_location_path) {
+    g_return_if_fail(connection != nullptr);
+
+    // PropertiesChanged("org.freedesktop.GeoClue2.Client", {"Location": <new>}, [])
+    GVariantBuilder changed;
+    g_variant_builder_init(&changed, G_VARIANT_TYPE_VARDICT);
+    g_variant_builder_add(&changed, "{sv}", "Location",
+                          g_variant_new_object_path(m_new_location_path.c_str()));
+
+    m_properties_template = g_dbus_message_new_signal(
+        TEMPLATE_OBJECT_PATH, "org.freedesktop.DBus.Properties", "PropertiesChanged");
+    g_dbus_message_set_body(m_properties_template,
+                            g_variant_new("(sa{sv}@as)", GEOCLUE2_CLIENT_INTERFACE, &changed,
+                                          g_variant_new_strv(nullptr, 0)));
+}
+
+LocationSignalFanout::~LocationSignalFanout() {
+    if (m_properties_template) {
+        g_object_unref(m_properties_template);
+        m_properties_template = nullptr;
+    }
+
+    for (auto &entry : m_updated_templates) {
+        g_object_unref(entry.second);
+    }
+    m_updated_templates.clear();
+}
+
+GDBusMessage *
+LocationSignalFanout::location_updated_template(const std::string &old_location_path) {
+    auto it = m_updated_templates.find(old_location_path);
+    if (it != m_updated_templates.end()) {
+        return it->second;
+    }
+
+    GDBusMessage *message = g_dbus_message_new_signal(TEMPLATE_OBJECT_PATH,
+                                                      GEOCLUE2_CLIENT_INTERFACE, "LocationUpdated");
+    g_dbus_message_set_body(message, g_variant_new("(oo)", old_location_path.c_str(),
+                                                   m_new_location_path.c_str()));
+
+    m_updated_templates.emplace(old_location_path, message);
+    return message;
+}
+
+bool LocationSignalFanout::send(const std::string &client_path, const std::string &peer,
+                                const std::string &old_location_path) {
+    if (!m_connection || !m_properties_template) {
+        return false;
+    }
+
+    // Property first, so proxies have the new value cached when the signal arrives
+    if (!stamp_and_send(m_properties_template, client_path, peer)) {
+        return false;
+    }
+
+    if (!stamp_and_send(location_updated_template(old_location_path), client_path, peer)) {
+        return false;
+    }
+
+    ++m_sent;
+    return true;
+}
+
+bool LocationSignalFanout::stamp_and_send(GDBusMessage *message_template, const std::string &path,
+                                          const std::string &destination) {
+    GError *error = nullptr;
+
+    // The copy shares the (immutable) body and header values with the template
+    GDBusMessage *message = g_dbus_message_copy(message_template, &error);
+    if (!message) {
+        g_warning("LocationSignalFanout: failed to copy message for %s: %s", path.c_str(),
+                  error ? error->message : "unknown error");
+        if (error) {
+            g_error_free(error);
+        }
+        return false;
+    }
+
+    g_dbus_message_set_path(message, path.c_str());
+    if (!destination.empty()) {
+        g_dbus_message_set_destination(message, destination.c_str());
+    }
+
+    gboolean ok = g_dbus_connection_send_message(m_connection, message,
+                                                 G_DBUS_SEND_MESSAGE_FLAGS_NONE, nullptr, &error);
+    g_object_unref(message);
+
+    if (!ok) {
+        g_warning("LocationSignalFanout: failed to send to %s: %s", path.c_str(),
+                  error ? error->message : "unknown error");
+        if (error) {
+            g_error_free(error);
+        }
+        return false;
+    }
+
+    return true;
+}
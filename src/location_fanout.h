@@ -0,0 +1,53 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <string>
+#include <unordered_map>
+
+/**
+ * Per-fix fan-out of Client signals.
+ *
+ * Every active client receives the same two signals for a fix: a
+ * PropertiesChanged for its Location property and LocationUpdated(old, new).
+ * Only the object path, the destination and (rarely) the old location path
+ * differ. The bodies are therefore built once per fix into template messages
+ * and each client gets a copy with its own path and destination stamped in.
+ * Signals are addressed to the owning peer, so the bus daemon does not have
+ * to match them against every other connection.
+ */
+
+class LocationSignalFanout {
+  public:
+    LocationSignalFanout(GDBusConnection *connection, const std::string &new_location_path);
+    ~LocationSignalFanout();
+
+    // Non-copyable
+    LocationSignalFanout(const LocationSignalFanout &) = delete;
+    LocationSignalFanout &operator=(const LocationSignalFanout &) = delete;
+
+    // Queue PropertiesChanged + LocationUpdated for one client
+    bool send(const std::string &client_path, const std::string &peer,
+              const std::string &old_location_path);
+
+    // Number of clients the fix was sent to
+    guint sent() const { return m_sent; }
+
+    const std::string &get_location_path() const { return m_new_location_path; }
+
+  private:
+    GDBusConnection *m_connection;
+    std::string m_new_location_path;
+    GDBusMessage *m_properties_template = nullptr;
+
+    // LocationUpdated templates keyed by old location path. Clients that were
+    // active for the previous fix all share one entry.
+    std::unordered_map<std::string, GDBusMessage *> m_updated_templates;
+
+    guint m_sent = 0;
+
+    GDBusMessage *location_updated_template(const std::string &old_location_path);
+    bool stamp_and_send(GDBusMessage *message_template, const std::string &path,
+                        const std::string &destination);
+};
@@ -0,0 +1,130 @@
+#include "log.h"
+
+#include <stdio.h>
+
+/**
+ * Implementation of the category-filtered logging.
+ */
+
+// Each rate-limited site logs at most this many lines per interval
+const guint LOG_RATELIMIT_BURST = 10;
+const gint64 LOG_RATELIMIT_INTERVAL_US = 5 * G_USEC_PER_SEC;
+
+const char *const LOG_CATEGORY_NAMES[] = {"manager", "client", "backend", "fix"};
+const char *const LOG_LEVEL_NAMES[] = {"warning", "message", "debug"};
+
+int g_log_levels[(int)LogCategory::Count] = {
+    BRIDGE_LOG_LEVEL_MESSAGE, BRIDGE_LOG_LEVEL_MESSAGE, BRIDGE_LOG_LEVEL_MESSAGE,
+    BRIDGE_LOG_LEVEL_MESSAGE};
+
+// Lines dropped by all rate-limited sites
+static guint64 s_suppressed_total = 0;
+
+// Marks structured records that already passed our category filter
+static const char *LOG_FILTERED_FIELD = "GEOCLUE2TO1_FILTERED";
+
+/**
+ * Debug lines reaching GLib already passed our category filter. They are
+ * re-logged as structured records carrying LOG_FILTERED_FIELD, so that they
+ * reach the journal with their priority and domain.
+ */
+static void on_debug_log(const gchar *log_domain, GLogLevelFlags log_level, const gchar *message,
+                         gpointer /*user_data*/) {
+    g_log_structured(log_domain, static_cast<GLogLevelFlags>(log_level & G_LOG_LEVEL_MASK),
+                     LOG_FILTERED_FIELD, "1", "MESSAGE", "%s", message);
+}
+
+/**
+ * Writes marked records even if G_MESSAGES_DEBUG would have dropped them;
+ * everything else goes to GLib's default writer.
+ */
+static GLogWriterOutput write_log(GLogLevelFlags log_level, const GLogField *fields,
+                                  gsize n_fields, gpointer user_data) {
+    for (gsize i = 0; i < n_fields; ++i) {
+        if (g_strcmp0(fields[i].key, LOG_FILTERED_FIELD) != 0) {
+            continue;
+        }
+        if (g_log_writer_is_journald(fileno(stderr)) &&
+            g_log_writer_journald(log_level, fields, n_fields, user_data) ==
+                G_LOG_WRITER_HANDLED) {
+            return G_LOG_WRITER_HANDLED;
+        }
+        return g_log_writer_standard_streams(log_level, fields, n_fields, user_data);
+    }
+
+    return g_log_writer_default(log_level, fields, n_fields, user_data);
+}
+
+void log_init(bool debug_enabled) {
+    static_assert(G_N_ELEMENTS(LOG_CATEGORY_NAMES) == (int)LogCategory::Count,
+                  "log categories and names disagree");
+
+    g_log_set_writer_func(write_log, nullptr, nullptr);
+    g_log_set_handler(nullptr, static_cast<GLogLevelFlags>(G_LOG_LEVEL_DEBUG | G_LOG_LEVEL_INFO),
+                      on_debug_log, nullptr);
+
+    if (debug_enabled) {
+        // Also let GLib/GIO debug output through
+        g_setenv("G_MESSAGES_DEBUG", "all", TRUE);
+        log_set_level("all", "debug");
+    }
+}
+
+bool log_set_level(const std::string &category, const std::string &level) {
+    int value = -1;
+    for (guint i = 0; i < G_N_ELEMENTS(LOG_LEVEL_NAMES); ++i) {
+        if (level == LOG_LEVEL_NAMES[i]) {
+            value = (int)i;
+        }
+    }
+    if (value < 0) {
+        return false;
+    }
+
+    bool found = false;
+    for (int i = 0; i < (int)LogCategory::Count; ++i) {
+        if (category == "all" || category == LOG_CATEGORY_NAMES[i]) {
+            g_log_levels[i] = value;
+            found = true;
+        }
+    }
+
+    if (found && value > BRIDGE_LOG_MAX_LEVEL) {
+        g_warning("Log level %s of %s exceeds the compiled-in maximum %s", level.c_str(),
+                  category.c_str(), LOG_LEVEL_NAMES[BRIDGE_LOG_MAX_LEVEL]);
+    }
+
+    return found;
+}
+
+void log_collect_stats(GVariantBuilder *stats) {
+    for (int i = 0; i < (int)LogCategory::Count; ++i) {
+        std::string key = std::string("log.level.") + LOG_CATEGORY_NAMES[i];
+        g_variant_builder_add(stats, "{sv}", key.c_str(),
+                              g_variant_new_string(LOG_LEVEL_NAMES[g_log_levels[i]]));
+    }
+    g_variant_builder_add(stats, "{sv}", "log.suppressed",
+                          g_variant_new_uint64(s_suppressed_total));
+}
+
+bool LogRateLimit::allow() {
+    gint64 now = g_get_monotonic_time();
+
+    if (now - m_window_start_us >= LOG_RATELIMIT_INTERVAL_US) {
+        if (m_suppressed > 0) {
+            g_message("(%u similar messages suppressed)", m_suppressed);
+        }
+        m_window_start_us = now;
+        m_count = 0;
+        m_suppressed = 0;
+    }
+
+    if (m_count < LOG_RATELIMIT_BURST) {
+        ++m_count;
+        return true;
+    }
+
+    ++m_suppressed;
+    ++s_suppressed_total;
+    return false;
+}
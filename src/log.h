@@ -0,0 +1,111 @@
+#pragma once
+
+#include <glib.h>
+
+#include <string>
+
+/**
+ * Category-filtered logging for the bridge.
+ *
+ * BRIDGE_DEBUG() and BRIDGE_MESSAGE() check the runtime level of their
+ * category before anything is formatted, so a disabled site costs a load
+ * and a compare. Levels above BRIDGE_LOG_MAX_LEVEL (set with the CMake
+ * cache variable of the same name) are compiled out altogether, arguments
+ * included. The runtime levels start at "message" ("debug" with --debug) and
+ * can be changed through SetLogLevel() on the control interface.
+ *
+ * The _RATELIMITED variants are for sites hit on every fix or call: each
+ * site logs at most LOG_RATELIMIT_BURST lines per LOG_RATELIMIT_INTERVAL_US
+ * and reports how many it dropped once it logs again.
+ *
+ * Warnings are not filtered; use g_warning().
+ */
+
+#define BRIDGE_LOG_LEVEL_WARNING 0
+#define BRIDGE_LOG_LEVEL_MESSAGE 1
+#define BRIDGE_LOG_LEVEL_DEBUG 2
+
+#ifndef BRIDGE_LOG_MAX_LEVEL
+#define BRIDGE_LOG_MAX_LEVEL BRIDGE_LOG_LEVEL_DEBUG
+#endif
+
+enum class LogCategory {
+    Manager, // Manager methods, client bookkeeping, GPS lifecycle
+    Client,  // Client methods and state changes
+    Backend, // GeoClue1 backend
+    Fix,     // per-fix path: positions, Location objects, LocationUpdated
+    Count
+};
+
+// Runtime level per category; read inline by the macros
+extern int g_log_levels[(int)LogCategory::Count];
+
+inline bool log_enabled(LogCategory category, int level) {
+    return level <= g_log_levels[(int)category];
+}
+
+// Set every category to "debug" (--debug) or "message"
+void log_init(bool debug_enabled);
+
+// Set the level of `category` ("all" for every category) by name. Returns
+// false for an unknown category or level.
+bool log_set_level(const std::string &category, const std::string &level);
+
+// Add log.level.<category> and log.suppressed entries to a stats a{sv}
+void log_collect_stats(GVariantBuilder *stats);
+
+/**
+ * Per-site rate limiter of the _RATELIMITED macros.
+ */
+class LogRateLimit {
+  public:
+    // True if this call may log. Once a new interval opens, a note about the
+    // lines dropped in the previous one is logged first.
+    bool allow();
+
+  private:
+    gint64 m_window_start_us = 0;
+    guint m_count = 0;
+    guint m_suppressed = 0;
+};
+
+#define BRIDGE_LOG_IF(category, level, log_fn, ...) \
+    do {                                            \
+        if (log_enabled(category, level)) {         \
+            log_fn(__VA_ARGS__);                    \
+        }                                           \
+    } while (0)
+
+#define BRIDGE_LOG_RATELIMITED_IF(category, level, log_fn, ...)    \
+    do {                                                           \
+        if (log_enabled(category, level)) {                        \
+            static LogRateLimit bridge_log_limit;                  \
+            if (bridge_log_limit.allow()) {                        \
+                log_fn(__VA_ARGS__);                               \
+            }                                                      \
+        }                                                          \
+    } while (0)
+
+#define BRIDGE_LOG_NOTHING() \
+    do {                     \
+    } while (0)
+
+#if BRIDGE_LOG_MAX_LEVEL >= BRIDGE_LOG_LEVEL_MESSAGE
+#define BRIDGE_MESSAGE(category, ...) \
+    BRIDGE_LOG_IF(category, BRIDGE_LOG_LEVEL_MESSAGE, g_message, __VA_ARGS__)
+#define BRIDGE_MESSAGE_RATELIMITED(category, ...) \
+    BRIDGE_LOG_RATELIMITED_IF(category, BRIDGE_LOG_LEVEL_MESSAGE, g_message, __VA_ARGS__)
+#else
+#define BRIDGE_MESSAGE(category, ...) BRIDGE_LOG_NOTHING()
+#define BRIDGE_MESSAGE_RATELIMITED(category, ...) BRIDGE_LOG_NOTHING()
+#endif
+
+#if BRIDGE_LOG_MAX_LEVEL >= BRIDGE_LOG_LEVEL_DEBUG
+#define BRIDGE_DEBUG(category, ...) \
+    BRIDGE_LOG_IF(category, BRIDGE_LOG_LEVEL_DEBUG, g_debug, __VA_ARGS__)
+#define BRIDGE_DEBUG_RATELIMITED(category, ...) \
+    BRIDGE_LOG_RATELIMITED_IF(category, BRIDGE_LOG_LEVEL_DEBUG, g_debug, __VA_ARGS__)
+#else
+#define BRIDGE_DEBUG(category, ...) BRIDGE_LOG_NOTHING()
+#define BRIDGE_DEBUG_RATELIMITED(category, ...) BRIDGE_LOG_NOTHING()
+#endif
@@ -0,0 +1,140 @@
+#include "loop_monitor.h"
+
+#include <algorithm>
+
+#ifdef HAVE_SYSTEMD
+#include <systemd/sd-daemon.h>
+#endif
+
+/**
+ * Implementation of the main-loop monitor.
+ */
+
+// Upper bounds of the lag histogram buckets; the last bucket is open-ended
+const guint LAG_BUCKET_BOUNDS_MS[] = {1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024};
+
+LoopMonitor *LoopMonitor::s_instance = nullptr;
+
+LoopMonitor::LoopMonitor(guint stall_threshold_ms, bool profile_callbacks)
+    : m_stall_threshold_ms(stall_threshold_ms), m_profile_callbacks(profile_callbacks) {
+    static_assert(G_N_ELEMENTS(LAG_BUCKET_BOUNDS_MS) + 1 == LAG_BUCKETS,
+                  "lag buckets and bounds disagree");
+
+#ifdef HAVE_SYSTEMD
+    // Ping at half the watchdog period so one late tick does not kill us
+    uint64_t watchdog_us = 0;
+    if (sd_watchdog_enabled(0, &watchdog_us) > 0 && watchdog_us > 0) {
+        m_watchdog = true;
+        m_tick_interval_ms =
+            std::max<guint>(1, std::min<guint64>(m_tick_interval_ms, watchdog_us / 2000));
+        g_message("LoopMonitor: systemd watchdog every %" G_GUINT64_FORMAT " ms",
+                  (guint64)watchdog_us / 1000);
+    }
+#endif
+
+    // No periodic wakeup unless the watchdog or the profile asks for it
+    if (m_watchdog || m_profile_callbacks) {
+        m_last_tick_us = g_get_monotonic_time();
+        m_tick_id = g_timeout_add(m_tick_interval_ms, &LoopMonitor::on_tick, this);
+    }
+
+    s_instance = this;
+}
+
+LoopMonitor::~LoopMonitor() {
+    if (m_tick_id != 0) {
+        g_source_remove(m_tick_id);
+        m_tick_id = 0;
+    }
+
+    if (s_instance == this) {
+        s_instance = nullptr;
+    }
+}
+
+void LoopMonitor::record(const char *scope, const char *name, gint64 duration_us) {
+    if (duration_us > m_slowest_us) {
+        m_slowest_us = duration_us;
+        m_slowest_callback = std::string(scope) + "." + name;
+    }
+
+    if (m_stall_threshold_ms > 0 && duration_us >= (gint64)m_stall_threshold_ms * 1000) {
+        g_warning("LoopMonitor: %s.%s blocked the main loop for %.1f ms", scope, name,
+                  duration_us / 1000.0);
+    }
+
+    if (m_profile_callbacks) {
+        CallbackProfile &profile = m_profiles[std::string(scope) + "." + name];
+        ++profile.count;
+        profile.total_us += duration_us;
+        profile.max_us = std::max(profile.max_us, duration_us);
+    }
+}
+
+/* static */ gboolean LoopMonitor::on_tick(gpointer user_data) {
+    auto *self = static_cast<LoopMonitor *>(user_data);
+
+    gint64 now = g_get_monotonic_time();
+    gint64 lag_us =
+        std::max<gint64>(0, now - self->m_last_tick_us - (gint64)self->m_tick_interval_ms * 1000);
+    self->m_last_tick_us = now;
+
+    guint bucket = 0;
+    while (bucket < LAG_BUCKETS - 1 && lag_us >= (gint64)LAG_BUCKET_BOUNDS_MS[bucket] * 1000) {
+        ++bucket;
+    }
+    ++self->m_lag_histogram[bucket];
+    self->m_lag_max_us = std::max(self->m_lag_max_us, lag_us);
+
+    if (self->m_stall_threshold_ms > 0 && lag_us >= (gint64)self->m_stall_threshold_ms * 1000) {
+        ++self->m_stalls;
+        g_warning("LoopMonitor: main loop lagged %.1f ms, slowest callback %s (%.1f ms)",
+                  lag_us / 1000.0,
+                  self->m_slowest_us > 0 ? self->m_slowest_callback.c_str() : "(not instrumented)",
+                  self->m_slowest_us / 1000.0);
+    }
+    self->m_slowest_us = 0;
+
+#ifdef HAVE_SYSTEMD
+    if (self->m_watchdog) {
+        sd_notify(0, "WATCHDOG=1");
+    }
+#endif
+
+    return G_SOURCE_CONTINUE;
+}
+
+void LoopMonitor::collect_stats(GVariantBuilder *stats) const {
+    g_variant_builder_add(stats, "{sv}", "loop.stalls", g_variant_new_uint64(m_stalls));
+    g_variant_builder_add(stats, "{sv}", "loop.lag_max_us", g_variant_new_int64(m_lag_max_us));
+    g_variant_builder_add(stats, "{sv}", "loop.lag_histogram",
+                          g_variant_new_fixed_array(G_VARIANT_TYPE_UINT64, m_lag_histogram,
+                                                    LAG_BUCKETS, sizeof(guint64)));
+    g_variant_builder_add(stats, "{sv}", "loop.lag_histogram_bounds_ms",
+                          g_variant_new_fixed_array(G_VARIANT_TYPE_UINT32, LAG_BUCKET_BOUNDS_MS,
+                                                    G_N_ELEMENTS(LAG_BUCKET_BOUNDS_MS),
+                                                    sizeof(guint)));
+
+    for (const auto &pair : m_profiles) {
+        std::string prefix = "callbacks." + pair.first;
+        g_variant_builder_add(stats, "{sv}", (prefix + ".count").c_str(),
+                              g_variant_new_uint64(pair.second.count));
+        g_variant_builder_add(stats, "{sv}", (prefix + ".total_us").c_str(),
+                              g_variant_new_int64(pair.second.total_us));
+        g_variant_builder_add(stats, "{sv}", (prefix + ".max_us").c_str(),
+                              g_variant_new_int64(pair.second.max_us));
+    }
+}
+
+LoopMonitor::Scope::Scope(const char *scope, const char *name)
+    : m_monitor(LoopMonitor::instance()), m_scope(scope), m_name(name) {
+    if (m_monitor) {
+        m_start_us = g_get_monotonic_time();
+    }
+}
+
+LoopMonitor::Scope::~Scope() {
+    if (m_monitor) {
+        m_monitor->record(m_scope, m_name, g_get_monotonic_time() - m_start_us);
+    }
+}
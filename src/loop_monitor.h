@@ -0,0 +1,91 @@
+#pragma once
+
+#include <glib.h>
+
+#include <map>
+#include <string>
+
+/**
+ * Main-loop stall detector and per-callback latency profiler.
+ *
+ * D-Bus handlers, backend signal handlers and timeouts wrap their body in a
+ * LoopMonitor::Scope, so a callback that blocks the loop is logged by name.
+ * With profiling enabled the scopes also keep count/total/max per callback.
+ *
+ * A periodic timeout measures how late the main loop dispatches it; that
+ * lag is kept in a histogram. It only runs while something needs it: under
+ * systemd with WatchdogSec= it pings the watchdog, so a wedged main loop gets
+ * the service restarted, and with profiling enabled it feeds the histogram.
+ * An idle daemon is otherwise not woken up once a second.
+ */
+
+class LoopMonitor {
+  public:
+    // stall_threshold_ms = 0 disables stall logging; the lag ticker runs
+    // only with the systemd watchdog or profile_callbacks
+    LoopMonitor(guint stall_threshold_ms, bool profile_callbacks);
+    ~LoopMonitor();
+
+    // Non-copyable
+    LoopMonitor(const LoopMonitor &) = delete;
+    LoopMonitor &operator=(const LoopMonitor &) = delete;
+
+    // The installed monitor, or nullptr
+    static LoopMonitor *instance() { return s_instance; }
+
+    // Add loop.* and callbacks.* entries to a stats a{sv}
+    void collect_stats(GVariantBuilder *stats) const;
+
+    /**
+     * Times one dispatch. `scope` and `name` must outlive the Scope (string
+     * literals or D-Bus member names owned by the invocation).
+     */
+    class Scope {
+      public:
+        Scope(const char *scope, const char *name);
+        ~Scope();
+
+        // Non-copyable
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+      private:
+        LoopMonitor *m_monitor;
+        const char *m_scope;
+        const char *m_name;
+        gint64 m_start_us = 0;
+    };
+
+  private:
+    struct CallbackProfile {
+        guint64 count = 0;
+        gint64 total_us = 0;
+        gint64 max_us = 0;
+    };
+
+    static LoopMonitor *s_instance;
+
+    guint m_stall_threshold_ms;
+    bool m_profile_callbacks;
+
+    // Lag ticker
+    guint m_tick_id = 0;
+    guint m_tick_interval_ms = 1000;
+    gint64 m_last_tick_us = 0;
+    bool m_watchdog = false;
+
+    // Lag histogram, buckets bounded by LAG_BUCKET_BOUNDS_MS (+ overflow)
+    static const guint LAG_BUCKETS = 12;
+    guint64 m_lag_histogram[LAG_BUCKETS] = {};
+    gint64 m_lag_max_us = 0;
+    guint64 m_stalls = 0;
+
+    // Slowest callback since the last tick, to blame for lag
+    std::string m_slowest_callback;
+    gint64 m_slowest_us = 0;
+
+    std::map<std::string, CallbackProfile> m_profiles;
+
+    void record(const char *scope, const char *name, gint64 duration_us);
+    static gboolean on_tick(gpointer user_data);
+};
@@ -2,39 +2,72 @@
 #include <glib-unix.h>
 #include <glib.h>
 
+#include <algorithm>
 #include <csignal>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <string>
 
+#include <unistd.h>
+
+#ifdef HAVE_SYSTEMD
+#include <systemd/sd-daemon.h>
+#endif
+
+#include "bridge_config.h"
+#include "bridge_control.h"
 #include "geoclue1_backend.h"
 #include "geoclue2_manager.h"
+#include "handoff.h"
+#include "log.h"
+#include "loop_monitor.h"
+#include "memory_pressure.h"
+#include "memory_stats.h"
+#include "startup_timeline.h"
+#include "trace_ring.h"
 
 /**
  * Entry point for the geoclue2to1 bridge daemon.
  *
- * This is intentionally minimal at this stage:
- * - Initializes GLib and dbus-glib
  * - Connects to the system bus
- * - Requests the org.freedesktop.GeoClue2 name
- * - Starts the GLib main loop
+ * - Exports the GeoClue2 Manager and the diagnostics interface
+ * - Requests the org.freedesktop.GeoClue2 name asynchronously
+ * - Runs the GLib main loop; the Geoclue1 backend and its session bus
+ *   connection are created on the first Client.Start()
+ * - Optionally exits when idle, to be restarted by D-Bus activation
+ * - Hands its clients over to a successor started with --takeover, which
+ *   SIGUSR2 starts
+ * - Applies changes to its configuration file without a restart
  *
- * TODO:
- * - Register the GeoClue2 Manager/Client/Location objects
- * - Wire them to the Geoclue1 backend
- * - Add CLI options for debug/grace-timeout
+ * Each startup phase is timed and reported as startup.* by GetStats.
  */
 
 namespace {
 
 const char *GEOCLUE2_BUS_NAME = "org.freedesktop.GeoClue2";
 
+// Tuning file; drop-ins are read from DEFAULT_CONFIG_PATH.d/
+const char *DEFAULT_CONFIG_PATH = "/etc/geoclue2to1.conf";
+
 // Global state for clean shutdown
 GMainLoop *g_main_loop_ptr = nullptr;
 GDBusConnection *g_connection_ptr = nullptr;
 std::shared_ptr<GeoClue2Manager> g_manager;
+std::shared_ptr<BridgeControl> g_control;
 std::shared_ptr<Geoclue1Backend> g_backend;
+std::unique_ptr<HandoffServer> g_handoff;
+std::unique_ptr<LoopMonitor> g_loop_monitor;
+std::unique_ptr<MemoryPressureMonitor> g_pressure_monitor;
+std::unique_ptr<ConfigMonitor> g_config_monitor;
+int g_exit_status = EXIT_SUCCESS;
+guint g_owner_id = 0;
+
+// Our command line, for starting a successor on upgrade
+gchar **g_saved_argv = nullptr;
+
+// Startup phase timings, reported through GetStats
+StartupTimeline g_startup;
 
 /**
  * Common signal handler for SIGINT/SIGTERM.
@@ -58,24 +91,98 @@ gboolean on_unix_signal(gpointer data) {
     return G_SOURCE_REMOVE;
 }
 
+/**
+ * SIGUSR1: write the event trace ring to $XDG_RUNTIME_DIR/geoclue2to1-trace.json
+ * for chrome://tracing or Perfetto.
+ */
+gboolean on_dump_trace_signal(gpointer /*data*/) {
+    gchar *path = g_build_filename(g_get_user_runtime_dir(), "geoclue2to1-trace.json", nullptr);
+
+    GError *error = nullptr;
+    if (TraceRing::dump_to_file(path, &error)) {
+        g_message("Trace written to %s", path);
+    } else {
+        g_warning("Failed to write trace to %s: %s", path, error->message);
+        g_error_free(error);
+    }
+
+    g_free(path);
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * SIGHUP: re-read the configuration files, e.g. where inotify is unavailable.
+ */
+gboolean on_reload_signal(gpointer /*data*/) {
+    if (g_config_monitor) {
+        g_config_monitor->reload();
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+/**
+ * SIGUSR2 (ExecReload= of the unit): start the installed binary with
+ * --takeover. It takes our state and bus name over and becomes the unit's
+ * main process (see on_name_acquired); we exit once it owns the name.
+ */
+gboolean on_upgrade_signal(gpointer /*data*/) {
+    if (g_handoff->successor_pending()) {
+        g_message("A successor is already starting");
+        return G_SOURCE_CONTINUE;
+    }
+
+    GPtrArray *args = g_ptr_array_new();
+    for (gchar **arg = g_saved_argv; *arg; ++arg) {
+        if (g_strcmp0(*arg, "--takeover") != 0) {
+            g_ptr_array_add(args, *arg);
+        }
+    }
+    g_ptr_array_add(args, (gpointer) "--takeover");
+    g_ptr_array_add(args, nullptr);
+
+    // The successor's pid is not known yet; it claims the watchdog itself
+    gchar **envp = g_environ_unsetenv(g_get_environ(), "WATCHDOG_PID");
+
+    // Only this process is served our state; the handoff server reaps it
+    GError *error = nullptr;
+    GPid pid = 0;
+    if (g_spawn_async(nullptr, reinterpret_cast<gchar **>(args->pdata), envp,
+                      static_cast<GSpawnFlags>(G_SPAWN_SEARCH_PATH | G_SPAWN_DO_NOT_REAP_CHILD),
+                      nullptr, nullptr, &pid, &error)) {
+        g_message("Started a successor to take over");
+        g_handoff->expect_successor(pid);
+    } else {
+        g_warning("Failed to start a successor: %s", error->message);
+        g_error_free(error);
+    }
+
+    g_strfreev(envp);
+    g_ptr_array_free(args, TRUE);
+    return G_SOURCE_CONTINUE;
+}
+
 void setup_unix_signal_handlers() {
 #ifdef G_OS_UNIX
     g_unix_signal_add(SIGINT, on_unix_signal, GINT_TO_POINTER(SIGINT));
     g_unix_signal_add(SIGTERM, on_unix_signal, GINT_TO_POINTER(SIGTERM));
+    g_unix_signal_add(SIGUSR1, on_dump_trace_signal, nullptr);
+    g_unix_signal_add(SIGHUP, on_reload_signal, nullptr);
+    g_unix_signal_add(SIGUSR2, on_upgrade_signal, nullptr);
 #endif
 }
 
-void log_init(bool debug_enabled) {
-    if (debug_enabled) {
-        g_log_set_handler(nullptr, static_cast<GLogLevelFlags>(G_LOG_LEVEL_MASK),
-                          g_log_default_handler, nullptr);
-        g_setenv("G_MESSAGES_DEBUG", "all", TRUE);
-    }
-}
-
 struct CommandLineOptions {
     bool debug = false;
     int grace_timeout_ms = 15000; // default 15 seconds
+    int max_clients_per_peer = 16;
+    int max_clients = 256;
+    int idle_client_timeout_min = 10;
+    int exit_on_idle_min = 0;
+    bool takeover = false;
+    int stall_threshold_ms = 250;
+    bool profile_callbacks = false;
+    gchar *memory_pressure_file = nullptr;
+    gchar *config_path = nullptr;
 };
 
 CommandLineOptions parse_command_line(int *argc, char ***argv) {
@@ -85,8 +192,30 @@ CommandLineOptions parse_command_line(int *argc, char ***argv) {
         {"debug", 0, 0, G_OPTION_ARG_NONE, &opts.debug, "Enable debug logging", nullptr},
         {"grace-timeout", 0, 0, G_OPTION_ARG_INT, &opts.grace_timeout_ms,
          "Grace timeout in milliseconds before stopping "
-         "GeoClue1 when no clients are active",
+         "GeoClue1 when no clients are active ([grace] timeout-ms overrides it)",
          "MILLISECONDS"},
+        {"config", 0, 0, G_OPTION_ARG_FILENAME, &opts.config_path,
+         "Read tuning from this file and its .d/ drop-ins (default /etc/geoclue2to1.conf)",
+         "PATH"},
+        {"max-clients-per-peer", 0, 0, G_OPTION_ARG_INT, &opts.max_clients_per_peer,
+         "Maximum number of clients a single D-Bus peer may create (0 = unlimited)", "N"},
+        {"max-clients", 0, 0, G_OPTION_ARG_INT, &opts.max_clients,
+         "Maximum number of clients in total (0 = unlimited)", "N"},
+        {"idle-client-timeout", 0, 0, G_OPTION_ARG_INT, &opts.idle_client_timeout_min,
+         "Remove clients that were never started or stopped for this long (0 = never)",
+         "MINUTES"},
+        {"exit-on-idle", 0, 0, G_OPTION_ARG_INT, &opts.exit_on_idle_min,
+         "Release the bus name and exit after this long without clients (0 = never)",
+         "MINUTES"},
+        {"takeover", 0, 0, G_OPTION_ARG_NONE, &opts.takeover,
+         "Take clients and the bus name over from a running instance", nullptr},
+        {"stall-threshold", 0, 0, G_OPTION_ARG_INT, &opts.stall_threshold_ms,
+         "Log main loop stalls and callbacks longer than this (0 = off)", "MILLISECONDS"},
+        {"profile-callbacks", 0, 0, G_OPTION_ARG_NONE, &opts.profile_callbacks,
+         "Keep per-callback latency statistics for GetStats", nullptr},
+        {"memory-pressure-file", 0, 0, G_OPTION_ARG_FILENAME, &opts.memory_pressure_file,
+         "Read memory pressure from this file (\"1\" or \"0\") instead of PSI, for tests",
+         "PATH"},
         {nullptr}};
 
     GError *error = nullptr;
@@ -104,43 +233,185 @@ CommandLineOptions parse_command_line(int *argc, char ***argv) {
     return opts;
 }
 
-GDBusConnection *connect_system_bus() {
+GDBusConnection *connect_bus(GBusType bus_type, const char *phase) {
+    g_startup.begin(phase);
+
     GError *error = nullptr;
-    GDBusConnection *connection = g_bus_get_sync(G_BUS_TYPE_SYSTEM, nullptr, &error);
+    GDBusConnection *connection = g_bus_get_sync(bus_type, nullptr, &error);
     if (!connection) {
-        g_printerr("Failed to connect to system bus: %s\n",
-                   error ? error->message : "unknown error");
+        g_warning("Failed to connect to %s bus: %s",
+                  bus_type == G_BUS_TYPE_SYSTEM ? "system" : "session",
+                  error ? error->message : "unknown error");
         if (error) {
             g_error_free(error);
         }
-        std::exit(EXIT_FAILURE);
     }
+
+    g_startup.end(phase);
     return connection;
 }
 
-void acquire_bus_name(GDBusConnection *connection) {
+void on_name_acquired(GDBusConnection * /*connection*/, const gchar *name,
+                      gpointer user_data) {
+    g_startup.end("acquire_name");
+    gchar *history =
+        g_build_filename(g_get_user_cache_dir(), "geoclue2to1", "startup.ini", nullptr);
+    g_startup.mark_ready(history);
+    g_free(history);
+
+    g_message("Acquired D-Bus name '%s'", name);
+    g_startup.log();
+
+#ifdef HAVE_SYSTEMD
+    if (GPOINTER_TO_INT(user_data)) {
+        // Replacing the unit's main process (see on_upgrade_signal)
+        sd_notifyf(0, "MAINPID=%lu\nREADY=1", (unsigned long)getpid());
+    } else {
+        sd_notify(0, "READY=1");
+    }
+#endif
+}
+
+void on_name_lost(GDBusConnection *connection, const gchar *name, gpointer /*user_data*/) {
+    if (g_handoff && g_handoff->handed_off()) {
+        // Replaced by the successor we handed our state to
+        g_message("D-Bus name '%s' taken over by the new instance, exiting", name);
+        if (g_main_loop_ptr) {
+            g_main_loop_quit(g_main_loop_ptr);
+        }
+        return;
+    }
+
+    if (!connection) {
+        g_printerr("Lost connection to the system bus\n");
+    } else {
+        g_printerr("Failed to acquire or lost D-Bus name '%s'\n", name);
+    }
+
+    g_exit_status = EXIT_FAILURE;
+    if (g_main_loop_ptr) {
+        g_main_loop_quit(g_main_loop_ptr);
+    }
+}
+
+/**
+ * Request org.freedesktop.GeoClue2 without blocking. The objects are already
+ * exported at this point, so the first activated call is answered as soon as
+ * the name is ours. We always allow a successor to replace us (see
+ * handoff.h); a successor taking over asks for replacement.
+ */
+void acquire_bus_name(GDBusConnection *connection, bool replace) {
+    GBusNameOwnerFlags flags = G_BUS_NAME_OWNER_FLAGS_ALLOW_REPLACEMENT;
+    if (replace) {
+        flags = static_cast<GBusNameOwnerFlags>(flags | G_BUS_NAME_OWNER_FLAGS_REPLACE);
+    }
+
+    g_startup.begin("acquire_name");
+    g_owner_id = g_bus_own_name_on_connection(connection, GEOCLUE2_BUS_NAME, flags,
+                                              on_name_acquired, on_name_lost,
+                                              GINT_TO_POINTER(replace), nullptr);
+}
+
+/**
+ * Fetch the state of the running instance for --takeover. Returns nullptr
+ * (and starts fresh) if there is none.
+ */
+GVariant *receive_handoff() {
+    g_startup.begin("handoff");
+
     GError *error = nullptr;
+    GVariant *snapshot = handoff_receive_snapshot(handoff_socket_path(), &error);
+    if (!snapshot) {
+        g_warning("No state to take over, starting fresh: %s", error->message);
+        g_error_free(error);
+    }
 
-    GVariant *result = g_dbus_connection_call_sync(
-        connection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
-        "RequestName", g_variant_new("(su)", GEOCLUE2_BUS_NAME, 0 /* flags */),
-        G_VARIANT_TYPE("(u)"), G_DBUS_CALL_FLAGS_NONE, -1, nullptr, &error);
+    g_startup.end("handoff");
+    return snapshot;
+}
 
-    if (!result) {
-        g_printerr("Failed to request bus name '%s': %s\n", GEOCLUE2_BUS_NAME,
-                   error ? error->message : "unknown error");
-        if (error) {
+void release_bus_name() {
+    if (g_owner_id != 0) {
+        g_bus_unown_name(g_owner_id);
+        g_owner_id = 0;
+    }
+}
+
+/**
+ * Exit-on-idle: give the name back first so that the next GetClient()
+ * activates a fresh instance, then leave the main loop.
+ */
+void on_manager_idle() {
+    release_bus_name();
+    if (g_main_loop_ptr) {
+        g_main_loop_quit(g_main_loop_ptr);
+    }
+}
+
+// A backend being created for the Manager
+struct BackendRequest {
+    GeoClue2Manager *manager;
+    GeoClue2Manager::BackendReady ready;
+};
+
+void on_session_bus(GObject * /*source*/, GAsyncResult *res, gpointer user_data) {
+    std::unique_ptr<BackendRequest> request(static_cast<BackendRequest *>(user_data));
+
+    GError *error = nullptr;
+    GDBusConnection *session = g_bus_get_finish(res, &error);
+    if (!session) {
+        // The Manager is gone; it must not be called back
+        if (g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
             g_error_free(error);
+            return;
         }
-        std::exit(EXIT_FAILURE);
+        g_warning("Failed to connect to session bus: %s", error->message);
+        g_error_free(error);
     }
+    g_startup.end("connect_session");
 
-    guint request_name_result;
-    g_variant_get(result, "(u)", &request_name_result);
-    g_variant_unref(result);
+    auto backend = std::make_shared<Geoclue1Backend>(session);
+    if (session) {
+        g_object_unref(session);
+    }
 
-    g_message("Acquired D-Bus name '%s' with result code %u", GEOCLUE2_BUS_NAME,
-              request_name_result);
+    // Wire position callback to broadcast updates to all active GeoClue2 clients
+    GeoClue2Manager *manager = request->manager;
+    backend->set_position_callback([manager](const GeoClue1Position &pos) {
+        BRIDGE_DEBUG_RATELIMITED(LogCategory::Fix,
+                                 "GeoClue1 position: lat=%.6f lon=%.6f alt=%.1f acc=%.1f "
+                                 "speed=%.1f heading=%.1f",
+                                 pos.latitude, pos.longitude, pos.altitude, pos.accuracy,
+                                 pos.speed, pos.heading);
+
+        // Broadcast to all active clients
+        manager->handle_position_update(pos);
+    });
+
+    // Velocity callback for debugging (actual data is merged in on_position_changed)
+    backend->set_velocity_callback([](const GeoClue1Velocity &vel) {
+        BRIDGE_DEBUG_RATELIMITED(LogCategory::Fix,
+                                 "GeoClue1 velocity: speed=%.1f direction=%.1f climb=%.1f",
+                                 vel.speed, vel.direction, vel.climb);
+    });
+
+    g_backend = backend;
+    g_startup.end("backend_init");
+    request->ready(backend);
+}
+
+/**
+ * Create the GeoClue1 backend on first use. The session bus is only
+ * connected at this point, so an instance that never serves a Start() never
+ * touches it. The connection is made asynchronously; the Manager answers
+ * the Start() calls waiting for it once it is up.
+ */
+void create_backend(GeoClue2Manager *manager, GCancellable *cancellable,
+                    GeoClue2Manager::BackendReady ready) {
+    g_startup.begin("backend_init");
+    g_startup.begin("connect_session");
+    g_bus_get(G_BUS_TYPE_SESSION, cancellable, &on_session_bus,
+              new BackendRequest{manager, std::move(ready)});
 }
 
 } // namespace
@@ -151,30 +422,113 @@ int main(int argc, char **argv) {
 #endif
 
     // Parse command line options
+    g_saved_argv = g_strdupv(argv);
     CommandLineOptions options = parse_command_line(&argc, &argv);
 
     // Initialize logging
     log_init(options.debug);
     g_message("Starting geoclue2to1 bridge daemon");
 
-    // Connect to the system bus
-    GDBusConnection *connection = connect_system_bus();
+    // Connect to the system bus; the session bus is connected on first use
+    GDBusConnection *connection = connect_bus(G_BUS_TYPE_SYSTEM, "connect_system");
+    if (!connection) {
+        return EXIT_FAILURE;
+    }
     g_connection_ptr = connection;
 
-    // Request org.freedesktop.GeoClue2 name
-    acquire_bus_name(connection);
-
-    // Initialize and register:
-    // - GeoClue2 Manager object at /org/freedesktop/GeoClue2/Manager
-    //   (Client and Location objects will be created on demand)
-    // - Geoclue1 backend and client registry (to be implemented), using
-    //   options.grace_timeout_ms for GPS stop grace timeout
-    std::shared_ptr<GeoClue2Manager> manager = geoclue2_manager_register(connection);
-    if (!manager) {
+    // Export the GeoClue2 Manager at /org/freedesktop/GeoClue2/Manager before
+    // owning the name (Client and Location objects are created on demand)
+    g_startup.begin("export_manager");
+    // Callbacks below hold the Manager by pointer; g_manager owns it until
+    // the shutdown below destroys it after them
+    g_manager = geoclue2_manager_register(connection);
+    if (!g_manager) {
         g_printerr("Failed to register GeoClue2 Manager on D-Bus\n");
         return EXIT_FAILURE;
     }
-    g_manager = manager;
+    GeoClue2Manager *manager = g_manager.get();
+    manager->set_client_limits(std::max(options.max_clients_per_peer, 0),
+                               std::max(options.max_clients, 0));
+    manager->set_idle_client_timeout(std::max(options.idle_client_timeout_min, 0) * 60);
+    manager->set_backend_factory(
+        [manager](GCancellable *cancellable, GeoClue2Manager::BackendReady ready) {
+            create_backend(manager, cancellable, std::move(ready));
+        });
+    manager->set_exit_on_idle(std::max(options.exit_on_idle_min, 0) * 60, on_manager_idle);
+
+    // Tuning from the configuration file, re-applied whenever it changes;
+    // the command line supplies what the files leave unset
+    BridgeConfig config_defaults;
+    config_defaults.grace_timeout_ms = (guint)std::max(options.grace_timeout_ms, 0);
+    g_config_monitor = std::make_unique<ConfigMonitor>(
+        options.config_path ? options.config_path : DEFAULT_CONFIG_PATH, config_defaults,
+        [manager](const BridgeConfig &) { manager->apply_config(); });
+    g_free(options.config_path);
+
+    // Re-export the clients and fixes of the instance we replace
+    bool took_over = false;
+    if (options.takeover) {
+        GVariant *snapshot = receive_handoff();
+        if (snapshot) {
+            manager->restore_state(snapshot);
+            g_variant_unref(snapshot);
+            took_over = true;
+        }
+    }
+
+    // Serve our own state to the next upgrade; fixes that arrive after the
+    // snapshot are the successor's, unless it fails to take over
+    g_handoff = std::make_unique<HandoffServer>(
+        handoff_socket_path(),
+        [manager]() {
+            manager->set_handing_off(true);
+            return manager->save_state();
+        },
+        [manager](bool sent) {
+            if (!sent) {
+                manager->set_handing_off(false);
+            }
+        });
+
+    // Diagnostics interface (GetStats)
+    g_control = bridge_control_register(connection);
+    g_control->add_stats_provider(
+        [manager](GVariantBuilder *stats) { manager->collect_stats(stats); });
+    g_control->add_stats_provider([](GVariantBuilder *stats) { g_startup.collect_stats(stats); });
+    g_control->add_stats_provider(log_collect_stats);
+    g_control->add_stats_provider(memory_collect_stats);
+    g_control->add_stats_provider(
+        [](GVariantBuilder *stats) {
+            if (g_config_monitor) {
+                g_config_monitor->collect_stats(stats);
+            }
+        });
+
+    // Stall detection and systemd watchdog; handlers time themselves
+    g_loop_monitor = std::make_unique<LoopMonitor>(std::max(options.stall_threshold_ms, 0),
+                                                   options.profile_callbacks);
+    g_control->add_stats_provider(
+        [](GVariantBuilder *stats) {
+            if (g_loop_monitor) {
+                g_loop_monitor->collect_stats(stats);
+            }
+        });
+
+    // Shrink retention and caches when the system runs short of memory
+    g_pressure_monitor = std::make_unique<MemoryPressureMonitor>(
+        options.memory_pressure_file ? options.memory_pressure_file : "",
+        [manager](bool under_pressure) { manager->set_memory_pressure(under_pressure); });
+    g_free(options.memory_pressure_file);
+    g_control->add_stats_provider(
+        [](GVariantBuilder *stats) {
+            if (g_pressure_monitor) {
+                g_pressure_monitor->collect_stats(stats);
+            }
+        });
+    g_startup.end("export_manager");
+
+    // Request org.freedesktop.GeoClue2; completes once the main loop runs
+    acquire_bus_name(connection, took_over);
 
     // Start the GLib main loop
     GMainLoop *loop = g_main_loop_new(nullptr, FALSE);
@@ -187,28 +541,6 @@ int main(int argc, char **argv) {
     // Install signal handlers for clean shutdown (Ctrl+C, systemd stop)
     setup_unix_signal_handlers();
 
-    // Create GeoClue1 backend
-    g_backend = std::make_shared<Geoclue1Backend>(connection);
-
-    // Wire position callback to broadcast updates to all active GeoClue2 clients
-    g_backend->set_position_callback([manager](const GeoClue1Position &pos) {
-        g_debug("GeoClue1 position: lat=%.6f lon=%.6f alt=%.1f acc=%.1f "
-                "speed=%.1f heading=%.1f",
-                pos.latitude, pos.longitude, pos.altitude, pos.accuracy, pos.speed, pos.heading);
-
-        // Broadcast to all active clients
-        manager->handle_position_update(pos);
-    });
-
-    // Velocity callback for debugging (actual data is merged in on_position_changed)
-    g_backend->set_velocity_callback([](const GeoClue1Velocity &vel) {
-        g_debug("GeoClue1 velocity: speed=%.1f direction=%.1f climb=%.1f", vel.speed, vel.direction,
-                vel.climb);
-    });
-
-    // Hand backend to the Manager so it can manage GPS lifecycle
-    manager->set_backend(g_backend);
-
     g_message("GeoClue2 bridge ready - waiting for client connections");
 
     g_main_loop_run(loop);
@@ -221,8 +553,20 @@ int main(int argc, char **argv) {
         g_backend.reset();
     }
 
+    // Everything that calls into the Manager goes first, then the Manager
+    // itself, while the clock its timers and power accounting use is alive
+    g_handoff.reset();
+    g_pressure_monitor.reset();
+    g_loop_monitor.reset();
+    g_config_monitor.reset();
+    g_control.reset();
+    g_manager.reset();
+
+    release_bus_name();
+
     g_main_loop_unref(loop);
     g_main_loop_ptr = nullptr;
+    g_strfreev(g_saved_argv);
 
-    return EXIT_SUCCESS;
+    return g_exit_status;
 }
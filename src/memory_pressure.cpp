@@ -0,0 +1,210 @@
+#include "memory_pressure.h"
+#include "loop_monitor.h"
+
+#include <glib-unix.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <utility>
+
+/**
+ * Implementation of the memory-pressure monitor.
+ */
+
+// PSI trigger: 150 ms of "some" stall within a 2 s window. Unprivileged
+// processes may only use windows that are multiples of 2 s.
+const char *PSI_TRIGGER = "some 150000 2000000";
+
+const char *PSI_SYSTEM_PATH = "/proc/pressure/memory";
+
+// No trigger for this long ends a pressure episode
+const guint RELIEF_TIMEOUT_S = 30;
+
+namespace {
+
+// memory.pressure of the cgroup v2 we run in, or "" if there is none
+std::string own_cgroup_pressure_path() {
+    gchar *contents = nullptr;
+    if (!g_file_get_contents("/proc/self/cgroup", &contents, nullptr, nullptr)) {
+        return std::string();
+    }
+
+    // The unified hierarchy is listed as "0::/system.slice/foo.service"
+    std::string path;
+    gchar **lines = g_strsplit(contents, "\n", 0);
+    for (gchar **line = lines; *line; ++line) {
+        if (g_str_has_prefix(*line, "0::")) {
+            path = std::string("/sys/fs/cgroup") + (*line + 3) + "/memory.pressure";
+            break;
+        }
+    }
+
+    g_strfreev(lines);
+    g_free(contents);
+    return path;
+}
+
+} // namespace
+
+MemoryPressureMonitor::MemoryPressureMonitor(const std::string &stand_in_path, Callback changed)
+    : m_changed(std::move(changed)), m_stand_in_path(stand_in_path) {
+    if (!m_stand_in_path.empty()) {
+        GFile *file = g_file_new_for_path(m_stand_in_path.c_str());
+        GError *error = nullptr;
+        m_file_monitor = g_file_monitor_file(file, G_FILE_MONITOR_NONE, nullptr, &error);
+        g_object_unref(file);
+
+        if (!m_file_monitor) {
+            g_warning("MemoryPressureMonitor: cannot watch %s: %s", m_stand_in_path.c_str(),
+                      error->message);
+            g_error_free(error);
+            return;
+        }
+
+        g_signal_connect(m_file_monitor, "changed",
+                         G_CALLBACK(&MemoryPressureMonitor::on_stand_in_changed), this);
+        m_source = "file";
+        g_message("MemoryPressureMonitor: watching stand-in %s", m_stand_in_path.c_str());
+        read_stand_in();
+        return;
+    }
+
+    if (open_psi(PSI_SYSTEM_PATH)) {
+        m_source = "psi";
+    } else {
+        std::string cgroup_path = own_cgroup_pressure_path();
+        if (!cgroup_path.empty() && open_psi(cgroup_path)) {
+            m_source = "psi-cgroup";
+        }
+    }
+
+    if (m_psi_fd < 0) {
+        g_message("MemoryPressureMonitor: no PSI support, pressure handling disabled");
+    }
+}
+
+MemoryPressureMonitor::~MemoryPressureMonitor() {
+    if (m_psi_watch_id != 0) {
+        g_source_remove(m_psi_watch_id);
+    }
+    if (m_psi_fd >= 0) {
+        close(m_psi_fd);
+    }
+    if (m_relief_id != 0) {
+        g_source_remove(m_relief_id);
+    }
+    if (m_file_monitor) {
+        g_signal_handlers_disconnect_by_data(m_file_monitor, this);
+        g_file_monitor_cancel(m_file_monitor);
+        g_object_unref(m_file_monitor);
+    }
+}
+
+bool MemoryPressureMonitor::open_psi(const std::string &path) {
+    int fd = open(path.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    // The trigger is registered by writing it, including the terminating NUL
+    if (write(fd, PSI_TRIGGER, strlen(PSI_TRIGGER) + 1) < 0) {
+        g_message("MemoryPressureMonitor: cannot set trigger on %s: %s", path.c_str(),
+                  g_strerror(errno));
+        close(fd);
+        return false;
+    }
+
+    m_psi_fd = fd;
+    m_psi_watch_id =
+        g_unix_fd_add(fd, static_cast<GIOCondition>(G_IO_PRI | G_IO_ERR),
+                      &MemoryPressureMonitor::on_psi_event, this);
+    g_message("MemoryPressureMonitor: PSI trigger \"%s\" on %s", PSI_TRIGGER, path.c_str());
+    return true;
+}
+
+void MemoryPressureMonitor::read_stand_in() {
+    gchar *contents = nullptr;
+    bool under_pressure = false;
+    if (g_file_get_contents(m_stand_in_path.c_str(), &contents, nullptr, nullptr)) {
+        under_pressure = g_strstrip(contents)[0] == '1';
+        g_free(contents);
+    }
+
+    if (under_pressure && !m_under_pressure) {
+        ++m_events;
+    }
+    set_under_pressure(under_pressure);
+}
+
+void MemoryPressureMonitor::set_under_pressure(bool under_pressure) {
+    if (under_pressure == m_under_pressure) {
+        return;
+    }
+
+    m_under_pressure = under_pressure;
+    if (under_pressure) {
+        ++m_episodes;
+        g_message("MemoryPressureMonitor: memory pressure (%s)", m_source.c_str());
+    } else {
+        g_message("MemoryPressureMonitor: memory pressure relieved");
+    }
+
+    if (m_changed) {
+        m_changed(under_pressure);
+    }
+}
+
+void MemoryPressureMonitor::collect_stats(GVariantBuilder *stats) const {
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.source",
+                          g_variant_new_string(m_source.c_str()));
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.active",
+                          g_variant_new_boolean(m_under_pressure));
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.events", g_variant_new_uint64(m_events));
+    g_variant_builder_add(stats, "{sv}", "memory.pressure.episodes",
+                          g_variant_new_uint64(m_episodes));
+}
+
+/* static */ gboolean MemoryPressureMonitor::on_psi_event(gint /*fd*/, GIOCondition condition,
+                                                          gpointer user_data) {
+    LoopMonitor::Scope timing("Pressure", "PSI");
+
+    auto *self = static_cast<MemoryPressureMonitor *>(user_data);
+
+    if (condition & G_IO_ERR) {
+        // The cgroup went away; nothing more will arrive on this fd
+        g_warning("MemoryPressureMonitor: PSI trigger failed, pressure handling disabled");
+        self->m_psi_watch_id = 0;
+        return G_SOURCE_REMOVE;
+    }
+
+    ++self->m_events;
+
+    if (self->m_relief_id != 0) {
+        g_source_remove(self->m_relief_id);
+    }
+    self->m_relief_id = g_timeout_add_seconds(RELIEF_TIMEOUT_S,
+                                              &MemoryPressureMonitor::on_relief_timeout, self);
+
+    self->set_under_pressure(true);
+    return G_SOURCE_CONTINUE;
+}
+
+/* static */ gboolean MemoryPressureMonitor::on_relief_timeout(gpointer user_data) {
+    LoopMonitor::Scope timing("Timeout", "PressureRelief");
+
+    auto *self = static_cast<MemoryPressureMonitor *>(user_data);
+    self->m_relief_id = 0;
+    self->set_under_pressure(false);
+    return G_SOURCE_REMOVE;
+}
+
+/* static */ void MemoryPressureMonitor::on_stand_in_changed(GFileMonitor * /*monitor*/,
+                                                             GFile * /*file*/,
+                                                             GFile * /*other_file*/,
+                                                             GFileMonitorEvent /*event_type*/,
+                                                             gpointer user_data) {
+    auto *self = static_cast<MemoryPressureMonitor *>(user_data);
+    self->read_stand_in();
+}
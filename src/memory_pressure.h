@@ -0,0 +1,66 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <functional>
+#include <string>
+
+/**
+ * Memory-pressure notifications.
+ *
+ * Subscribes to a PSI trigger ("some" stall of 150 ms within a 2 s window)
+ * on /proc/pressure/memory, falling back to the memory.pressure file of our
+ * own cgroup v2. The kernel only reports the onset of pressure, so relief is
+ * declared once no trigger fired for RELIEF_TIMEOUT_S.
+ *
+ * For tests a stand-in file can be watched instead: it holds "1" while
+ * under pressure and "0" otherwise, and each change is reported at once.
+ *
+ * Without PSI support (kernel < 4.20 or CONFIG_PSI=n) the monitor stays
+ * inactive and never reports pressure.
+ */
+
+class MemoryPressureMonitor {
+  public:
+    using Callback = std::function<void(bool under_pressure)>;
+
+    // An empty `stand_in_path` selects PSI
+    MemoryPressureMonitor(const std::string &stand_in_path, Callback changed);
+    ~MemoryPressureMonitor();
+
+    // Non-copyable
+    MemoryPressureMonitor(const MemoryPressureMonitor &) = delete;
+    MemoryPressureMonitor &operator=(const MemoryPressureMonitor &) = delete;
+
+    bool under_pressure() const { return m_under_pressure; }
+
+    // Add memory.pressure.* entries to a stats a{sv}
+    void collect_stats(GVariantBuilder *stats) const;
+
+  private:
+    Callback m_changed;
+    std::string m_source = "none";
+    bool m_under_pressure = false;
+
+    // PSI trigger
+    int m_psi_fd = -1;
+    guint m_psi_watch_id = 0;
+    guint m_relief_id = 0;
+
+    // Stand-in file
+    std::string m_stand_in_path;
+    GFileMonitor *m_file_monitor = nullptr;
+
+    guint64 m_events = 0;
+    guint64 m_episodes = 0;
+
+    bool open_psi(const std::string &path);
+    void read_stand_in();
+    void set_under_pressure(bool under_pressure);
+
+    static gboolean on_psi_event(gint fd, GIOCondition condition, gpointer user_data);
+    static gboolean on_relief_timeout(gpointer user_data);
+    static void on_stand_in_changed(GFileMonitor *monitor, GFile *file, GFile *other_file,
+                                    GFileMonitorEvent event_type, gpointer user_data);
+};
@@ -0,0 +1,169 @@
+#include "memory_stats.h"
+
+#ifdef HAVE_ALLOC_COUNTING
+#include <cerrno>
+#include <malloc.h>
+#endif
+
+/**
+ * Implementation of the memory accounting.
+ */
+
+#ifdef HAVE_ALLOC_COUNTING
+
+/*
+ * Counting allocator: wraps glibc's allocator entry points. The executable's
+ * definitions take precedence over libc for every library in the process.
+ * Counters are relaxed atomics since GDBus allocates from its worker thread.
+ * The per-thread count is a plain thread_local: the library is linked into
+ * the executable, so it lives in static TLS and reading it never allocates.
+ */
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+}
+
+namespace {
+
+std::atomic<guint64> s_allocations{0};
+std::atomic<guint64> s_frees{0};
+std::atomic<gint64> s_live_bytes{0};
+std::atomic<gint64> s_peak_live_bytes{0};
+thread_local guint64 t_allocations = 0;
+
+void count_allocation(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    gint64 size = malloc_usable_size(ptr);
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    ++t_allocations;
+    gint64 live = s_live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+    gint64 peak = s_peak_live_bytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !s_peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+void count_free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+
+    s_frees.fetch_add(1, std::memory_order_relaxed);
+    s_live_bytes.fetch_sub(malloc_usable_size(ptr), std::memory_order_relaxed);
+}
+
+} // namespace
+
+extern "C" {
+
+void *malloc(size_t size) {
+    void *ptr = __libc_malloc(size);
+    count_allocation(ptr);
+    return ptr;
+}
+
+void *calloc(size_t count, size_t size) {
+    void *ptr = __libc_calloc(count, size);
+    count_allocation(ptr);
+    return ptr;
+}
+
+void *realloc(void *ptr, size_t size) {
+    count_free(ptr);
+    void *result = __libc_realloc(ptr, size);
+    // A failed realloc leaves the old block in place
+    count_allocation(result ? result : (size != 0 ? ptr : nullptr));
+    return result;
+}
+
+void *memalign(size_t alignment, size_t size) {
+    void *ptr = __libc_memalign(alignment, size);
+    count_allocation(ptr);
+    return ptr;
+}
+
+void *aligned_alloc(size_t alignment, size_t size) { return memalign(alignment, size); }
+
+int posix_memalign(void **result, size_t alignment, size_t size) {
+    void *ptr = memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *result = ptr;
+    return 0;
+}
+
+void free(void *ptr) {
+    count_free(ptr);
+    __libc_free(ptr);
+}
+
+} // extern "C"
+
+AllocationCounters allocation_counters() {
+    AllocationCounters counters;
+    counters.available = true;
+    counters.allocations = s_allocations.load(std::memory_order_relaxed);
+    counters.thread_allocations = t_allocations;
+    counters.frees = s_frees.load(std::memory_order_relaxed);
+    counters.live_bytes = s_live_bytes.load(std::memory_order_relaxed);
+    counters.peak_live_bytes = s_peak_live_bytes.load(std::memory_order_relaxed);
+    return counters;
+}
+
+#else
+
+AllocationCounters allocation_counters() { return AllocationCounters(); }
+
+#endif
+
+ProcessMemory process_memory() {
+    ProcessMemory memory;
+
+    gchar *contents = nullptr;
+    if (!g_file_get_contents("/proc/self/status", &contents, nullptr, nullptr)) {
+        return memory;
+    }
+
+    // Lines look like "VmRSS:	    5120 kB"
+    gchar **lines = g_strsplit(contents, "\n", 0);
+    for (gchar **line = lines; *line; ++line) {
+        if (g_str_has_prefix(*line, "VmRSS:")) {
+            memory.rss_bytes = g_ascii_strtoll(*line + 6, nullptr, 10) * 1024;
+        } else if (g_str_has_prefix(*line, "VmHWM:")) {
+            memory.peak_rss_bytes = g_ascii_strtoll(*line + 6, nullptr, 10) * 1024;
+        }
+    }
+
+    g_strfreev(lines);
+    g_free(contents);
+    return memory;
+}
+
+void memory_collect_stats(GVariantBuilder *stats) {
+    ProcessMemory memory = process_memory();
+    g_variant_builder_add(stats, "{sv}", "memory.rss_bytes", g_variant_new_int64(memory.rss_bytes));
+    g_variant_builder_add(stats, "{sv}", "memory.peak_rss_bytes",
+                          g_variant_new_int64(memory.peak_rss_bytes));
+
+    AllocationCounters counters = allocation_counters();
+    if (!counters.available) {
+        return;
+    }
+
+    g_variant_builder_add(stats, "{sv}", "memory.heap.allocations",
+                          g_variant_new_uint64(counters.allocations));
+    g_variant_builder_add(stats, "{sv}", "memory.heap.frees", g_variant_new_uint64(counters.frees));
+    g_variant_builder_add(stats, "{sv}", "memory.heap.live_bytes",
+                          g_variant_new_int64(counters.live_bytes));
+    g_variant_builder_add(stats, "{sv}", "memory.heap.peak_live_bytes",
+                          g_variant_new_int64(counters.peak_live_bytes));
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <glib.h>
+
+#include <atomic>
+
+/**
+ * Memory accounting for the stats interface.
+ *
+ * - LiveCounted<T> counts live instances of the exported object classes, so
+ *   leaked Clients or Locations show up even when no container holds them.
+ * - process_memory() reads RSS and its peak from /proc/self/status.
+ * - Built with -DENABLE_ALLOC_COUNTING=ON, malloc and friends are wrapped
+ *   for the whole process (GLib included). The wrappers count allocations
+ *   and live heap bytes; allocation_counters() reads them. Allocations are
+ *   also counted per thread, so the main loop's share can be told apart
+ *   from GDBus's worker thread. Without the option `available` is false.
+ */
+
+template <typename T> class LiveCounted {
+  public:
+    static guint64 live() { return s_live.load(std::memory_order_relaxed); }
+
+  protected:
+    LiveCounted() { s_live.fetch_add(1, std::memory_order_relaxed); }
+    LiveCounted(const LiveCounted &) { s_live.fetch_add(1, std::memory_order_relaxed); }
+    ~LiveCounted() { s_live.fetch_sub(1, std::memory_order_relaxed); }
+
+  private:
+    static inline std::atomic<guint64> s_live{0};
+};
+
+struct ProcessMemory {
+    gint64 rss_bytes = -1;
+    gint64 peak_rss_bytes = -1;
+};
+
+struct AllocationCounters {
+    bool available = false;
+    guint64 allocations = 0;
+    guint64 thread_allocations = 0; // made by the calling thread
+    guint64 frees = 0;
+    gint64 live_bytes = 0;
+    gint64 peak_live_bytes = 0;
+};
+
+ProcessMemory process_memory();
+AllocationCounters allocation_counters();
+
+// Add memory.rss_bytes, memory.peak_rss_bytes and, with the counting
+// allocator, memory.heap.* entries to a stats a{sv}
+void memory_collect_stats(GVariantBuilder *stats);
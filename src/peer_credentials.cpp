@@ -0,0 +1,171 @@
+#include "peer_credentials.h"
+
+#include <utility>
+
+/**
+ * Implementation of the peer credential cache.
+ */
+
+namespace {
+
+// Heap-allocated context for async D-Bus calls
+struct FetchCall {
+    PeerCredentialCache::Callback done;
+};
+
+bool parse_credentials(GVariant *result, PeerCredentials *credentials) {
+    GVariant *dict = g_variant_get_child_value(result, 0);
+
+    credentials->has_uid = g_variant_lookup(dict, "UnixUserID", "u", &credentials->uid);
+    credentials->has_pid = g_variant_lookup(dict, "ProcessID", "u", &credentials->pid);
+
+    // Read while the peer is connected, so the pid still belongs to it
+    if (credentials->has_pid) {
+        gchar *proc_exe = g_strdup_printf("/proc/%u/exe", credentials->pid);
+        gchar *exe = g_file_read_link(proc_exe, nullptr);
+        if (exe) {
+            credentials->exe = exe;
+        }
+        g_free(exe);
+        g_free(proc_exe);
+    }
+
+    g_variant_unref(dict);
+    return credentials->has_uid;
+}
+
+} // namespace
+
+PeerCredentialCache::PeerCredentialCache(GDBusConnection *connection)
+    : m_connection(connection), m_cancellable(g_cancellable_new()) {}
+
+PeerCredentialCache::~PeerCredentialCache() {
+    // Pending async calls see G_IO_ERROR_CANCELLED and do not touch us
+    g_cancellable_cancel(m_cancellable);
+    g_object_unref(m_cancellable);
+}
+
+void PeerCredentialCache::fetch(const std::string &peer, Callback done) {
+    auto *call = new FetchCall{std::move(done)};
+
+    g_dbus_connection_call(
+        m_connection, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus",
+        "GetConnectionCredentials", g_variant_new("(s)", peer.c_str()),
+        G_VARIANT_TYPE("(a{sv})"), G_DBUS_CALL_FLAGS_NONE, -1, m_cancellable,
+        [](GObject *source, GAsyncResult *res, gpointer user_data) {
+            auto *call = static_cast<FetchCall *>(user_data);
+            GError *error = nullptr;
+            GVariant *result =
+                g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+
+            PeerCredentials credentials;
+            bool ok = false;
+            if (result) {
+                ok = parse_credentials(result, &credentials);
+                g_variant_unref(result);
+            } else {
+                bool cancelled = g_error_matches(error, G_IO_ERROR, G_IO_ERROR_CANCELLED);
+                if (!cancelled) {
+                    g_warning("PeerCredentialCache: GetConnectionCredentials failed: %s",
+                              error->message);
+                }
+                g_error_free(error);
+                if (cancelled) {
+                    delete call;
+                    return;
+                }
+            }
+
+            call->done(ok, credentials);
+            delete call;
+        },
+        call);
+}
+
+void PeerCredentialCache::track(const std::string &peer) {
+    if (m_entries.count(peer)) {
+        return;
+    }
+
+    m_entries[peer];
+
+    fetch(peer, [this, peer](bool ok, const PeerCredentials &credentials) {
+        // The peer may have been forgotten while the call was in flight
+        auto it = m_entries.find(peer);
+        if (it == m_entries.end() || it->second.resolved) {
+            return;
+        }
+
+        Entry &entry = it->second;
+        entry.resolved = true;
+        entry.ok = ok;
+        entry.credentials = credentials;
+        if (!ok) {
+            ++m_failures;
+        }
+
+        std::vector<Callback> waiters;
+        waiters.swap(entry.waiters);
+        for (auto &waiter : waiters) {
+            waiter(ok, credentials);
+        }
+    });
+}
+
+void PeerCredentialCache::forget(const std::string &peer) {
+    auto it = m_entries.find(peer);
+    if (it == m_entries.end()) {
+        return;
+    }
+
+    std::vector<Callback> waiters;
+    waiters.swap(it->second.waiters);
+    m_entries.erase(it);
+
+    for (auto &waiter : waiters) {
+        waiter(false, PeerCredentials());
+    }
+}
+
+const PeerCredentials *PeerCredentialCache::find(const std::string &peer) const {
+    auto it = m_entries.find(peer);
+    if (it == m_entries.end() || !it->second.resolved || !it->second.ok) {
+        return nullptr;
+    }
+    return &it->second.credentials;
+}
+
+void PeerCredentialCache::lookup(const std::string &peer, Callback done) {
+    auto it = m_entries.find(peer);
+    if (it == m_entries.end()) {
+        ++m_uncached;
+        fetch(peer, [this, done](bool ok, const PeerCredentials &credentials) {
+            if (!ok) {
+                ++m_failures;
+            }
+            done(ok, credentials);
+        });
+        return;
+    }
+
+    if (it->second.resolved) {
+        ++m_hits;
+        done(it->second.ok, it->second.credentials);
+        return;
+    }
+
+    // Eager fetch still in flight: ride along instead of asking again
+    ++m_waits;
+    it->second.waiters.push_back(std::move(done));
+}
+
+void PeerCredentialCache::collect_stats(GVariantBuilder *stats) const {
+    g_variant_builder_add(stats, "{sv}", "credentials.cached",
+                          g_variant_new_uint32(m_entries.size()));
+    g_variant_builder_add(stats, "{sv}", "credentials.hits", g_variant_new_uint64(m_hits));
+    g_variant_builder_add(stats, "{sv}", "credentials.waits", g_variant_new_uint64(m_waits));
+    g_variant_builder_add(stats, "{sv}", "credentials.uncached",
+                          g_variant_new_uint64(m_uncached));
+    g_variant_builder_add(stats, "{sv}", "credentials.failures",
+                          g_variant_new_uint64(m_failures));
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Credentials of a D-Bus peer as reported by the bus daemon, and the
+ * executable of its process.
+ */
+struct PeerCredentials {
+    bool has_uid = false;
+    guint uid = 0;
+    bool has_pid = false;
+    guint pid = 0;
+    std::string exe; // executable of the process, empty if unknown
+};
+
+/**
+ * Per-unique-name cache of peer credentials.
+ *
+ * Tracked peers get their credentials fetched once with an async
+ * org.freedesktop.DBus.GetConnectionCredentials call as soon as they are
+ * tracked, so policy checks in method handlers are local lookups instead of
+ * bus daemon round-trips. Unique names are never reused by the bus, so an
+ * entry stays valid until the owner forgets the peer.
+ */
+
+class PeerCredentialCache {
+  public:
+    // ok=false if the bus daemon could not resolve the peer
+    using Callback = std::function<void(bool ok, const PeerCredentials &credentials)>;
+
+    explicit PeerCredentialCache(GDBusConnection *connection);
+    ~PeerCredentialCache();
+
+    // Non-copyable
+    PeerCredentialCache(const PeerCredentialCache &) = delete;
+    PeerCredentialCache &operator=(const PeerCredentialCache &) = delete;
+
+    // Start caching credentials for `peer` (no-op if already tracked)
+    void track(const std::string &peer);
+
+    // Drop the entry for `peer`; callers still waiting get ok=false
+    void forget(const std::string &peer);
+
+    // Cached credentials or nullptr if unknown / not yet resolved
+    const PeerCredentials *find(const std::string &peer) const;
+
+    // Resolve credentials, synchronously when cached. Untracked peers are
+    // resolved with a one-off call and not cached.
+    void lookup(const std::string &peer, Callback done);
+
+    // Add cache counters to a stats a{sv}
+    void collect_stats(GVariantBuilder *stats) const;
+
+  private:
+    struct Entry {
+        bool resolved = false;
+        bool ok = false;
+        PeerCredentials credentials;
+        std::vector<Callback> waiters;
+    };
+
+    GDBusConnection *m_connection;
+    GCancellable *m_cancellable = nullptr;
+    std::unordered_map<std::string, Entry> m_entries;
+
+    guint64 m_hits = 0;
+    guint64 m_waits = 0;
+    guint64 m_uncached = 0;
+    guint64 m_failures = 0;
+
+    void fetch(const std::string &peer, Callback done);
+};
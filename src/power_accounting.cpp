@@ -0,0 +1,287 @@
+#include "power_accounting.h"
+#include "clock.h"
+#include "loop_monitor.h"
+
+#include <utility>
+
+/**
+ * Implementation of the GPS power accounting.
+ */
+
+// Counters are saved when GPS stops, at exit (unless handed off) and this
+// often while it runs
+const guint POWER_SAVE_INTERVAL_S = 10 * 60;
+
+PowerAccounting::PowerAccounting(const std::string &store_path) : m_store_path(store_path) {
+    load();
+}
+
+PowerAccounting::~PowerAccounting() {
+    if (m_save_timer_id != 0) {
+        Clock::get().remove(m_save_timer_id);
+        m_save_timer_id = 0;
+    }
+
+    accrue();
+    if (m_saving) {
+        save();
+    }
+}
+
+void PowerAccounting::client_started(const std::string &client_path,
+                                     const std::string &app_id) {
+    accrue();
+
+    m_active[client_path] = app_id;
+    if (m_resumed.erase(client_path) == 0) {
+        ++m_totals.apps[app_id].sessions;
+    }
+
+    // A new user ends the grace period
+    m_grace_app.clear();
+}
+
+void PowerAccounting::client_stopped(const std::string &client_path) {
+    auto it = m_active.find(client_path);
+    if (it == m_active.end()) {
+        return;
+    }
+
+    accrue();
+
+    // The last client to stop starts the grace period; its app owns it
+    if (m_active.size() == 1) {
+        m_grace_app = it->second;
+    }
+
+    m_active.erase(it);
+}
+
+void PowerAccounting::gps_started() {
+    if (m_gps_on) {
+        return;
+    }
+
+    ++m_gps_starts;
+    resume_gps();
+}
+
+void PowerAccounting::resume_gps() {
+    m_gps_on = true;
+    m_accrued_until_us = Clock::get().monotonic_us();
+
+    // A crash or power loss while GPS runs costs at most one interval
+    m_save_timer_id = Clock::get().add_timeout_seconds(POWER_SAVE_INTERVAL_S,
+                                                       &PowerAccounting::on_save_timeout, this);
+}
+
+void PowerAccounting::gps_stopped() {
+    if (!m_gps_on) {
+        return;
+    }
+
+    if (m_save_timer_id != 0) {
+        Clock::get().remove(m_save_timer_id);
+        m_save_timer_id = 0;
+    }
+
+    accrue();
+    m_gps_on = false;
+    m_grace_app.clear();
+    if (m_saving) {
+        save();
+    }
+}
+
+void PowerAccounting::distribute(gint64 elapsed_us, Totals &totals) const {
+    totals.gps_on_us += elapsed_us;
+
+    if (!m_active.empty()) {
+        // The first client also gets what does not divide evenly, so that
+        // the apps add up to gps_on_us
+        gint64 share_us = elapsed_us / (gint64)m_active.size();
+        gint64 remainder_us = elapsed_us % (gint64)m_active.size();
+        for (const auto &pair : m_active) {
+            totals.apps[pair.second].gps_us += share_us + remainder_us;
+            remainder_us = 0;
+        }
+        return;
+    }
+
+    totals.grace_us += elapsed_us;
+    if (!m_grace_app.empty()) {
+        totals.apps[m_grace_app].grace_us += elapsed_us;
+    }
+}
+
+void PowerAccounting::accrue() {
+    if (!m_gps_on) {
+        return;
+    }
+
+    gint64 now = Clock::get().monotonic_us();
+    distribute(now - m_accrued_until_us, m_totals);
+    m_accrued_until_us = now;
+}
+
+/* static */ gboolean PowerAccounting::on_save_timeout(gpointer user_data) {
+    LoopMonitor::Scope timing("Timeout", "PowerSave");
+
+    auto *self = static_cast<PowerAccounting *>(user_data);
+    self->accrue();
+    if (self->m_saving) {
+        self->save();
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+void PowerAccounting::collect_stats(GVariantBuilder *stats) const {
+    Totals totals = m_totals;
+    if (m_gps_on) {
+        distribute(Clock::get().monotonic_us() - m_accrued_until_us, totals);
+    }
+
+    g_variant_builder_add(stats, "{sv}", "power.gps_on", g_variant_new_boolean(m_gps_on));
+    g_variant_builder_add(stats, "{sv}", "power.gps_on_us", g_variant_new_int64(totals.gps_on_us));
+    g_variant_builder_add(stats, "{sv}", "power.grace_us", g_variant_new_int64(totals.grace_us));
+    g_variant_builder_add(stats, "{sv}", "power.gps_starts", g_variant_new_uint64(m_gps_starts));
+
+    for (const auto &pair : totals.apps) {
+        std::string prefix = "power.app." + pair.first;
+        g_variant_builder_add(stats, "{sv}", (prefix + ".gps_us").c_str(),
+                              g_variant_new_int64(pair.second.gps_us));
+        g_variant_builder_add(stats, "{sv}", (prefix + ".grace_us").c_str(),
+                              g_variant_new_int64(pair.second.grace_us));
+        g_variant_builder_add(stats, "{sv}", (prefix + ".sessions").c_str(),
+                              g_variant_new_uint64(pair.second.sessions));
+    }
+}
+
+GVariant *PowerAccounting::save_state() const {
+    Totals totals = m_totals;
+    if (m_gps_on) {
+        distribute(Clock::get().monotonic_us() - m_accrued_until_us, totals);
+    }
+
+    GVariantBuilder apps;
+    g_variant_builder_init(&apps, G_VARIANT_TYPE("a(sxxt)"));
+    for (const auto &pair : totals.apps) {
+        g_variant_builder_add(&apps, "(sxxt)", pair.first.c_str(), pair.second.gps_us,
+                              pair.second.grace_us, pair.second.sessions);
+    }
+
+    GVariantBuilder active;
+    g_variant_builder_init(&active, G_VARIANT_TYPE("as"));
+    for (const auto &pair : m_active) {
+        g_variant_builder_add(&active, "s", pair.first.c_str());
+    }
+
+    GVariantBuilder state;
+    g_variant_builder_init(&state, G_VARIANT_TYPE_VARDICT);
+    g_variant_builder_add(&state, "{sv}", "gps-on-us", g_variant_new_int64(totals.gps_on_us));
+    g_variant_builder_add(&state, "{sv}", "grace-us", g_variant_new_int64(totals.grace_us));
+    g_variant_builder_add(&state, "{sv}", "gps-starts", g_variant_new_uint64(m_gps_starts));
+    g_variant_builder_add(&state, "{sv}", "apps", g_variant_builder_end(&apps));
+    g_variant_builder_add(&state, "{sv}", "active", g_variant_builder_end(&active));
+    g_variant_builder_add(&state, "{sv}", "grace-app", g_variant_new_string(m_grace_app.c_str()));
+    g_variant_builder_add(&state, "{sv}", "gps-on", g_variant_new_boolean(m_gps_on));
+    return g_variant_builder_end(&state);
+}
+
+void PowerAccounting::restore_state(GVariant *state) {
+    // The old instance's totals are newer than what it last saved
+    Totals totals;
+    g_variant_lookup(state, "gps-on-us", "x", &totals.gps_on_us);
+    g_variant_lookup(state, "grace-us", "x", &totals.grace_us);
+    g_variant_lookup(state, "gps-starts", "t", &m_gps_starts);
+
+    GVariantIter *iter = nullptr;
+    if (g_variant_lookup(state, "apps", "a(sxxt)", &iter)) {
+        const gchar *app_id = nullptr;
+        AppUsage usage;
+        while (g_variant_iter_next(iter, "(&sxxt)", &app_id, &usage.gps_us, &usage.grace_us,
+                                   &usage.sessions)) {
+            totals.apps[app_id] = usage;
+        }
+        g_variant_iter_free(iter);
+    }
+    m_totals = std::move(totals);
+
+    if (g_variant_lookup(state, "active", "as", &iter)) {
+        const gchar *client_path = nullptr;
+        while (g_variant_iter_next(iter, "&s", &client_path)) {
+            m_resumed.insert(client_path);
+        }
+        g_variant_iter_free(iter);
+    }
+
+    const gchar *grace_app = nullptr;
+    if (g_variant_lookup(state, "grace-app", "&s", &grace_app)) {
+        m_grace_app = grace_app;
+    }
+
+    // GPS stays on across the handoff; it is not a new start
+    gboolean gps_on = FALSE;
+    if (g_variant_lookup(state, "gps-on", "b", &gps_on) && gps_on && !m_gps_on) {
+        resume_gps();
+    }
+}
+
+void PowerAccounting::load() {
+    GKeyFile *store = g_key_file_new();
+    if (!g_key_file_load_from_file(store, m_store_path.c_str(), G_KEY_FILE_NONE, nullptr)) {
+        g_key_file_free(store);
+        return;
+    }
+
+    m_totals.gps_on_us = g_key_file_get_int64(store, "total", "gps-on-us", nullptr);
+    m_totals.grace_us = g_key_file_get_int64(store, "total", "grace-us", nullptr);
+    m_gps_starts = g_key_file_get_uint64(store, "total", "gps-starts", nullptr);
+
+    gsize n_groups = 0;
+    gchar **groups = g_key_file_get_groups(store, &n_groups);
+    for (gsize i = 0; i < n_groups; ++i) {
+        gchar *app_id = g_key_file_get_string(store, groups[i], "id", nullptr);
+        if (!app_id) {
+            continue;
+        }
+
+        AppUsage &usage = m_totals.apps[app_id];
+        usage.gps_us = g_key_file_get_int64(store, groups[i], "gps-us", nullptr);
+        usage.grace_us = g_key_file_get_int64(store, groups[i], "grace-us", nullptr);
+        usage.sessions = g_key_file_get_uint64(store, groups[i], "sessions", nullptr);
+        g_free(app_id);
+    }
+
+    g_strfreev(groups);
+    g_key_file_free(store);
+}
+
+void PowerAccounting::save() {
+    GKeyFile *store = g_key_file_new();
+    g_key_file_set_int64(store, "total", "gps-on-us", m_totals.gps_on_us);
+    g_key_file_set_int64(store, "total", "grace-us", m_totals.grace_us);
+    g_key_file_set_uint64(store, "total", "gps-starts", m_gps_starts);
+
+    guint index = 0;
+    for (const auto &pair : m_totals.apps) {
+        gchar *group = g_strdup_printf("app-%u", index++);
+        g_key_file_set_string(store, group, "id", pair.first.c_str());
+        g_key_file_set_int64(store, group, "gps-us", pair.second.gps_us);
+        g_key_file_set_int64(store, group, "grace-us", pair.second.grace_us);
+        g_key_file_set_uint64(store, group, "sessions", pair.second.sessions);
+        g_free(group);
+    }
+
+    gchar *dir = g_path_get_dirname(m_store_path.c_str());
+    g_mkdir_with_parents(dir, 0700);
+    g_free(dir);
+
+    GError *error = nullptr;
+    if (!g_key_file_save_to_file(store, m_store_path.c_str(), &error)) {
+        g_warning("PowerAccounting: failed to save %s: %s", m_store_path.c_str(), error->message);
+        g_error_free(error);
+    }
+
+    g_key_file_free(store);
+}
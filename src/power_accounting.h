@@ -0,0 +1,104 @@
+#pragma once
+
+#include <glib.h>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * GPS on-time accounting and per-application attribution.
+ *
+ * The Manager reports when the GeoClue1 backend starts and stops tracking
+ * and when clients start and stop. While clients are active, each interval
+ * of GPS on-time is split evenly across the active clients and credited to
+ * their application (DesktopId, or the peer's process name without one).
+ * The grace period after the last client stopped is credited, as grace
+ * time, to the application of that client.
+ *
+ * Totals survive restarts in a small key file in the state directory (see
+ * bridge_state_path()), saved when GPS stops and every
+ * POWER_SAVE_INTERVAL_S while it runs, and are reported as power.* entries
+ * by GetStats. An upgrade carries them in the handoff snapshot instead,
+ * together with the active clients and GPS state, so that the successor
+ * neither loses the last interval nor counts the handoff as new sessions
+ * or GPS starts.
+ */
+
+class PowerAccounting {
+  public:
+    explicit PowerAccounting(const std::string &store_path);
+    ~PowerAccounting();
+
+    // Non-copyable
+    PowerAccounting(const PowerAccounting &) = delete;
+    PowerAccounting &operator=(const PowerAccounting &) = delete;
+
+    void client_started(const std::string &client_path, const std::string &app_id);
+    void client_stopped(const std::string &client_path);
+
+    // Backend tracking state; repeated calls are ignored
+    void gps_started();
+    void gps_stopped();
+
+    // Add power.* totals and power.app.<app>.* entries, including the
+    // interval still running, to a stats a{sv}
+    void collect_stats(GVariantBuilder *stats) const;
+
+    // Handoff: totals up to now, active clients and GPS state as an a{sv},
+    // and taking them over in the successor
+    GVariant *save_state() const;
+    void restore_state(GVariant *state);
+
+    // Off once a successor took our totals, so that it alone saves them
+    void set_saving(bool saving) { m_saving = saving; }
+
+  private:
+    struct AppUsage {
+        gint64 gps_us = 0;   // share of on-time while the app had active clients
+        gint64 grace_us = 0; // share of grace periods after the app stopped last
+        guint64 sessions = 0;
+    };
+
+    struct Totals {
+        gint64 gps_on_us = 0;
+        gint64 grace_us = 0;
+        std::map<std::string, AppUsage> apps;
+    };
+
+    std::string m_store_path;
+    Totals m_totals;
+    guint64 m_gps_starts = 0;
+
+    // Application of each active client
+    std::unordered_map<std::string, std::string> m_active;
+
+    // Clients that were active before a handoff; starting again is no new
+    // session for them
+    std::unordered_set<std::string> m_resumed;
+
+    // Application of the client whose Stop() started the grace period
+    std::string m_grace_app;
+
+    bool m_gps_on = false;
+    gint64 m_accrued_until_us = 0;
+    bool m_saving = true;
+
+    // Periodic save while GPS runs
+    guint m_save_timer_id = 0;
+
+    // Credit the time since the last call to `totals`
+    void distribute(gint64 elapsed_us, Totals &totals) const;
+
+    // Credit the time up to now
+    void accrue();
+
+    // GPS runs from now on; gps_started() without counting a start
+    void resume_gps();
+
+    void load();
+    void save();
+
+    static gboolean on_save_timeout(gpointer user_data);
+};
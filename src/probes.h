@@ -0,0 +1,35 @@
+#pragma once
+
+/**
+ * USDT (SystemTap-style) static probes for production profiling.
+ *
+ * Built with -DENABLE_USDT=ON the probes become `geoclue2to1:<name>` markers,
+ * visible to bpftrace and perf (e.g. `bpftrace -l 'usdt:/usr/bin/geoclue2to1:*'`).
+ * An unattached probe is a single nop. Otherwise the macros expand to
+ * nothing and their arguments are not evaluated.
+ *
+ * A double underscore in a probe name is shown as a dash by the tools.
+ * Arguments must be integers or pointers.
+ */
+
+#ifdef HAVE_USDT
+
+#include <sys/sdt.h>
+
+#define BRIDGE_PROBE0(name) DTRACE_PROBE(geoclue2to1, name)
+#define BRIDGE_PROBE1(name, a) DTRACE_PROBE1(geoclue2to1, name, a)
+#define BRIDGE_PROBE2(name, a, b) DTRACE_PROBE2(geoclue2to1, name, a, b)
+
+#else
+
+#define BRIDGE_PROBE0(name) \
+    do {                    \
+    } while (0)
+#define BRIDGE_PROBE1(name, a) \
+    do {                       \
+    } while (0)
+#define BRIDGE_PROBE2(name, a, b) \
+    do {                          \
+    } while (0)
+
+#endif
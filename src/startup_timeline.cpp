@@ -0,0 +1,149 @@
+#include "startup_timeline.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+
+/**
+ * Implementation of the startup timeline.
+ */
+
+namespace {
+
+/**
+ * Time since the kernel started this process, from the starttime field of
+ * /proc/self/stat (clock ticks since boot). Returns -1 if unavailable.
+ */
+gint64 process_age_us() {
+    gchar *contents = nullptr;
+    if (!g_file_get_contents("/proc/self/stat", &contents, nullptr, nullptr)) {
+        return -1;
+    }
+
+    // The command name may contain spaces; fields resume after its ')'
+    const char *p = strrchr(contents, ')');
+    long long start_ticks = -1;
+    if (p) {
+        gchar **fields = g_strsplit(p + 2, " ", 0);
+        // starttime is field 22 of the file; field 3 (state) is fields[0]
+        if (g_strv_length(fields) > 19) {
+            start_ticks = g_ascii_strtoll(fields[19], nullptr, 10);
+        }
+        g_strfreev(fields);
+    }
+    g_free(contents);
+
+    struct timespec now;
+    long ticks_per_s = sysconf(_SC_CLK_TCK);
+    if (start_ticks < 0 || ticks_per_s <= 0 || clock_gettime(CLOCK_BOOTTIME, &now) != 0) {
+        return -1;
+    }
+
+    gint64 now_us = (gint64)now.tv_sec * G_USEC_PER_SEC + now.tv_nsec / 1000;
+    gint64 start_us = start_ticks * G_USEC_PER_SEC / ticks_per_s;
+    return std::max<gint64>(0, now_us - start_us);
+}
+
+} // namespace
+
+StartupTimeline::StartupTimeline()
+    : m_origin_us(g_get_monotonic_time()), m_exec_us(process_age_us()) {}
+
+void StartupTimeline::begin(const char *phase) {
+    Phase entry;
+    entry.name = phase;
+    entry.begin_us = g_get_monotonic_time() - m_origin_us;
+    m_phases.push_back(entry);
+}
+
+void StartupTimeline::end(const char *phase) {
+    for (auto &entry : m_phases) {
+        if (entry.end_us < 0 && entry.name == phase) {
+            entry.end_us = g_get_monotonic_time() - m_origin_us;
+            return;
+        }
+    }
+    g_warning("StartupTimeline: phase %s ended without being started", phase);
+}
+
+void StartupTimeline::mark_ready(const std::string &history_path) {
+    if (m_ready_us >= 0) {
+        return;
+    }
+
+    m_ready_us = g_get_monotonic_time() - m_origin_us;
+    update_history(history_path, std::max<gint64>(m_exec_us, 0) + m_ready_us);
+}
+
+void StartupTimeline::update_history(const std::string &history_path, gint64 activation_us) {
+    GKeyFile *history = g_key_file_new();
+    g_key_file_load_from_file(history, history_path.c_str(), G_KEY_FILE_NONE, nullptr);
+
+    const char *group = "activation";
+    m_activations = g_key_file_get_uint64(history, group, "count", nullptr) + 1;
+    m_activation_total_us = g_key_file_get_int64(history, group, "total-us", nullptr) +
+                            activation_us;
+    m_activation_max_us =
+        std::max(g_key_file_get_int64(history, group, "max-us", nullptr), activation_us);
+
+    g_key_file_set_uint64(history, group, "count", m_activations);
+    g_key_file_set_int64(history, group, "total-us", m_activation_total_us);
+    g_key_file_set_int64(history, group, "max-us", m_activation_max_us);
+    g_key_file_set_int64(history, group, "last-us", activation_us);
+
+    gchar *dir = g_path_get_dirname(history_path.c_str());
+    g_mkdir_with_parents(dir, 0700);
+    g_free(dir);
+
+    GError *error = nullptr;
+    if (!g_key_file_save_to_file(history, history_path.c_str(), &error)) {
+        g_warning("StartupTimeline: failed to save %s: %s", history_path.c_str(), error->message);
+        g_error_free(error);
+    }
+
+    g_key_file_free(history);
+}
+
+void StartupTimeline::log() const {
+    for (const auto &entry : m_phases) {
+        if (entry.end_us >= 0) {
+            g_message("Startup: %-16s +%6.1f ms  %6.1f ms", entry.name.c_str(),
+                      entry.begin_us / 1000.0, (entry.end_us - entry.begin_us) / 1000.0);
+        }
+    }
+    if (m_ready_us >= 0) {
+        g_message("Startup: ready after %.1f ms (%.1f ms since exec)", m_ready_us / 1000.0,
+                  (std::max<gint64>(m_exec_us, 0) + m_ready_us) / 1000.0);
+    }
+}
+
+void StartupTimeline::collect_stats(GVariantBuilder *stats) const {
+    for (const auto &entry : m_phases) {
+        if (entry.end_us < 0) {
+            continue;
+        }
+        std::string key = "startup." + entry.name + "_us";
+        g_variant_builder_add(stats, "{sv}", key.c_str(),
+                              g_variant_new_int64(entry.end_us - entry.begin_us));
+    }
+
+    if (m_exec_us >= 0) {
+        g_variant_builder_add(stats, "{sv}", "startup.exec_us", g_variant_new_int64(m_exec_us));
+    }
+
+    if (m_ready_us >= 0) {
+        g_variant_builder_add(stats, "{sv}", "startup.ready_us", g_variant_new_int64(m_ready_us));
+        g_variant_builder_add(stats, "{sv}", "startup.cold_activation_us",
+                              g_variant_new_int64(std::max<gint64>(m_exec_us, 0) + m_ready_us));
+    }
+
+    if (m_activations > 0) {
+        g_variant_builder_add(stats, "{sv}", "startup.activations",
+                              g_variant_new_uint64(m_activations));
+        g_variant_builder_add(stats, "{sv}", "startup.cold_activation_mean_us",
+                              g_variant_new_int64(m_activation_total_us / (gint64)m_activations));
+        g_variant_builder_add(stats, "{sv}", "startup.cold_activation_max_us",
+                              g_variant_new_int64(m_activation_max_us));
+    }
+}
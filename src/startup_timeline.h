@@ -0,0 +1,60 @@
+#pragma once
+
+#include <glib.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * Timeline of the daemon's startup phases.
+ *
+ * Phases are identified by name and may overlap (the session bus is connected
+ * asynchronously on the first Start(), while the loop keeps serving the system
+ * bus). Times are monotonic microseconds relative to the construction of the
+ * timeline, a static object created at process start.
+ *
+ * The cold activation time (process exec to bus name acquired) is kept in a
+ * small history file so that it can be tracked across D-Bus activations.
+ */
+
+class StartupTimeline {
+  public:
+    StartupTimeline();
+
+    // Non-copyable
+    StartupTimeline(const StartupTimeline &) = delete;
+    StartupTimeline &operator=(const StartupTimeline &) = delete;
+
+    void begin(const char *phase);
+    void end(const char *phase);
+
+    // The service answers requests under its well-known name from now on;
+    // records the cold activation time in the history at `history_path`
+    void mark_ready(const std::string &history_path);
+
+    // Log the phase durations once startup completed
+    void log() const;
+
+    // Add startup.<phase>_us durations, startup.ready_us and the cold
+    // activation history to a stats a{sv}
+    void collect_stats(GVariantBuilder *stats) const;
+
+  private:
+    struct Phase {
+        std::string name;
+        gint64 begin_us = 0;
+        gint64 end_us = -1; // -1 while running
+    };
+
+    gint64 m_origin_us;
+    gint64 m_exec_us = -1; // process exec to origin, clock tick resolution
+    gint64 m_ready_us = -1;
+    std::vector<Phase> m_phases;
+
+    // Cold activation history, including this run once ready
+    guint64 m_activations = 0;
+    gint64 m_activation_total_us = 0;
+    gint64 m_activation_max_us = 0;
+
+    void update_history(const std::string &history_path, gint64 activation_us);
+};
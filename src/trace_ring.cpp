@@ -0,0 +1,51 @@
+#include "trace_ring.h"
+
+#include <unistd.h>
+
+/**
+ * Implementation of the trace ring export.
+ */
+
+TraceEvent TraceRing::s_events[TraceRing::CAPACITY];
+std::atomic<guint32> TraceRing::s_next{0};
+
+gchar *TraceRing::dump_json() {
+    // The ring is only written from the main loop, which is running us
+    guint32 next = s_next.load(std::memory_order_acquire);
+    guint32 count = next < CAPACITY ? next : CAPACITY;
+    guint32 first = next - count;
+
+    GString *json = g_string_sized_new(64 + count * 128);
+    g_string_append(json, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+    int pid = getpid();
+    for (guint32 i = 0; i < count; ++i) {
+        const TraceEvent &event = s_events[(first + i) & (CAPACITY - 1)];
+        if (!event.name) {
+            continue;
+        }
+
+        g_string_append_printf(json,
+                               "%s{\"cat\":\"%s\",\"name\":\"%s\",\"ph\":\"%c\","
+                               "\"ts\":%" G_GINT64_FORMAT ".%03d,\"pid\":%d,\"tid\":%d",
+                               i ? "," : "", event.cat, event.name, event.phase,
+                               event.ts_ns / 1000, (int)(event.ts_ns % 1000), pid, pid);
+        if (event.phase == 'i') {
+            g_string_append(json, ",\"s\":\"t\"");
+        }
+        if (event.phase != 'E') {
+            g_string_append_printf(json, ",\"args\":{\"arg\":%u}", event.arg);
+        }
+        g_string_append_c(json, '}');
+    }
+
+    g_string_append(json, "]}\n");
+    return g_string_free(json, FALSE);
+}
+
+bool TraceRing::dump_to_file(const std::string &path, GError **error) {
+    gchar *json = dump_json();
+    bool ok = g_file_set_contents(path.c_str(), json, -1, error);
+    g_free(json);
+    return ok;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <glib.h>
+
+#include <atomic>
+#include <ctime>
+#include <string>
+
+/**
+ * Always-on binary event trace of the hot path.
+ *
+ * Each step (GeoClue1 signal, fusion, Location export, per-client emit,
+ * start/stop, GeoClue1 calls) records a 32-byte event into a fixed-size
+ * ring: one relaxed atomic increment, one clock_gettime() from the vDSO and
+ * four stores, no allocation and no locking. `cat` and `name` must be
+ * string literals. The ring is exported as Chrome/Perfetto trace JSON on
+ * SIGUSR1 or through the DumpTrace() method of the control interface.
+ */
+
+struct TraceEvent {
+    gint64 ts_ns;
+    const char *cat;
+    const char *name;
+    guint32 arg;
+    char phase; // 'B' begin, 'E' end, 'i' instant
+};
+
+class TraceRing {
+  public:
+    // Power of two, so the slot is a mask of the sequence number
+    static constexpr guint32 CAPACITY = 8192;
+
+    static void record(const char *cat, const char *name, char phase, guint32 arg) {
+        guint32 seq = s_next.fetch_add(1, std::memory_order_relaxed);
+        TraceEvent &event = s_events[seq & (CAPACITY - 1)];
+
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        event.ts_ns = (gint64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+        event.cat = cat;
+        event.name = name;
+        event.arg = arg;
+        event.phase = phase;
+    }
+
+    static void instant(const char *cat, const char *name, guint32 arg = 0) {
+        record(cat, name, 'i', arg);
+    }
+
+    // Events oldest first as {"traceEvents": [...]}; free with g_free()
+    static gchar *dump_json();
+
+    // Write dump_json() to `path`
+    static bool dump_to_file(const std::string &path, GError **error);
+
+  private:
+    static TraceEvent s_events[CAPACITY];
+    static std::atomic<guint32> s_next;
+};
+
+/**
+ * Records a begin event now and the matching end event when it goes out of
+ * scope.
+ */
+class TraceSpan {
+  public:
+    TraceSpan(const char *cat, const char *name, guint32 arg = 0) : m_cat(cat), m_name(name) {
+        TraceRing::record(m_cat, m_name, 'B', arg);
+    }
+    ~TraceSpan() { TraceRing::record(m_cat, m_name, 'E', 0); }
+
+    // Non-copyable
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+  private:
+    const char *m_cat;
+    const char *m_name;
+};
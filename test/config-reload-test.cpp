@@ -0,0 +1,141 @@
+/*
+ * Configuration reload test
+ *
+ * Runs a Manager on a private bus with a ConfigMonitor watching a
+ * configuration file and its drop-in directory in a temporary directory.
+ * Editing the files must be picked up without a restart and applied as a
+ * whole: a smaller retention depth drops Locations at once, a drop-in
+ * overrides the main file key by key, a file with an invalid value leaves
+ * the running configuration untouched, and a per-DesktopId rate cap limits
+ * what a started client receives but still delivers its latest fix.
+ *
+ * Exits with 77 (skipped) when no dbus-daemon is available.
+ */
+
+#include <gio/gio.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "bridge_config.h"
+#include "geoclue2_location.h"
+#include "geoclue2_manager.h"
+#include "test_util.h"
+
+namespace {
+
+const char *CAPPED_DESKTOP_ID = "org.example.Capped";
+
+void write_file(const std::string &path, const char *contents) {
+    g_file_set_contents(path.c_str(), contents, -1, nullptr);
+}
+
+// Wait until a reload after `generation` was applied
+bool wait_for_reload(guint64 generation) {
+    return wait_for([generation]() { return BridgeConfig::current().generation > generation; });
+}
+
+} // namespace
+
+int main() {
+    if (!have_dbus_daemon()) {
+        return EXIT_SKIP;
+    }
+
+    TestBus bus("configtest");
+    std::string config_path = bus.path("geoclue2to1.conf");
+    std::string drop_in_dir = config_path + ".d";
+    std::string small_drop_in = drop_in_dir + "/10-small.conf";
+    std::string broken_drop_in = drop_in_dir + "/20-broken.conf";
+    g_mkdir_with_parents(drop_in_dir.c_str(), 0700);
+    write_file(config_path, "[retention]\ndepth=20\n[grace]\ntimeout-ms=4000\n");
+
+    GDBusConnection *service = bus.connect();
+    GDBusConnection *peer = bus.connect();
+    const gchar *service_name = g_dbus_connection_get_unique_name(service);
+
+    bool ok = true;
+    {
+        auto manager = geoclue2_manager_register(service);
+        BridgeConfig defaults;
+        defaults.grace_timeout_ms = 9000;
+        ConfigMonitor monitor(config_path, defaults,
+                              [&manager](const BridgeConfig &) { manager->apply_config(); });
+
+        const BridgeConfig &initial = BridgeConfig::current();
+        ok &= check(initial.retention_depth == 20 && initial.grace_timeout_ms == 4000,
+                    "file read at startup overrides the defaults");
+        ok &= check(initial.velocity_fresh_steps == 2, "unset keys keep their defaults");
+
+        push_fixes(*manager, 0, 40);
+        drain_main_context();
+        ok &= check(GeoClue2Location::live() == 20, "retention follows the file");
+
+        // A drop-in overrides single keys of the main file
+        guint64 generation = BridgeConfig::current().generation;
+        write_file(small_drop_in,
+                   "[retention]\ndepth=8\npressure-depth=2\n[fusion]\nvelocity-fresh-steps=4\n");
+        ok &= check(wait_for_reload(generation), "drop-in noticed");
+        const BridgeConfig &small = BridgeConfig::current();
+        ok &= check(small.retention_depth == 8 && small.velocity_fresh_steps == 4 &&
+                        small.grace_timeout_ms == 4000,
+                    "drop-in merged over the main file");
+        ok &= check(GeoClue2Location::live() == 8, "smaller retention applied at once");
+
+        // An invalid value rejects the whole reload, including its valid keys
+        guint64 errors = 0;
+        write_file(broken_drop_in, "[grace]\ntimeout-ms=100\n[retention]\ndepth=lots\n");
+        ok &= check(wait_for([&monitor, &errors]() {
+                        GVariantBuilder builder;
+                        g_variant_builder_init(&builder, G_VARIANT_TYPE_VARDICT);
+                        monitor.collect_stats(&builder);
+                        GVariant *stats = g_variant_ref_sink(g_variant_builder_end(&builder));
+                        g_variant_lookup(stats, "config.reload_errors", "t", &errors);
+                        g_variant_unref(stats);
+                        return errors > 0;
+                    }),
+                    "invalid drop-in rejected");
+        ok &= check(BridgeConfig::current().retention_depth == 8 &&
+                        BridgeConfig::current().grace_timeout_ms == 4000,
+                    "running configuration kept after an error");
+
+        push_fixes(*manager, 0, 20);
+        drain_main_context();
+        ok &= check(GeoClue2Location::live() == 8, "retention unchanged after an error");
+
+        // Per-DesktopId rate cap: one fix per second for the capped app
+        generation = BridgeConfig::current().generation;
+        g_unlink(broken_drop_in.c_str());
+        write_file(config_path, "[retention]\ndepth=20\n[application org.example.Capped]\n"
+                                "max-rate=1\n");
+        ok &= check(wait_for_reload(generation), "edited main file noticed");
+        const BridgeConfig &capped = BridgeConfig::current();
+        ok &= check(capped.min_delivery_interval_us(CAPPED_DESKTOP_ID) == G_USEC_PER_SEC &&
+                        capped.min_delivery_interval_us("org.example.Other") == 0,
+                    "rate cap only for its DesktopId");
+        ok &= check(capped.grace_timeout_ms == 9000, "removed key falls back to the default");
+
+        ok &= check(!start_client(peer, service_name, CAPPED_DESKTOP_ID).empty(),
+                    "capped client started");
+        guint64 sent = stat_u64(*manager, "delivery.sent_updates");
+        push_fixes(*manager, 0, 10);
+        drain_main_context();
+        ok &= check(stat_u64(*manager, "delivery.sent_updates") - sent == 1 &&
+                        stat_u64(*manager, "delivery.rate_capped_updates") == 9,
+                    "burst above the rate cap delivered once");
+        ok &= check(wait_for([&]() {
+                        return stat_u64(*manager, "delivery.sent_updates") - sent == 2;
+                    }),
+                    "latest capped fix delivered once the cap passed");
+    }
+
+    ok &= check(BridgeConfig::current().generation == 0, "defaults back without a monitor");
+
+    g_object_unref(peer);
+    g_object_unref(service);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
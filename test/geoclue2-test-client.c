@@ -3,6 +3,15 @@
  *
  * Demonstrates basic usage of the GeoClue2 D-Bus API.
  * Similar in functionality to geoclue2's where-am-i demo.
+ *
+ * With --clients N it turns into a load generator instead: N clients spread
+ * over a few shared bus connections, each reading every new Location with
+ * an asynchronous GetAll. After --duration seconds it reports the latency
+ * from each fix to its receipt, the update rate per client and missed or
+ * stale Location paths, as text or with --json as JSON. The latency comes
+ * from the Location's Timestamp, which GeoClue1 gives in whole seconds, or
+ * with --emit-time-in-altitude from the emit time bench's geoclue1-standin
+ * carries in the Altitude field, in microseconds.
  */
 
 #include <gio/gio.h>
@@ -11,6 +20,16 @@
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#define GEOCLUE2_BUS_NAME "org.freedesktop.GeoClue2"
+#define GEOCLUE2_MANAGER_PATH "/org/freedesktop/GeoClue2/Manager"
+#define GEOCLUE2_CLIENT_INTERFACE "org.freedesktop.GeoClue2.Client"
+#define GEOCLUE2_LOCATION_INTERFACE "org.freedesktop.GeoClue2.Location"
+#define DBUS_PROPERTIES_INTERFACE "org.freedesktop.DBus.Properties"
+
+// Default per-peer client limit of the bridge (--max-clients-per-peer)
+#define CLIENTS_PER_CONNECTION 16
 
 static GMainLoop *loop = NULL;
 static GDBusProxy *manager_proxy = NULL;
@@ -27,14 +46,10 @@ static gboolean on_signal(gpointer user_data) {
     return G_SOURCE_REMOVE;
 }
 
-// Helper to get a double property from a proxy
-static gdouble get_double_property(GDBusProxy *proxy, const gchar *property) {
-    GVariant *variant = g_dbus_proxy_get_cached_property(proxy, property);
-    if (!variant)
-        return 0.0;
-
-    gdouble value = g_variant_get_double(variant);
-    g_variant_unref(variant);
+// Helper to get a double from a GetAll dictionary
+static gdouble lookup_double(GVariant *properties, const gchar *property) {
+    gdouble value = 0.0;
+    g_variant_lookup(properties, property, "d", &value);
     return value;
 }
 
@@ -49,45 +64,31 @@ static gchar *get_string_property(GDBusProxy *proxy, const gchar *property) {
     return value;
 }
 
-// Print location information
-static void print_location(const gchar *location_path) {
+// Print location information from its GetAll reply
+static void on_location_properties(GObject *source, GAsyncResult *res, gpointer user_data) {
+    gchar *location_path = user_data;
     GError *error = NULL;
-    GDBusProxy *location_proxy;
     gdouble lat, lon, accuracy, altitude, speed, heading;
-    GVariant *timestamp_variant;
-    guint64 timestamp_sec, timestamp_usec;
+    guint64 timestamp_sec = 0, timestamp_usec = 0;
 
-    if (g_strcmp0(location_path, "/") == 0) {
-        g_print("Location: (none)\n");
-        return;
-    }
-
-    location_proxy = g_dbus_proxy_new_for_bus_sync(
-        G_BUS_TYPE_SYSTEM, G_DBUS_PROXY_FLAGS_NONE, NULL, "org.freedesktop.GeoClue2", location_path,
-        "org.freedesktop.GeoClue2.Location", NULL, &error);
-
-    if (!location_proxy) {
-        g_printerr("Failed to create Location proxy: %s\n", error->message);
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+    if (!result) {
+        g_printerr("Failed to read Location %s: %s\n", location_path, error->message);
         g_error_free(error);
+        g_free(location_path);
         return;
     }
 
+    GVariant *properties = g_variant_get_child_value(result, 0);
+
     // Get all properties
-    lat = get_double_property(location_proxy, "Latitude");
-    lon = get_double_property(location_proxy, "Longitude");
-    accuracy = get_double_property(location_proxy, "Accuracy");
-    altitude = get_double_property(location_proxy, "Altitude");
-    speed = get_double_property(location_proxy, "Speed");
-    heading = get_double_property(location_proxy, "Heading");
-
-    timestamp_variant = g_dbus_proxy_get_cached_property(location_proxy, "Timestamp");
-    if (timestamp_variant) {
-        g_variant_get(timestamp_variant, "(tt)", &timestamp_sec, &timestamp_usec);
-        g_variant_unref(timestamp_variant);
-    } else {
-        timestamp_sec = 0;
-        timestamp_usec = 0;
-    }
+    lat = lookup_double(properties, "Latitude");
+    lon = lookup_double(properties, "Longitude");
+    accuracy = lookup_double(properties, "Accuracy");
+    altitude = lookup_double(properties, "Altitude");
+    speed = lookup_double(properties, "Speed");
+    heading = lookup_double(properties, "Heading");
+    g_variant_lookup(properties, "Timestamp", "(tt)", &timestamp_sec, &timestamp_usec);
 
     // Print location data
     g_print("\n=== Location Update ===\n");
@@ -119,7 +120,23 @@ static void print_location(const gchar *location_path) {
         g_date_time_unref(dt);
     }
 
-    g_object_unref(location_proxy);
+    g_variant_unref(properties);
+    g_variant_unref(result);
+    g_free(location_path);
+}
+
+// Read a Location with one asynchronous GetAll; printed when it arrives
+static void print_location(const gchar *location_path) {
+    if (g_strcmp0(location_path, "/") == 0) {
+        g_print("Location: (none)\n");
+        return;
+    }
+
+    g_dbus_connection_call(g_dbus_proxy_get_connection(client_proxy), GEOCLUE2_BUS_NAME,
+                           location_path, DBUS_PROPERTIES_INTERFACE, "GetAll",
+                           g_variant_new("(s)", GEOCLUE2_LOCATION_INTERFACE),
+                           G_VARIANT_TYPE("(a{sv})"), G_DBUS_CALL_FLAGS_NONE, -1, NULL,
+                           on_location_properties, g_strdup(location_path));
 }
 
 // LocationUpdated signal handler
@@ -134,22 +151,494 @@ static void on_location_updated(GDBusProxy *proxy, gchar *sender_name, gchar *si
     print_location(new_path);
 }
 
+/* Load generator (--clients) */
+
+typedef struct {
+    GDBusConnection *connection;
+    gchar *path;
+    guint64 updates;
+    guint64 last_location_id;
+    guint64 missed;
+    guint64 stale;
+    guint64 errors;
+} LoadClient;
+
+typedef struct {
+    GDBusConnection *connection;
+    guint subscription;
+    GHashTable *clients; // client path -> LoadClient (not owned)
+} LoadConnection;
+
+typedef struct {
+    GPtrArray *clients;     // LoadClient, owned
+    GPtrArray *connections; // LoadConnection, owned
+    const gchar *desktop_id;
+    guint pending_setup;
+    guint failed_setup;
+    gchar *first_setup_error;
+    gboolean emit_time_in_altitude; // else the latency comes from the Timestamp
+    GArray *latencies_us;           // fix -> LocationUpdated receipt
+    GArray *fetch_us;     // LocationUpdated receipt -> GetAll reply
+    gint64 started_us;
+    gint64 stopped_us;
+    gboolean running;
+} LoadState;
+
+typedef struct {
+    LoadState *state;
+    LoadClient *client;
+    gint64 received_realtime_us;
+    gint64 received_us;
+} LoadFetch;
+
+static LoadState load;
+
+static guint64 location_id_of(const gchar *path) {
+    const gchar *slash = strrchr(path, '/');
+    return slash ? g_ascii_strtoull(slash + 1, NULL, 10) : 0;
+}
+
+static void on_load_location_fetched(GObject *source, GAsyncResult *res, gpointer user_data) {
+    LoadFetch *fetch = user_data;
+    GError *error = NULL;
+
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+    if (!result) {
+        // The Location left the bridge's retention window before we read it
+        if (g_error_matches(error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_METHOD) ||
+            g_error_matches(error, G_DBUS_ERROR, G_DBUS_ERROR_UNKNOWN_OBJECT)) {
+            fetch->client->stale++;
+        } else {
+            fetch->client->errors++;
+        }
+        g_error_free(error);
+        g_free(fetch);
+        return;
+    }
+
+    if (fetch->state->running) {
+        gint64 fetch_us = g_get_monotonic_time() - fetch->received_us;
+        g_array_append_val(fetch->state->fetch_us, fetch_us);
+
+        guint64 timestamp_sec = 0, timestamp_usec = 0;
+        gdouble emit_us = 0.0;
+        GVariant *properties = g_variant_get_child_value(result, 0);
+        if (fetch->state->emit_time_in_altitude) {
+            // The stand-in's CLOCK_MONOTONIC at emit, the clock of received_us
+            if (g_variant_lookup(properties, "Altitude", "d", &emit_us) && emit_us > 0.0) {
+                gint64 latency_us = fetch->received_us - (gint64)emit_us;
+                g_array_append_val(fetch->state->latencies_us, latency_us);
+            }
+        } else if (g_variant_lookup(properties, "Timestamp", "(tt)", &timestamp_sec,
+                                    &timestamp_usec) &&
+                   timestamp_sec > 0) {
+            gint64 latency_us = fetch->received_realtime_us -
+                                ((gint64)timestamp_sec * G_USEC_PER_SEC + (gint64)timestamp_usec);
+            g_array_append_val(fetch->state->latencies_us, latency_us);
+        }
+        g_variant_unref(properties);
+    }
+
+    g_variant_unref(result);
+    g_free(fetch);
+}
+
+static void on_load_location_updated(GDBusConnection *connection, const gchar *sender_name,
+                                     const gchar *object_path, const gchar *interface_name,
+                                     const gchar *signal_name, GVariant *parameters,
+                                     gpointer user_data) {
+    LoadConnection *load_connection = user_data;
+    LoadClient *client = g_hash_table_lookup(load_connection->clients, object_path);
+    const gchar *old_path, *new_path;
+
+    if (!client || !load.running)
+        return;
+
+    g_variant_get(parameters, "(&o&o)", &old_path, &new_path);
+
+    // Location ids grow by one per fix; a gap means this client skipped fixes
+    guint64 location_id = location_id_of(new_path);
+    if (client->last_location_id > 0 && location_id > client->last_location_id + 1) {
+        client->missed += location_id - client->last_location_id - 1;
+    }
+    if (location_id > client->last_location_id) {
+        client->last_location_id = location_id;
+    }
+    client->updates++;
+
+    LoadFetch *fetch = g_new0(LoadFetch, 1);
+    fetch->state = &load;
+    fetch->client = client;
+    fetch->received_realtime_us = g_get_real_time();
+    fetch->received_us = g_get_monotonic_time();
+    g_dbus_connection_call(connection, GEOCLUE2_BUS_NAME, new_path, DBUS_PROPERTIES_INTERFACE,
+                           "GetAll", g_variant_new("(s)", GEOCLUE2_LOCATION_INTERFACE),
+                           G_VARIANT_TYPE("(a{sv})"), G_DBUS_CALL_FLAGS_NONE, -1, NULL,
+                           on_load_location_fetched, fetch);
+}
+
+static void load_setup_failed(GError *error) {
+    load.failed_setup++;
+    if (!load.first_setup_error)
+        load.first_setup_error = g_strdup(error->message);
+    g_error_free(error);
+    load.pending_setup--;
+}
+
+static void on_load_client_started(GObject *source, GAsyncResult *res, gpointer user_data) {
+    GError *error = NULL;
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+    if (!result) {
+        load_setup_failed(error);
+        return;
+    }
+    g_variant_unref(result);
+    load.pending_setup--;
+}
+
+static void on_load_client_created(GObject *source, GAsyncResult *res, gpointer user_data) {
+    LoadClient *client = user_data;
+    GError *error = NULL;
+
+    GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &error);
+    if (!result) {
+        load_setup_failed(error);
+        return;
+    }
+    g_variant_get(result, "(o)", &client->path);
+    g_variant_unref(result);
+
+    for (guint i = 0; i < load.connections->len; i++) {
+        LoadConnection *load_connection = g_ptr_array_index(load.connections, i);
+        if (load_connection->connection == client->connection) {
+            g_hash_table_insert(load_connection->clients, client->path, client);
+        }
+    }
+
+    // Messages on one connection arrive in order, so Start sees the DesktopId
+    g_dbus_connection_call(client->connection, GEOCLUE2_BUS_NAME, client->path,
+                           DBUS_PROPERTIES_INTERFACE, "Set",
+                           g_variant_new("(ssv)", GEOCLUE2_CLIENT_INTERFACE, "DesktopId",
+                                         g_variant_new_string(load.desktop_id)),
+                           NULL, G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL, NULL);
+    g_dbus_connection_call(client->connection, GEOCLUE2_BUS_NAME, client->path,
+                           GEOCLUE2_CLIENT_INTERFACE, "Start", NULL, NULL,
+                           G_DBUS_CALL_FLAGS_NONE, -1, NULL, on_load_client_started, client);
+}
+
+static gboolean on_load_duration_elapsed(gpointer user_data) {
+    g_main_loop_quit(loop);
+    return G_SOURCE_REMOVE;
+}
+
+static gint compare_int64(gconstpointer a, gconstpointer b) {
+    gint64 x = *(const gint64 *)a, y = *(const gint64 *)b;
+    return x < y ? -1 : x > y;
+}
+
+// Nearest-rank percentile of a sorted array
+static gint64 percentile(GArray *sorted, double fraction) {
+    if (sorted->len == 0)
+        return 0;
+    guint rank = (guint)(fraction * sorted->len + 0.999999);
+    rank = CLAMP(rank, 1, sorted->len);
+    return g_array_index(sorted, gint64, rank - 1);
+}
+
+static void append_distribution(GString *out, gboolean json, const gchar *name, GArray *samples) {
+    g_array_sort(samples, compare_int64);
+    double mean = 0.0;
+    for (guint i = 0; i < samples->len; i++)
+        mean += g_array_index(samples, gint64, i);
+    mean = samples->len ? mean / samples->len : 0.0;
+
+    gint64 max = samples->len ? g_array_index(samples, gint64, samples->len - 1) : 0;
+    if (json) {
+        g_string_append_printf(out,
+                               "\"%s\":{\"count\":%u,\"mean_us\":%.1f,\"p50_us\":%" G_GINT64_FORMAT
+                               ",\"p95_us\":%" G_GINT64_FORMAT ",\"p99_us\":%" G_GINT64_FORMAT
+                               ",\"max_us\":%" G_GINT64_FORMAT "}",
+                               name, samples->len, mean, percentile(samples, 0.50),
+                               percentile(samples, 0.95), percentile(samples, 0.99), max);
+    } else {
+        g_string_append_printf(out,
+                               "%-22s n=%-8u mean %9.2f  p50 %9.2f  p95 %9.2f  p99 %9.2f  "
+                               "max %9.2f ms\n",
+                               name, samples->len, mean / 1000.0,
+                               percentile(samples, 0.50) / 1000.0,
+                               percentile(samples, 0.95) / 1000.0,
+                               percentile(samples, 0.99) / 1000.0, max / 1000.0);
+    }
+}
+
+static void print_load_report(gboolean json, guint connections) {
+    double seconds = (load.stopped_us - load.started_us) / (double)G_USEC_PER_SEC;
+    guint64 updates = 0, missed = 0, stale = 0, errors = 0;
+    double rate_min = 0.0, rate_max = 0.0;
+    guint started = 0;
+
+    for (guint i = 0; i < load.clients->len; i++) {
+        LoadClient *client = g_ptr_array_index(load.clients, i);
+        if (!client->path)
+            continue;
+
+        double rate = seconds > 0.0 ? client->updates / seconds : 0.0;
+        rate_min = started == 0 ? rate : MIN(rate_min, rate);
+        rate_max = MAX(rate_max, rate);
+        started++;
+
+        updates += client->updates;
+        missed += client->missed;
+        stale += client->stale;
+        errors += client->errors;
+    }
+    double rate_mean = started && seconds > 0.0 ? updates / seconds / started : 0.0;
+
+    GString *out = g_string_new(NULL);
+    if (json) {
+        g_string_append_printf(out,
+                               "{\"clients\":%u,\"started\":%u,\"connections\":%u,"
+                               "\"duration_s\":%.3f,\"updates\":%" G_GUINT64_FORMAT
+                               ",\"update_rate_hz\":{\"min\":%.3f,\"mean\":%.3f,\"max\":%.3f},"
+                               "\"missed\":%" G_GUINT64_FORMAT ",\"stale\":%" G_GUINT64_FORMAT
+                               ",\"errors\":%" G_GUINT64_FORMAT ",\"latency_source\":\"%s\",",
+                               load.clients->len, started, connections, seconds, updates,
+                               rate_min, rate_mean, rate_max, missed, stale, errors,
+                               load.emit_time_in_altitude ? "emit_time" : "timestamp_1s");
+        append_distribution(out, TRUE, "latency", load.latencies_us);
+        g_string_append_c(out, ',');
+        append_distribution(out, TRUE, "fetch", load.fetch_us);
+        g_string_append(out, "}\n");
+    } else {
+        g_string_append_printf(out,
+                               "\n%u of %u clients on %u connections, %.1f s\n"
+                               "Updates:               %" G_GUINT64_FORMAT
+                               " (per client %.2f min, %.2f mean, %.2f max Hz)\n"
+                               "Missed fixes:          %" G_GUINT64_FORMAT "\n"
+                               "Stale Location paths:  %" G_GUINT64_FORMAT "\n"
+                               "Other read errors:     %" G_GUINT64_FORMAT "\n",
+                               started, load.clients->len, connections, seconds, updates,
+                               rate_min, rate_mean, rate_max, missed, stale, errors);
+        if (load.emit_time_in_altitude) {
+            append_distribution(out, FALSE, "Emit -> receipt", load.latencies_us);
+        } else {
+            append_distribution(out, FALSE, "Timestamp -> receipt", load.latencies_us);
+            g_string_append(out, "  (Timestamp has 1 s resolution; see --emit-time-in-altitude)\n");
+        }
+        append_distribution(out, FALSE, "Receipt -> GetAll", load.fetch_us);
+    }
+
+    fputs(out->str, stdout);
+    g_string_free(out, TRUE);
+}
+
+static void load_client_free(gpointer data) {
+    LoadClient *client = data;
+    g_free(client->path);
+    g_free(client);
+}
+
+static void load_connection_free(gpointer data) {
+    LoadConnection *load_connection = data;
+    g_dbus_connection_signal_unsubscribe(load_connection->connection,
+                                         load_connection->subscription);
+    g_hash_table_unref(load_connection->clients);
+    g_dbus_connection_close_sync(load_connection->connection, NULL, NULL);
+    g_object_unref(load_connection->connection);
+    g_free(load_connection);
+}
+
+static int run_load(gint clients, gint duration_s, gint connections, gboolean json,
+                    const gchar *desktop_id, gboolean emit_time_in_altitude) {
+    GError *error = NULL;
+
+    if (connections <= 0)
+        connections = (clients + CLIENTS_PER_CONNECTION - 1) / CLIENTS_PER_CONNECTION;
+    connections = CLAMP(connections, 1, clients);
+
+    gchar *address = g_dbus_address_get_for_bus_sync(G_BUS_TYPE_SYSTEM, NULL, &error);
+    if (!address) {
+        g_printerr("Cannot find the system bus: %s\n", error->message);
+        g_error_free(error);
+        return 1;
+    }
+
+    load.clients = g_ptr_array_new_with_free_func(load_client_free);
+    load.connections = g_ptr_array_new_with_free_func(load_connection_free);
+    load.desktop_id = desktop_id;
+    load.emit_time_in_altitude = emit_time_in_altitude;
+    load.latencies_us = g_array_new(FALSE, FALSE, sizeof(gint64));
+    load.fetch_us = g_array_new(FALSE, FALSE, sizeof(gint64));
+
+    // Each connection is one peer to the bridge
+    gchar *bridge_name = NULL;
+    for (gint i = 0; i < connections; i++) {
+        GDBusConnection *connection = g_dbus_connection_new_for_address_sync(
+            address,
+            G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT |
+                G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION,
+            NULL, NULL, &error);
+        if (!connection) {
+            g_printerr("Cannot connect to the system bus: %s\n", error->message);
+            g_error_free(error);
+            g_free(address);
+            return 1;
+        }
+
+        // Signals carry the bridge's unique name as sender
+        if (!bridge_name) {
+            GVariant *owner = g_dbus_connection_call_sync(
+                connection, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+                "org.freedesktop.DBus", "GetNameOwner", g_variant_new("(s)", GEOCLUE2_BUS_NAME),
+                G_VARIANT_TYPE("(s)"), G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL);
+            if (!owner) {
+                // Activate the bridge, then ask again
+                GVariant *activated = g_dbus_connection_call_sync(
+                    connection, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+                    "org.freedesktop.DBus", "StartServiceByName",
+                    g_variant_new("(su)", GEOCLUE2_BUS_NAME, 0), NULL, G_DBUS_CALL_FLAGS_NONE,
+                    -1, NULL, &error);
+                if (!activated) {
+                    g_printerr("Cannot start %s: %s\n", GEOCLUE2_BUS_NAME, error->message);
+                    g_error_free(error);
+                    g_object_unref(connection);
+                    g_free(address);
+                    return 1;
+                }
+                g_variant_unref(activated);
+                owner = g_dbus_connection_call_sync(
+                    connection, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+                    "org.freedesktop.DBus", "GetNameOwner",
+                    g_variant_new("(s)", GEOCLUE2_BUS_NAME), G_VARIANT_TYPE("(s)"),
+                    G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL);
+            }
+            if (!owner) {
+                g_printerr("%s has no owner\n", GEOCLUE2_BUS_NAME);
+                g_object_unref(connection);
+                g_free(address);
+                return 1;
+            }
+            g_variant_get(owner, "(s)", &bridge_name);
+            g_variant_unref(owner);
+        }
+
+        LoadConnection *load_connection = g_new0(LoadConnection, 1);
+        load_connection->connection = connection;
+        load_connection->clients = g_hash_table_new(g_str_hash, g_str_equal);
+        load_connection->subscription = g_dbus_connection_signal_subscribe(
+            connection, bridge_name, GEOCLUE2_CLIENT_INTERFACE, "LocationUpdated", NULL, NULL,
+            G_DBUS_SIGNAL_FLAGS_NONE, on_load_location_updated, load_connection, NULL);
+        g_ptr_array_add(load.connections, load_connection);
+    }
+    g_free(address);
+    g_free(bridge_name);
+
+    // CreateClient, not GetClient: GetClient hands a peer the same client
+    for (gint i = 0; i < clients; i++) {
+        LoadClient *client = g_new0(LoadClient, 1);
+        LoadConnection *load_connection = g_ptr_array_index(load.connections, i % connections);
+        client->connection = load_connection->connection;
+        g_ptr_array_add(load.clients, client);
+
+        load.pending_setup++;
+        g_dbus_connection_call(client->connection, GEOCLUE2_BUS_NAME, GEOCLUE2_MANAGER_PATH,
+                               "org.freedesktop.GeoClue2.Manager", "CreateClient", NULL,
+                               G_VARIANT_TYPE("(o)"), G_DBUS_CALL_FLAGS_NONE, -1, NULL,
+                               on_load_client_created, client);
+    }
+
+    while (load.pending_setup > 0)
+        g_main_context_iteration(NULL, TRUE);
+
+    if (load.failed_setup > 0) {
+        g_printerr("%u of %d clients failed to start: %s\n", load.failed_setup, clients,
+                   load.first_setup_error);
+        g_printerr("(the bridge limits clients per peer; try more --connections)\n");
+    }
+    if (load.failed_setup == (guint)clients) {
+        return 1;
+    }
+
+    if (!json)
+        g_print("Running %d clients on %d connections for %d s...\n", clients, connections,
+                duration_s);
+
+    loop = g_main_loop_new(NULL, FALSE);
+    g_timeout_add_seconds(duration_s, on_load_duration_elapsed, NULL);
+    load.running = TRUE;
+    load.started_us = g_get_monotonic_time();
+    g_main_loop_run(loop);
+    load.stopped_us = g_get_monotonic_time();
+    load.running = FALSE;
+
+    print_load_report(json, connections);
+
+    // Closing the connections makes the bridge drop their clients
+    g_ptr_array_unref(load.connections);
+    g_ptr_array_unref(load.clients);
+    g_array_unref(load.latencies_us);
+    g_array_unref(load.fetch_us);
+    g_free(load.first_setup_error);
+    g_main_loop_unref(loop);
+    return 0;
+}
+
 int main(int argc, char *argv[]) {
     GError *error = NULL;
     GVariant *result;
+    gint clients = 0;
+    gint duration_s = 60;
+    gint connections = 0;
+    gboolean json = FALSE;
+    gboolean emit_time_in_altitude = FALSE;
+    gchar *desktop_id = NULL;
+
+    GOptionEntry entries[] = {
+        {"clients", 0, 0, G_OPTION_ARG_INT, &clients,
+         "Load mode: run N clients instead of printing one client's updates", "N"},
+        {"duration", 0, 0, G_OPTION_ARG_INT, &duration_s, "Load mode: seconds to run (default 60)",
+         "S"},
+        {"connections", 0, 0, G_OPTION_ARG_INT, &connections,
+         "Load mode: bus connections to share (default: one per 16 clients)", "M"},
+        {"json", 0, 0, G_OPTION_ARG_NONE, &json, "Load mode: print the report as JSON", NULL},
+        {"emit-time-in-altitude", 0, 0, G_OPTION_ARG_NONE, &emit_time_in_altitude,
+         "Load mode: take the latency from the emit time bench's geoclue1-standin puts in "
+         "Altitude (microseconds) instead of the 1 s Timestamp",
+         NULL},
+        {"desktop-id", 0, 0, G_OPTION_ARG_STRING, &desktop_id,
+         "DesktopId to set (default geoclue2-test-client)", "ID"},
+        {NULL, 0, 0, G_OPTION_ARG_NONE, NULL, NULL, NULL}};
+
+    GOptionContext *context = g_option_context_new("- GeoClue2 test client and load generator");
+    g_option_context_add_main_entries(context, entries, NULL);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("Option parsing failed: %s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(context);
+        return 1;
+    }
+    g_option_context_free(context);
 
     // Setup signal handlers
     g_unix_signal_add(SIGINT, on_signal, GINT_TO_POINTER(SIGINT));
     g_unix_signal_add(SIGTERM, on_signal, GINT_TO_POINTER(SIGTERM));
 
+    if (clients > 0) {
+        int status = run_load(clients, MAX(duration_s, 1), connections, json,
+                              desktop_id ? desktop_id : "geoclue2-test-client",
+                              emit_time_in_altitude);
+        g_free(desktop_id);
+        return status;
+    }
+
     g_print("GeoClue2 Test Client\n");
     g_print("====================\n\n");
 
     // Connect to Manager
     g_print("Connecting to GeoClue2 Manager...\n");
     manager_proxy = g_dbus_proxy_new_for_bus_sync(
-        G_BUS_TYPE_SYSTEM, G_DBUS_PROXY_FLAGS_NONE, NULL, "org.freedesktop.GeoClue2",
-        "/org/freedesktop/GeoClue2/Manager", "org.freedesktop.GeoClue2.Manager", NULL, &error);
+        G_BUS_TYPE_SYSTEM, G_DBUS_PROXY_FLAGS_NONE, NULL, GEOCLUE2_BUS_NAME,
+        GEOCLUE2_MANAGER_PATH, "org.freedesktop.GeoClue2.Manager", NULL, &error);
 
     if (!manager_proxy) {
         g_printerr("Failed to connect to Manager: %s\n", error->message);
@@ -175,8 +664,8 @@ int main(int argc, char *argv[]) {
 
     // Create Client proxy
     client_proxy = g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SYSTEM, G_DBUS_PROXY_FLAGS_NONE, NULL,
-                                                 "org.freedesktop.GeoClue2", client_path,
-                                                 "org.freedesktop.GeoClue2.Client", NULL, &error);
+                                                 GEOCLUE2_BUS_NAME, client_path,
+                                                 GEOCLUE2_CLIENT_INTERFACE, NULL, &error);
 
     if (!client_proxy) {
         g_printerr("Failed to create Client proxy: %s\n", error->message);
@@ -187,8 +676,9 @@ int main(int argc, char *argv[]) {
     // Set DesktopId property
     g_print("Setting DesktopId...\n");
     g_dbus_proxy_call_sync(client_proxy, "org.freedesktop.DBus.Properties.Set",
-                           g_variant_new("(ssv)", "org.freedesktop.GeoClue2.Client", "DesktopId",
-                                         g_variant_new_string("geoclue2-test-client")),
+                           g_variant_new("(ssv)", GEOCLUE2_CLIENT_INTERFACE, "DesktopId",
+                                         g_variant_new_string(desktop_id ? desktop_id
+                                                                         : "geoclue2-test-client")),
                            G_DBUS_CALL_FLAGS_NONE, -1, NULL, NULL);
 
     // Subscribe to LocationUpdated signal
@@ -237,9 +727,10 @@ int main(int argc, char *argv[]) {
     if (manager_proxy)
         g_object_unref(manager_proxy);
     g_free(client_path);
+    g_free(desktop_id);
     g_main_loop_unref(loop);
 
     g_print("Test client exited cleanly.\n");
 
     return 0;
-}
\ No newline at end of file
+}
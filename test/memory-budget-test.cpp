@@ -0,0 +1,302 @@
+/*
+ * Memory budget test
+ *
+ * Runs a Manager on a private bus, starts N clients spread over a few peer
+ * connections and pushes M fixes through handle_position_update(). Every
+ * client reads each Location it is sent, so fixes go out through the
+ * regular send path rather than the slow-client one. Fails if Client or
+ * Location objects leak, if retention is not bounded, if the process
+ * grows beyond the budgets below once warmed up, or if a fix costs more
+ * allocations late in the run than early on.
+ *
+ * Exits with 77 (skipped) when no dbus-daemon is available.
+ */
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dbus_interfaces.h"
+#include "geoclue1_backend.h"
+#include "geoclue2_client.h"
+#include "geoclue2_location.h"
+#include "geoclue2_manager.h"
+#include "memory_stats.h"
+#include "test_util.h"
+
+namespace {
+
+// Peer connections the clients are spread over
+const int PEERS = 4;
+
+// Locations the Manager retains for slow readers
+const guint64 MAX_RETAINED_LOCATIONS = 25;
+
+// Budgets, measured from the end of the warm-up (first tenth of the fixes)
+const gint64 RSS_GROWTH_BUDGET_BYTES = 2 * 1024 * 1024;
+const gint64 HEAP_GROWTH_BUDGET_BYTES = 256 * 1024;
+
+// Main-thread allocations per fix and client (the stamped PropertiesChanged
+// and LocationUpdated copies, and serving the client's GetAll of the new
+// Location; GDBus's worker thread is not counted) are reported, not held to
+// a fixed number, which no run has calibrated. The second half of the run
+// may cost at most this much more per fix than the first.
+const double ALLOCATION_DRIFT_TOLERANCE = 0.05;
+
+gint64 heap_live_bytes() { return allocation_counters().live_bytes; }
+
+/**
+ * The peers' side of the clients: every LocationUpdated is answered with a
+ * GetAll of the new Location, as a GeoClue2 client library does. Runs on a
+ * thread and main context of its own, so the allocations counted on the
+ * main thread are the Manager's.
+ */
+class Readers {
+  public:
+    Readers(const std::vector<GDBusConnection *> &peers, const char *service)
+        : m_peers(peers), m_context(g_main_context_new()),
+          m_loop(g_main_loop_new(m_context, FALSE)) {
+        // Signals are dispatched to the context that was the thread default
+        // when subscribing
+        g_main_context_push_thread_default(m_context);
+        for (GDBusConnection *peer : m_peers) {
+            m_subscriptions.push_back(g_dbus_connection_signal_subscribe(
+                peer, service, GEOCLUE2_CLIENT_INTERFACE, "LocationUpdated", nullptr, nullptr,
+                G_DBUS_SIGNAL_FLAGS_NONE, &Readers::on_location_updated, this, nullptr));
+        }
+        g_main_context_pop_thread_default(m_context);
+
+        m_thread = g_thread_new("readers", &Readers::run, this);
+    }
+
+    ~Readers() {
+        // An idle source rather than g_main_context_invoke(), which would run
+        // the quit here if the thread has not acquired the context yet
+        GSource *quit = g_idle_source_new();
+        g_source_set_callback(
+            quit,
+            [](gpointer loop) -> gboolean {
+                g_main_loop_quit(static_cast<GMainLoop *>(loop));
+                return G_SOURCE_REMOVE;
+            },
+            m_loop, nullptr);
+        g_source_attach(quit, m_context);
+        g_source_unref(quit);
+        g_thread_join(m_thread);
+
+        for (size_t i = 0; i < m_peers.size(); ++i) {
+            g_dbus_connection_signal_unsubscribe(m_peers[i], m_subscriptions[i]);
+        }
+        g_main_loop_unref(m_loop);
+        g_main_context_unref(m_context);
+    }
+
+    // Non-copyable
+    Readers(const Readers &) = delete;
+    Readers &operator=(const Readers &) = delete;
+
+    guint64 reads() const { return m_reads.load(); }
+    guint64 failed_reads() const { return m_failed_reads.load(); }
+
+  private:
+    static gpointer run(gpointer data) {
+        auto *self = static_cast<Readers *>(data);
+        g_main_context_push_thread_default(self->m_context);
+        g_main_loop_run(self->m_loop);
+        g_main_context_pop_thread_default(self->m_context);
+        return nullptr;
+    }
+
+    static void on_location_updated(GDBusConnection *connection, const gchar *sender,
+                                    const gchar * /*object_path*/,
+                                    const gchar * /*interface_name*/,
+                                    const gchar * /*signal_name*/, GVariant *parameters,
+                                    gpointer user_data) {
+        const gchar *old_path = nullptr;
+        const gchar *new_path = nullptr;
+        g_variant_get(parameters, "(&o&o)", &old_path, &new_path);
+
+        g_dbus_connection_call(connection, sender, new_path, "org.freedesktop.DBus.Properties",
+                               "GetAll", g_variant_new("(s)", GEOCLUE2_LOCATION_INTERFACE),
+                               nullptr, G_DBUS_CALL_FLAGS_NONE, -1, nullptr,
+                               &Readers::on_read, user_data);
+    }
+
+    static void on_read(GObject *source, GAsyncResult *res, gpointer user_data) {
+        auto *self = static_cast<Readers *>(user_data);
+        GVariant *result = g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, nullptr);
+        if (result) {
+            g_variant_unref(result);
+            ++self->m_reads;
+        } else {
+            ++self->m_failed_reads;
+        }
+    }
+
+    std::vector<GDBusConnection *> m_peers;
+    std::vector<guint> m_subscriptions;
+    GMainContext *m_context;
+    GMainLoop *m_loop;
+    GThread *m_thread = nullptr;
+    std::atomic<guint64> m_reads{0};
+    std::atomic<guint64> m_failed_reads{0};
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    gint clients = 64;
+    gint fixes = 2000;
+
+    GOptionEntry entries[] = {
+        {"clients", 0, 0, G_OPTION_ARG_INT, &clients, "Number of clients", "N"},
+        {"fixes", 0, 0, G_OPTION_ARG_INT, &fixes, "Number of fixes", "M"},
+        {nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr}};
+
+    GError *error = nullptr;
+    GOptionContext *context = g_option_context_new("- Manager memory budget test");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("Option parsing failed: %s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(context);
+        return EXIT_FAILURE;
+    }
+    g_option_context_free(context);
+
+    if (!have_dbus_daemon()) {
+        return EXIT_SKIP;
+    }
+
+    // Keeps the persisted state (authorization, power) out of $HOME
+    TestBus bus("memtest");
+
+    GDBusConnection *service = bus.connect();
+    const gchar *service_name = g_dbus_connection_get_unique_name(service);
+
+    std::vector<GDBusConnection *> peers;
+    for (int i = 0; i < PEERS; ++i) {
+        peers.push_back(bus.connect());
+    }
+
+    bool ok = true;
+    {
+        auto manager = geoclue2_manager_register(service);
+        manager->set_client_limits(0, 0);
+
+        ProcessMemory before_clients = process_memory();
+
+        // N clients, started, spread over the peers
+        std::vector<std::string> paths;
+        for (int i = 0; i < clients; ++i) {
+            GDBusConnection *peer = peers[i % PEERS];
+            std::string path = start_client(peer, service_name, "org.example.Budget");
+            if (path.empty()) {
+                return EXIT_FAILURE;
+            }
+            paths.push_back(path);
+        }
+
+        ProcessMemory after_clients = process_memory();
+        g_print("clients: %d, RSS %+" G_GINT64_FORMAT " bytes (%" G_GINT64_FORMAT
+                " per client)\n",
+                clients, after_clients.rss_bytes - before_clients.rss_bytes,
+                (after_clients.rss_bytes - before_clients.rss_bytes) / std::max(clients, 1));
+
+        Readers readers(peers, service_name);
+
+        // M fixes, each read by every client before the next; the first
+        // tenth warms up caches and the retention deque
+        int warmup = std::max(fixes / 10, (int)MAX_RETAINED_LOCATIONS + 1);
+        ProcessMemory after_warmup;
+        gint64 heap_after_warmup = 0;
+        guint64 allocations_after_warmup = 0;
+        int halfway = warmup + (fixes - warmup) / 2;
+        guint64 allocations_halfway = 0;
+
+        for (int i = 0; i < fixes; ++i) {
+            GeoClue1Position pos;
+            pos.latitude = 60.17 + i * 1e-5;
+            pos.longitude = 24.94 + i * 1e-5;
+            pos.altitude = 12.0;
+            pos.accuracy = 5.0;
+            pos.speed = 1.5;
+            pos.heading = 90.0;
+            pos.timestamp_iso8601 = std::to_string(1700000000 + i);
+            manager->handle_position_update(pos);
+
+            guint64 expected = (guint64)clients * (i + 1);
+            if (!wait_for([&readers, expected]() {
+                    return readers.reads() + readers.failed_reads() >= expected;
+                })) {
+                g_printerr("fix %d: %" G_GUINT64_FORMAT " of %" G_GUINT64_FORMAT " reads\n", i,
+                           readers.reads(), expected);
+                break;
+            }
+
+            if (i + 1 == warmup) {
+                after_warmup = process_memory();
+                heap_after_warmup = heap_live_bytes();
+                allocations_after_warmup = allocation_counters().thread_allocations;
+            }
+            if (i + 1 == halfway) {
+                allocations_halfway = allocation_counters().thread_allocations;
+            }
+        }
+
+        ProcessMemory after_fixes = process_memory();
+        gint64 rss_growth = after_fixes.rss_bytes - after_warmup.rss_bytes;
+        g_print("fixes: %d, RSS growth after warm-up %" G_GINT64_FORMAT
+                " bytes, peak RSS %" G_GINT64_FORMAT " bytes\n",
+                fixes, rss_growth, after_fixes.peak_rss_bytes);
+
+        ok &= check(readers.reads() == (guint64)clients * fixes, "every fix read by every client");
+        ok &= check(GeoClue2Client::live() == (guint64)clients, "all clients alive");
+        ok &= check(GeoClue2Location::live() <= MAX_RETAINED_LOCATIONS,
+                    "Location retention bounded");
+        ok &= check(rss_growth <= RSS_GROWTH_BUDGET_BYTES, "RSS growth within budget");
+
+        AllocationCounters counters = allocation_counters();
+        if (counters.available) {
+            gint64 heap_growth = heap_live_bytes() - heap_after_warmup;
+            double early = (double)(allocations_halfway - allocations_after_warmup) /
+                           std::max(halfway - warmup, 1) / std::max(clients, 1);
+            double late = (double)(counters.thread_allocations - allocations_halfway) /
+                          std::max(fixes - halfway, 1) / std::max(clients, 1);
+            g_print("heap growth after warm-up %" G_GINT64_FORMAT " bytes, %.1f then %.1f "
+                    "main-thread allocations per fix and client\n",
+                    heap_growth, early, late);
+            ok &= check(heap_growth <= HEAP_GROWTH_BUDGET_BYTES, "heap growth within budget");
+            ok &= check(late <= early * (1.0 + ALLOCATION_DRIFT_TOLERANCE),
+                        "allocations per fix and client do not grow");
+        }
+
+        for (size_t i = 0; i < paths.size(); ++i) {
+            GVariant *result =
+                call(peers[i % PEERS], service_name, GEOCLUE2_MANAGER_OBJECT_PATH,
+                     GEOCLUE2_MANAGER_INTERFACE, "DeleteClient",
+                     g_variant_new("(o)", paths[i].c_str()));
+            if (result) {
+                g_variant_unref(result);
+            }
+        }
+        drain_main_context();
+
+        ok &= check(GeoClue2Client::live() == 0, "no clients leaked after DeleteClient");
+    }
+
+    ok &= check(GeoClue2Location::live() == 0, "no Locations leaked after the Manager");
+
+    for (GDBusConnection *peer : peers) {
+        g_object_unref(peer);
+    }
+    g_object_unref(service);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
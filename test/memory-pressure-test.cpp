@@ -0,0 +1,93 @@
+/*
+ * Memory pressure test
+ *
+ * Runs a Manager on a private bus with a MemoryPressureMonitor watching a
+ * stand-in file. Raising pressure through the file must shrink Location
+ * retention right away and keep it shrunk for new fixes, count each
+ * reaction in the stats, and relieving it must restore the full depth.
+ *
+ * Exits with 77 (skipped) when no dbus-daemon is available.
+ */
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "geoclue2_location.h"
+#include "geoclue2_manager.h"
+#include "memory_pressure.h"
+#include "test_util.h"
+
+namespace {
+
+// Retention depth without and with memory pressure
+const guint64 NORMAL_RETAINED_LOCATIONS = 25;
+const guint64 PRESSURE_RETAINED_LOCATIONS = 5;
+
+void write_stand_in(const std::string &path, const char *contents) {
+    g_file_set_contents(path.c_str(), contents, -1, nullptr);
+}
+
+} // namespace
+
+int main() {
+    if (!have_dbus_daemon()) {
+        return EXIT_SKIP;
+    }
+
+    TestBus bus("pressuretest");
+    std::string stand_in = bus.path("pressure");
+    write_stand_in(stand_in, "0\n");
+    GDBusConnection *service = bus.connect();
+
+    bool ok = true;
+    {
+        auto manager = geoclue2_manager_register(service);
+        MemoryPressureMonitor monitor(stand_in, [&manager](bool under_pressure) {
+            manager->set_memory_pressure(under_pressure);
+        });
+
+        push_fixes(*manager, 0, 40);
+        drain_main_context();
+        ok &= check(GeoClue2Location::live() == NORMAL_RETAINED_LOCATIONS,
+                    "full retention without pressure");
+
+        write_stand_in(stand_in, "1\n");
+        ok &= check(wait_for([&monitor]() { return monitor.under_pressure(); }),
+                    "stand-in pressure noticed");
+        ok &= check(GeoClue2Location::live() == PRESSURE_RETAINED_LOCATIONS,
+                    "retention shrunk at once");
+
+        push_fixes(*manager, 0, 40);
+        drain_main_context();
+        ok &= check(GeoClue2Location::live() == PRESSURE_RETAINED_LOCATIONS,
+                    "retention stays shrunk under pressure");
+        ok &= check(stat_u64(*manager, "memory.pressure.retention_shrinks") == 1,
+                    "retention shrink counted");
+        ok &= check(stat_u64(*manager, "memory.pressure.locations_dropped") ==
+                        NORMAL_RETAINED_LOCATIONS - PRESSURE_RETAINED_LOCATIONS,
+                    "dropped locations counted");
+        ok &= check(stat_u64(*manager, "memory.pressure.cache_trims") == 1, "cache trim counted");
+#ifdef __GLIBC__
+        // No backend, so GPS is off and the heap is trimmed right away
+        ok &= check(stat_u64(*manager, "memory.pressure.malloc_trims") == 1,
+                    "malloc_trim counted");
+#endif
+
+        write_stand_in(stand_in, "0\n");
+        ok &= check(wait_for([&monitor]() { return !monitor.under_pressure(); }),
+                    "stand-in relief noticed");
+
+        push_fixes(*manager, 0, 40);
+        drain_main_context();
+        ok &= check(GeoClue2Location::live() == NORMAL_RETAINED_LOCATIONS,
+                    "full retention after relief");
+    }
+
+    g_object_unref(service);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,163 @@
+/*
+ * QoS class test
+ *
+ * Runs a Manager on a private bus with a configuration file that puts one
+ * started client in each QoS class, and records the LocationUpdated signals
+ * their peer receives. Within a fix the realtime client must be served
+ * before the interactive one, and the deferred classes only after both. A
+ * burst of fixes must reach the immediate classes in full while a background
+ * client gets only the latest, held back by the class's shipped 1 Hz cap
+ * until a second after its previous fix, and a batch client gets one fix at
+ * the end of its batching window. Time runs on a VirtualClock, so the
+ * windows and the cap are stepped through exactly.
+ *
+ * Exits with 77 (skipped) when no dbus-daemon is available.
+ */
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "bridge_config.h"
+#include "clock.h"
+#include "dbus_interfaces.h"
+#include "geoclue2_manager.h"
+#include "test_util.h"
+
+namespace {
+
+// Batching window of the batch class in CONFIG
+const gint64 BATCH_WINDOW_US = 300 * 1000;
+
+const char *CONFIG =
+    "[delivery]\n"
+    "slow-unread-limit=1000\n"
+    "[class batch]\n"
+    "batch-ms=300\n"
+    "[application org.example.Nav]\n"
+    "class=realtime\n"
+    "[application org.example.Weather]\n"
+    "class=background\n"
+    "[application org.example.Sync]\n"
+    "class=batch\n";
+
+// Client paths in the order their LocationUpdated arrived
+struct Received {
+    std::vector<std::string> clients;
+
+    size_t count(const std::string &client) const {
+        return std::count(clients.begin(), clients.end(), client);
+    }
+
+    // Position of the first signal of `client`, or the end
+    size_t first(const std::string &client) const {
+        return std::find(clients.begin(), clients.end(), client) - clients.begin();
+    }
+};
+
+void on_location_updated(GDBusConnection * /*connection*/, const gchar * /*sender*/,
+                         const gchar *object_path, const gchar * /*interface_name*/,
+                         const gchar * /*signal_name*/, GVariant * /*parameters*/,
+                         gpointer user_data) {
+    static_cast<Received *>(user_data)->clients.push_back(object_path);
+}
+
+} // namespace
+
+int main() {
+    if (!have_dbus_daemon()) {
+        return EXIT_SKIP;
+    }
+
+    TestBus bus("qostest");
+    std::string config_path = bus.path("geoclue2to1.conf");
+    g_file_set_contents(config_path.c_str(), CONFIG, -1, nullptr);
+
+    GDBusConnection *service = bus.connect();
+    GDBusConnection *peer = bus.connect();
+    const gchar *service_name = g_dbus_connection_get_unique_name(service);
+
+    Received received;
+    guint subscription = g_dbus_connection_signal_subscribe(
+        peer, service_name, GEOCLUE2_CLIENT_INTERFACE, "LocationUpdated", nullptr, nullptr,
+        G_DBUS_SIGNAL_FLAGS_NONE, &on_location_updated, &received, nullptr);
+
+    VirtualClock clock(g_get_real_time());
+    Clock::install(&clock);
+
+    bool ok = true;
+    {
+        auto manager = geoclue2_manager_register(service);
+        ConfigMonitor monitor(config_path, BridgeConfig(),
+                              [&manager](const BridgeConfig &) { manager->apply_config(); });
+
+        const BridgeConfig &config = BridgeConfig::current();
+        ok &= check(config.qos_class_of("org.example.Nav") == QOS_REALTIME &&
+                        config.qos_class_of("org.example.Map") == QOS_INTERACTIVE &&
+                        config.qos_class_of("org.example.Sync") == QOS_BATCH,
+                    "DesktopIds assigned to their classes");
+
+        // Created before the realtime client, so registry order alone would
+        // not put the realtime client first
+        std::string map = start_client(peer, service_name, "org.example.Map");
+        std::string nav = start_client(peer, service_name, "org.example.Nav");
+        std::string weather = start_client(peer, service_name, "org.example.Weather");
+        std::string sync = start_client(peer, service_name, "org.example.Sync");
+        ok &= check(!map.empty() && !nav.empty() && !weather.empty() && !sync.empty(),
+                    "one client per class started");
+
+        // One fix: served in class order, batch at the end of its window
+        push_fixes(*manager, 0, 1);
+        ok &= check(wait_for([&]() { return received.count(weather) == 1; }),
+                    "deferred classes served");
+        clock.advance(BATCH_WINDOW_US);
+        ok &= check(wait_for([&]() { return received.count(sync) == 1; }),
+                    "every class received the fix");
+        ok &= check(received.first(nav) < received.first(map) &&
+                        received.first(map) < received.first(weather) &&
+                        received.first(weather) < received.first(sync),
+                    "realtime first, deferred classes last");
+
+        // A burst: the immediate classes get every fix, background the latest
+        // once a second has passed since its previous one
+        received.clients.clear();
+        push_fixes(*manager, 1, 10);
+        ok &= check(wait_for([&]() {
+                        return stat_u64(*manager, "qos.deferred_fanouts") == 2 &&
+                               received.count(nav) == 10 && received.count(map) == 10;
+                    }),
+                    "immediate classes received every fix");
+        ok &= check(stat_u64(*manager, "qos.deferred_superseded") == 9,
+                    "background fixes superseded within the burst");
+        ok &= check(stat_u64(*manager, "delivery.rate_capped_updates") == 1,
+                    "latest fix held by the background rate cap");
+
+        clock.advance(BATCH_WINDOW_US);
+        ok &= check(wait_for([&]() { return received.count(sync) == 1; }),
+                    "batch window flushed");
+        drain_main_context();
+        ok &= check(received.count(weather) == 0, "background capped within the second");
+
+        clock.advance(G_USEC_PER_SEC - 2 * BATCH_WINDOW_US);
+        ok &= check(wait_for([&]() { return received.count(weather) == 1; }),
+                    "background received the burst");
+
+        clock.advance(BATCH_WINDOW_US);
+        drain_main_context();
+        ok &= check(received.count(sync) == 1 && received.count(weather) == 1 &&
+                        stat_u64(*manager, "delivery.batched_updates") == 2,
+                    "burst delivered once to the deferred classes");
+    }
+
+    Clock::install(nullptr);
+
+    g_dbus_connection_signal_unsubscribe(peer, subscription);
+    g_object_unref(peer);
+    g_object_unref(service);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
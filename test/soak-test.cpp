@@ -0,0 +1,752 @@
+/*
+ * Accelerated soak test
+ *
+ * Runs a Manager with a real Geoclue1Backend on a private bus under a
+ * VirtualClock and plays a scripted day of client usage against it: apps
+ * that navigate for an hour, check the weather, flap within the grace
+ * period, never read their Locations, vanish without Stop(), or create a
+ * client and never start it. A scripted GeoClue1 provider, serving from a
+ * thread of its own, sends a fix every simulated second while GPS is on
+ * and a VelocityChanged before every tenth fix.
+ *
+ * Virtual time only moves between events, so --hours 24 takes minutes.
+ * Fails on:
+ * - leaks: Clients, Locations, peer watches, virtual timers or GeoClue1
+ *   references left once every app has gone
+ * - memory growth: RSS or live heap past their budgets after the first
+ *   hour, or live heap growing in every hourly sample
+ * - timer drift: GPS on-time (power.gps_on_us) or the number of GPS
+ *   sessions differing from the script's model of the grace period, or
+ *   idle clients reclaimed outside their timeout
+ * - velocity freshness: Speed on a Location not matching the number of
+ *   positions since the last VelocityChanged
+ *
+ * Exits with 77 (skipped) when no dbus-daemon is available.
+ */
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "clock.h"
+#include "dbus_interfaces.h"
+#include "geoclue1_backend.h"
+#include "geoclue2_manager.h"
+#include "memory_stats.h"
+#include "test_util.h"
+
+namespace {
+
+// Virtual wall clock at the start of the day
+const gint64 VIRTUAL_EPOCH_US = G_GINT64_CONSTANT(1760000000) * G_USEC_PER_SEC;
+
+const gint64 SECOND_US = G_USEC_PER_SEC;
+const gint64 MINUTE_US = 60 * SECOND_US;
+const gint64 HOUR_US = 60 * MINUTE_US;
+
+// The Manager's defaults the model below follows
+const gint64 GRACE_US = 15 * SECOND_US;
+const gint64 IDLE_CLIENT_TIMEOUT_US = 10 * MINUTE_US;
+const gint64 REAPER_INTERVAL_US = MINUTE_US;
+const guint64 MAX_RETAINED_LOCATIONS = 25;
+
+// Scripted provider: one fix per second, velocity before every tenth, merged
+// into that fix and the next ([fusion] velocity-fresh-steps, default 2)
+const gint64 FIX_INTERVAL_US = SECOND_US;
+const guint64 VELOCITY_EVERY = 10;
+const guint64 VELOCITY_FRESH_STEPS = 2;
+
+// Growth allowed after the first simulated hour
+const gint64 RSS_GROWTH_BUDGET_BYTES = 4 * 1024 * 1024;
+const gint64 HEAP_GROWTH_BUDGET_BYTES = 512 * 1024;
+
+const char *GEOCLUE1_SERVICE = "org.freedesktop.Geoclue.Master";
+const char *GEOCLUE1_MASTER_PATH = "/org/freedesktop/Geoclue/Master";
+const char *GEOCLUE1_CLIENT_PATH = "/org/freedesktop/Geoclue/Master/client0";
+const char *GEOCLUE1_PROVIDER_PATH = "/org/freedesktop/Geoclue/Providers/Scripted";
+
+const char *GEOCLUE1_XML = "<node>"
+                           "  <interface name='org.freedesktop.Geoclue.Master'>"
+                           "    <method name='Create'><arg type='o' direction='out'/></method>"
+                           "  </interface>"
+                           "  <interface name='org.freedesktop.Geoclue.MasterClient'>"
+                           "    <method name='SetRequirements'>"
+                           "      <arg type='i' direction='in'/><arg type='i' direction='in'/>"
+                           "      <arg type='b' direction='in'/><arg type='i' direction='in'/>"
+                           "    </method>"
+                           "    <method name='PositionStart'/>"
+                           "  </interface>"
+                           "  <interface name='org.freedesktop.Geoclue'>"
+                           "    <method name='AddReference'/>"
+                           "    <method name='RemoveReference'/>"
+                           "  </interface>"
+                           "  <interface name='org.freedesktop.Geoclue.Position'/>"
+                           "  <interface name='org.freedesktop.Geoclue.Velocity'/>"
+                           "</node>";
+
+/**
+ * GeoClue1 master and a scripted provider. Serves from its own thread and
+ * main context, since the backend calls it synchronously from ours.
+ */
+class ScriptedGeoClue1 {
+  public:
+    explicit ScriptedGeoClue1(const char *address) : m_address(address) {
+        m_thread = g_thread_new("scripted-geoclue1", &ScriptedGeoClue1::run, this);
+        while (!m_ready.load()) {
+            g_usleep(1000);
+        }
+    }
+
+    ~ScriptedGeoClue1() {
+        g_main_loop_quit(m_loop);
+        g_thread_join(m_thread);
+    }
+
+    // Non-copyable
+    ScriptedGeoClue1(const ScriptedGeoClue1 &) = delete;
+    ScriptedGeoClue1 &operator=(const ScriptedGeoClue1 &) = delete;
+
+    // GDBus connections may emit from any thread
+    void emit_velocity(gint timestamp, double speed, double direction) {
+        g_dbus_connection_emit_signal(
+            m_connection, nullptr, GEOCLUE1_PROVIDER_PATH, "org.freedesktop.Geoclue.Velocity",
+            "VelocityChanged", g_variant_new("(iiddd)", 7, timestamp, speed, direction, 0.0),
+            nullptr);
+    }
+
+    void emit_position(gint timestamp, double latitude, double longitude) {
+        g_dbus_connection_emit_signal(m_connection, nullptr, GEOCLUE1_PROVIDER_PATH,
+                                      "org.freedesktop.Geoclue.Position", "PositionChanged",
+                                      g_variant_new("(iiddd(idd))", 7, timestamp, latitude,
+                                                    longitude, 12.0, 5, 4.0, 8.0),
+                                      nullptr);
+    }
+
+    // Between PositionStart and the client's last RemoveReference
+    bool started() const { return m_started.load(); }
+    gint client_references() const { return m_client_references.load(); }
+    gint provider_references() const { return m_provider_references.load(); }
+    guint position_starts() const { return m_position_starts.load(); }
+
+  private:
+    std::string m_address;
+    GThread *m_thread = nullptr;
+    GMainLoop *m_loop = nullptr;
+    GDBusConnection *m_connection = nullptr;
+    std::atomic<bool> m_ready{false};
+
+    std::atomic<bool> m_started{false};
+    std::atomic<gint> m_client_references{0};
+    std::atomic<gint> m_provider_references{0};
+    std::atomic<guint> m_position_starts{0};
+
+    static gpointer run(gpointer data) {
+        auto *self = static_cast<ScriptedGeoClue1 *>(data);
+        GMainContext *context = g_main_context_new();
+        g_main_context_push_thread_default(context);
+        self->m_loop = g_main_loop_new(context, FALSE);
+        self->m_connection = connect_to(self->m_address.c_str());
+
+        static const GDBusInterfaceVTable vtable = {&ScriptedGeoClue1::on_method_call, nullptr,
+                                                    nullptr, {}};
+        GDBusNodeInfo *node = g_dbus_node_info_new_for_xml(GEOCLUE1_XML, nullptr);
+        const struct {
+            const char *path;
+            const char *interface;
+        } objects[] = {
+            {GEOCLUE1_MASTER_PATH, "org.freedesktop.Geoclue.Master"},
+            {GEOCLUE1_CLIENT_PATH, "org.freedesktop.Geoclue.MasterClient"},
+            {GEOCLUE1_CLIENT_PATH, "org.freedesktop.Geoclue"},
+            {GEOCLUE1_PROVIDER_PATH, "org.freedesktop.Geoclue"},
+            {GEOCLUE1_PROVIDER_PATH, "org.freedesktop.Geoclue.Position"},
+            {GEOCLUE1_PROVIDER_PATH, "org.freedesktop.Geoclue.Velocity"},
+        };
+        for (const auto &object : objects) {
+            g_dbus_connection_register_object(
+                self->m_connection, object.path,
+                g_dbus_node_info_lookup_interface(node, object.interface), &vtable, self, nullptr,
+                nullptr);
+        }
+
+        GVariant *reply = g_dbus_connection_call_sync(
+            self->m_connection, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+            "org.freedesktop.DBus", "RequestName", g_variant_new("(su)", GEOCLUE1_SERVICE, 0),
+            nullptr, G_DBUS_CALL_FLAGS_NONE, -1, nullptr, nullptr);
+        if (reply) {
+            g_variant_unref(reply);
+        }
+
+        self->m_ready.store(true);
+        g_main_loop_run(self->m_loop);
+
+        g_dbus_connection_close_sync(self->m_connection, nullptr, nullptr);
+        g_object_unref(self->m_connection);
+        g_dbus_node_info_unref(node);
+        g_main_loop_unref(self->m_loop);
+        g_main_context_pop_thread_default(context);
+        g_main_context_unref(context);
+        return nullptr;
+    }
+
+    static void on_method_call(GDBusConnection *connection, const gchar * /*sender*/,
+                               const gchar *object_path, const gchar *interface_name,
+                               const gchar *method_name, GVariant * /*parameters*/,
+                               GDBusMethodInvocation *invocation, gpointer user_data) {
+        auto *self = static_cast<ScriptedGeoClue1 *>(user_data);
+        bool on_client = g_strcmp0(object_path, GEOCLUE1_CLIENT_PATH) == 0;
+
+        if (g_strcmp0(method_name, "Create") == 0) {
+            g_dbus_method_invocation_return_value(invocation,
+                                                  g_variant_new("(o)", GEOCLUE1_CLIENT_PATH));
+            return;
+        }
+
+        if (g_strcmp0(method_name, "AddReference") == 0) {
+            ++(on_client ? self->m_client_references : self->m_provider_references);
+        } else if (g_strcmp0(method_name, "RemoveReference") == 0) {
+            if (on_client) {
+                if (--self->m_client_references == 0) {
+                    self->m_started.store(false);
+                }
+            } else {
+                --self->m_provider_references;
+            }
+        }
+
+        g_dbus_method_invocation_return_value(invocation, nullptr);
+
+        // geoclue-master picks a provider once positioning starts
+        if (g_strcmp0(interface_name, "org.freedesktop.Geoclue.MasterClient") == 0 &&
+            g_strcmp0(method_name, "PositionStart") == 0) {
+            ++self->m_position_starts;
+            self->m_started.store(true);
+            g_dbus_connection_emit_signal(
+                connection, nullptr, GEOCLUE1_CLIENT_PATH, "org.freedesktop.Geoclue.MasterClient",
+                "PositionProviderChanged",
+                g_variant_new("(ssss)", "Scripted", "Scripted soak test provider",
+                              g_dbus_connection_get_unique_name(connection),
+                              GEOCLUE1_PROVIDER_PATH),
+                nullptr);
+        }
+    }
+};
+
+/**
+ * What the script expects of the grace period: GPS turns on with the first
+ * active client and off GRACE_US after the last one stopped, unless another
+ * started in between.
+ */
+class GpsModel {
+  public:
+    void activate(gint64 now) {
+        settle(now);
+        if (++m_active == 1) {
+            m_off_deadline = -1;
+            if (!m_on) {
+                m_on = true;
+                m_on_since = now;
+                ++m_sessions;
+            }
+        }
+    }
+
+    void deactivate(gint64 now) {
+        settle(now);
+        if (--m_active == 0) {
+            m_off_deadline = now + GRACE_US;
+        }
+    }
+
+    gint64 on_us(gint64 now) {
+        settle(now);
+        return m_on_us + (m_on ? now - m_on_since : 0);
+    }
+
+    guint active() const { return m_active; }
+    guint sessions() const { return m_sessions; }
+
+  private:
+    guint m_active = 0;
+    bool m_on = false;
+    gint64 m_on_since = 0;
+    gint64 m_off_deadline = -1;
+    gint64 m_on_us = 0;
+    guint m_sessions = 0;
+
+    void settle(gint64 now) {
+        if (m_on && m_off_deadline >= 0 && m_off_deadline <= now) {
+            m_on_us += m_off_deadline - m_on_since;
+            m_on = false;
+            m_off_deadline = -1;
+        }
+    }
+};
+
+enum class Behaviour {
+    Reader,   // reads every Location it is sent
+    Slow,     // reads the first fix of a session only, so it gets coalesced
+    Vanisher, // reads, and ends sessions by closing its connection
+};
+
+struct App {
+    const char *desktop_id;
+    Behaviour behaviour;
+    gint64 session_min_us, session_max_us;
+    gint64 pause_min_us, pause_max_us;
+    bool delete_after_stop;
+
+    GDBusConnection *connection = nullptr;
+    std::string client_path;
+    bool active = false;
+    bool read_this_session = false;
+    gint64 next_event_us = 0;
+};
+
+struct Soak {
+    VirtualClock &clock;
+    GeoClue2Manager &manager;
+    ScriptedGeoClue1 &geoclue1;
+    GDBusConnection *backend_connection;
+    const char *address;
+    const char *service_name;
+    GRand *rand;
+
+    GpsModel gps;
+    guint64 fixes_sent = 0;
+    guint64 fixes_received = 0;
+    guint64 velocity_mismatches = 0;
+    guint64 failed_calls = 0;
+    bool lost_fix = false;
+
+    // Unstarted clients, one an hour from a peer that never starts them
+    GDBusConnection *idle_peer = nullptr;
+    std::vector<gint64> unstarted_created_us;
+};
+
+gint64 now_us(const Soak &soak) { return soak.clock.monotonic_us(); }
+
+gint64 random_between(Soak &soak, gint64 min_us, gint64 max_us) {
+    // Whole seconds keep the events off the fix grid's rounding
+    gint64 seconds = g_rand_int_range(soak.rand, (gint32)(min_us / SECOND_US),
+                                      (gint32)(max_us / SECOND_US) + 1);
+    return seconds * SECOND_US;
+}
+
+bool checked(Soak &soak, GVariant *result) {
+    if (!result) {
+        ++soak.failed_calls;
+        return false;
+    }
+    g_variant_unref(result);
+    return true;
+}
+
+// A round trip on the backend's connection, so that its match rules for
+// the provider's signals are in the bus before the first fix
+void sync_backend_matches(Soak &soak) {
+    GVariant *reply = g_dbus_connection_call_sync(
+        soak.backend_connection, "org.freedesktop.DBus", "/org/freedesktop/DBus",
+        "org.freedesktop.DBus", "GetId", nullptr, nullptr, G_DBUS_CALL_FLAGS_NONE, -1, nullptr,
+        nullptr);
+    checked(soak, reply);
+}
+
+void start_session(Soak &soak, App &app) {
+    if (!app.connection) {
+        app.connection = connect_to(soak.address);
+    }
+
+    if (app.client_path.empty()) {
+        GVariant *result = call(app.connection, soak.service_name, GEOCLUE2_MANAGER_OBJECT_PATH,
+                                GEOCLUE2_MANAGER_INTERFACE, "CreateClient", nullptr);
+        if (!result) {
+            ++soak.failed_calls;
+            return;
+        }
+        const gchar *path = nullptr;
+        g_variant_get(result, "(&o)", &path);
+        app.client_path = path;
+        g_variant_unref(result);
+
+        checked(soak, call(app.connection, soak.service_name, app.client_path.c_str(),
+                           "org.freedesktop.DBus.Properties", "Set",
+                           g_variant_new("(ssv)", GEOCLUE2_CLIENT_INTERFACE, "DesktopId",
+                                         g_variant_new_string(app.desktop_id))));
+    }
+
+    bool gps_was_on = soak.geoclue1.started();
+    if (!checked(soak, call(app.connection, soak.service_name, app.client_path.c_str(),
+                            GEOCLUE2_CLIENT_INTERFACE, "Start", nullptr))) {
+        return;
+    }
+    app.active = true;
+    app.read_this_session = false;
+    soak.gps.activate(now_us(soak));
+
+    // A fresh GeoClue1 session: wait for the backend to pick the provider
+    if (!gps_was_on) {
+        if (!wait_for([&soak]() { return soak.geoclue1.provider_references() > 0; })) {
+            g_printerr("GeoClue1 provider was never referenced\n");
+            ++soak.failed_calls;
+        }
+        sync_backend_matches(soak);
+    }
+}
+
+void end_session(Soak &soak, App &app) {
+    if (app.behaviour == Behaviour::Vanisher) {
+        // No Stop(): the Manager must notice the peer going away
+        g_dbus_connection_close_sync(app.connection, nullptr, nullptr);
+        g_object_unref(app.connection);
+        app.connection = nullptr;
+        app.client_path.clear();
+    } else {
+        checked(soak, call(app.connection, soak.service_name, app.client_path.c_str(),
+                           GEOCLUE2_CLIENT_INTERFACE, "Stop", nullptr));
+        if (app.delete_after_stop) {
+            checked(soak, call(app.connection, soak.service_name, GEOCLUE2_MANAGER_OBJECT_PATH,
+                               GEOCLUE2_MANAGER_INTERFACE, "DeleteClient",
+                               g_variant_new("(o)", app.client_path.c_str())));
+            app.client_path.clear();
+        }
+    }
+
+    app.active = false;
+    soak.gps.deactivate(now_us(soak));
+}
+
+void run_app_event(Soak &soak, App &app) {
+    if (app.active) {
+        end_session(soak, app);
+        app.next_event_us = now_us(soak) + random_between(soak, app.pause_min_us, app.pause_max_us);
+    } else {
+        start_session(soak, app);
+        app.next_event_us =
+            now_us(soak) + random_between(soak, app.session_min_us, app.session_max_us);
+    }
+
+    // Stop() and vanished peers settle before time moves on
+    guint expected = soak.gps.active();
+    if (!wait_for([&soak, expected]() {
+            return stat_u32(soak.manager, "clients.active") == expected;
+        })) {
+        g_printerr("Manager has %u active clients, script %u\n",
+                   stat_u32(soak.manager, "clients.active"), expected);
+        ++soak.failed_calls;
+    }
+}
+
+void create_unstarted_client(Soak &soak) {
+    checked(soak, call(soak.idle_peer, soak.service_name, GEOCLUE2_MANAGER_OBJECT_PATH,
+                       GEOCLUE2_MANAGER_INTERFACE, "CreateClient", nullptr));
+    soak.unstarted_created_us.push_back(now_us(soak));
+}
+
+guint64 unstarted_created_before(const Soak &soak, gint64 time_us) {
+    return std::count_if(soak.unstarted_created_us.begin(), soak.unstarted_created_us.end(),
+                         [time_us](gint64 created) { return created <= time_us; });
+}
+
+// Read the Location the Client points at, and check its velocity against
+// the fixes since the last VelocityChanged
+void read_location(Soak &soak, App &app) {
+    GVariant *result = call(app.connection, soak.service_name, app.client_path.c_str(),
+                            "org.freedesktop.DBus.Properties", "Get",
+                            g_variant_new("(ss)", GEOCLUE2_CLIENT_INTERFACE, "Location"));
+    if (!result) {
+        ++soak.failed_calls;
+        return;
+    }
+    GVariant *value = nullptr;
+    g_variant_get(result, "(v)", &value);
+    std::string path = g_variant_get_string(value, nullptr);
+    g_variant_unref(value);
+    g_variant_unref(result);
+    if (path == "/") {
+        return;
+    }
+
+    result = call(app.connection, soak.service_name, path.c_str(),
+                  "org.freedesktop.DBus.Properties", "GetAll",
+                  g_variant_new("(s)", GEOCLUE2_LOCATION_INTERFACE));
+    if (!result) {
+        ++soak.failed_calls;
+        return;
+    }
+    GVariant *properties = g_variant_get_child_value(result, 0);
+    gdouble speed = -1.0;
+    g_variant_lookup(properties, "Speed", "d", &speed);
+    g_variant_unref(properties);
+    g_variant_unref(result);
+
+    // Location N carries the N-th fix
+    guint64 fix = g_ascii_strtoull(strrchr(path.c_str(), '/') + 1, nullptr, 10);
+    bool fresh = (fix - 1) % VELOCITY_EVERY < VELOCITY_FRESH_STEPS;
+    if (fresh != (speed >= 0.0)) {
+        ++soak.velocity_mismatches;
+    }
+}
+
+void send_fix(Soak &soak, std::vector<App> &apps) {
+    guint64 fix = ++soak.fixes_sent;
+    gint timestamp = (gint)(soak.clock.real_us() / G_USEC_PER_SEC);
+
+    if ((fix - 1) % VELOCITY_EVERY == 0) {
+        soak.geoclue1.emit_velocity(timestamp, 1.0 + (fix % 7), (fix * 13) % 360);
+    }
+    soak.geoclue1.emit_position(timestamp, 60.17 + (fix % 1000) * 1e-5, 24.94);
+
+    if (!wait_for([&soak]() { return soak.fixes_received == soak.fixes_sent; })) {
+        g_printerr("Fix %" G_GUINT64_FORMAT " never reached the Manager\n", fix);
+        soak.lost_fix = true;
+        soak.fixes_received = soak.fixes_sent;
+        return;
+    }
+
+    for (auto &app : apps) {
+        if (app.active && (app.behaviour != Behaviour::Slow || !app.read_this_session)) {
+            read_location(soak, app);
+            app.read_this_session = true;
+        }
+    }
+}
+
+struct Sample {
+    gint64 rss_bytes;
+    gint64 heap_live_bytes;
+};
+
+Sample sample_memory() {
+    return Sample{process_memory().rss_bytes, allocation_counters().live_bytes};
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    gint hours = 24;
+    gint seed = 1;
+
+    GOptionEntry entries[] = {
+        {"hours", 0, 0, G_OPTION_ARG_INT, &hours, "Simulated hours (default 24)", "H"},
+        {"seed", 0, 0, G_OPTION_ARG_INT, &seed, "Seed of the usage script", "N"},
+        {nullptr, 0, 0, G_OPTION_ARG_NONE, nullptr, nullptr, nullptr}};
+
+    GError *error = nullptr;
+    GOptionContext *context = g_option_context_new("- accelerated soak test");
+    g_option_context_add_main_entries(context, entries, nullptr);
+    if (!g_option_context_parse(context, &argc, &argv, &error)) {
+        g_printerr("Option parsing failed: %s\n", error->message);
+        g_error_free(error);
+        g_option_context_free(context);
+        return EXIT_FAILURE;
+    }
+    g_option_context_free(context);
+    hours = std::max(hours, 2);
+
+    if (!have_dbus_daemon()) {
+        return EXIT_SKIP;
+    }
+
+    // Keeps the persisted state (authorization, power) out of $HOME
+    TestBus bus("soaktest");
+    const gchar *address = bus.address();
+
+    // Installed before anything schedules a timer
+    VirtualClock clock(VIRTUAL_EPOCH_US);
+    Clock::install(&clock);
+
+    GDBusConnection *service = bus.connect();
+    GDBusConnection *backend_connection = bus.connect();
+
+    bool ok = true;
+    {
+        ScriptedGeoClue1 geoclue1(address);
+        auto manager = geoclue2_manager_register(service);
+
+        GRand *rand = g_rand_new_with_seed((guint32)seed);
+        Soak soak{clock,   *manager, geoclue1, backend_connection, address,
+                  g_dbus_connection_get_unique_name(service), rand};
+        soak.idle_peer = connect_to(address);
+
+        manager->set_backend_factory([&soak, backend_connection](
+                                         GCancellable *, GeoClue2Manager::BackendReady ready) {
+            auto backend = std::make_shared<Geoclue1Backend>(backend_connection);
+            backend->set_position_callback([&soak](const GeoClue1Position &pos) {
+                soak.manager.handle_position_update(pos);
+                ++soak.fixes_received;
+            });
+            ready(backend);
+        });
+
+        std::vector<App> apps = {
+            {"org.example.Navigation", Behaviour::Reader, 20 * MINUTE_US, 90 * MINUTE_US,
+             30 * MINUTE_US, 180 * MINUTE_US, true},
+            {"org.example.Weather", Behaviour::Reader, 5 * SECOND_US, 60 * SECOND_US,
+             50 * MINUTE_US, 70 * MINUTE_US, true},
+            {"org.example.Fitness", Behaviour::Slow, 30 * MINUTE_US, 60 * MINUTE_US, 2 * HOUR_US,
+             6 * HOUR_US, true},
+            // Pauses around the grace period, so GPS is sometimes kept warm
+            {"org.example.Camera", Behaviour::Reader, 10 * SECOND_US, 2 * MINUTE_US,
+             2 * SECOND_US, 30 * SECOND_US, false},
+            {"org.example.Tracker", Behaviour::Vanisher, 10 * MINUTE_US, 40 * MINUTE_US,
+             20 * MINUTE_US, 60 * MINUTE_US, false},
+            {"org.example.Widget", Behaviour::Reader, 1 * MINUTE_US, 5 * MINUTE_US,
+             5 * MINUTE_US, 30 * MINUTE_US, true},
+        };
+        for (auto &app : apps) {
+            app.next_event_us = random_between(soak, 0, 2 * HOUR_US);
+        }
+
+        std::vector<Sample> hourly;
+        hourly.push_back(sample_memory());
+
+        const gint64 end_us = (gint64)hours * HOUR_US;
+        gint64 next_hour_us = 0;
+        gint64 next_fix_us = 0;
+        gint64 started_real_us = g_get_monotonic_time();
+        bool reaping_ok = true;
+
+        while (now_us(soak) < end_us && soak.failed_calls == 0 && !soak.lost_fix) {
+            gint64 now = now_us(soak);
+
+            if (now >= next_hour_us) {
+                if (now > 0) {
+                    hourly.push_back(sample_memory());
+                    const Sample &last = hourly.back();
+                    g_print("hour %2" G_GINT64_FORMAT ": %" G_GUINT64_FORMAT
+                            " fixes, GPS on %" G_GINT64_FORMAT " s, RSS %" G_GINT64_FORMAT
+                            " KiB, heap %" G_GINT64_FORMAT " KiB, %.1f s real\n",
+                            now / HOUR_US, soak.fixes_sent,
+                            stat_i64(*manager, "power.gps_on_us") / G_USEC_PER_SEC,
+                            last.rss_bytes / 1024, last.heap_live_bytes / 1024,
+                            (g_get_monotonic_time() - started_real_us) / 1e6);
+                }
+
+                // Every unstarted client is reclaimed within a reaper
+                // interval of its timeout, and none earlier
+                guint64 reaped = stat_u64(*manager, "clients.reaped");
+                if (reaped < unstarted_created_before(soak, now - IDLE_CLIENT_TIMEOUT_US -
+                                                                REAPER_INTERVAL_US) ||
+                    reaped > unstarted_created_before(soak, now - IDLE_CLIENT_TIMEOUT_US)) {
+                    g_printerr("%" G_GUINT64_FORMAT " clients reaped at %" G_GINT64_FORMAT
+                               " s\n",
+                               reaped, now / SECOND_US);
+                    reaping_ok = false;
+                }
+
+                create_unstarted_client(soak);
+                next_hour_us += HOUR_US;
+            }
+
+            for (auto &app : apps) {
+                if (app.next_event_us <= now) {
+                    run_app_event(soak, app);
+                }
+            }
+
+            bool gps_on = geoclue1.started();
+            if (gps_on && now >= next_fix_us) {
+                send_fix(soak, apps);
+                next_fix_us = now + FIX_INTERVAL_US;
+            }
+
+            // Jump to whatever happens next: a script event, a fix or a timer
+            gint64 next = std::min(end_us, next_hour_us);
+            for (const auto &app : apps) {
+                next = std::min(next, app.next_event_us);
+            }
+            if (gps_on) {
+                next = std::min(next, next_fix_us);
+            }
+            if (clock.next_deadline_us() >= 0) {
+                next = std::min(next, clock.next_deadline_us());
+            }
+            clock.advance(std::max(next - now_us(soak), (gint64)0));
+            drain_main_context();
+        }
+
+        ok &= check(soak.failed_calls == 0, "all client calls succeeded");
+        ok &= check(!soak.lost_fix, "every fix reached the Manager");
+        ok &= check(soak.fixes_sent > 0, "fixes were sent");
+        ok &= check(soak.velocity_mismatches == 0, "velocity merged into the right fixes");
+        ok &= check(reaping_ok, "idle clients reclaimed on time");
+
+        // Timer drift: the grace periods as the script models them
+        gint64 gps_on_us = stat_i64(*manager, "power.gps_on_us");
+        gint64 expected_on_us = soak.gps.on_us(now_us(soak));
+        g_print("GPS on %" G_GINT64_FORMAT " us, model %" G_GINT64_FORMAT " us, %u sessions\n",
+                gps_on_us, expected_on_us, soak.gps.sessions());
+        ok &= check(gps_on_us == expected_on_us, "GPS on-time matches the grace model");
+        ok &= check(geoclue1.position_starts() == soak.gps.sessions(),
+                    "GPS sessions match the grace model");
+
+        // Memory: budgets from the first simulated hour on, and no steady climb
+        const Sample &warm = hourly[1];
+        const Sample &last = hourly.back();
+        g_print("RSS %+" G_GINT64_FORMAT " bytes, heap %+" G_GINT64_FORMAT
+                " bytes since hour 1\n",
+                last.rss_bytes - warm.rss_bytes, last.heap_live_bytes - warm.heap_live_bytes);
+        ok &= check(last.rss_bytes - warm.rss_bytes <= RSS_GROWTH_BUDGET_BYTES,
+                    "RSS growth within budget");
+        if (allocation_counters().available) {
+            ok &= check(last.heap_live_bytes - warm.heap_live_bytes <= HEAP_GROWTH_BUDGET_BYTES,
+                        "heap growth within budget");
+            bool climbing = hourly.size() > 3;
+            for (size_t i = 2; i < hourly.size(); ++i) {
+                climbing &= hourly[i].heap_live_bytes > hourly[i - 1].heap_live_bytes;
+            }
+            ok &= check(!climbing, "live heap not growing every hour");
+        }
+
+        // Everyone leaves; an hour later nothing may be left behind
+        for (auto &app : apps) {
+            if (app.active) {
+                run_app_event(soak, app);
+            }
+            if (app.connection) {
+                g_dbus_connection_close_sync(app.connection, nullptr, nullptr);
+                g_object_unref(app.connection);
+                app.connection = nullptr;
+            }
+        }
+        g_dbus_connection_close_sync(soak.idle_peer, nullptr, nullptr);
+        g_object_unref(soak.idle_peer);
+        ok &= check(wait_for([&manager]() {
+                        return stat_u32(*manager, "clients.total") == 0;
+                    }),
+                    "all clients removed");
+
+        clock.advance(HOUR_US);
+        drain_main_context();
+
+        ok &= check(stat_u64(*manager, "memory.clients.live") == 0, "no Client objects leaked");
+        ok &= check(stat_u64(*manager, "memory.locations.live") <= MAX_RETAINED_LOCATIONS,
+                    "Location retention bounded");
+        ok &= check(stat_u32(*manager, "peers.total") == 0 &&
+                        stat_u32(*manager, "peers.watches") == 0,
+                    "no peers or name watches left");
+        ok &= check(clock.pending() == 0, "no timers left");
+        ok &= check(!geoclue1.started() && geoclue1.client_references() == 0 &&
+                        geoclue1.provider_references() == 0,
+                    "GeoClue1 released");
+
+        g_print("%d simulated hours in %.1f s, %" G_GUINT64_FORMAT " fixes, %" G_GUINT64_FORMAT
+                " timer callbacks\n",
+                hours, (g_get_monotonic_time() - started_real_us) / 1e6, soak.fixes_sent,
+                clock.fired());
+        g_rand_free(rand);
+    }
+
+    Clock::install(nullptr);
+    g_object_unref(backend_connection);
+    g_object_unref(service);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
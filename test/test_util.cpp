@@ -0,0 +1,199 @@
+#include "test_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "dbus_interfaces.h"
+#include "geoclue1_backend.h"
+#include "geoclue2_manager.h"
+
+/**
+ * Implementation of the shared test helpers.
+ */
+
+namespace {
+
+struct Reply {
+    GVariant *result = nullptr;
+    GError *error = nullptr;
+    bool done = false;
+};
+
+template <typename T> T stat(const GeoClue2Manager &manager, const char *key, const char *format) {
+    GVariantBuilder builder;
+    g_variant_builder_init(&builder, G_VARIANT_TYPE_VARDICT);
+    manager.collect_stats(&builder);
+    GVariant *stats = g_variant_ref_sink(g_variant_builder_end(&builder));
+
+    T value = 0;
+    g_variant_lookup(stats, key, format, &value);
+    g_variant_unref(stats);
+    return value;
+}
+
+} // namespace
+
+bool check(bool ok, const char *what) {
+    g_print("%s %s\n", ok ? "PASS" : "FAIL", what);
+    return ok;
+}
+
+bool wait_for(const std::function<bool()> &condition, gint64 timeout_us) {
+    gint64 deadline = g_get_monotonic_time() + timeout_us;
+    while (!condition()) {
+        if (g_get_monotonic_time() > deadline) {
+            return false;
+        }
+        if (!g_main_context_iteration(nullptr, FALSE)) {
+            g_usleep(100);
+        }
+    }
+    return true;
+}
+
+void drain_main_context() {
+    while (g_main_context_iteration(nullptr, FALSE)) {
+    }
+}
+
+GVariant *call(GDBusConnection *peer, const char *service, const char *path,
+               const char *interface, const char *method, GVariant *parameters) {
+    Reply reply;
+    g_dbus_connection_call(
+        peer, service, path, interface, method, parameters, nullptr, G_DBUS_CALL_FLAGS_NONE, -1,
+        nullptr,
+        [](GObject *source, GAsyncResult *res, gpointer user_data) {
+            auto *reply = static_cast<Reply *>(user_data);
+            reply->result =
+                g_dbus_connection_call_finish(G_DBUS_CONNECTION(source), res, &reply->error);
+            reply->done = true;
+        },
+        &reply);
+
+    while (!reply.done) {
+        g_main_context_iteration(nullptr, TRUE);
+    }
+
+    if (!reply.result) {
+        g_printerr("%s.%s on %s failed: %s\n", interface, method, path, reply.error->message);
+        g_error_free(reply.error);
+    }
+    return reply.result;
+}
+
+std::string start_client(GDBusConnection *peer, const char *service, const char *desktop_id) {
+    GVariant *result = call(peer, service, GEOCLUE2_MANAGER_OBJECT_PATH,
+                            GEOCLUE2_MANAGER_INTERFACE, "CreateClient", nullptr);
+    if (!result) {
+        return "";
+    }
+
+    const gchar *path = nullptr;
+    g_variant_get(result, "(&o)", &path);
+    std::string client_path = path;
+    g_variant_unref(result);
+
+    GVariant *set = call(peer, service, client_path.c_str(), "org.freedesktop.DBus.Properties",
+                         "Set",
+                         g_variant_new("(ssv)", GEOCLUE2_CLIENT_INTERFACE, "DesktopId",
+                                       g_variant_new_string(desktop_id)));
+    GVariant *started = set ? call(peer, service, client_path.c_str(),
+                                   GEOCLUE2_CLIENT_INTERFACE, "Start", nullptr)
+                            : nullptr;
+
+    if (set) {
+        g_variant_unref(set);
+    }
+    if (!started) {
+        return "";
+    }
+    g_variant_unref(started);
+    return client_path;
+}
+
+void push_fixes(GeoClue2Manager &manager, int first, int count) {
+    for (int i = first; i < first + count; ++i) {
+        GeoClue1Position pos;
+        pos.latitude = 60.17 + i * 1e-5;
+        pos.longitude = 24.94;
+        pos.accuracy = 5.0;
+        pos.timestamp_iso8601 = std::to_string(1700000000 + i);
+        manager.handle_position_update(pos);
+    }
+}
+
+guint32 stat_u32(const GeoClue2Manager &manager, const char *key) {
+    return stat<guint32>(manager, key, "u");
+}
+
+guint64 stat_u64(const GeoClue2Manager &manager, const char *key) {
+    return stat<guint64>(manager, key, "t");
+}
+
+gint64 stat_i64(const GeoClue2Manager &manager, const char *key) {
+    return stat<gint64>(manager, key, "x");
+}
+
+GDBusConnection *connect_to(const char *address) {
+    GError *error = nullptr;
+    GDBusConnection *connection = g_dbus_connection_new_for_address_sync(
+        address,
+        static_cast<GDBusConnectionFlags>(G_DBUS_CONNECTION_FLAGS_AUTHENTICATION_CLIENT |
+                                          G_DBUS_CONNECTION_FLAGS_MESSAGE_BUS_CONNECTION),
+        nullptr, nullptr, &error);
+    if (!connection) {
+        g_printerr("Failed to connect to the test bus: %s\n", error->message);
+        g_error_free(error);
+        exit(EXIT_FAILURE);
+    }
+    return connection;
+}
+
+bool have_dbus_daemon() {
+    gchar *daemon = g_find_program_in_path("dbus-daemon");
+    if (!daemon) {
+        g_print("SKIP: dbus-daemon not found\n");
+        return false;
+    }
+    g_free(daemon);
+    return true;
+}
+
+TestBus::TestBus(const char *name) {
+    gchar *pattern = g_strdup_printf("geoclue2to1-%s-XXXXXX", name);
+    m_dir = g_dir_make_tmp(pattern, nullptr);
+    g_free(pattern);
+    if (!m_dir) {
+        g_printerr("Failed to create a scratch directory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Read once by GLib, so set before anything asks for them
+    g_setenv("XDG_CACHE_HOME", m_dir, TRUE);
+    g_setenv("XDG_STATE_HOME", m_dir, TRUE);
+
+    m_bus = g_test_dbus_new(G_TEST_DBUS_NONE);
+    g_test_dbus_up(m_bus);
+}
+
+TestBus::~TestBus() {
+    g_test_dbus_down(m_bus);
+    g_object_unref(m_bus);
+
+    // Only files written by the test and the Manager live in there
+    gchar *rm_argv[] = {(gchar *)"rm", (gchar *)"-rf", m_dir, nullptr};
+    g_spawn_sync(nullptr, rm_argv, nullptr, G_SPAWN_SEARCH_PATH, nullptr, nullptr, nullptr,
+                 nullptr, nullptr, nullptr);
+    g_free(m_dir);
+}
+
+const char *TestBus::address() const { return g_test_dbus_get_bus_address(m_bus); }
+
+std::string TestBus::path(const char *name) const {
+    gchar *path = g_build_filename(m_dir, name, nullptr);
+    std::string result = path;
+    g_free(path);
+    return result;
+}
+
+GDBusConnection *TestBus::connect() const { return connect_to(address()); }
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <gio/gio.h>
+#include <glib.h>
+
+#include <functional>
+#include <string>
+
+class GeoClue2Manager;
+
+/**
+ * Helpers shared by the tests: a private bus with a scratch directory for
+ * the state the Manager persists, method calls that keep serving the
+ * Manager while they wait, and the fixes and stats the tests drive and read
+ * it with.
+ *
+ * The Manager runs on the default main context of the test, so every helper
+ * that waits iterates that context.
+ */
+
+// ctest's SKIP_RETURN_CODE for the tests
+const int EXIT_SKIP = 77;
+
+// How long a reply, signal or file event may take to arrive by default
+const gint64 WAIT_TIMEOUT_US = 5 * G_USEC_PER_SEC;
+
+// Print PASS or FAIL for `what`; returns `ok`
+bool check(bool ok, const char *what);
+
+// Iterate the default main context until `condition` holds; false after
+// `timeout_us` of real time
+bool wait_for(const std::function<bool()> &condition, gint64 timeout_us = WAIT_TIMEOUT_US);
+
+// Dispatch everything that is ready without blocking
+void drain_main_context();
+
+// Method call from a peer connection, serving the Manager until it returns.
+// Prints the error and returns nullptr when the call fails.
+GVariant *call(GDBusConnection *peer, const char *service, const char *path,
+               const char *interface, const char *method, GVariant *parameters);
+
+// Object path of a started client of `desktop_id` owned by `peer`, or ""
+std::string start_client(GDBusConnection *peer, const char *service, const char *desktop_id);
+
+// `count` fixes numbered from `first`, handed to the Manager back to back
+// as the backend does in a burst; nothing is dispatched in between
+void push_fixes(GeoClue2Manager &manager, int first, int count);
+
+// One entry of the Manager's GetStats a{sv}, 0 if absent
+guint32 stat_u32(const GeoClue2Manager &manager, const char *key);
+guint64 stat_u64(const GeoClue2Manager &manager, const char *key);
+gint64 stat_i64(const GeoClue2Manager &manager, const char *key);
+
+// Bus connection to `address`; exits the test if it cannot be made
+GDBusConnection *connect_to(const char *address);
+
+// Whether dbus-daemon is installed; prints the SKIP line if it is not
+bool have_dbus_daemon();
+
+/**
+ * A private message bus and a scratch directory. XDG_CACHE_HOME and
+ * XDG_STATE_HOME point at the directory, so the persisted caches and state
+ * stay out of $HOME; it is removed with everything in it on destruction.
+ * Unref the connections made on the bus before destroying it.
+ */
+class TestBus {
+  public:
+    // `name` labels the scratch directory
+    explicit TestBus(const char *name);
+    ~TestBus();
+
+    // Non-copyable
+    TestBus(const TestBus &) = delete;
+    TestBus &operator=(const TestBus &) = delete;
+
+    const char *address() const;
+
+    // `name` inside the scratch directory
+    std::string path(const char *name) const;
+
+    // New connection to the bus; exits the test if it cannot be made
+    GDBusConnection *connect() const;
+
+  private:
+    gchar *m_dir;
+    GTestDBus *m_bus;
+};